@@ -12,6 +12,7 @@
 #include "DS1307.h"
 
 #define DS1307_ADDRESS 0xD0
+#define DS1307_ASYNC_DONE 0x01 // flag set by nowDone
 
 ////////////////////////////////////////////////////////////////////////////////
 // RtcDs1307 implementation
@@ -61,12 +62,8 @@ bool RtcDs1307::adjust(const DateTime& dt)
     return (mI2c.write(DS1307_ADDRESS,(const char *)buf,sizeof(buf)) == 0);
 }
 
-DateTime RtcDs1307::now()
-{   uint8_t buf[7] = {0};
-    
-    if(mI2c.write(DS1307_ADDRESS,(const char *)&buf[0],1,true) == 0)
-        mI2c.read(DS1307_ADDRESS,(char *)buf,sizeof(buf));
-
+static DateTime decodeTime(const uint8_t *buf)
+{
     return DateTime (
         bcd2bin(buf[6]) + 2000 // y
         ,bcd2bin(buf[5]) // m
@@ -75,4 +72,42 @@ DateTime RtcDs1307::now()
         ,bcd2bin(buf[1]) // mm
         ,bcd2bin(buf[0] & 0x7F) // ss - mask off CH - Clock Halt
         );
-}
\ No newline at end of file
+}
+
+DateTime RtcDs1307::now()
+{   uint8_t buf[7] = {0};
+
+#if DEVICE_I2C_ASYNCH
+    // Sleep on the event flag while the 9 bytes go through the bus (about 1 ms at 100 kHz)
+    mAsyncFlags.clear(DS1307_ASYNC_DONE);
+    if(nowAsync(callback(this,&RtcDs1307::nowDone)) == 0)
+    {
+        mAsyncFlags.wait_any(DS1307_ASYNC_DONE);
+        if(mAsyncEvent & I2C_EVENT_TRANSFER_COMPLETE)
+            return nowResult();
+    }
+#endif
+    if(mI2c.write(DS1307_ADDRESS,(const char *)&buf[0],1,true) == 0)
+        mI2c.read(DS1307_ADDRESS,(char *)buf,sizeof(buf));
+
+    return decodeTime(buf);
+}
+
+#if DEVICE_I2C_ASYNCH
+int RtcDs1307::nowAsync(const event_callback_t &callback)
+{
+    mAsyncRegister = 0;
+    return mI2c.transfer(DS1307_ADDRESS,&mAsyncRegister,1,(char *)mAsyncTime,sizeof(mAsyncTime),callback,I2C_EVENT_ALL,false);
+}
+
+DateTime RtcDs1307::nowResult()
+{
+    return decodeTime(mAsyncTime);
+}
+
+void RtcDs1307::nowDone(int event)
+{
+    mAsyncEvent = event;
+    mAsyncFlags.set(DS1307_ASYNC_DONE);
+}
+#endif
\ No newline at end of file
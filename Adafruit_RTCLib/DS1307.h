@@ -21,12 +21,30 @@ public:
     RtcDs1307(I2C &i2c);
     bool adjust(const DateTime& dt);
     bool isRunning();
+    // Reads the time. On targets with DEVICE_I2C_ASYNCH it is a wrapper of nowAsync: the calling
+    // thread sleeps during the transfer instead of spinning in the blocking driver, so it must be
+    // called from a thread, not from an interrupt. Falls back to the blocking read if the transfer
+    // cannot be started or fails.
     DateTime now();
     bool commit();
     uint8_t &operator[](uint8_t i) { return mRam[(i<sizeof(mRam)-1 ? i+1 : 0)]; };
+#if DEVICE_I2C_ASYNCH
+    // Non-blocking read of the time registers (I2C::transfer). The callback runs in interrupt
+    // context with the I2C event; after I2C_EVENT_TRANSFER_COMPLETE, nowResult gives the time.
+    // Returns 0 if the transfer was started, -1 if the bus is busy.
+    int nowAsync(const event_callback_t &callback);
+    DateTime nowResult();
+#endif
 protected:
     I2C &mI2c;
     uint8_t mRam[1+56]; // device register address + 56 bytes
+    char mAsyncRegister; // register address sent by the asynchronous read
+    uint8_t mAsyncTime[7]; // time registers filled by the asynchronous read
+#if DEVICE_I2C_ASYNCH
+    EventFlags mAsyncFlags; // set by nowDone at the end of the transfer started by now()
+    volatile int mAsyncEvent; // I2C event received by nowDone
+    void nowDone(int event);
+#endif
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,150 @@
+/**
+ * atitudeCarro.cpp       v0.0        17-10-2026
+ *
+ * Orientador: Elias Teodoro da Silva Junior
+ * Autores: Felipe Moura de Castro e Joao Bruno Costa Cruz,
+ * Instituto Federal de Educação, Ciência e Tecnologia do Ceará (IFCE) - Campus Fortaleza
+ *
+ * @Opensource
+ * Este código-fonte pode ser utilizado, copiado, estudado, modificado e redistribuído sem restrições.
+ *
+ * Copyright (c) 2019, Felipe Moura de Castro e Joao Bruno Costa Cruz.
+ *
+ */
+
+#include "atitudeCarro.h"
+#include <math.h>
+
+#define ATITUDE_GRAUS_POR_RADIANO   57.2957795f
+
+void iniciaAtitude (atitudeCarro *atitude) {
+    memset (atitude, 0, sizeof (atitudeCarro));
+    atitude->q[0] = 1.0f;
+    atitude->montagem[0] = 1.0f;
+}
+
+void nivelaAtitude (atitudeCarro *atitude, float rolagem, float arfagem) {
+    float cr = cosf (rolagem * 0.5f), sr = sinf (rolagem * 0.5f);
+    float ca = cosf (arfagem * 0.5f), sa = sinf (arfagem * 0.5f);
+
+    atitude->q[0] = cr * ca;
+    atitude->q[1] = sr * ca;
+    atitude->q[2] = cr * sa;
+    atitude->q[3] = -sr * sa;
+    atitude->iniciada = true;
+}
+
+void alinhaAtitude (atitudeCarro *atitude, float guinada) {
+    atitude->montagem[0] = cosf (guinada);
+    atitude->montagem[1] = sinf (guinada);
+}
+
+/**
+ * Quatérnio de rolagem e arfagem (guinada zero) que leva a gravidade medida para o eixo Z da Terra
+ */
+static void nivelaPelaGravidade (atitudeCarro *atitude, const float *acce) {
+    nivelaAtitude (atitude, atan2f (acce[1], acce[2]),
+                   atan2f (-acce[0], sqrtf (acce[1] * acce[1] + acce[2] * acce[2])));
+}
+
+void atualizaAtitude (atitudeCarro *atitude, const float *acce, const float *gyro, float dt) {
+    float *q = atitude->q;
+    float gx = gyro[0], gy = gyro[1], gz = gyro[2];
+    float modulo, ax, ay, az, vx, vy, vz, ex, ey, ez;
+    float q0, q1, q2, q3, norma;
+    float R[3][3], terra[3], cosseno, seno;
+    int i;
+
+    modulo = sqrtf (acce[0] * acce[0] + acce[1] * acce[1] + acce[2] * acce[2]);
+    if (!atitude->iniciada) {
+        if (modulo == 0.0f) {
+            return;
+        }
+        nivelaPelaGravidade (atitude, acce);
+    }
+    atitude->amostras++;
+
+    // Correção pela gravidade: erro = (aceleração medida) x (vertical prevista pelo quatérnio), no sensor
+    if (fabsf (modulo - ATITUDE_GRAVIDADE) < ATITUDE_LIMITE_ACELERACAO * ATITUDE_GRAVIDADE) {
+        ax = acce[0] / modulo;
+        ay = acce[1] / modulo;
+        az = acce[2] / modulo;
+        vx = 2.0f * (q[1] * q[3] - q[0] * q[2]);
+        vy = 2.0f * (q[0] * q[1] + q[2] * q[3]);
+        vz = q[0] * q[0] - q[1] * q[1] - q[2] * q[2] + q[3] * q[3];
+        ex = ay * vz - az * vy;
+        ey = az * vx - ax * vz;
+        ez = ax * vy - ay * vx;
+        atitude->integral[0] += ATITUDE_KI * ex * dt;
+        atitude->integral[1] += ATITUDE_KI * ey * dt;
+        atitude->integral[2] += ATITUDE_KI * ez * dt;
+        gx += ATITUDE_KP * ex;
+        gy += ATITUDE_KP * ey;
+        gz += ATITUDE_KP * ez;
+        atitude->correcoes++;
+    }
+    gx += atitude->integral[0];
+    gy += atitude->integral[1];
+    gz += atitude->integral[2];
+
+    // dq/dt = q * (0, w) / 2
+    q0 = q[0]; q1 = q[1]; q2 = q[2]; q3 = q[3];
+    dt *= 0.5f;
+    q[0] += (-q1 * gx - q2 * gy - q3 * gz) * dt;
+    q[1] += (q0 * gx + q2 * gz - q3 * gy) * dt;
+    q[2] += (q0 * gy - q1 * gz + q3 * gx) * dt;
+    q[3] += (q0 * gz + q1 * gy - q2 * gx) * dt;
+    norma = 1.0f / sqrtf (q[0] * q[0] + q[1] * q[1] + q[2] * q[2] + q[3] * q[3]);
+    for (i = 0; i < 4; i++) {
+        q[i] *= norma;
+    }
+
+    // Matriz de rotação sensor -> Terra
+    q0 = q[0]; q1 = q[1]; q2 = q[2]; q3 = q[3];
+    R[0][0] = 1.0f - 2.0f * (q2 * q2 + q3 * q3);
+    R[0][1] = 2.0f * (q1 * q2 - q0 * q3);
+    R[0][2] = 2.0f * (q1 * q3 + q0 * q2);
+    R[1][0] = 2.0f * (q1 * q2 + q0 * q3);
+    R[1][1] = 1.0f - 2.0f * (q1 * q1 + q3 * q3);
+    R[1][2] = 2.0f * (q2 * q3 - q0 * q1);
+    R[2][0] = 2.0f * (q1 * q3 - q0 * q2);
+    R[2][1] = 2.0f * (q2 * q3 + q0 * q1);
+    R[2][2] = 1.0f - 2.0f * (q1 * q1 + q2 * q2);
+
+    // Guinada do eixo X do sensor no plano horizontal (com o sensor vertical, a projeção some e a guinada é mantida)
+    norma = sqrtf (R[0][0] * R[0][0] + R[1][0] * R[1][0]);
+    cosseno = norma > 1e-3f ? R[0][0] / norma : 1.0f;
+    seno = norma > 1e-3f ? R[1][0] / norma : 0.0f;
+
+    // Soma da guinada da montagem: o eixo X de saída aponta para a frente do carro
+    norma = cosseno * atitude->montagem[0] - seno * atitude->montagem[1];
+    seno = seno * atitude->montagem[0] + cosseno * atitude->montagem[1];
+    cosseno = norma;
+
+    // Terra -> carro nivelado: rotação de -guinada em torno de Z
+    for (i = 0; i < 3; i++) {
+        terra[i] = R[i][0] * acce[0] + R[i][1] * acce[1] + R[i][2] * acce[2];
+    }
+    atitude->linear[0] = cosseno * terra[0] + seno * terra[1];
+    atitude->linear[1] = -seno * terra[0] + cosseno * terra[1];
+    atitude->linear[2] = terra[2] - ATITUDE_GRAVIDADE;
+
+    for (i = 0; i < 3; i++) {
+        terra[i] = R[i][0] * gyro[0] + R[i][1] * gyro[1] + R[i][2] * gyro[2];
+    }
+    atitude->giro[0] = cosseno * terra[0] + seno * terra[1];
+    atitude->giro[1] = -seno * terra[0] + cosseno * terra[1];
+    atitude->giro[2] = terra[2];
+}
+
+float inclinacaoAtitude (const atitudeCarro *atitude) {
+    const float *q = atitude->q;
+    float cosseno = 1.0f - 2.0f * (q[1] * q[1] + q[2] * q[2]);
+
+    if (cosseno > 1.0f) {
+        cosseno = 1.0f;
+    } else if (cosseno < -1.0f) {
+        cosseno = -1.0f;
+    }
+    return acosf (cosseno) * ATITUDE_GRAUS_POR_RADIANO;
+}
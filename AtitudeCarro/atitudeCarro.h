@@ -0,0 +1,137 @@
+/**
+ * atitudeCarro.h       v0.0        17-10-2026
+ *
+ * Orientador: Elias Teodoro da Silva Junior
+ * Autores: Felipe Moura de Castro e Joao Bruno Costa Cruz,
+ * Instituto Federal de Educação, Ciência e Tecnologia do Ceará (IFCE) - Campus Fortaleza
+ *
+ * @Opensource
+ * Este código-fonte pode ser utilizado, copiado, estudado, modificado e redistribuído sem restrições.
+ *
+ * Copyright (c) 2019, Felipe Moura de Castro e Joao Bruno Costa Cruz.
+ *
+ */
+
+#ifndef _ATITUDE_CARRO_H_
+#define _ATITUDE_CARRO_H_
+
+#include "mbed.h"
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * Atitude (orientação) da MPU6050
+ *
+ * Filtro complementar de Mahony: o quatérnio é integrado com a velocidade angular e corrigido, a cada amostra,
+ * pelo erro entre a direção da gravidade medida pelo acelerômetro e a prevista pelo quatérnio (termos
+ * proporcional ATITUDE_KP e integral ATITUDE_KI; o termo integral estima o bias do giroscópio). A correção só
+ * é aplicada quando o módulo da aceleração está perto de 1 g: em frenagens e curvas fortes o acelerômetro não
+ * mede só a gravidade (uma aceleração longitudinal moderada ainda passa pelo limite e inclina a estimativa aos
+ * poucos, com a constante de tempo de 1 / ATITUDE_KP). Sem magnetômetro, a guinada não é observável e deriva; por isso as saídas são dadas no
+ * referencial do carro nivelado: X é a projeção horizontal do eixo X do sensor, Z aponta para cima e Y completa
+ * o referencial. A gravidade é removida da aceleração nesse referencial. Quando a guinada da montagem é conhecida
+ * (alinhaAtitude), o eixo X passa a ser a frente do carro.
+ *
+ * O primeiro quatérnio vem da calibração guardada (nivelaAtitude) ou, sem ela, da primeira amostra do acelerômetro
+ * (rolagem e arfagem), sem tempo de convergência.
+ * Cada passo custa cerca de 150 operações em float (precisão simples, FPU do Cortex-M4F) e duas raízes.
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+#define ATITUDE_KP                  0.5f        // 1/s: constante de tempo de 2 s para a correção pela gravidade
+#define ATITUDE_KI                  0.05f
+#define ATITUDE_GRAVIDADE           9.81f       // mesmo valor da conversão da MPU6050
+#define ATITUDE_LIMITE_ACELERACAO   0.05f       // desvio máximo do módulo em relação a 1 g para corrigir (fração de g)
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * @brief   Estimador de atitude
+ *
+ * @var q                             quatérnio (w, x, y, z) que leva do referencial do sensor ao da Terra (Z para cima)
+ * @var integral                      termo integral da correção (bias do giroscópio com o sinal trocado, rad/s)
+ * @var linear                        aceleração sem a gravidade no referencial do carro nivelado (m/s²)
+ * @var giro                          velocidade angular no referencial do carro nivelado (rad/s)
+ * @var montagem                      cosseno e seno da guinada da montagem (ângulo da frente do carro a partir de X)
+ * @var amostras                      amostras processadas
+ * @var correcoes                     amostras em que a gravidade foi usada na correção
+ * @var iniciada                      indica se o quatérnio já foi iniciado pelo acelerômetro
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+typedef struct {
+    float q[4];
+    float integral[3];
+    float linear[3];
+    float giro[3];
+    float montagem[2];
+    uint32_t amostras;
+    uint32_t correcoes;
+    bool iniciada;
+} atitudeCarro;
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * Protótipo das funções
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * @brief Inicializa o estimador. O quatérnio é definido pela primeira amostra.
+ *
+ * @param atitude       ponteiro para o estimador
+ *
+ * @return                      Não retorna nada.
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+void iniciaAtitude (atitudeCarro *atitude);
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * @brief Define o quatérnio pela rolagem e pela arfagem (guinada zero), no lugar da primeira amostra
+ *
+ * @param atitude       ponteiro para o estimador
+ * @param rolagem       rotação em torno do eixo X do sensor (rad)
+ * @param arfagem       rotação em torno do eixo Y do sensor (rad)
+ *
+ * @return                      Não retorna nada.
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+void nivelaAtitude (atitudeCarro *atitude, float rolagem, float arfagem);
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * @brief Define a guinada da montagem: as saídas passam a ter o eixo X na frente do carro
+ *
+ * @param atitude       ponteiro para o estimador
+ * @param guinada       ângulo da frente do carro a partir da projeção horizontal do eixo X do sensor (rad)
+ *
+ * @return                      Não retorna nada.
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+void alinhaAtitude (atitudeCarro *atitude, float guinada);
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * @brief Atualiza a atitude com uma amostra e calcula a aceleração linear e a velocidade angular no referencial
+ *        do carro nivelado (atitudeCarro::linear e atitudeCarro::giro). Deve ser chamada a cada amostra.
+ *
+ * @param atitude       ponteiro para o estimador
+ * @param acce          aceleração nos eixos X, Y e Z do sensor (m/s²), como em MPU6050::getAccelero
+ * @param gyro          velocidade angular nos eixos X, Y e Z do sensor (rad/s), como em MPU6050::getGyro
+ * @param dt            intervalo desde a amostra anterior (s)
+ *
+ * @return                      Não retorna nada.
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+void atualizaAtitude (atitudeCarro *atitude, const float *acce, const float *gyro, float dt);
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * @brief Inclinação do eixo Z do sensor em relação à vertical
+ *
+ * @param atitude       ponteiro para o estimador
+ *
+ * @return                      ângulo em graus (0 = sensor nivelado, 180 = de cabeça para baixo).
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+float inclinacaoAtitude (const atitudeCarro *atitude);
+
+#endif /*_ATITUDE_CARRO_H_*/
@@ -0,0 +1,113 @@
+/**
+ * barramentoCarro.cpp       v0.0        17-10-2026
+ *
+ * Orientador: Elias Teodoro da Silva Junior
+ * Autores: Felipe Moura de Castro e Joao Bruno Costa Cruz,
+ * Instituto Federal de Educação, Ciência e Tecnologia do Ceará (IFCE) - Campus Fortaleza
+ *
+ * @Opensource
+ * Este código-fonte pode ser utilizado, copiado, estudado, modificado e redistribuído sem restrições.
+ *
+ * Copyright (c) 2019, Felipe Moura de Castro e Joao Bruno Costa Cruz.
+ *
+ */
+
+#include "barramentoCarro.h"
+
+void iniciaBarramento (barramentoI2C *barramento, I2C *i2c, int hz) {
+    memset (barramento, 0, sizeof (barramentoI2C));
+    barramento->i2c = i2c;
+    i2c->frequency (hz);
+}
+
+int cadastraClienteI2C (barramentoI2C *barramento, clienteI2C *cliente, const char *nome, uint8_t prioridade) {
+    if (barramento->quantidadeDeClientes >= BARRAMENTO_MAX_CLIENTES) {
+        return 0;
+    }
+    memset (cliente, 0, sizeof (clienteI2C));
+    cliente->nome = nome;
+    cliente->prioridade = prioridade;
+    barramento->clientes[barramento->quantidadeDeClientes++] = cliente;
+    return 1;
+}
+
+void obtemBarramento (barramentoI2C *barramento, clienteI2C *cliente) {
+    uint32_t espera;
+
+    cliente->inicioDaEspera = us_ticker_read ();
+
+    // O estado do barramento só é alterado com as interrupções desligadas (poucas instruções)
+    core_util_critical_section_enter ();
+    if (barramento->dono == NULL) {
+        barramento->dono = cliente;
+        core_util_critical_section_exit ();
+    } else {
+        cliente->thread = ThisThread::get_id ();
+        cliente->esperando = true;
+        core_util_critical_section_exit ();
+        // liberaBarramento torna este cliente o dono antes de sinalizar
+        ThisThread::flags_wait_any (BARRAMENTO_SINAL);
+    }
+
+    cliente->inicioDoUso = us_ticker_read ();
+    espera = cliente->inicioDoUso - cliente->inicioDaEspera;
+    cliente->esperaTotalUs += espera;
+    // O relatório zera a espera máxima a cada intervalo, de outra Thread
+    core_util_critical_section_enter ();
+    if (espera > cliente->esperaMaximaUs) {
+        cliente->esperaMaximaUs = espera;
+    }
+    core_util_critical_section_exit ();
+}
+
+void liberaBarramento (barramentoI2C *barramento, clienteI2C *cliente) {
+    clienteI2C *proximo = NULL;
+    int i;
+
+    cliente->usoUs += us_ticker_read () - cliente->inicioDoUso;
+    cliente->transacoes++;
+
+    core_util_critical_section_enter ();
+    for (i = 0; i < barramento->quantidadeDeClientes; i++) {
+        if (barramento->clientes[i]->esperando &&
+            (proximo == NULL || barramento->clientes[i]->prioridade > proximo->prioridade)) {
+            proximo = barramento->clientes[i];
+        }
+    }
+    if (proximo != NULL) {
+        proximo->esperando = false;
+    }
+    barramento->dono = proximo;
+    core_util_critical_section_exit ();
+
+    if (proximo != NULL) {
+        osThreadFlagsSet (proximo->thread, BARRAMENTO_SINAL);
+    }
+}
+
+void relatorioBarramento (barramentoI2C *barramento, const char *nome, clienteI2C *anteriores, uint32_t intervaloUs) {
+    clienteI2C *cliente;
+    uint32_t usoTotal = 0, ocupacao, transacoes, esperaMaxima;
+    int i;
+
+    // Ocupação em décimos de por cento (o uso inclui o processamento entre as operações de uma transação)
+    for (i = 0; i < barramento->quantidadeDeClientes; i++) {
+        usoTotal += barramento->clientes[i]->usoUs - anteriores[i].usoUs;
+    }
+    ocupacao = intervaloUs ? (uint32_t)((uint64_t)usoTotal * 1000 / intervaloUs) : 0;
+    printf ("%s: ocupacao %lu.%lu%%\r\n", nome, (unsigned long)(ocupacao / 10), (unsigned long)(ocupacao % 10));
+
+    for (i = 0; i < barramento->quantidadeDeClientes; i++) {
+        cliente = barramento->clientes[i];
+        transacoes = cliente->transacoes - anteriores[i].transacoes;
+        core_util_critical_section_enter ();
+        esperaMaxima = cliente->esperaMaximaUs;
+        cliente->esperaMaximaUs = 0;
+        core_util_critical_section_exit ();
+        printf ("  %s: %lu transacoes; uso %lu us; espera media %lu us; espera maxima no intervalo %lu us\r\n",
+                cliente->nome, (unsigned long)transacoes, (unsigned long)(cliente->usoUs - anteriores[i].usoUs),
+                (unsigned long)(transacoes ? (cliente->esperaTotalUs - anteriores[i].esperaTotalUs) / transacoes : 0),
+                (unsigned long)esperaMaxima);
+        memcpy (&anteriores[i], cliente, sizeof (clienteI2C));
+    }
+}
@@ -0,0 +1,161 @@
+/**
+ * barramentoCarro.h       v0.0        17-10-2026
+ *
+ * Orientador: Elias Teodoro da Silva Junior
+ * Autores: Felipe Moura de Castro e Joao Bruno Costa Cruz,
+ * Instituto Federal de Educação, Ciência e Tecnologia do Ceará (IFCE) - Campus Fortaleza
+ *
+ * @Opensource
+ * Este código-fonte pode ser utilizado, copiado, estudado, modificado e redistribuído sem restrições.
+ *
+ * Copyright (c) 2019, Felipe Moura de Castro e Joao Bruno Costa Cruz.
+ *
+ */
+
+#ifndef _BARRAMENTO_CARRO_H_
+#define _BARRAMENTO_CARRO_H_
+
+#include "mbed.h"
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * Gerenciador de barramento I2C
+ *
+ * Cada barramento (objeto I2C) tem um gerenciador e cada Thread que usa um dispositivo do barramento é um
+ * cliente, com uma prioridade. Uma transação vai de obtemBarramento a liberaBarramento e pode conter várias
+ * operações seguidas (por exemplo: ler a contagem da FIFO e esvaziá-la), que então não são intercaladas com
+ * as de outro cliente. Quando o barramento é liberado, ele passa ao cliente de maior prioridade que estiver
+ * esperando (a mesma prioridade, por ordem de cadastro); quem espera fica bloqueado, sem consumir CPU.
+ *
+ * O gerenciador mede, para cada cliente, as transações, o tempo de espera (total e máximo) e o tempo de uso
+ * do barramento, de onde sai a ocupação do barramento.
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+#define BARRAMENTO_MAX_CLIENTES     8
+#define BARRAMENTO_SINAL            0x100   // sinal (ThisThread::flags) que entrega o barramento ao cliente
+
+/**
+ * Frequências do I2C
+ */
+#define BARRAMENTO_NORMAL_HZ        100000  // DS1307 (não suporta mais que 100 kHz)
+#define BARRAMENTO_RAPIDO_HZ        400000  // MPU6050
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * @brief   Cliente de um barramento (uma Thread)
+ *
+ * @var nome                          nome usado no relatório
+ * @var prioridade                    maior valor -> atendido primeiro
+ * @var thread                        Thread que está esperando (válido apenas enquanto esperando)
+ * @var esperando                     indica se o cliente está na fila do barramento
+ * @var transacoes                    transações concluídas
+ * @var esperaTotalUs                 tempo total esperando o barramento (us)
+ * @var esperaMaximaUs                maior espera desde o último relatório (us; zerada por relatorioBarramento)
+ * @var usoUs                         tempo total com o barramento (us)
+ * @var inicioDaEspera                instante (us) em que a espera começou
+ * @var inicioDoUso                   instante (us) em que o cliente recebeu o barramento
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+typedef struct {
+    const char *nome;
+    uint8_t prioridade;
+    osThreadId_t thread;
+    volatile bool esperando;
+    volatile uint32_t transacoes;
+    volatile uint32_t esperaTotalUs;
+    volatile uint32_t esperaMaximaUs;
+    volatile uint32_t usoUs;
+    uint32_t inicioDaEspera;
+    uint32_t inicioDoUso;
+} clienteI2C;
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * @brief   Gerenciador de um barramento I2C
+ *
+ * @var i2c                           barramento gerenciado
+ * @var clientes                      clientes cadastrados
+ * @var quantidadeDeClientes          quantidade de clientes cadastrados
+ * @var dono                          cliente com o barramento (NULL se livre)
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+typedef struct {
+    I2C *i2c;
+    clienteI2C *clientes[BARRAMENTO_MAX_CLIENTES];
+    uint8_t quantidadeDeClientes;
+    clienteI2C *volatile dono;
+} barramentoI2C;
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * Protótipo das funções
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * @brief Inicializa o gerenciador (sem clientes) e ajusta a frequência do barramento
+ *
+ * @param barramento    ponteiro para o gerenciador
+ * @param i2c           barramento gerenciado
+ * @param hz            frequência do barramento (BARRAMENTO_NORMAL_HZ ou BARRAMENTO_RAPIDO_HZ)
+ *
+ * @return                      Não retorna nada.
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+void iniciaBarramento (barramentoI2C *barramento, I2C *i2c, int hz);
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * @brief Cadastra um cliente. Deve ser chamada antes de as Threads começarem a usar o barramento.
+ *
+ * @param barramento    ponteiro para o gerenciador
+ * @param cliente       ponteiro para o cliente (deve permanecer válido)
+ * @param nome          nome usado no relatório
+ * @param prioridade    maior valor -> atendido primeiro
+ *
+ * @return                      1 se o cliente foi cadastrado; 0 se já há BARRAMENTO_MAX_CLIENTES clientes.
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+int cadastraClienteI2C (barramentoI2C *barramento, clienteI2C *cliente, const char *nome, uint8_t prioridade);
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * @brief Inicia uma transação: bloqueia a Thread até que o barramento seja entregue ao cliente
+ *
+ * @param barramento    ponteiro para o gerenciador
+ * @param cliente       cliente da Thread que chama
+ *
+ * @return                      Não retorna nada.
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+void obtemBarramento (barramentoI2C *barramento, clienteI2C *cliente);
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * @brief Encerra a transação e entrega o barramento ao cliente de maior prioridade que estiver esperando
+ *
+ * @param barramento    ponteiro para o gerenciador
+ * @param cliente       cliente da Thread que chama (o dono do barramento)
+ *
+ * @return                      Não retorna nada.
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+void liberaBarramento (barramentoI2C *barramento, clienteI2C *cliente);
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * @brief Imprime, para cada cliente, as transações, a espera (média e máxima) e o uso desde a chamada anterior e a
+ *        ocupação do barramento no intervalo. A espera máxima de cada cliente é zerada para o intervalo seguinte.
+ *
+ * @param barramento    ponteiro para o gerenciador
+ * @param nome          nome do barramento
+ * @param anteriores    cópia dos clientes na chamada anterior (BARRAMENTO_MAX_CLIENTES posições, atualizada)
+ * @param intervaloUs   tempo desde a chamada anterior (us)
+ *
+ * @return                      Não retorna nada.
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+void relatorioBarramento (barramentoI2C *barramento, const char *nome, clienteI2C *anteriores, uint32_t intervaloUs);
+
+#endif /*_BARRAMENTO_CARRO_H_*/
@@ -0,0 +1,301 @@
+/**
+ * calibracaoCarro.cpp       v0.0        17-10-2026
+ *
+ * Orientador: Elias Teodoro da Silva Junior
+ * Autores: Felipe Moura de Castro e Joao Bruno Costa Cruz,
+ * Instituto Federal de Educação, Ciência e Tecnologia do Ceará (IFCE) - Campus Fortaleza
+ *
+ * @Opensource
+ * Este código-fonte pode ser utilizado, copiado, estudado, modificado e redistribuído sem restrições.
+ *
+ * Copyright (c) 2019, Felipe Moura de Castro e Joao Bruno Costa Cruz.
+ *
+ */
+
+#include "calibracaoCarro.h"
+#include <math.h>
+
+/**
+ * Velocidade mínima dos dois fixes usados na guinada (10 km/h): exclui as manobras, inclusive de ré, em que a
+ * velocidade do GPS (sem sinal) não acompanha a aceleração
+ */
+#define CALIBRACAO_VELOCIDADE_MINIMA    2778
+
+#define CALIBRACAO_PI                   3.14159265f
+#define CALIBRACAO_ESCALA_ANGULO        10000.0f    // 10^-4 rad
+#define CALIBRACAO_ESCALA_GIRO          10000.0f    // 10^-4 rad/s
+#define CALIBRACAO_ESCALA_ACELERACAO    1000.0f     // mm/s²
+
+// Memória do DS1307: marca, versão, registro e CRC-16 (o último byte usado é o 41 de 55)
+#define CALIBRACAO_TAMANHO              (2 + sizeof (registroCalibracao) + 2)
+
+// Arredonda e limita à faixa de um int16_t
+static int16_t paraInt16 (float valor) {
+    valor = valor >= 0.0f ? valor + 0.5f : valor - 0.5f;
+    if (valor > 32767.0f) {
+        return 32767;
+    }
+    if (valor < -32767.0f) {
+        return -32767;
+    }
+    return (int16_t)valor;
+}
+
+// Diferença entre dois ângulos, entre -pi e pi
+static float diferencaAngular (float a, float b) {
+    float diferenca = a - b;
+
+    while (diferenca > CALIBRACAO_PI) {
+        diferenca -= 2.0f * CALIBRACAO_PI;
+    }
+    while (diferenca < -CALIBRACAO_PI) {
+        diferenca += 2.0f * CALIBRACAO_PI;
+    }
+    return diferenca;
+}
+
+void publicaCalibracao (calibracaoCarro *calibracao) {
+    uint32_t sequencia = calibracao->sequencia;
+
+    calibracao->sequencia = sequencia + 1;
+    __DMB ();
+    memcpy (&calibracao->publicado, &calibracao->registro, sizeof (registroCalibracao));
+    __DMB ();
+    calibracao->sequencia = sequencia + 2;
+}
+
+void iniciaCalibracao (calibracaoCarro *calibracao, uint32_t taxaHz) {
+    memset (calibracao, 0, sizeof (calibracaoCarro));
+    calibracao->taxaHz = taxaHz;
+    calibracao->velocidadeAnterior = -1;
+}
+
+void aplicaCalibracao (calibracaoCarro *calibracao, atitudeCarro *atitude, const registroCalibracao *registro) {
+    int k;
+
+    memcpy (&calibracao->registro, registro, sizeof (registroCalibracao));
+    if (registro->validos & CALIBRACAO_BIAS) {
+        for (k = 0; k < 3; k++) {
+            calibracao->biasAcce[k] = registro->acce[k] / CALIBRACAO_ESCALA_ACELERACAO;
+            calibracao->biasGyro[k] = registro->gyro[k] / CALIBRACAO_ESCALA_GIRO;
+        }
+    }
+    if (registro->validos & CALIBRACAO_NIVEL) {
+        nivelaAtitude (atitude, registro->rolagem / CALIBRACAO_ESCALA_ANGULO,
+                       registro->arfagem / CALIBRACAO_ESCALA_ANGULO);
+    }
+    if (registro->validos & CALIBRACAO_GUINADA) {
+        alinhaAtitude (atitude, registro->guinada / CALIBRACAO_ESCALA_ANGULO);
+    }
+}
+
+void corrigeCalibracao (const calibracaoCarro *calibracao, float *acce, float *gyro) {
+    int k;
+
+    for (k = 0; k < 3; k++) {
+        acce[k] -= calibracao->biasAcce[k];
+        gyro[k] -= calibracao->biasGyro[k];
+    }
+}
+
+/**
+ * Fim de uma janela parada: verifica se o carro esteve mesmo parado e compara as médias com a calibração em uso
+ */
+static int fechaJanela (calibracaoCarro *calibracao, atitudeCarro *atitude) {
+    registroCalibracao *registro = &calibracao->registro;
+    float media[6], desvio, modulo, erro, rolagem, arfagem;
+    bool deriva;
+    int k;
+
+    for (k = 0; k < 6; k++) {
+        media[k] = calibracao->soma[k] / CALIBRACAO_JANELA;
+        desvio = k < 3 ? CALIBRACAO_DESVIO_ACELERACAO : CALIBRACAO_DESVIO_GIRO;
+        if (calibracao->somaDosQuadrados[k] / CALIBRACAO_JANELA - media[k] * media[k] > desvio * desvio) {
+            return 0;
+        }
+        media[k] += calibracao->referencia[k];
+    }
+    calibracao->janelas++;
+
+    // O giroscópio já está corrigido: a média é o bias que sobrou
+    modulo = sqrtf (media[0] * media[0] + media[1] * media[1] + media[2] * media[2]);
+    erro = modulo - ATITUDE_GRAVIDADE;
+    rolagem = atan2f (media[1], media[2]);
+    arfagem = atan2f (-media[0], sqrtf (media[1] * media[1] + media[2] * media[2]));
+
+    deriva = (registro->validos & (CALIBRACAO_BIAS | CALIBRACAO_NIVEL)) != (CALIBRACAO_BIAS | CALIBRACAO_NIVEL);
+    deriva = deriva || fabsf (erro) > CALIBRACAO_DERIVA_ACELERACAO;
+    for (k = 3; k < 6; k++) {
+        deriva = deriva || fabsf (media[k]) > CALIBRACAO_DERIVA_GIRO;
+    }
+    deriva = deriva ||
+             fabsf (diferencaAngular (rolagem, registro->rolagem / CALIBRACAO_ESCALA_ANGULO)) > CALIBRACAO_DERIVA_NIVEL ||
+             fabsf (diferencaAngular (arfagem, registro->arfagem / CALIBRACAO_ESCALA_ANGULO)) > CALIBRACAO_DERIVA_NIVEL;
+    if (!deriva) {
+        return 0;
+    }
+
+    // O termo integral da atitude compensava o bias que sobrou (com o sinal trocado): passa para a calibração
+    for (k = 0; k < 3; k++) {
+        calibracao->biasGyro[k] += media[3 + k];
+        atitude->integral[k] += media[3 + k];
+        calibracao->biasAcce[k] += erro * media[k] / modulo;
+        registro->acce[k] = paraInt16 (calibracao->biasAcce[k] * CALIBRACAO_ESCALA_ACELERACAO);
+        registro->gyro[k] = paraInt16 (calibracao->biasGyro[k] * CALIBRACAO_ESCALA_GIRO);
+    }
+    registro->rolagem = paraInt16 (rolagem * CALIBRACAO_ESCALA_ANGULO);
+    registro->arfagem = paraInt16 (arfagem * CALIBRACAO_ESCALA_ANGULO);
+    registro->validos |= CALIBRACAO_BIAS | CALIBRACAO_NIVEL;
+    calibracao->recalibracoes++;
+    publicaCalibracao (calibracao);
+    return 1;
+}
+
+int acumulaCalibracao (calibracaoCarro *calibracao, atitudeCarro *atitude, const float *acce, const float *gyro) {
+    float valor[6], diferenca;
+    int k;
+
+    // Guinada da montagem: aceleração horizontal integrada até o próximo fix
+    calibracao->amostrasDesdeOFix++;
+    calibracao->integral[0] += atitude->linear[0] / calibracao->taxaHz;
+    calibracao->integral[1] += atitude->linear[1] / calibracao->taxaHz;
+    if (fabsf (atitude->giro[2]) > calibracao->curvaMaxima) {
+        calibracao->curvaMaxima = fabsf (atitude->giro[2]);
+    }
+
+    // Janela parada: só com um fix recente mostrando o carro parado
+    if (!calibracao->parado ||
+        calibracao->amostrasDesdeOFix > calibracao->taxaHz * CALIBRACAO_INTERVALO_MAXIMO_MS / 1000) {
+        calibracao->naJanela = 0;
+        return 0;
+    }
+    for (k = 0; k < 3; k++) {
+        valor[k] = acce[k];
+        valor[3 + k] = gyro[k];
+    }
+    // As somas são feitas em relação à primeira amostra, para não perder precisão em float com 1 g
+    if (calibracao->naJanela == 0) {
+        memcpy (calibracao->referencia, valor, sizeof (valor));
+        memset (calibracao->soma, 0, sizeof (calibracao->soma));
+        memset (calibracao->somaDosQuadrados, 0, sizeof (calibracao->somaDosQuadrados));
+    }
+    for (k = 0; k < 6; k++) {
+        diferenca = valor[k] - calibracao->referencia[k];
+        calibracao->soma[k] += diferenca;
+        calibracao->somaDosQuadrados[k] += diferenca * diferenca;
+    }
+    if (++calibracao->naJanela < CALIBRACAO_JANELA) {
+        return 0;
+    }
+    calibracao->naJanela = 0;
+    return fechaJanela (calibracao, atitude);
+}
+
+int fixCalibracao (calibracaoCarro *calibracao, atitudeCarro *atitude, const dataGPS *fix) {
+    registroCalibracao *registro = &calibracao->registro;
+    bool valido = (fix->valid == 'A');
+    uint32_t intervaloMs = calibracao->amostrasDesdeOFix * 1000 / calibracao->taxaHz;
+    float variacao, residuo, guinada;
+    int refeito = 0;
+
+    calibracao->parado = valido && fix->speed < CALIBRACAO_VELOCIDADE_PARADO;
+
+    // Trecho reto entre dois fixes em movimento: a aceleração integrada é a variação da velocidade na
+    // direção da frente do carro
+    if (valido && calibracao->velocidadeAnterior >= CALIBRACAO_VELOCIDADE_MINIMA &&
+        fix->speed >= CALIBRACAO_VELOCIDADE_MINIMA && intervaloMs <= CALIBRACAO_INTERVALO_MAXIMO_MS &&
+        calibracao->curvaMaxima <= CALIBRACAO_CURVA_MAXIMA) {
+        variacao = (fix->speed - calibracao->velocidadeAnterior) / 1000.0f;
+        calibracao->frente[0] += variacao * calibracao->integral[0];
+        calibracao->frente[1] += variacao * calibracao->integral[1];
+        calibracao->somaDasVariacoes += variacao * variacao;
+    }
+
+    // Ângulo da frente medida no referencial de saída da atitude (zero se a guinada em uso estiver certa)
+    if (calibracao->somaDasVariacoes >= CALIBRACAO_VARIACAO_MINIMA) {
+        residuo = atan2f (calibracao->frente[1], calibracao->frente[0]);
+        calibracao->frente[0] = calibracao->frente[1] = 0.0f;
+        calibracao->somaDasVariacoes = 0.0f;
+        if (!(registro->validos & CALIBRACAO_GUINADA) || fabsf (residuo) > CALIBRACAO_DERIVA_GUINADA) {
+            guinada = diferencaAngular (registro->guinada / CALIBRACAO_ESCALA_ANGULO + residuo, 0.0f);
+            alinhaAtitude (atitude, guinada);
+            registro->guinada = paraInt16 (guinada * CALIBRACAO_ESCALA_ANGULO);
+            registro->validos |= CALIBRACAO_GUINADA;
+            calibracao->recalibracoes++;
+            publicaCalibracao (calibracao);
+            refeito = 1;
+        }
+    }
+
+    calibracao->velocidadeAnterior = valido ? fix->speed : -1;
+    calibracao->integral[0] = calibracao->integral[1] = 0.0f;
+    calibracao->curvaMaxima = 0.0f;
+    calibracao->amostrasDesdeOFix = 0;
+    return refeito;
+}
+
+uint32_t leCalibracao (const calibracaoCarro *calibracao, registroCalibracao *registro) {
+    uint32_t antes, depois;
+
+    do {
+        antes = calibracao->sequencia;
+        __DMB ();
+        memcpy (registro, &calibracao->publicado, sizeof (registroCalibracao));
+        __DMB ();
+        depois = calibracao->sequencia;
+    } while ((antes & 1) || antes != depois);
+
+    return antes / 2;
+}
+
+// CRC-16/CCITT (polinômio 0x1021, valor inicial 0xFFFF)
+static uint16_t crcDaCalibracao (const uint8_t *dados, int n) {
+    uint16_t crc = 0xFFFF;
+    int i, b;
+
+    for (i = 0; i < n; i++) {
+        crc ^= (uint16_t)dados[i] << 8;
+        for (b = 0; b < 8; b++) {
+            crc = (crc & 0x8000) ? (uint16_t)((crc << 1) ^ 0x1021) : (uint16_t)(crc << 1);
+        }
+    }
+    return crc;
+}
+
+int salvaCalibracao (RtcDs1307 *rtc, const registroCalibracao *registro) {
+    uint8_t dados[CALIBRACAO_TAMANHO];
+    uint16_t crc;
+    unsigned int i;
+
+    dados[0] = CALIBRACAO_MARCA;
+    dados[1] = CALIBRACAO_VERSAO;
+    memcpy (&dados[2], registro, sizeof (registroCalibracao));
+    crc = crcDaCalibracao (dados, CALIBRACAO_TAMANHO - 2);
+    dados[CALIBRACAO_TAMANHO - 2] = (uint8_t)(crc >> 8);
+    dados[CALIBRACAO_TAMANHO - 1] = (uint8_t)crc;
+
+    // A memória inteira é regravada: o registro da partida rápida vai junto, sem alteração
+    for (i = 0; i < CALIBRACAO_TAMANHO; i++) {
+        (*rtc)[CALIBRACAO_ENDERECO + i] = dados[i];
+    }
+    return rtc->commit () ? 1 : 0;
+}
+
+int carregaCalibracao (RtcDs1307 *rtc, registroCalibracao *registro) {
+    uint8_t dados[CALIBRACAO_TAMANHO];
+    unsigned int i;
+
+    // A cópia da memória do DS1307 é lida na construção do RtcDs1307
+    for (i = 0; i < CALIBRACAO_TAMANHO; i++) {
+        dados[i] = (*rtc)[CALIBRACAO_ENDERECO + i];
+    }
+    if (dados[0] != CALIBRACAO_MARCA || dados[1] != CALIBRACAO_VERSAO) {
+        return 0;
+    }
+    if (crcDaCalibracao (dados, CALIBRACAO_TAMANHO - 2) !=
+        (uint16_t)((dados[CALIBRACAO_TAMANHO - 2] << 8) | dados[CALIBRACAO_TAMANHO - 1])) {
+        return 0;
+    }
+    memcpy (registro, &dados[2], sizeof (registroCalibracao));
+    return 1;
+}
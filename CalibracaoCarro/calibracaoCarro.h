@@ -0,0 +1,260 @@
+/**
+ * calibracaoCarro.h       v0.0        17-10-2026
+ *
+ * Orientador: Elias Teodoro da Silva Junior
+ * Autores: Felipe Moura de Castro e Joao Bruno Costa Cruz,
+ * Instituto Federal de Educação, Ciência e Tecnologia do Ceará (IFCE) - Campus Fortaleza
+ *
+ * @Opensource
+ * Este código-fonte pode ser utilizado, copiado, estudado, modificado e redistribuído sem restrições.
+ *
+ * Copyright (c) 2019, Felipe Moura de Castro e Joao Bruno Costa Cruz.
+ *
+ */
+
+#ifndef _CALIBRACAO_CARRO_H_
+#define _CALIBRACAO_CARRO_H_
+
+#include "mbed.h"
+#include "GPS_Carro/GPS_Carro.h"
+#include "DS1307.h"
+#include "AtitudeCarro/atitudeCarro.h"
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * Calibração da MPU6050 e da montagem
+ *
+ * O registro de calibração (bias do acelerômetro e do giroscópio, rolagem e arfagem da montagem e guinada da
+ * montagem) fica na memória do DS1307, depois do registro da partida rápida, com marca, versão e CRC-16. Na
+ * inicialização ele é aplicado antes da primeira amostra: o bias já é descontado e o estimador de atitude parte
+ * da montagem guardada, sem espera.
+ *
+ * Com o carro parado (fix válido abaixo de CALIBRACAO_VELOCIDADE_PARADO), as amostras já corrigidas são
+ * acumuladas em janelas de CALIBRACAO_JANELA amostras. Uma janela sem movimento (desvio padrão pequeno em todos
+ * os eixos) mede o bias que sobrou no giroscópio (a média), o erro do acelerômetro na direção da gravidade
+ * (módulo da média menos 1 g; as outras direções só aparecem quando o carro para em outra inclinação) e a
+ * rolagem e a arfagem da montagem. Em movimento, a aceleração horizontal integrada entre dois fixes é comparada
+ * com a variação da velocidade do GPS, em trechos retos: a soma dos produtos aponta para a frente do carro e dá
+ * a guinada da montagem, que a gravidade não mostra.
+ *
+ * O registro só é refeito quando alguma medida se afasta da calibração em uso por mais que o limite de deriva
+ * (CALIBRACAO_DERIVA_*). O acúmulo custa algumas somas por amostra; a gravação no DS1307 fica com a Thread que
+ * usa o barramento do RTC.
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+#define CALIBRACAO_ENDERECO             18          // primeiro byte na memória do DS1307 (0 a 17: partida rápida)
+#define CALIBRACAO_MARCA                0xC5        // identifica um registro gravado por este programa
+#define CALIBRACAO_VERSAO               1           // muda quando o formato do registro muda
+
+#define CALIBRACAO_VELOCIDADE_PARADO    833         // mm/s (3 km/h)
+#define CALIBRACAO_JANELA               2000        // amostras de uma janela parada (2 s a 1 kHz)
+#define CALIBRACAO_DESVIO_GIRO          0.02f       // rad/s: desvio padrão máximo de cada eixo na janela parada
+#define CALIBRACAO_DESVIO_ACELERACAO    0.5f        // m/s²: desvio padrão máximo de cada eixo (motor ligado vibra)
+
+#define CALIBRACAO_CURVA_MAXIMA         0.05f       // rad/s: guinada máxima de um trecho considerado reto
+#define CALIBRACAO_INTERVALO_MAXIMO_MS  1500        // intervalo máximo entre dois fixes usados na guinada
+#define CALIBRACAO_VARIACAO_MINIMA      50.0f       // (m/s)²: soma dos quadrados das variações para medir a guinada
+
+#define CALIBRACAO_DERIVA_GIRO          0.002f      // rad/s (0,11 graus/s)
+#define CALIBRACAO_DERIVA_ACELERACAO    0.05f       // m/s²
+#define CALIBRACAO_DERIVA_NIVEL         0.035f      // rad (2 graus)
+#define CALIBRACAO_DERIVA_GUINADA       0.035f      // rad (2 graus)
+
+/**
+ * Partes válidas do registro
+ */
+#define CALIBRACAO_BIAS                 0x01
+#define CALIBRACAO_NIVEL                0x02
+#define CALIBRACAO_GUINADA              0x04
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * @brief   Registro de calibração, no formato guardado no DS1307 (20 bytes)
+ *
+ * @var acce                          bias do acelerômetro nos eixos do sensor (mm/s²)
+ * @var gyro                          bias do giroscópio nos eixos do sensor (10^-4 rad/s)
+ * @var rolagem                       rolagem da montagem (10^-4 rad)
+ * @var arfagem                       arfagem da montagem (10^-4 rad)
+ * @var guinada                       guinada da montagem: ângulo da frente do carro a partir de X (10^-4 rad)
+ * @var validos                       partes válidas (CALIBRACAO_BIAS, CALIBRACAO_NIVEL, CALIBRACAO_GUINADA)
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+typedef struct {
+    int16_t acce[3];
+    int16_t gyro[3];
+    int16_t rolagem;
+    int16_t arfagem;
+    int16_t guinada;
+    uint16_t validos;
+} registroCalibracao;
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * @brief   Calibração em uso e medidas acumuladas. Escrita apenas pela Thread da navegação; o registro é
+ *          publicado para a gravação com o mesmo controle de sequência do publicadorGPS.
+ *
+ * @var taxaHz                        taxa de amostragem (Hz)
+ * @var biasAcce                      bias do acelerômetro em uso (m/s²)
+ * @var biasGyro                      bias do giroscópio em uso (rad/s)
+ * @var registro                      registro correspondente à calibração em uso
+ * @var referencia                    primeira amostra da janela parada (as somas são feitas em relação a ela)
+ * @var soma                          soma dos desvios em relação à referência (acelerômetro e giroscópio)
+ * @var somaDosQuadrados              soma dos quadrados dos desvios
+ * @var naJanela                      amostras da janela parada atual
+ * @var parado                        indica se o último fix mostrou o carro parado
+ * @var amostrasDesdeOFix             amostras desde o último fix
+ * @var integral                      aceleração horizontal integrada desde o último fix (m/s)
+ * @var curvaMaxima                   maior velocidade angular vertical desde o último fix (rad/s)
+ * @var velocidadeAnterior            velocidade do último fix (mm/s; negativa se o fix não serviu)
+ * @var frente                        soma das acelerações integradas ponderadas pela variação da velocidade
+ * @var somaDasVariacoes              soma dos quadrados das variações da velocidade ((m/s)²)
+ * @var janelas                       janelas paradas aceitas
+ * @var recalibracoes                 registros refeitos por deriva
+ * @var sequencia                     contador de publicações do registro (par quando não há escrita em andamento)
+ * @var publicado                     último registro publicado
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+typedef struct {
+    uint32_t taxaHz;
+    float biasAcce[3];
+    float biasGyro[3];
+    registroCalibracao registro;
+    float referencia[6];
+    float soma[6];
+    float somaDosQuadrados[6];
+    uint32_t naJanela;
+    bool parado;
+    uint32_t amostrasDesdeOFix;
+    float integral[2];
+    float curvaMaxima;
+    int32_t velocidadeAnterior;
+    float frente[2];
+    float somaDasVariacoes;
+    uint32_t janelas;
+    uint32_t recalibracoes;
+    volatile uint32_t sequencia;
+    registroCalibracao publicado;
+} calibracaoCarro;
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * Protótipo das funções
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * @brief Inicializa a calibração sem correções (bias zero, montagem desconhecida)
+ *
+ * @param calibracao    ponteiro para a calibração
+ * @param taxaHz        taxa de amostragem da MPU6050 (Hz)
+ *
+ * @return                      Não retorna nada.
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+void iniciaCalibracao (calibracaoCarro *calibracao, uint32_t taxaHz);
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * @brief Passa a usar um registro (guardado no DS1307) e aplica a montagem ao estimador de atitude
+ *
+ * @param calibracao    ponteiro para a calibração
+ * @param atitude       estimador de atitude (ainda sem amostras)
+ * @param registro      registro carregado por carregaCalibracao
+ *
+ * @return                      Não retorna nada.
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+void aplicaCalibracao (calibracaoCarro *calibracao, atitudeCarro *atitude, const registroCalibracao *registro);
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * @brief Desconta o bias de uma amostra
+ *
+ * @param calibracao    ponteiro para a calibração
+ * @param acce          aceleração nos eixos X, Y e Z do sensor (m/s²), corrigida no lugar
+ * @param gyro          velocidade angular nos eixos X, Y e Z do sensor (rad/s), corrigida no lugar
+ *
+ * @return                      Não retorna nada.
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+void corrigeCalibracao (const calibracaoCarro *calibracao, float *acce, float *gyro);
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * @brief Acumula uma amostra já corrigida e já processada pelo estimador de atitude. Ao fim de uma janela parada
+ *        com deriva, o bias e a montagem em uso são atualizados e o novo registro é publicado.
+ *
+ * @param calibracao    ponteiro para a calibração
+ * @param atitude       estimador de atitude (o termo integral é ajustado quando o bias do giroscópio muda)
+ * @param acce          aceleração corrigida nos eixos do sensor (m/s²)
+ * @param gyro          velocidade angular corrigida nos eixos do sensor (rad/s)
+ *
+ * @return                      1 se o registro foi refeito; 0 caso contrário.
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+int acumulaCalibracao (calibracaoCarro *calibracao, atitudeCarro *atitude, const float *acce, const float *gyro);
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * @brief Informa um fix novo: decide se o carro está parado e compara a variação da velocidade com a aceleração
+ *        integrada desde o fix anterior (guinada da montagem)
+ *
+ * @param calibracao    ponteiro para a calibração
+ * @param atitude       estimador de atitude (recebe a nova guinada da montagem)
+ * @param fix           fix recebido do GPS
+ *
+ * @return                      1 se o registro foi refeito; 0 caso contrário.
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+int fixCalibracao (calibracaoCarro *calibracao, atitudeCarro *atitude, const dataGPS *fix);
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * @brief Publica o registro em uso, com o mesmo controle de sequência de publicaGPS. Chamada pela própria
+ *        calibração quando o registro é refeito; deve ser chamada apenas pela Thread da navegação.
+ *
+ * @param calibracao    ponteiro para a calibração
+ *
+ * @return                      Não retorna nada.
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+void publicaCalibracao (calibracaoCarro *calibracao);
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * @brief Lê o último registro publicado. Pode ser chamada por qualquer Thread.
+ *
+ * @param calibracao    ponteiro para a calibração
+ * @param registro      ponteiro para a struct que recebe o registro
+ *
+ * @return                      quantidade de publicações (0 se nenhum registro foi refeito).
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+uint32_t leCalibracao (const calibracaoCarro *calibracao, registroCalibracao *registro);
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * @brief Guarda o registro na memória do DS1307 (marca, versão, registro e CRC-16)
+ *
+ * @param rtc           DS1307
+ * @param registro      registro a guardar
+ *
+ * @return                      1 se a memória foi gravada; 0 em caso de erro no I2C.
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+int salvaCalibracao (RtcDs1307 *rtc, const registroCalibracao *registro);
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * @brief Lê o registro guardado na memória do DS1307 (cópia lida na construção do RtcDs1307)
+ *
+ * @param rtc           DS1307
+ * @param registro      ponteiro para a struct que recebe o registro
+ *
+ * @return                      1 se há um registro válido desta versão; 0 caso contrário.
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+int carregaCalibracao (RtcDs1307 *rtc, registroCalibracao *registro);
+
+#endif /*_CALIBRACAO_CARRO_H_*/
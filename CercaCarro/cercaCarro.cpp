@@ -0,0 +1,286 @@
+/**
+ * cercaCarro.cpp       v0.0        17-10-2026
+ *
+ * Orientador: Elias Teodoro da Silva Junior
+ * Autores: Felipe Moura de Castro e Joao Bruno Costa Cruz,
+ * Instituto Federal de Educação, Ciência e Tecnologia do Ceará (IFCE) - Campus Fortaleza
+ *
+ * @Opensource
+ * Este código-fonte pode ser utilizado, copiado, estudado, modificado e redistribuído sem restrições.
+ *
+ * Copyright (c) 2019, Felipe Moura de Castro e Joao Bruno Costa Cruz.
+ *
+ */
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * As coordenadas são tomadas em relação ao canto sudoeste da grade e multiplicadas por 2. A altura e a
+ * largura das células são ímpares, então o centro de uma célula tem coordenadas ímpares e nunca coincide
+ * com um vértice nem com um fix (coordenadas pares).
+ *
+ * Um segmento pc cruza a aresta ab quando a e b ficam em lados opostos da reta pc e p e c ficam em
+ * lados opostos da reta ab. Um vértice exatamente sobre a reta pc é tratado como se estivesse do lado
+ * negativo; assim, quando o segmento passa por um vértice, apenas uma das duas arestas vizinhas é contada.
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+
+#include "cercaCarro.h"
+
+// Produto vetorial (b - a) x (c - a): > 0 se c está à esquerda de ab
+static inline int64_t orientacao (int64_t ax, int64_t ay, int64_t bx, int64_t by, int64_t cx, int64_t cy) {
+    return (bx - ax) * (cy - ay) - (by - ay) * (cx - ax);
+}
+
+// Indica se o segmento pc cruza a aresta ab
+static inline int cruza (int64_t px, int64_t py, int64_t cx, int64_t cy,
+                         int64_t ax, int64_t ay, int64_t bx, int64_t by) {
+    if ((orientacao (px, py, cx, cy, ax, ay) > 0) == (orientacao (px, py, cx, cy, bx, by) > 0)) {
+        return 0;
+    }
+    return (orientacao (ax, ay, bx, by, px, py) > 0) != (orientacao (ax, ay, bx, by, cx, cy) > 0);
+}
+
+// Índice do vértice final da aresta que começa em 'vertice'
+static inline uint16_t fimDaAresta (const poligonoCerca *poligono, uint16_t vertice) {
+    vertice++;
+    return (vertice == poligono->primeiroVertice + poligono->quantidadeDeVertices) ? poligono->primeiroVertice : vertice;
+}
+
+// Coordenadas de um vértice em relação ao canto da grade, multiplicadas por 2
+static inline void relativoAGrade (const gradeCerca *grade, const verticeCerca *v, int64_t *x, int64_t *y) {
+    *x = 2 * ((int64_t)v->longitude - grade->longitudeMinima);
+    *y = 2 * ((int64_t)v->latitude - grade->latitudeMinima);
+}
+
+// Paridade do número de cruzamentos entre o centro (cx, cy) e um ponto a leste de toda a cerca
+static int centroDentro (const gradeCerca *grade, const verticeCerca *vertices, const poligonoCerca *poligono,
+                         int64_t cx, int64_t cy) {
+    int64_t ax, ay, bx, by, fx = 0;
+    int dentro = 0;
+    uint32_t i;
+
+    for (i = 0; i < poligono->quantidadeDeVertices; i++) {
+        relativoAGrade (grade, &vertices[poligono->primeiroVertice + i], &ax, &ay);
+        if (ax > fx) {
+            fx = ax;
+        }
+    }
+    fx += 2;
+
+    for (i = poligono->primeiroVertice; i < (uint32_t)poligono->primeiroVertice + poligono->quantidadeDeVertices; i++) {
+        relativoAGrade (grade, &vertices[i], &ax, &ay);
+        relativoAGrade (grade, &vertices[fimDaAresta (poligono, (uint16_t)i)], &bx, &by);
+        dentro ^= cruza (cx, cy, fx, cy, ax, ay, bx, by);
+    }
+    return dentro;
+}
+
+int montaGradeCerca (montagemCerca *montagem, uint16_t linhas, uint16_t colunas, const verticeCerca *vertices,
+                     const poligonoCerca *poligonos, uint16_t quantidade) {
+    gradeCerca *grade = &montagem->grade;
+    int32_t latitudeMaxima, longitudeMaxima;
+    int64_t ax, ay, bx, by, sul, oeste, cx, cy;
+    uint32_t registros = 0, arestas = 0, inicioDasArestas, i, maximoDeRegistros, maximoDeArestas;
+    int celula, p, dentro;
+
+    memset (grade, 0, sizeof (gradeCerca));
+    montagem->quantidadeDeRegistros = montagem->quantidadeDeArestas = 0;
+    if (quantidade == 0 || linhas == 0 || colunas == 0 || (uint32_t)linhas * colunas > CERCA_MAX_INDICE) {
+        return 0;
+    }
+    maximoDeRegistros = (montagem->maximoDeRegistros < CERCA_MAX_INDICE) ? montagem->maximoDeRegistros : CERCA_MAX_INDICE;
+    maximoDeArestas = (montagem->maximoDeArestas < CERCA_MAX_INDICE) ? montagem->maximoDeArestas : CERCA_MAX_INDICE;
+    grade->linhas = linhas;
+    grade->colunas = colunas;
+
+    // Retângulo que envolve todas as cercas
+    grade->latitudeMinima = latitudeMaxima = vertices[poligonos[0].primeiroVertice].latitude;
+    grade->longitudeMinima = longitudeMaxima = vertices[poligonos[0].primeiroVertice].longitude;
+    for (p = 0; p < quantidade; p++) {
+        if (poligonos[p].quantidadeDeVertices < 3 ||
+            (uint32_t)poligonos[p].primeiroVertice + poligonos[p].quantidadeDeVertices > CERCA_MAX_INDICE) {
+            return 0;
+        }
+        for (i = poligonos[p].primeiroVertice; i < (uint32_t)poligonos[p].primeiroVertice + poligonos[p].quantidadeDeVertices; i++) {
+            if (vertices[i].latitude < grade->latitudeMinima) grade->latitudeMinima = vertices[i].latitude;
+            if (vertices[i].latitude > latitudeMaxima) latitudeMaxima = vertices[i].latitude;
+            if (vertices[i].longitude < grade->longitudeMinima) grade->longitudeMinima = vertices[i].longitude;
+            if (vertices[i].longitude > longitudeMaxima) longitudeMaxima = vertices[i].longitude;
+        }
+    }
+
+    // Células de dimensões ímpares que cobrem todo o retângulo
+    grade->alturaDaCelula = (int32_t)(((int64_t)latitudeMaxima - grade->latitudeMinima) / linhas + 1) | 1;
+    grade->larguraDaCelula = (int32_t)(((int64_t)longitudeMaxima - grade->longitudeMinima) / colunas + 1) | 1;
+
+    for (celula = 0; celula < linhas * colunas; celula++) {
+        montagem->inicioDaCelula[celula] = (uint16_t)registros;
+        sul = (int64_t)(celula / colunas) * grade->alturaDaCelula;
+        oeste = (int64_t)(celula % colunas) * grade->larguraDaCelula;
+        cy = 2 * sul + grade->alturaDaCelula;
+        cx = 2 * oeste + grade->larguraDaCelula;
+
+        for (p = 0; p < quantidade; p++) {
+            inicioDasArestas = arestas;
+
+            // Arestas cujo retângulo toca a célula (bordas incluídas)
+            for (i = poligonos[p].primeiroVertice; i < (uint32_t)poligonos[p].primeiroVertice + poligonos[p].quantidadeDeVertices; i++) {
+                relativoAGrade (grade, &vertices[i], &ax, &ay);
+                relativoAGrade (grade, &vertices[fimDaAresta (&poligonos[p], (uint16_t)i)], &bx, &by);
+                if ((ay < by ? ay : by) > 2 * (sul + grade->alturaDaCelula) || (ay > by ? ay : by) < 2 * sul ||
+                    (ax < bx ? ax : bx) > 2 * (oeste + grade->larguraDaCelula) || (ax > bx ? ax : bx) < 2 * oeste) {
+                    continue;
+                }
+                // Centro sobre a aresta: a referência da célula seria ambígua
+                if (orientacao (ax, ay, bx, by, cx, cy) == 0 &&
+                    cx >= (ax < bx ? ax : bx) && cx <= (ax > bx ? ax : bx) &&
+                    cy >= (ay < by ? ay : by) && cy <= (ay > by ? ay : by)) {
+                    return 0;
+                }
+                if (arestas >= maximoDeArestas) {
+                    return 0;
+                }
+                montagem->arestas[arestas++] = (uint16_t)i;
+            }
+
+            // Cercas sem arestas na célula só são registradas se a cobrem inteira
+            dentro = centroDentro (grade, vertices, &poligonos[p], cx, cy);
+            if (arestas == inicioDasArestas && !dentro) {
+                continue;
+            }
+            if (registros >= maximoDeRegistros) {
+                return 0;
+            }
+            montagem->registros[registros].poligono = (uint16_t)p;
+            montagem->registros[registros].centroDentro = (uint8_t)dentro;
+            montagem->registros[registros].primeiraAresta = (uint16_t)inicioDasArestas;
+            registros++;
+        }
+    }
+    montagem->inicioDaCelula[linhas * colunas] = (uint16_t)registros;
+    montagem->registros[registros].poligono = 0;
+    montagem->registros[registros].centroDentro = 0;
+    montagem->registros[registros].primeiraAresta = (uint16_t)arestas;
+    montagem->quantidadeDeRegistros = registros;
+    montagem->quantidadeDeArestas = arestas;
+    grade->inicioDaCelula = montagem->inicioDaCelula;
+    grade->registros = montagem->registros;
+    grade->arestas = montagem->arestas;
+    return 1;
+}
+
+int iniciaCercas (cercasCarro *cercas, const verticeCerca *vertices, const poligonoCerca *poligonos, uint16_t quantidade,
+                  const gradeCerca *grade) {
+    memset (cercas, 0, sizeof (cercasCarro));
+    if (quantidade == 0 || quantidade > CERCA_MAX_POLIGONOS || grade == NULL) {
+        return 0;
+    }
+    cercas->vertices = vertices;
+    cercas->poligonos = poligonos;
+    cercas->grade = grade;
+    cercas->quantidadeDePoligonos = quantidade;
+    return 1;
+}
+
+void localizaNasCercas (const cercasCarro *cercas, int32_t latitude, int32_t longitude, uint32_t *dentro) {
+    const gradeCerca *grade = cercas->grade;
+    int64_t dy, dx, linha, coluna, px, py, cx, cy, ax, ay, bx, by;
+    const registroCerca *registro;
+    const poligonoCerca *poligono;
+    uint32_t r, fim, a, celula;
+    int paridade;
+
+    memset (dentro, 0, CERCA_PALAVRAS * sizeof (uint32_t));
+
+    // Fora da grade não há cerca
+    if (cercas->quantidadeDePoligonos == 0) {
+        return;
+    }
+    dy = (int64_t)latitude - grade->latitudeMinima;
+    dx = (int64_t)longitude - grade->longitudeMinima;
+    if (dy < 0 || dx < 0) {
+        return;
+    }
+    linha = dy / grade->alturaDaCelula;
+    coluna = dx / grade->larguraDaCelula;
+    if (linha >= grade->linhas || coluna >= grade->colunas) {
+        return;
+    }
+
+    py = 2 * dy;
+    px = 2 * dx;
+    cy = 2 * linha * grade->alturaDaCelula + grade->alturaDaCelula;
+    cx = 2 * coluna * grade->larguraDaCelula + grade->larguraDaCelula;
+
+    celula = (uint32_t)(linha * grade->colunas + coluna);
+    fim = grade->inicioDaCelula[celula + 1];
+    for (r = grade->inicioDaCelula[celula]; r < fim; r++) {
+        registro = &grade->registros[r];
+        poligono = &cercas->poligonos[registro->poligono];
+        paridade = registro->centroDentro;
+        for (a = registro->primeiraAresta; a < grade->registros[r + 1].primeiraAresta; a++) {
+            relativoAGrade (grade, &cercas->vertices[grade->arestas[a]], &ax, &ay);
+            relativoAGrade (grade, &cercas->vertices[fimDaAresta (poligono, grade->arestas[a])], &bx, &by);
+            paridade ^= cruza (px, py, cx, cy, ax, ay, bx, by);
+        }
+        if (paridade) {
+            dentro[registro->poligono >> 5] |= (uint32_t)1 << (registro->poligono & 31);
+        }
+    }
+}
+
+int verificaCercas (cercasCarro *cercas, const dataGPS *fix, eventoCerca *eventos, int maximo) {
+    uint32_t atual[CERCA_PALAVRAS], diferentes, visitar, bit;
+    int palavra, b, p, n = 0;
+
+    if (fix->valid != 'A') {
+        return 0;
+    }
+    localizaNasCercas (cercas, fix->latitude, fix->longitude, atual);
+
+    // Estado inicial: o carro pode ligar já dentro de uma garagem
+    if (!cercas->estadoConhecido) {
+        memcpy (cercas->dentro, atual, sizeof (atual));
+        memset (cercas->pendentes, 0, sizeof (cercas->pendentes));
+        memset (cercas->confirmacoes, 0, sizeof (cercas->confirmacoes));
+        cercas->estadoConhecido = true;
+        return 0;
+    }
+
+    // Só as cercas que contrariam o estado confirmado ou têm confirmações em andamento são visitadas
+    for (palavra = 0; palavra < CERCA_PALAVRAS; palavra++) {
+        diferentes = atual[palavra] ^ cercas->dentro[palavra];
+        visitar = diferentes | cercas->pendentes[palavra];
+        for (b = 0; visitar != 0; b++, visitar >>= 1) {
+            if (!(visitar & 1)) {
+                continue;
+            }
+            bit = (uint32_t)1 << b;
+            p = palavra * 32 + b;
+            if (!(diferentes & bit)) {
+                cercas->confirmacoes[p] = 0;
+                cercas->pendentes[palavra] &= ~bit;
+                continue;
+            }
+            if (cercas->confirmacoes[p] < CERCA_CONFIRMACOES) {
+                cercas->confirmacoes[p]++;
+            }
+            // Sem espaço para o evento, a transição fica para o próximo fix
+            if (cercas->confirmacoes[p] < CERCA_CONFIRMACOES || n >= maximo) {
+                cercas->pendentes[palavra] |= bit;
+                continue;
+            }
+            cercas->dentro[palavra] ^= bit;
+            cercas->pendentes[palavra] &= ~bit;
+            cercas->confirmacoes[p] = 0;
+            eventos[n].poligono = (uint16_t)p;
+            eventos[n].transicao = (atual[palavra] & bit) ? CERCA_ENTRADA : CERCA_SAIDA;
+            eventos[n].latitude = fix->latitude;
+            eventos[n].longitude = fix->longitude;
+            eventos[n].instante = tempoDoFix (fix);
+            n++;
+        }
+    }
+    return n;
+}
+
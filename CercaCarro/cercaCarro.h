@@ -0,0 +1,291 @@
+/**
+ * cercaCarro.h       v0.0        17-10-2026
+ *
+ * Orientador: Elias Teodoro da Silva Junior
+ * Autores: Felipe Moura de Castro e Joao Bruno Costa Cruz,
+ * Instituto Federal de Educação, Ciência e Tecnologia do Ceará (IFCE) - Campus Fortaleza
+ *
+ * @Opensource
+ * Este código-fonte pode ser utilizado, copiado, estudado, modificado e redistribuído sem restrições.
+ *
+ * Copyright (c) 2019, Felipe Moura de Castro e Joao Bruno Costa Cruz.
+ *
+ */
+
+#ifndef _CERCA_CARRO_H_
+#define _CERCA_CARRO_H_
+
+#include "mbed.h"
+#include "FilaCarro/filaCarro.h"
+#include "GPS_Carro/GPS_Carro.h"
+#include "TempoCarro/tempoCarro.h"
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * Cercas virtuais (geofencing)
+ *
+ * As cercas são polígonos (garagens, áreas restritas...) descritos por vértices em graus * 10^7, o
+ * mesmo formato do dataGPS.
+ *
+ * montaGradeCerca divide o retângulo que envolve todas as cercas em uma grade de linhas x colunas
+ * células e guarda, para cada célula, quais cercas a tocam, se o centro da célula está dentro de cada
+ * uma delas e quais arestas cruzam a célula. A grade é montada no computador pela ferramenta
+ * geraGradeCercas (testes/), que escreve os vértices, as cercas e a grade como vetores constantes
+ * (CercaCarro/cercasDoCarro.cpp): no carro tudo fica na FLASH e nada é montado na inicialização.
+ *
+ * A cada fix, só as arestas da célula onde o carro está são testadas: o fix está dentro de uma cerca
+ * se o segmento entre ele e o centro da célula cruza as arestas um número par de vezes e o centro
+ * está dentro (ou ímpar e o centro está fora). Todas as contas são inteiras (64 bits), sem ponto
+ * flutuante.
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+#ifndef CERCA_MAX_POLIGONOS
+#define CERCA_MAX_POLIGONOS     32      // define o tamanho do estado (cercasCarro) na RAM
+#endif
+#define CERCA_PALAVRAS          ((CERCA_MAX_POLIGONOS + 31) / 32)
+#define CERCA_MAX_INDICE        0xFFFF  // limite de vértices, registros e arestas da grade (índices de 16 bits)
+
+/**
+ * Fixes consecutivos do outro lado da cerca necessários para confirmar uma entrada ou saída
+ * (evita eventos repetidos quando o carro anda sobre a borda)
+ */
+#define CERCA_CONFIRMACOES      3
+
+/**
+ * Tipos de cerca
+ */
+#define CERCA_GARAGEM           'G'
+#define CERCA_RESTRITA          'R'
+
+/**
+ * Transições
+ */
+#define CERCA_ENTRADA           'E'
+#define CERCA_SAIDA             'S'
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * @brief   Vértice de uma cerca
+ *
+ * @var latitude                      graus * 10^7
+ * @var longitude                     graus * 10^7
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+typedef struct {
+    int32_t latitude;
+    int32_t longitude;
+} verticeCerca;
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * @brief   Cerca (polígono simples, sem repetir o primeiro vértice no final)
+ *
+ * @var nome                          nome da cerca
+ * @var tipo                          CERCA_GARAGEM, CERCA_RESTRITA...
+ * @var primeiroVertice               índice do primeiro vértice no vetor de vértices
+ * @var quantidadeDeVertices          quantidade de vértices (no mínimo 3)
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+typedef struct {
+    const char *nome;
+    char tipo;
+    uint16_t primeiroVertice;
+    uint16_t quantidadeDeVertices;
+} poligonoCerca;
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * @brief   Registro de uma cerca em uma célula da grade. As arestas do registro vão de
+ *          primeiraAresta até a primeiraAresta do registro seguinte.
+ *
+ * @var poligono                      índice da cerca
+ * @var centroDentro                  1 se o centro da célula está dentro da cerca
+ * @var primeiraAresta                índice da primeira aresta do registro no vetor de arestas da grade
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+typedef struct {
+    uint16_t poligono;
+    uint8_t centroDentro;
+    uint16_t primeiraAresta;
+} registroCerca;
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * @brief   Índice em grade das cercas (constante: gerado no computador por geraGradeCercas)
+ *
+ * @var latitudeMinima                canto sudoeste da grade (graus * 10^7)
+ * @var longitudeMinima               canto sudoeste da grade (graus * 10^7)
+ * @var alturaDaCelula                altura de uma célula (graus * 10^7, ímpar)
+ * @var larguraDaCelula               largura de uma célula (graus * 10^7, ímpar)
+ * @var linhas                        quantidade de linhas da grade
+ * @var colunas                       quantidade de colunas da grade
+ * @var inicioDaCelula                índice do primeiro registro de cada célula (mais um para o fim da última)
+ * @var registros                     registros de todas as células (mais um para o fim das arestas)
+ * @var arestas                       arestas de todos os registros (índice do vértice inicial da aresta)
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+typedef struct {
+    int32_t latitudeMinima;
+    int32_t longitudeMinima;
+    int32_t alturaDaCelula;
+    int32_t larguraDaCelula;
+    uint16_t linhas;
+    uint16_t colunas;
+    const uint16_t *inicioDaCelula;
+    const registroCerca *registros;
+    const uint16_t *arestas;
+} gradeCerca;
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * @brief   Espaço para montar uma grade (no computador). Quem chama aloca os vetores e informa os tamanhos.
+ *
+ * @var grade                         grade montada (aponta para os vetores abaixo)
+ * @var inicioDaCelula                linhas * colunas + 1 posições
+ * @var registros                     maximoDeRegistros + 1 posições
+ * @var arestas                       maximoDeArestas posições
+ * @var maximoDeRegistros             registros disponíveis (até CERCA_MAX_INDICE)
+ * @var maximoDeArestas               arestas disponíveis (até CERCA_MAX_INDICE)
+ * @var quantidadeDeRegistros         registros usados pela grade montada
+ * @var quantidadeDeArestas           arestas usadas pela grade montada
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+typedef struct {
+    gradeCerca grade;
+    uint16_t *inicioDaCelula;
+    registroCerca *registros;
+    uint16_t *arestas;
+    uint32_t maximoDeRegistros;
+    uint32_t maximoDeArestas;
+    uint32_t quantidadeDeRegistros;
+    uint32_t quantidadeDeArestas;
+} montagemCerca;
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * @brief   Conjunto de cercas com o índice em grade e o estado do carro em relação a cada cerca
+ *
+ * @var vertices                      vértices de todas as cercas
+ * @var poligonos                     cercas
+ * @var grade                         índice em grade das cercas
+ * @var quantidadeDePoligonos         quantidade de cercas
+ * @var dentro                        um bit por cerca: 1 se o carro está dentro (estado confirmado)
+ * @var pendentes                     um bit por cerca: 1 se há confirmações em andamento
+ * @var confirmacoes                  fixes consecutivos em que cada cerca contrariou o estado confirmado
+ * @var estadoConhecido               indica se algum fix já foi verificado
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+typedef struct {
+    const verticeCerca *vertices;
+    const poligonoCerca *poligonos;
+    const gradeCerca *grade;
+    uint16_t quantidadeDePoligonos;
+    uint32_t dentro[CERCA_PALAVRAS];
+    uint32_t pendentes[CERCA_PALAVRAS];
+    uint8_t confirmacoes[CERCA_MAX_POLIGONOS];
+    bool estadoConhecido;
+} cercasCarro;
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * @brief   Entrada ou saída de uma cerca
+ *
+ * @var poligono                      índice da cerca
+ * @var transicao                     CERCA_ENTRADA ou CERCA_SAIDA
+ * @var latitude                      posição do fix que confirmou a transição (graus * 10^7)
+ * @var longitude                     posição do fix que confirmou a transição (graus * 10^7)
+ * @var instante                      tempo Unix do fix em milissegundos (0 se o fix não tem data)
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+typedef struct {
+    uint16_t poligono;
+    char transicao;
+    int32_t latitude;
+    int32_t longitude;
+    uint64_t instante;
+} eventoCerca;
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * Tamanho da fila de eventos (deve ser potência de 2)
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+#define TAMANHO_FILA_CERCA 8
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * @brief   Fila de eventos (filaCarro) com um único produtor e um único consumidor
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+typedef filaCarro<eventoCerca, TAMANHO_FILA_CERCA> filaCerca;
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * Protótipo das funções
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * @brief Monta o índice em grade das cercas nos vetores da montagem (usada no computador por geraGradeCercas)
+ *
+ * @param montagem      vetores e tamanhos disponíveis; recebe a grade montada
+ * @param linhas        quantidade de linhas da grade
+ * @param colunas       quantidade de colunas da grade
+ * @param vertices      vértices de todas as cercas
+ * @param poligonos     cercas
+ * @param quantidade    quantidade de cercas
+ *
+ * @return                      1 se a grade foi montada; 0 se alguma cerca é inválida, o centro de uma
+ *                              célula cai sobre uma aresta ou a grade não coube na montagem.
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+int montaGradeCerca (montagemCerca *montagem, uint16_t linhas, uint16_t colunas, const verticeCerca *vertices,
+                     const poligonoCerca *poligonos, uint16_t quantidade);
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * @brief Inicializa o conjunto de cercas com a grade já montada. Deve ser chamada uma vez, antes de verificaCercas.
+ *
+ * @param cercas        ponteiro para o conjunto de cercas
+ * @param vertices      vértices de todas as cercas (devem permanecer válidos enquanto as cercas forem usadas)
+ * @param poligonos     cercas (devem permanecer válidas enquanto as cercas forem usadas)
+ * @param quantidade    quantidade de cercas (até CERCA_MAX_POLIGONOS)
+ * @param grade         grade montada para esses vértices e cercas
+ *
+ * @return                      1 se as cercas foram iniciadas; 0 se não há cercas ou são mais de CERCA_MAX_POLIGONOS.
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+int iniciaCercas (cercasCarro *cercas, const verticeCerca *vertices, const poligonoCerca *poligonos, uint16_t quantidade,
+                  const gradeCerca *grade);
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * @brief Verifica um fix contra todas as cercas e gera um evento para cada entrada ou saída confirmada.
+ *        Fixes inválidos são ignorados. O primeiro fix apenas define o estado inicial (sem eventos).
+ *
+ * @param cercas        ponteiro para o conjunto de cercas
+ * @param fix           fix recebido do GPS
+ * @param eventos       vetor que recebe os eventos
+ * @param maximo        tamanho do vetor de eventos
+ *
+ * @return                      quantidade de eventos gerados.
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+int verificaCercas (cercasCarro *cercas, const dataGPS *fix, eventoCerca *eventos, int maximo);
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * @brief Indica em quais cercas um ponto está, consultando apenas as arestas da sua célula
+ *
+ * @param cercas        ponteiro para o conjunto de cercas
+ * @param latitude      graus * 10^7
+ * @param longitude     graus * 10^7
+ * @param dentro        CERCA_PALAVRAS palavras que recebem um bit por cerca: 1 se o ponto está dentro
+ *
+ * @return                      Não retorna nada.
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+void localizaNasCercas (const cercasCarro *cercas, int32_t latitude, int32_t longitude, uint32_t *dentro);
+
+#endif /*_CERCA_CARRO_H_*/
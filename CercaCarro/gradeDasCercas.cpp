@@ -0,0 +1,50 @@
+/**
+ * gradeDasCercas.cpp       v0.0        17-10-2026
+ *
+ * Orientador: Elias Teodoro da Silva Junior
+ * Autores: Felipe Moura de Castro e Joao Bruno Costa Cruz,
+ * Instituto Federal de Educação, Ciência e Tecnologia do Ceará (IFCE) - Campus Fortaleza
+ *
+ * @Opensource
+ * Este código-fonte pode ser utilizado, copiado, estudado, modificado e redistribuído sem restrições.
+ *
+ * Copyright (c) 2019, Felipe Moura de Castro e Joao Bruno Costa Cruz.
+ *
+ */
+
+/**
+ * Gerado por testes/geraGradeCercas a partir de CercaCarro/cercas.txt (não edite: altere as cercas e gere
+ * de novo). Grade de 2 x 2 células, 4 registros e 8 arestas.
+ */
+
+#include "gradeDasCercas.h"
+
+const verticeCerca verticesDasCercas[4] = {
+    { -37435000, -385369000 },
+    { -37435000, -385353000 },
+    { -37451000, -385353000 },
+    { -37451000, -385369000 },
+};
+
+const poligonoCerca poligonosDasCercas[1] = {
+    { "IFCE Fortaleza", 'G', 0, 4 },
+};
+
+const uint16_t quantidadeDeCercas = 1;
+
+static const uint16_t inicioDaCelula[5] = {
+    0, 1, 2, 3, 4,
+};
+
+static const registroCerca registros[5] = {
+    { 0, 1, 0 }, { 0, 1, 2 }, { 0, 1, 4 }, { 0, 1, 6 },
+    { 0, 0, 8 },
+};
+
+static const uint16_t arestas[8] = {
+    2, 3, 1, 2, 0, 3, 0, 1,
+};
+
+const gradeCerca gradeDasCercas = {
+    -37451000, -385369000, 8001, 8001, 2, 2, inicioDaCelula, registros, arestas
+};
@@ -0,0 +1,37 @@
+/**
+ * gradeDasCercas.h       v0.0        17-10-2026
+ *
+ * Orientador: Elias Teodoro da Silva Junior
+ * Autores: Felipe Moura de Castro e Joao Bruno Costa Cruz,
+ * Instituto Federal de Educação, Ciência e Tecnologia do Ceará (IFCE) - Campus Fortaleza
+ *
+ * @Opensource
+ * Este código-fonte pode ser utilizado, copiado, estudado, modificado e redistribuído sem restrições.
+ *
+ * Copyright (c) 2019, Felipe Moura de Castro e Joao Bruno Costa Cruz.
+ *
+ */
+
+#ifndef _GRADE_DAS_CERCAS_H_
+#define _GRADE_DAS_CERCAS_H_
+
+#include "cercaCarro.h"
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * Cercas do carro e o seu índice em grade, definidos em gradeDasCercas.cpp
+ *
+ * gradeDasCercas.cpp é gerado no computador a partir de cercas.txt:
+ *
+ *      geraGradeCercas CercaCarro/cercas.txt CercaCarro/gradeDasCercas.cpp
+ *
+ * (a ferramenta é compilada junto com os testes, em testes/). O teste geraGradeCercas do ctest falha se o arquivo
+ * gerado não corresponder a cercas.txt.
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+extern const verticeCerca verticesDasCercas[];
+extern const poligonoCerca poligonosDasCercas[];
+extern const uint16_t quantidadeDeCercas;
+extern const gradeCerca gradeDasCercas;
+
+#endif /*_GRADE_DAS_CERCAS_H_*/
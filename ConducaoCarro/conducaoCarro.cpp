@@ -0,0 +1,124 @@
+/**
+ * conducaoCarro.cpp       v0.0        17-10-2026
+ *
+ * Orientador: Elias Teodoro da Silva Junior
+ * Autores: Felipe Moura de Castro e Joao Bruno Costa Cruz,
+ * Instituto Federal de Educação, Ciência e Tecnologia do Ceará (IFCE) - Campus Fortaleza
+ *
+ * @Opensource
+ * Este código-fonte pode ser utilizado, copiado, estudado, modificado e redistribuído sem restrições.
+ *
+ * Copyright (c) 2019, Felipe Moura de Castro e Joao Bruno Costa Cruz.
+ *
+ */
+
+#include "conducaoCarro.h"
+#include <math.h>
+
+void iniciaConducao (conducaoCarro *conducao, uint32_t taxaHz) {
+    memset (conducao, 0, sizeof (conducaoCarro));
+    conducao->taxaHz = taxaHz;
+    conducao->alfa = 1.0f / (1.0f + CONDUCAO_CONSTANTE_S * taxaHz);
+    conducao->detectores[CONDUCAO_FRENAGEM].limiar = CONDUCAO_LIMIAR_FRENAGEM;
+    conducao->detectores[CONDUCAO_ACELERACAO].limiar = CONDUCAO_LIMIAR_ACELERACAO;
+    conducao->detectores[CONDUCAO_CURVA].limiar = CONDUCAO_LIMIAR_CURVA;
+}
+
+/**
+ * Atualiza um detector com o valor filtrado. Se outro detector já entregou um evento nesta amostra (podeEncerrar
+ * falso), o fim fica para a amostra seguinte.
+ */
+static int atualizaDetector (conducaoCarro *conducao, uint8_t tipo, float valor, const dataGPS *posicao,
+                             uint64_t instante, bool podeEncerrar, eventoConducao *evento) {
+    detectorConducao *detector = &conducao->detectores[tipo];
+    bool movimento = posicao->valid == 'A' && posicao->speed >= CONDUCAO_VELOCIDADE_MINIMA;
+    uint32_t duracao;
+    bool severo;
+
+    if (!detector->ativo) {
+        if (valor < detector->limiar || !movimento) {
+            return 0;
+        }
+        detector->ativo = true;
+        detector->amostras = 0;
+        detector->abaixo = 0;
+        detector->pico = valor;
+        detector->evento.tipo = tipo;
+        detector->evento.latitude = posicao->latitude;
+        detector->evento.longitude = posicao->longitude;
+        detector->evento.velocidade = posicao->speed;
+        detector->evento.instante = instante;
+    }
+
+    detector->amostras++;
+    if (valor > detector->pico) {
+        detector->pico = valor;
+    }
+    if (valor >= detector->limiar * CONDUCAO_HISTERESE) {
+        detector->abaixo = 0;
+        return 0;
+    }
+    if (++detector->abaixo < conducao->taxaHz * CONDUCAO_FIM_MS / 1000 || !podeEncerrar) {
+        return 0;
+    }
+
+    // Fim: o tempo de confirmação não entra na duração
+    detector->ativo = false;
+    duracao = (detector->amostras - detector->abaixo) * 1000 / conducao->taxaHz;
+    if (duracao < CONDUCAO_DURACAO_MINIMA_MS) {
+        return 0;
+    }
+    severo = detector->pico >= detector->limiar * CONDUCAO_FATOR_SEVERO;
+    conducao->contagens[tipo][severo ? 1 : 0]++;
+    conducao->eventos++;
+
+    memcpy (evento, &detector->evento, sizeof (eventoConducao));
+    evento->numero = conducao->eventos;
+    evento->severo = severo;
+    evento->pico = (uint16_t)(detector->pico * 1000.0f > 65535.0f ? 65535 : detector->pico * 1000.0f + 0.5f);
+    evento->duracaoMs = (uint16_t)(duracao > 65535 ? 65535 : duracao);
+    return 1;
+}
+
+int classificaConducao (conducaoCarro *conducao, const float *linear, const dataGPS *posicao, uint64_t instante,
+                        bool alinhado, eventoConducao *evento) {
+    int entregue, tipo;
+
+    conducao->longitudinal += conducao->alfa * (linear[0] - conducao->longitudinal);
+    conducao->lateral += conducao->alfa * (linear[1] - conducao->lateral);
+
+    // Sem a guinada da montagem, o eixo X não é a frente do carro: frenagem e curva se misturam e nada é contado.
+    // Um evento em andamento é descartado (a calibração pode ter mudado no meio dele).
+    if (!alinhado) {
+        for (tipo = 0; tipo < CONDUCAO_TIPOS; tipo++) {
+            conducao->detectores[tipo].ativo = false;
+        }
+        conducao->amostrasSemGuinada++;
+        return 0;
+    }
+
+    entregue = atualizaDetector (conducao, CONDUCAO_FRENAGEM, -conducao->longitudinal, posicao, instante,
+                                 true, evento);
+    entregue |= atualizaDetector (conducao, CONDUCAO_ACELERACAO, conducao->longitudinal, posicao, instante,
+                                  !entregue, evento);
+    entregue |= atualizaDetector (conducao, CONDUCAO_CURVA, fabsf (conducao->lateral), posicao, instante,
+                                  !entregue, evento);
+    return entregue;
+}
+
+void codificaConducao (const conducaoCarro *conducao, uint32_t enviados[CONDUCAO_TIPOS][2], uint8_t *bytes) {
+    uint32_t novos[2];
+    int tipo, severidade;
+
+    for (tipo = 0; tipo < CONDUCAO_TIPOS; tipo++) {
+        for (severidade = 0; severidade < 2; severidade++) {
+            novos[severidade] = conducao->contagens[tipo][severidade] - enviados[tipo][severidade];
+            if (novos[severidade] > 15) {
+                novos[severidade] = 15;
+            }
+            enviados[tipo][severidade] += novos[severidade];
+        }
+        bytes[tipo] = (uint8_t)((novos[0] << 4) | novos[1]);
+    }
+}
+
@@ -0,0 +1,203 @@
+/**
+ * conducaoCarro.h       v0.0        17-10-2026
+ *
+ * Orientador: Elias Teodoro da Silva Junior
+ * Autores: Felipe Moura de Castro e Joao Bruno Costa Cruz,
+ * Instituto Federal de Educação, Ciência e Tecnologia do Ceará (IFCE) - Campus Fortaleza
+ *
+ * @Opensource
+ * Este código-fonte pode ser utilizado, copiado, estudado, modificado e redistribuído sem restrições.
+ *
+ * Copyright (c) 2019, Felipe Moura de Castro e Joao Bruno Costa Cruz.
+ *
+ */
+
+#ifndef _CONDUCAO_CARRO_H_
+#define _CONDUCAO_CARRO_H_
+
+#include "mbed.h"
+#include "FilaCarro/filaCarro.h"
+#include "GPS_Carro/GPS_Carro.h"
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * Eventos de condução brusca
+ *
+ * A cada amostra da MPU6050, a aceleração longitudinal e a lateral (sem a gravidade, no referencial do carro dado pelo
+ * estimador de atitude) passam por um passa-baixas de 1ª ordem com constante de tempo CONDUCAO_CONSTANTE_S, que
+ * remove a vibração e os buracos e mantém as manobras. Três detectores iguais acompanham a frenagem (longitudinal
+ * negativa), a aceleração (longitudinal positiva) e a curva (módulo da lateral):
+ *
+ * - um evento começa quando o valor filtrado passa do limiar do tipo, com a velocidade estimada acima de
+ *   CONDUCAO_VELOCIDADE_MINIMA (o carro parado não gera eventos);
+ * - termina quando o valor fica abaixo de CONDUCAO_HISTERESE do limiar por CONDUCAO_FIM_MS seguidos (uma
+ *   oscilação no meio da manobra não divide o evento em dois);
+ * - só é contado se durou CONDUCAO_DURACAO_MINIMA_MS (descarta picos curtos que passaram pelo filtro).
+ *
+ * Cada evento tem o pico, a duração e a posição e a velocidade do início. É severo se o pico chegou a
+ * CONDUCAO_FATOR_SEVERO vezes o limiar. Os contadores por tipo e severidade só crescem; o envio pela rede LoRa manda a
+ * diferença desde o envio anterior em 3 bytes (codificaConducao). Memória e custo por amostra são constantes.
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+#define CONDUCAO_LIMIAR_FRENAGEM        3.4f        // m/s² (0,35 g)
+#define CONDUCAO_LIMIAR_ACELERACAO      2.9f        // m/s² (0,30 g)
+#define CONDUCAO_LIMIAR_CURVA           3.9f        // m/s² (0,40 g)
+#define CONDUCAO_HISTERESE              0.7f        // fração do limiar abaixo da qual o evento termina
+#define CONDUCAO_FATOR_SEVERO           1.5f        // fração do limiar a partir da qual o evento é severo
+#define CONDUCAO_CONSTANTE_S            0.15f       // constante de tempo do passa-baixas (s)
+#define CONDUCAO_DURACAO_MINIMA_MS      300
+#define CONDUCAO_FIM_MS                 200
+#define CONDUCAO_VELOCIDADE_MINIMA      2778        // mm/s (10 km/h)
+
+/**
+ * Tipos de evento (índices dos detectores e dos contadores)
+ */
+#define CONDUCAO_FRENAGEM               0
+#define CONDUCAO_ACELERACAO             1
+#define CONDUCAO_CURVA                  2
+#define CONDUCAO_TIPOS                  3
+
+/**
+ * Código de cada tipo nos arquivos
+ */
+#define CONDUCAO_CODIGOS                "FAC"
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * @brief   Evento de condução brusca
+ *
+ * @var numero                        número do evento desde a inicialização
+ * @var tipo                          CONDUCAO_FRENAGEM, CONDUCAO_ACELERACAO ou CONDUCAO_CURVA
+ * @var severo                        indica se o pico chegou a CONDUCAO_FATOR_SEVERO vezes o limiar
+ * @var latitude                      posição no início do evento (graus * 10^7)
+ * @var longitude                     posição no início do evento (graus * 10^7)
+ * @var instante                      tempo Unix do início em milissegundos (0 se o relógio não estava sincronizado)
+ * @var velocidade                    velocidade estimada no início (mm/s)
+ * @var pico                          maior aceleração filtrada no evento (mm/s²)
+ * @var duracaoMs                     duração do evento (sem o tempo de confirmação do fim)
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+typedef struct {
+    uint32_t numero;
+    uint8_t tipo;
+    bool severo;
+    int32_t latitude;
+    int32_t longitude;
+    uint64_t instante;
+    uint32_t velocidade;
+    uint16_t pico;
+    uint16_t duracaoMs;
+} eventoConducao;
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * @brief   Detector de um tipo de evento
+ *
+ * @var limiar                        aceleração de início do evento (m/s²)
+ * @var ativo                         indica se há um evento em andamento
+ * @var amostras                      amostras desde o início do evento
+ * @var abaixo                        amostras seguidas abaixo do limiar de fim
+ * @var pico                          maior valor no evento (m/s²)
+ * @var evento                        evento em andamento (posição, instante e velocidade do início)
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+typedef struct {
+    float limiar;
+    bool ativo;
+    uint32_t amostras;
+    uint32_t abaixo;
+    float pico;
+    eventoConducao evento;
+} detectorConducao;
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * @brief   Classificador de condução. Escrito apenas pela Thread da navegação; os contadores podem ser lidos por
+ *          qualquer Thread (cada um é uma palavra de 32 bits).
+ *
+ * @var taxaHz                        taxa de amostragem (Hz)
+ * @var alfa                          coeficiente do passa-baixas
+ * @var longitudinal                  aceleração longitudinal filtrada (m/s², positiva para a frente)
+ * @var lateral                       aceleração lateral filtrada (m/s²)
+ * @var detectores                    um detector por tipo
+ * @var eventos                       eventos contados desde a inicialização
+ * @var contagens                     eventos por tipo: normais (índice 0) e severos (índice 1)
+ * @var amostrasSemGuinada            amostras não classificadas por falta da guinada da montagem
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+typedef struct {
+    uint32_t taxaHz;
+    float alfa;
+    float longitudinal;
+    float lateral;
+    detectorConducao detectores[CONDUCAO_TIPOS];
+    uint32_t eventos;
+    volatile uint32_t contagens[CONDUCAO_TIPOS][2];
+    volatile uint32_t amostrasSemGuinada;
+} conducaoCarro;
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * Tamanho da fila de eventos (deve ser potência de 2)
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+#define TAMANHO_FILA_CONDUCAO 8
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * @brief   Fila de eventos (filaCarro) com um único produtor e um único consumidor
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+typedef filaCarro<eventoConducao, TAMANHO_FILA_CONDUCAO> filaConducao;
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * Protótipo das funções
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * @brief Inicializa o classificador (sem eventos)
+ *
+ * @param conducao      ponteiro para o classificador
+ * @param taxaHz        taxa de amostragem da MPU6050 (Hz)
+ *
+ * @return                      Não retorna nada.
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+void iniciaConducao (conducaoCarro *conducao, uint32_t taxaHz);
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * @brief Processa uma amostra. Deve ser chamada a cada amostra, na taxa informada em iniciaConducao. Enquanto a
+ *        guinada da montagem não é conhecida (alinhado falso), o passa-baixas continua, mas nenhum evento é contado.
+ *
+ * @param conducao      ponteiro para o classificador
+ * @param linear        aceleração sem a gravidade no referencial do carro (m/s²), como em atitudeCarro::linear
+ * @param posicao       última posição estimada (a velocidade só é usada se o fix for válido)
+ * @param instante      tempo Unix atual em milissegundos (0 se o relógio não está sincronizado)
+ * @param alinhado      indica se o eixo X de linear é a frente do carro (CALIBRACAO_GUINADA válida)
+ * @param evento        ponteiro para a struct que recebe o evento concluído
+ *
+ * @return                      1 se um evento terminou (evento preenchido); 0 caso contrário.
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+int classificaConducao (conducaoCarro *conducao, const float *linear, const dataGPS *posicao, uint64_t instante,
+                        bool alinhado, eventoConducao *evento);
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * @brief Codifica os eventos desde o envio anterior em 3 bytes, um por tipo: normais no nibble alto e severos no
+ *        nibble baixo (até 15 de cada; o que passar fica para o envio seguinte)
+ *
+ * @param conducao      ponteiro para o classificador
+ * @param enviados      contagens já enviadas (CONDUCAO_TIPOS x 2, atualizadas com o que foi codificado)
+ * @param bytes         vetor de CONDUCAO_TIPOS bytes que recebe o resumo
+ *
+ * @return                      Não retorna nada.
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+void codificaConducao (const conducaoCarro *conducao, uint32_t enviados[CONDUCAO_TIPOS][2], uint8_t *bytes);
+
+#endif /*_CONDUCAO_CARRO_H_*/
@@ -0,0 +1,197 @@
+/**
+ * espectroCarro.cpp       v0.0        17-10-2026
+ *
+ * Orientador: Elias Teodoro da Silva Junior
+ * Autores: Felipe Moura de Castro e Joao Bruno Costa Cruz,
+ * Instituto Federal de Educação, Ciência e Tecnologia do Ceará (IFCE) - Campus Fortaleza
+ *
+ * @Opensource
+ * Este código-fonte pode ser utilizado, copiado, estudado, modificado e redistribuído sem restrições.
+ *
+ * Copyright (c) 2019, Felipe Moura de Castro e Joao Bruno Costa Cruz.
+ *
+ */
+
+#include "espectroCarro.h"
+#include <math.h>
+
+#define ESPECTRO_PI             3.14159265358979f
+#define ESPECTRO_METADE         (ESPECTRO_N / 2)
+
+void iniciaEspectro (espectroCarro *espectro, float taxaHz) {
+    static const float limites[ESPECTRO_BANDAS + 1] = ESPECTRO_LIMITES_HZ;
+    float somaDosQuadrados = 0.0f;
+    int k, indice;
+
+    memset (espectro, 0, sizeof (espectroCarro));
+#if ESPECTRO_CMSIS_DSP
+    arm_rfft_fast_init_f32 (&espectro->rfft, ESPECTRO_N);
+#endif
+    for (k = 0; k < ESPECTRO_METADE; k++) {
+        espectro->cosseno[k] = cosf (2.0f * ESPECTRO_PI * k / ESPECTRO_N);
+        espectro->seno[k] = sinf (2.0f * ESPECTRO_PI * k / ESPECTRO_N);
+    }
+    for (k = 0; k < ESPECTRO_N; k++) {
+        espectro->hann[k] = 0.5f - 0.5f * cosf (2.0f * ESPECTRO_PI * k / ESPECTRO_N);
+        somaDosQuadrados += espectro->hann[k] * espectro->hann[k];
+    }
+
+    // Parseval com a janela: média quadrática = 2 * soma |X[k]|² / (N * soma w²), contando só 0 < k < N/2
+    espectro->escala = 2.0f / (ESPECTRO_N * somaDosQuadrados);
+
+    // Limites das bandas em índices do espectro (resolução de taxaHz / N), sem o nível DC nem o de Nyquist
+    for (k = 0; k <= ESPECTRO_BANDAS; k++) {
+        indice = (int)ceilf (limites[k] * ESPECTRO_N / taxaHz);
+        if (indice < 1) {
+            indice = 1;
+        }
+        if (indice > ESPECTRO_METADE) {
+            indice = ESPECTRO_METADE;
+        }
+        espectro->inicioDaBanda[k] = indice;
+    }
+}
+
+#if !ESPECTRO_CMSIS_DSP
+/**
+ * FFT complexa de ESPECTRO_METADE pontos, no lugar (pares real, imaginário), radix-2 com decimação no tempo
+ */
+static void fftComplexa (const espectroCarro *espectro, float *dados) {
+    int i, j, k, bit, tamanho, metade, passo;
+    float wr, wi, tr, ti, t;
+
+    // Permutação por inversão de bits
+    for (i = 1, j = 0; i < ESPECTRO_METADE; i++) {
+        for (bit = ESPECTRO_METADE >> 1; j & bit; bit >>= 1) {
+            j ^= bit;
+        }
+        j |= bit;
+        if (i < j) {
+            t = dados[2 * i]; dados[2 * i] = dados[2 * j]; dados[2 * j] = t;
+            t = dados[2 * i + 1]; dados[2 * i + 1] = dados[2 * j + 1]; dados[2 * j + 1] = t;
+        }
+    }
+
+    // Borboletas: W = exp (-i 2 pi k / tamanho) = cosseno[k * passo] - i seno[k * passo]
+    for (tamanho = 2; tamanho <= ESPECTRO_METADE; tamanho <<= 1) {
+        metade = tamanho >> 1;
+        passo = ESPECTRO_N / tamanho;
+        for (i = 0; i < ESPECTRO_METADE; i += tamanho) {
+            for (k = 0; k < metade; k++) {
+                wr = espectro->cosseno[k * passo];
+                wi = -espectro->seno[k * passo];
+                j = i + k + metade;
+                tr = wr * dados[2 * j] - wi * dados[2 * j + 1];
+                ti = wr * dados[2 * j + 1] + wi * dados[2 * j];
+                dados[2 * j] = dados[2 * (i + k)] - tr;
+                dados[2 * j + 1] = dados[2 * (i + k) + 1] - ti;
+                dados[2 * (i + k)] += tr;
+                dados[2 * (i + k) + 1] += ti;
+            }
+        }
+    }
+}
+#endif
+
+void fftReal (espectroCarro *espectro, float *entrada, float *saida) {
+#if ESPECTRO_CMSIS_DSP
+    arm_rfft_fast_f32 (&espectro->rfft, entrada, saida, 0);
+#else
+    float zr, zi, cr, ci, er, ei, or_, oi, wr, wi;
+    int k;
+
+    // As amostras pares e ímpares formam um sinal complexo de N/2 pontos: z[n] = x[2n] + i x[2n+1]
+    fftComplexa (espectro, entrada);
+
+    // Separação: X[k] = (Z[k] + conj Z[N/2-k]) / 2 + W^k (Z[k] - conj Z[N/2-k]) / 2i
+    saida[0] = entrada[0] + entrada[1];
+    saida[1] = entrada[0] - entrada[1];
+    for (k = 1; k < ESPECTRO_METADE; k++) {
+        zr = entrada[2 * k];
+        zi = entrada[2 * k + 1];
+        cr = entrada[2 * (ESPECTRO_METADE - k)];
+        ci = -entrada[2 * (ESPECTRO_METADE - k) + 1];
+        er = 0.5f * (zr + cr);
+        ei = 0.5f * (zi + ci);
+        or_ = 0.5f * (zi - ci);
+        oi = -0.5f * (zr - cr);
+        wr = espectro->cosseno[k];
+        wi = -espectro->seno[k];
+        saida[2 * k] = er + wr * or_ - wi * oi;
+        saida[2 * k + 1] = ei + wr * oi + wi * or_;
+    }
+#endif
+}
+
+int acrescentaEspectro (espectroCarro *espectro, const float *amostras, int n, const dataGPS *posicao,
+                        uint64_t instante, janelaEspectro *janela) {
+    float *x = espectro->amostras;
+    float media = 0.0f, energia, re, im;
+    uint32_t inicio;
+    int k, b;
+
+    if (n > ESPECTRO_N - espectro->preenchidas) {
+        n = ESPECTRO_N - espectro->preenchidas;
+    }
+    memcpy (&x[espectro->preenchidas], amostras, n * sizeof (float));
+    espectro->preenchidas += n;
+    if (espectro->preenchidas < ESPECTRO_N) {
+        return 0;
+    }
+    espectro->preenchidas = 0;
+
+    // Sem a média (gravidade), a janela de Hann não espalha o nível DC pelas primeiras bandas
+    for (k = 0; k < ESPECTRO_N; k++) {
+        media += x[k];
+    }
+    media /= ESPECTRO_N;
+    for (k = 0; k < ESPECTRO_N; k++) {
+        x[k] = (x[k] - media) * espectro->hann[k];
+    }
+
+    inicio = us_ticker_read ();
+    fftReal (espectro, x, espectro->saida);
+    espectro->tempoDeFFTUs += us_ticker_read () - inicio;
+    espectro->transformadas++;
+
+    for (b = 0; b < ESPECTRO_BANDAS; b++) {
+        energia = 0.0f;
+        for (k = espectro->inicioDaBanda[b]; k < espectro->inicioDaBanda[b + 1]; k++) {
+            re = espectro->saida[2 * k];
+            im = espectro->saida[2 * k + 1];
+            energia += re * re + im * im;
+        }
+        energia = sqrtf (energia * espectro->escala) * 1000.0f;
+        janela->bandas[b] = energia >= 65535.0f ? 65535 : (uint16_t)(energia + 0.5f);
+    }
+    janela->latitude = posicao->latitude;
+    janela->longitude = posicao->longitude;
+    janela->instante = instante;
+    janela->velocidade = posicao->speed;
+    return 1;
+}
+
+void acumulaEspectro (acumuladorEspectro *acumulador, const janelaEspectro *janela) {
+    float rms;
+    int b;
+
+    for (b = 0; b < ESPECTRO_BANDAS; b++) {
+        rms = janela->bandas[b] * 0.001f;
+        acumulador->energia[b] += rms * rms;
+    }
+    acumulador->janelas++;
+}
+
+uint32_t mediaEspectro (acumuladorEspectro *acumulador, uint16_t *bandas) {
+    uint32_t janelas = acumulador->janelas;
+    float rms;
+    int b;
+
+    for (b = 0; b < ESPECTRO_BANDAS; b++) {
+        rms = janelas ? sqrtf (acumulador->energia[b] / janelas) * 1000.0f : 0.0f;
+        bandas[b] = rms >= 65535.0f ? 65535 : (uint16_t)(rms + 0.5f);
+    }
+    memset (acumulador, 0, sizeof (acumuladorEspectro));
+    return janelas;
+}
+
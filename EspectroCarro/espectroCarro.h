@@ -0,0 +1,199 @@
+/**
+ * espectroCarro.h       v0.0        17-10-2026
+ *
+ * Orientador: Elias Teodoro da Silva Junior
+ * Autores: Felipe Moura de Castro e Joao Bruno Costa Cruz,
+ * Instituto Federal de Educação, Ciência e Tecnologia do Ceará (IFCE) - Campus Fortaleza
+ *
+ * @Opensource
+ * Este código-fonte pode ser utilizado, copiado, estudado, modificado e redistribuído sem restrições.
+ *
+ * Copyright (c) 2019, Felipe Moura de Castro e Joao Bruno Costa Cruz.
+ *
+ */
+
+#ifndef _ESPECTRO_CARRO_H_
+#define _ESPECTRO_CARRO_H_
+
+#include "mbed.h"
+#include "FilaCarro/filaCarro.h"
+#include "GPS_Carro/GPS_Carro.h"
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * Espectro da vibração
+ *
+ * A aceleração vertical é dividida em janelas de ESPECTRO_N amostras (sem sobreposição). Cada janela tem a
+ * média removida, é multiplicada pela janela de Hann e passa por uma FFT real em float32. O espectro é reduzido
+ * à aceleração RMS em ESPECTRO_BANDAS bandas de frequência (limites em ESPECTRO_LIMITES_HZ), suficiente para
+ * distinguir os tipos de pavimento sem guardar o espectro inteiro.
+ *
+ * Com ESPECTRO_CMSIS_DSP = 1 a FFT é a arm_rfft_fast_f32 do CMSIS-DSP (a biblioteca deve ser acrescentada ao
+ * projeto); caso contrário é usada a implementação portátil deste módulo (FFT complexa de ESPECTRO_N / 2 pontos
+ * e separação do espectro real), que produz a saída no mesmo formato: saida[0] = X[0], saida[1] = X[N/2] e,
+ * para 0 < k < N/2, saida[2k] e saida[2k+1] = parte real e imaginária de X[k].
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+#ifndef ESPECTRO_CMSIS_DSP
+#define ESPECTRO_CMSIS_DSP      0
+#endif
+
+#if ESPECTRO_CMSIS_DSP
+#include "arm_math.h"
+#endif
+
+#define ESPECTRO_N              256         // potência de 2
+#define ESPECTRO_BANDAS         6
+#define ESPECTRO_LIMITES_HZ     { 1.0f, 8.0f, 16.0f, 32.0f, 64.0f, 128.0f, 500.0f }
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * @brief   Bandas de uma janela
+ *
+ * @var latitude                      posição no fim da janela (graus * 10^7)
+ * @var longitude                     posição no fim da janela (graus * 10^7)
+ * @var instante                      tempo Unix do fim da janela em milissegundos (0 se sem relógio)
+ * @var velocidade                    velocidade no fim da janela (mm/s)
+ * @var bandas                        aceleração RMS em cada banda (mm/s²)
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+typedef struct {
+    int32_t latitude;
+    int32_t longitude;
+    uint64_t instante;
+    uint32_t velocidade;
+    uint16_t bandas[ESPECTRO_BANDAS];
+} janelaEspectro;
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * @brief   Analisador de espectro
+ *
+ * @var cosseno                       cos (2 pi k / N), 0 <= k < N / 2
+ * @var seno                          sen (2 pi k / N), 0 <= k < N / 2
+ * @var hann                          janela de Hann
+ * @var inicioDaBanda                 primeiro índice do espectro de cada banda (mais um para o fim da última)
+ * @var escala                        converte a soma de |X[k]|² em média quadrática ((m/s²)²)
+ * @var amostras                      janela em preenchimento
+ * @var preenchidas                   amostras já na janela
+ * @var saida                         espectro da última janela (formato descrito acima)
+ * @var transformadas                 FFTs calculadas
+ * @var tempoDeFFTUs                  tempo total gasto nas FFTs (us)
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+typedef struct {
+#if ESPECTRO_CMSIS_DSP
+    arm_rfft_fast_instance_f32 rfft;
+#endif
+    float cosseno[ESPECTRO_N / 2];
+    float seno[ESPECTRO_N / 2];
+    float hann[ESPECTRO_N];
+    uint16_t inicioDaBanda[ESPECTRO_BANDAS + 1];
+    float escala;
+    float amostras[ESPECTRO_N];
+    uint16_t preenchidas;
+    float saida[ESPECTRO_N];
+    uint32_t transformadas;
+    uint32_t tempoDeFFTUs;
+} espectroCarro;
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * @brief   Média das bandas desde a última consulta (para o envio pela rede LoRa)
+ *
+ * @var energia                       soma das médias quadráticas de cada banda ((m/s²)²)
+ * @var janelas                       janelas somadas
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+typedef struct {
+    float energia[ESPECTRO_BANDAS];
+    uint32_t janelas;
+} acumuladorEspectro;
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * Tamanho da fila de janelas (deve ser potência de 2)
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+#define TAMANHO_FILA_ESPECTRO 8
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * @brief   Fila de janelas (filaCarro) com um único produtor e um único consumidor
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+typedef filaCarro<janelaEspectro, TAMANHO_FILA_ESPECTRO> filaEspectro;
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * Protótipo das funções
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * @brief Inicializa o analisador (tabelas de senos, janela de Hann e limites das bandas)
+ *
+ * @param espectro      ponteiro para o analisador
+ * @param taxaHz        taxa de amostragem (Hz)
+ *
+ * @return                      Não retorna nada.
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+void iniciaEspectro (espectroCarro *espectro, float taxaHz);
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * @brief FFT real de ESPECTRO_N pontos
+ *
+ * @param espectro      ponteiro para o analisador (tabelas)
+ * @param entrada       ESPECTRO_N amostras (o vetor é usado como área de trabalho e perde o conteúdo)
+ * @param saida         ESPECTRO_N valores no formato do arm_rfft_fast_f32
+ *
+ * @return                      Não retorna nada.
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+void fftReal (espectroCarro *espectro, float *entrada, float *saida);
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * @brief Acrescenta amostras à janela; quando ela completa, calcula o espectro e as bandas
+ *
+ * @param espectro      ponteiro para o analisador
+ * @param amostras      aceleração vertical (m/s²)
+ * @param n             quantidade de amostras (no máximo ESPECTRO_N)
+ * @param posicao       posição e velocidade atuais (fix ou estimativa da navegação)
+ * @param instante      tempo Unix atual em milissegundos (0 se sem relógio)
+ * @param janela        ponteiro para a struct que recebe as bandas
+ *
+ * @return                      1 se uma janela foi completada (janela preenchida); 0 caso contrário.
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+int acrescentaEspectro (espectroCarro *espectro, const float *amostras, int n, const dataGPS *posicao,
+                        uint64_t instante, janelaEspectro *janela);
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * @brief Soma as bandas de uma janela ao acumulador
+ *
+ * @param acumulador    ponteiro para o acumulador
+ * @param janela        bandas da janela
+ *
+ * @return                      Não retorna nada.
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+void acumulaEspectro (acumuladorEspectro *acumulador, const janelaEspectro *janela);
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * @brief Calcula a aceleração RMS média de cada banda desde a última chamada e zera o acumulador
+ *
+ * @param acumulador    ponteiro para o acumulador
+ * @param bandas        vetor de ESPECTRO_BANDAS valores que recebe as médias (mm/s²)
+ *
+ * @return                      quantidade de janelas da média (0 se não houve janelas; bandas zeradas).
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+uint32_t mediaEspectro (acumuladorEspectro *acumulador, uint16_t *bandas);
+
+#endif /*_ESPECTRO_CARRO_H_*/
@@ -0,0 +1,189 @@
+/**
+ * filaCarro.h       v0.0        17-10-2026
+ *
+ * Orientador: Elias Teodoro da Silva Junior
+ * Autores: Felipe Moura de Castro e Joao Bruno Costa Cruz,
+ * Instituto Federal de Educação, Ciência e Tecnologia do Ceará (IFCE) - Campus Fortaleza
+ *
+ * @Opensource
+ * Este código-fonte pode ser utilizado, copiado, estudado, modificado e redistribuído sem restrições.
+ *
+ * Copyright (c) 2019, Felipe Moura de Castro e Joao Bruno Costa Cruz.
+ *
+ */
+
+#ifndef _FILA_CARRO_H_
+#define _FILA_CARRO_H_
+
+#include "mbed.h"
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * Fila circular sem trava (lock-free) com um único produtor e um único consumidor
+ *
+ * É a mesma fila para todos os módulos (bytes do GPS, fixes, amostras da IMU, eventos...): cada módulo apenas
+ * declara o seu tipo com typedef filaCarro<elemento, tamanho>. O produtor só escreve em 'fim' e o consumidor só
+ * escreve em 'inicio'; os índices crescem livremente e são mascarados pelo tamanho, que deve ser potência de 2.
+ * A barreira __DMB garante que o elemento esteja completo antes de o índice ser publicado e que o espaço só seja
+ * liberado depois de lido, também quando o produtor é uma interrupção.
+ *
+ * As funções são templates definidos neste arquivo (inline): para cada tipo de fila o compilador gera o mesmo código
+ * que a versão escrita à mão, com o tamanho e o elemento constantes.
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * @brief   Fila de 'tamanho' elementos do tipo 'elemento'
+ *
+ * @var itens                         elementos armazenados
+ * @var inicio                        total de elementos já retirados (escrito apenas pelo consumidor)
+ * @var fim                           total de elementos já inseridos (escrito apenas pelo produtor)
+ * @var perdidos                      elementos descartados por falta de espaço na fila
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+template <typename elemento, uint32_t tamanho>
+struct filaCarro {
+    static_assert (tamanho > 0 && (tamanho & (tamanho - 1)) == 0, "o tamanho da fila deve ser potencia de 2");
+
+    elemento itens[tamanho];
+    volatile uint32_t inicio;
+    volatile uint32_t fim;
+    volatile uint32_t perdidos;
+};
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * @brief Inicializa a fila (vazia)
+ *
+ * @param fila          ponteiro para a fila
+ *
+ * @return                      Não retorna nada.
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+template <typename elemento, uint32_t tamanho>
+inline void iniciaFila (filaCarro<elemento, tamanho> *fila) {
+    fila->inicio = 0;
+    fila->fim = 0;
+    fila->perdidos = 0;
+}
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * @brief Reserva o próximo elemento livre para ser preenchido no lugar, sem cópia. Deve ser chamada apenas pelo
+ *        produtor; o elemento só é entregue ao consumidor por publicaNaFila. Não conta perdidos.
+ *
+ * @param fila          ponteiro para a fila
+ *
+ * @return                      ponteiro para o elemento; NULL se a fila está cheia.
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+template <typename elemento, uint32_t tamanho>
+inline elemento *reservaNaFila (filaCarro<elemento, tamanho> *fila) {
+    uint32_t fim = fila->fim;
+
+    if (fim - fila->inicio >= tamanho) {
+        return NULL;
+    }
+    return &fila->itens[fim & (tamanho - 1)];
+}
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * @brief Publica o elemento reservado. Deve ser chamada apenas pelo produtor.
+ *
+ * @param fila          ponteiro para a fila
+ *
+ * @return                      Não retorna nada.
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+template <typename elemento, uint32_t tamanho>
+inline void publicaNaFila (filaCarro<elemento, tamanho> *fila) {
+    // O índice só é publicado depois que o elemento já está na fila
+    __DMB ();
+    fila->fim = fila->fim + 1;
+}
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * @brief Consulta o elemento mais antigo, sem retirá-lo. Deve ser chamada apenas pelo consumidor.
+ *
+ * @param fila          ponteiro para a fila
+ *
+ * @return                      ponteiro para o elemento; NULL se a fila está vazia.
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+template <typename elemento, uint32_t tamanho>
+inline const elemento *consultaFila (filaCarro<elemento, tamanho> *fila) {
+    uint32_t inicio = fila->inicio;
+
+    if (inicio == fila->fim) {
+        return NULL;
+    }
+    __DMB ();
+    return &fila->itens[inicio & (tamanho - 1)];
+}
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * @brief Libera o elemento consultado para o produtor. Deve ser chamada apenas pelo consumidor.
+ *
+ * @param fila          ponteiro para a fila
+ *
+ * @return                      Não retorna nada.
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+template <typename elemento, uint32_t tamanho>
+inline void liberaDaFila (filaCarro<elemento, tamanho> *fila) {
+    // O espaço só é liberado para o produtor depois que o elemento foi lido
+    __DMB ();
+    fila->inicio = fila->inicio + 1;
+}
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * @brief Insere uma cópia do elemento. Deve ser chamada apenas pelo produtor.
+ *
+ * @param fila          ponteiro para a fila
+ * @param item          elemento a inserir
+ *
+ * @return                      1 se o elemento foi inserido; 0 se a fila estava cheia (elemento descartado e contado
+ *                              em perdidos).
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+template <typename elemento, uint32_t tamanho>
+inline int insereNaFila (filaCarro<elemento, tamanho> *fila, const elemento *item) {
+    elemento *livre = reservaNaFila (fila);
+
+    if (livre == NULL) {
+        fila->perdidos = fila->perdidos + 1;
+        return 0;
+    }
+    memcpy (livre, item, sizeof (elemento));
+    publicaNaFila (fila);
+    return 1;
+}
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * @brief Retira uma cópia do elemento mais antigo. Deve ser chamada apenas pelo consumidor.
+ *
+ * @param fila          ponteiro para a fila
+ * @param item          ponteiro que recebe o elemento
+ *
+ * @return                      1 se um elemento foi retirado; 0 se a fila estava vazia.
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+template <typename elemento, uint32_t tamanho>
+inline int retiraDaFila (filaCarro<elemento, tamanho> *fila, elemento *item) {
+    const elemento *antigo = consultaFila (fila);
+
+    if (antigo == NULL) {
+        return 0;
+    }
+    memcpy (item, antigo, sizeof (elemento));
+    liberaDaFila (fila);
+    return 1;
+}
+
+#endif /*_FILA_CARRO_H_*/
@@ -1,372 +1,1193 @@
-/**
- * GPS_Carro.cpp       v0.0        22-10-2019 
- *
- * Orientador: Elias Teodoro da Silva Junior
- * Autores: Felipe Moura de Castro e Joao Bruno Costa Cruz,
- * Instituto Federal de Educação, Ciência e Tecnologia do Ceará (IFCE) - Campus Fortaleza
- *
- * @Opensource
- * Este código-fonte pode ser utilizado, copiado, estudado, modificado e redistribuído sem restrições.
- *
- * Copyright (c) 2019, Felipe Moura de Castro e Joao Bruno Costa Cruz.
- *
- */
-
-/**
- *----------------------------------------------------------------------------------------------------------------------
- * Essa breve explicacao tenta esclarecer como funciona a 
- * decodificacao dos valores a serem armazenados.
- * 
- * Todos os valores são inicialmente armazenados em uma string e então, o endereço dessa string
- * é passado como parâmetro para que se fosse extrair os dados dessa string e armazenar na estrutura
- * que tem o endereço passado como parâmetro.
- *
- * A primeira análise é feita pela função "parse", verificando se o protocolo obtido é o "$GPRMC". Se
- * for verdade, então os dados são extraídos da string para serem armazenados; caso contrário, os dados
- * são "descartados".
- *
- * Um reset é dado na estrutura para excluir possíveis valores anteriormente armazenados, para que não
- * influenciem no cálculo dos novos valores.
- *
- * Após isso, cada um das funções abaixo saí a procura de vírgulas ',', pois elas dividem cada um dos atributos
- * fornecidos pelo GPS. Os dados são armazenados até que se encontre uma vírgula, e a posição dessa vírgula
- * é salva para que na busca do próximo dado, não precise se percorrer uma parte do vetor já percorrida.
- * 
- * Por fim, algumas conversões como transformação da latitude e longitude em graus com adição do devido sinal 
- * negativo ou positivo (- ou +), e também conversão da unidade de velocidade de knots para km/h são realizadas.
- *----------------------------------------------------------------------------------------------------------------------
- */ 
-
-#include "GPS_Carro.h"
-
-void parse (char *cmd, int n, dataGPS *data) {
-    if (strncmp (cmd,"GPRMC", 5) == 0) {
-        dataCatch (cmd, data);       
-    }
-    return;
-}
-
-
-// Fun��o para reiniciar as variaveis numericas
-void reset (dataGPS *data) {
-    data->time = 0;
-    data->latitude = 0;
-    data->longitude = 0;
-    data->speed = 0;
-    data->course = 0;
-    data->magnetcVariationValue = 0;
-}
-
-
-// Fun��o para pegar o protocolo
-int getProtocol (char *input, int pivot, dataGPS *data) {
-    int i;
-    // Executa at� encontrar uma virgula
-    for (i = 0; (int)input[pivot + i] != ',' ; i++) //i < 6
-    {
-        data->protocol[i] = input[pivot + i];  
-    }
-   
-    // Retorna a posi��o do ultimo dado pego
-    return pivot + i - 1;
-}
-
-// Fun��o para calcular uma potencia de 10
-int potencia (int val) {
-    int i, j;
-    j = 1;
-    for (i = 0; i < val; i++) {
-        j *= 10;
-    }
-
-    return j;
-}
-
-// Fun��o para pegar o tempo do gps
-int getTime (char *input, int pivot, dataGPS *data) {
-    int i, j;
-    // Executa at� encontrar uma virgula
-    for (i = 0; (int)input[pivot + i] != ',' ; i++) { // i < 9 
-        // Pega os valores diferentes de '.'
-        if ( (double)input[pivot + i] != '.') {
-            j = potencia (i);
-            data->time += ( (double)input[pivot + i] - '0')* (100000/j);
-        }
-    }
-     //Retorna a posi��o do ultimo dado pego
-     data->time -= 30000.0;
-    return pivot + i - 1;
-}
-
-// Fun��o para pegar o bit de validade do gps
-int getValid (char *input, int pivot, dataGPS *data) {
-    data->valid = input[pivot];
-   
-    return pivot;
-}
-
-// Fun��o para pegar a latitude do gps
-int getLatitude (char *input, int pivot, dataGPS *data) {
-    int i = 0, j;
-    double k = 1000.00;
-    // Executa at� encontrar uma virgula
-    for(i = 0; (int)input[pivot + i] != ',' ; i++) {
-        // Pega os valores diferentes de '.'
-        if( (double)input[pivot + i] != '.') {
-            j = potencia (i);
-            data->latitude += ( (double)input[pivot + i] - '0')* (k/j);
-        }
-        else {
-            // Ajusta a potencia
-            k *= 10;
-        }
-    }
-   
-    //Retorna a posi��o do ultimo dado pego
-    return pivot + i - 1;
-}
-
-// Fun��o para pegar a dire��o da latitude do gps
-int getDirection1 (char *input, int pivot, dataGPS *data)
-{
-    data->direction1 = input[pivot];
-   
-    return pivot;
-}
-
-// Fun��o para pegar a longitude do gps
-int getLongitude (char *input, int pivot, dataGPS *data)
-{
-    int i = 0, j;
-    double k = 10000.00;
-    // Executa at� encontrar uma virgula
-    for(i = 0; (int)input[pivot + i] != ',' ; i++) { // i < 10
-        // Pega os valores diferentes de '.'
-        if((double)input[pivot + i] != '.') {
-            j = potencia (i);
-            data->longitude += ( (double)input[pivot + i] - '0')* (k/j);
-        }
-        else {
-            // Ajusta a potencia
-            k *= 10;
-        }
-    }
-   
-    //Retorna a posi��o do ultimo dado pego
-    return pivot + i - 1;
-}
-
-// Fun��o para pegar a dire��o da longitude do gps
-int getDirection2 (char *input, int pivot, dataGPS *data)
-{
-    data->direction2 = input[pivot];
-   
-    return pivot;
-}
-
-// Fun��o para pegar a velocidade do gps
-int getSpeed (char *input, int pivot, dataGPS *data)
-{
-    int i = 0, j;
-    double k = 100.00;
-    // Executa at� encontrar uma virgula
-    for(i = 0; (int) input[pivot + i] != ',' ; i++) {
-        // Pega os valores diferentes de '.'
-        if( (double) input[pivot + i] != '.') {
-            j = potencia (i);
-            data->speed += ( (double)input[pivot + i] - '0')* (k/j);
-        }
-        else {
-            // Ajusta a potencia
-            k *= 10;
-        }
-    }
-   
-    //Retorna a posi��o do ultimo dado pego
-    return pivot + i - 1;
-}
-
-// Fun��o para pegar a dire��o do deslocamento do gps
-int getCourse(char *input, int pivot, dataGPS *data) {
-    int i = 0, j;
-    double k = 100.00;
-    // Executa at� encontrar uma virgula
-    for(i = 0; (int)input[pivot + i] != ',' ; i++) {
-        // Pega os valores diferentes de '.'
-        if( (double)input[pivot + i] != '.') {
-            j = potencia(i);
-            data->course += ((double)input[pivot + i] - '0')* (k/j);
-        }
-        else {
-            // Ajusta a potencia
-            k *= 10;
-        }
-    }
-   
-    //Retorna a posi��o do ultimo dado pego
-    return pivot + i - 1;
-}
-
-// Fun��o para pegar a data do gps
-int getDate (char *input, int pivot, dataGPS *data) {
-    int i;
-    // Executa at� encontrar uma virgula
-    for(i = 0; (int) input[pivot + i] != ',' ; i++) { //i < 6 
-        data->date[i] = input[pivot + i];  
-    }
-   
-    //Retorna a posi��o do ultimo dado pego
-    return pivot + i - 1;
-}
-
-// Fun��o para pegar a varia��o magn�tica do gps
-int getMagnetcVariationValue (char *input, int pivot, dataGPS *data) {
-    int i = 0, j;
-    double k = 100.00;
-    // Executa at� encontrar uma virgula
-    for(i = 0; (int)input[pivot + i] != ',' ; i++) {
-        // Pega os valores diferentes de '.'
-        if( (double)input[pivot + i] != '.') {
-            j = potencia(i);
-            data->magnetcVariationValue += ((double)input[pivot + i] - '0')* (k/j);
-        }
-        else {
-            // Ajusta a potencia
-            k *= 10;
-        }
-    }
-   
-    //Retorna a posi��o do ultimo dado pego
-    return pivot + i - 1;
-}
-
-// Fun��o para pegar o modo do gps
-int getMode (char *input, int pivot, dataGPS *data) {
-    data->mode = input[pivot];
-    if( (int)data->mode == ',')
-        return pivot - 1;
-    else
-        return pivot;
-}
-
-// Fun��o para pegar o checksum do gps
-void getChecksum (char *input, int pivot, dataGPS *data)
-{
-    int i;
-    for(i = 0; i < 4 ; i++) { //i < 6 
-        data->checksum[i] = input[pivot + i];  
-    }
-}
-
-
-// Fun��o para pegar todos os dados do gps
-void dataCatch (char  *mensagem, dataGPS *data) {   
-    int i = 0, j = 0;
-    reset (data);
-    while(j < 12) {
-        // A cada virgula o j � incrementado
-        if( (int)mensagem[i] == ',') {
-            j++;
-            i++;
-        }
-        // Escolhendo que dado ser� pego
-        switch (j) {
-            case 0:
-                //fun��o getProtocol
-                i = getProtocol (mensagem, i, data);
-                break;
-            case 1:
-                //fun��o getTime
-                i = getTime (mensagem, i, data);
-                break;
-            case 2:
-                //fun��o getValid
-                i = getValid (mensagem, i, data);
-                break;
-            case 3:
-                //fun��o getLatitude
-                i = getLatitude (mensagem, i, data);
-                break;
-            case 4:
-                //fun��o getDirection1
-                i = getDirection1 (mensagem, i, data);
-                break;
-            case 5:
-                //fun��o getLongitude
-                i = getLongitude (mensagem, i, data);
-                break;
-            case 6:
-                //fun��o getDirection2
-                i = getDirection2 (mensagem, i, data);
-                break;
-            case 7:
-                //fun��o getSpeed
-                i = getSpeed (mensagem, i, data);
-                break;
-            case 8:
-                //fun��o getCourse
-                i = getCourse (mensagem, i, data);
-                break;
-            case 9:
-                //fun��o getDate
-                i = getDate (mensagem, i, data);
-                break;
-            case 10:
-                //fun��o getMagnetcVariationValue
-                i = getMagnetcVariationValue (mensagem, i, data);
-                break;
-            case 11:
-                //fun��o getMagnetcVariationIndicator
-                i = getMode (mensagem, i, data);
-                break;
-            case 12:
-                //fun��o getChecksum
-                getChecksum (mensagem, i, data);
-                break;
-        }
-       
-        i++;
-    }
-    transformaCoordenada (data);
-    transformaSpeed (data);
-    
-}
-
-
-// Fun��o que ajusto o formato das coordenadas
-void transformaCoordenada (dataGPS *data)
-{
-    double num1, num2;
-    double aux, aux2;
-
-    num1 = data->latitude;
-    num2 = data->longitude;
-   
-    num1 = num1/100;
-    aux = num1;
-    aux = aux - (int)aux;
-    aux = aux*100;
-    aux = aux/60;
-    num1 = (int)num1;
-   
-    num2 = num2/100;
-    aux2 = num2;
-    aux2 = aux2 - (int)aux2;
-    aux2 = aux2*100;
-    aux2 = aux2/60;
-    num2 = (int)num2;
-   
-    data->latitude =  num1 + aux;
-    data->longitude =  num2 + aux2;
-   
-    if ( (int)data->direction1 == 'S')
-        data->latitude *= -1;
-   
-    if ( (int)data->direction2 == 'W')
-        data->longitude *= -1;
-}
-
-// Fun��o que passa a velocidade para km/h
-void transformaSpeed (dataGPS *data) {
-    data->speed = data->speed * 1.853;
-}
+/**
+ * GPS_Carro.cpp       v0.0        22-10-2019
+ *
+ * Orientador: Elias Teodoro da Silva Junior
+ * Autores: Felipe Moura de Castro e Joao Bruno Costa Cruz,
+ * Instituto Federal de Educação, Ciência e Tecnologia do Ceará (IFCE) - Campus Fortaleza
+ *
+ * @Opensource
+ * Este código-fonte pode ser utilizado, copiado, estudado, modificado e redistribuído sem restrições.
+ *
+ * Copyright (c) 2019, Felipe Moura de Castro e Joao Bruno Costa Cruz.
+ *
+ */
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * Essa breve explicacao tenta esclarecer como funciona a
+ * decodificacao dos valores a serem armazenados.
+ *
+ * Todos os valores são inicialmente armazenados em uma string e então, o endereço dessa string
+ * é passado como parâmetro para que se fosse extrair os dados dessa string e armazenar na estrutura
+ * que tem o endereço passado como parâmetro.
+ *
+ * A primeira análise é feita pela função "parse", verificando se o protocolo obtido é o "$GPRMC". Se
+ * for verdade, então os dados são extraídos da string para serem armazenados; caso contrário, os dados
+ * são "descartados".
+ *
+ * Um reset é dado na estrutura para excluir possíveis valores anteriormente armazenados, para que não
+ * influenciem no cálculo dos novos valores.
+ *
+ * Após isso, a sentença é percorrida uma única vez por um cursor. Cada vírgula ',' encerra um campo e
+ * o campo seguinte é decodificado a partir da posição em que o anterior parou, sem voltar atrás.
+ * Os campos numéricos são lidos como inteiros em ponto fixo (ex.: latitude em ddmm.mmmmm * 10^5),
+ * evitando aritmética em double (que no Cortex-M4F é emulada em software) para cada caractere.
+ * A leitura nunca ultrapassa o tamanho 'n' informado para a sentença.
+ *
+ * Por fim, algumas conversões como transformação da latitude e longitude em graus * 10^7 com adição do devido
+ * sinal negativo ou positivo (- ou +), e também conversão da unidade de velocidade de knots para mm/s são
+ * realizadas, ainda em inteiros. Nenhum valor da estrutura dataGPS é armazenado em ponto flutuante.
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+
+#include "GPS_Carro.h"
+#include <math.h>
+
+/**
+ * Casas decimais mantidas em cada campo numérico das sentenças NMEA
+ */
+#define CASAS_COORDENADA    5   // ddmm.mmmmm (NEO-6M fornece 5 casas nos minutos)
+#define CASAS_VELOCIDADE    3   // knots com 3 casas
+#define CASAS_CURSO         2   // graus com 2 casas
+#define CASAS_VARIACAO      1   // graus com 1 casa
+#define CASAS_ALTITUDE      3   // metros com 3 casas (mm)
+#define CASAS_DOP           2   // DOP com 2 casas
+#define CASAS_TEMPO         2   // hhmmss.ss (identifica a época mesmo acima de 1 Hz)
+#define CASAS_MILISSEGUNDOS 3   // hhmmss.sss -> hhmmss e milissegundos
+
+/**
+ * Etapas da montagem de uma sentença
+ */
+#define MONTADOR_ESPERA_INICIO  0   // aguardando '$'
+#define MONTADOR_CORPO          1   // acumulando caracteres e o XOR
+#define MONTADOR_CHECKSUM_1     2   // aguardando o primeiro dígito após '*'
+#define MONTADOR_CHECKSUM_2     3   // aguardando o segundo dígito após '*'
+
+void publicaGPS (publicadorGPS *publicador, const dataGPS *data) {
+    uint32_t sequencia = publicador->sequencia;
+
+    // Sequência ímpar: escrita em andamento
+    publicador->sequencia = sequencia + 1;
+    __DMB ();
+    memcpy (&publicador->dados, data, sizeof (dataGPS));
+    __DMB ();
+    publicador->sequencia = sequencia + 2;
+}
+
+uint32_t leGPS (const publicadorGPS *publicador, dataGPS *data) {
+    uint32_t antes, depois;
+
+    do {
+        antes = publicador->sequencia;
+        __DMB ();
+        memcpy (data, &publicador->dados, sizeof (dataGPS));
+        __DMB ();
+        depois = publicador->sequencia;
+    } while ((antes & 1) || antes != depois);
+
+    return antes / 2;
+}
+
+void iniciaMontador (montadorNMEA *montador) {
+    memset (montador, 0, sizeof (montadorNMEA));
+    montador->estado = MONTADOR_ESPERA_INICIO;
+}
+
+// Converte um dígito hexadecimal (maiúsculo ou minúsculo); retorna -1 se inválido
+static int valorHexadecimal (char c) {
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    return -1;
+}
+
+int montaSentenca (montadorNMEA *montador, char c) {
+    int digito;
+
+    // Um '$' sempre inicia uma nova sentença, mesmo que a anterior não tenha terminado
+    if (c == '$') {
+        if (montador->estado != MONTADOR_ESPERA_INICIO) {
+            montador->estatisticas.truncadas++;
+        }
+        montador->tamanho = 0;
+        montador->checksum = 0;
+        montador->estado = MONTADOR_CORPO;
+        return 0;
+    }
+
+    switch (montador->estado) {
+        case MONTADOR_CORPO:
+            if (c == '*') {
+                montador->estado = MONTADOR_CHECKSUM_1;
+            } else if (c == '\r' || c == '\n') {
+                // Fim de linha sem soma de verificação
+                montador->estatisticas.truncadas++;
+                montador->estado = MONTADOR_ESPERA_INICIO;
+                return 0;
+            } else {
+                montador->checksum ^= (uint8_t)c;
+            }
+            break;
+
+        case MONTADOR_CHECKSUM_1:
+        case MONTADOR_CHECKSUM_2:
+            digito = valorHexadecimal (c);
+            if (digito < 0) {
+                montador->estatisticas.rejeitadas++;
+                montador->estado = MONTADOR_ESPERA_INICIO;
+                return 0;
+            }
+            if (montador->estado == MONTADOR_CHECKSUM_1) {
+                montador->checksumRecebido = (uint8_t)(digito << 4);
+                montador->estado = MONTADOR_CHECKSUM_2;
+            } else {
+                montador->checksumRecebido |= (uint8_t)digito;
+                montador->estado = MONTADOR_ESPERA_INICIO;
+            }
+            break;
+
+        default:
+            // Bytes fora de uma sentença são ignorados
+            return 0;
+    }
+
+    // Guarda o caractere, reservando espaço para o '\0'
+    if (montador->tamanho >= TAMANHO_SENTENCA_GPS - 1) {
+        montador->estatisticas.truncadas++;
+        montador->estado = MONTADOR_ESPERA_INICIO;
+        return 0;
+    }
+    montador->sentenca[montador->tamanho++] = c;
+
+    // Sentença completa: confere a soma antes de entregá-la
+    if (montador->estado == MONTADOR_ESPERA_INICIO) {
+        montador->sentenca[montador->tamanho] = '\0';
+        if (montador->checksum != montador->checksumRecebido) {
+            montador->estatisticas.rejeitadas++;
+            return 0;
+        }
+        montador->estatisticas.aceitas++;
+        return 1;
+    }
+    return 0;
+}
+
+int parse (char *cmd, int n, dataGPS *data) {
+    if (n >= 5 && strncmp (cmd + 2, "RMC", 3) == 0) {
+        dataCatch (cmd, n, data);
+        return 1;
+    }
+    return 0;
+}
+
+
+// Função para reiniciar as variaveis numericas
+void reset (dataGPS *data) {
+    data->time = 0;
+    data->millisecond = 0;
+    data->latitude = 0;
+    data->longitude = 0;
+    data->speed = 0;
+    data->course = 0;
+    data->magnetcVariationValue = 0;
+}
+
+// Verifica se o caractere encerra um campo da sentença
+static inline bool fimDeCampo (char c) {
+    return (c == ',' || c == '*' || c == '\r' || c == '\n' || c == '\0');
+}
+
+// Avança o cursor até o final do campo atual, sem decodificá-lo
+static void pulaCampo (const char **cursor, const char *fim) {
+    const char *p = *cursor;
+    while (p < fim && !fimDeCampo (*p)) {
+        p++;
+    }
+    *cursor = p;
+}
+
+// Copia o campo atual como texto (no máximo tamanho - 1 caracteres) e termina com '\0'
+static void copiaCampo (const char **cursor, const char *fim, char *destino, int tamanho) {
+    const char *p = *cursor;
+    int i = 0;
+    while (p < fim && !fimDeCampo (*p)) {
+        if (i < tamanho - 1) {
+            destino[i++] = *p;
+        }
+        p++;
+    }
+    destino[i] = '\0';
+    *cursor = p;
+}
+
+// Lê o campo atual como um caractere único (ex.: 'A', 'N', 'W'); campo vazio resulta em '\0'
+static char caractereDoCampo (const char **cursor, const char *fim) {
+    char c = '\0';
+    if (*cursor < fim && !fimDeCampo (**cursor)) {
+        c = **cursor;
+    }
+    pulaCampo (cursor, fim);
+    return c;
+}
+
+// Acrescenta um dígito ao valor; campos longos demais saturam em vez de estourar o int32
+static inline int32_t acrescentaDigito (int32_t valor, int digito) {
+    return (valor > (INT32_MAX - 9) / 10) ? INT32_MAX : valor * 10 + digito;
+}
+
+/**
+ * Lê o campo atual como um número decimal em ponto fixo, mantendo exatamente 'casas' casas decimais.
+ * Dígitos excedentes são truncados e casas faltantes são completadas com zero.
+ * Ex.: "0343.1234" com casas = 5 -> 34312340
+ */
+static int32_t lerDecimalFixo (const char **cursor, const char *fim, int casas) {
+    const char *p = *cursor;
+    int32_t valor = 0;
+    int fracionarias = -1; // -1 enquanto o '.' não foi encontrado
+    bool negativo = false;
+
+    if (p < fim && *p == '-') {
+        negativo = true;
+        p++;
+    }
+    for (; p < fim && !fimDeCampo (*p); p++) {
+        if (*p == '.') {
+            fracionarias = 0;
+        } else if (*p >= '0' && *p <= '9') {
+            if (fracionarias < 0) {
+                valor = acrescentaDigito (valor, *p - '0');
+            } else if (fracionarias < casas) {
+                valor = acrescentaDigito (valor, *p - '0');
+                fracionarias++;
+            }
+        }
+    }
+    if (fracionarias < 0) {
+        fracionarias = 0;
+    }
+    for (; fracionarias < casas; fracionarias++) {
+        valor = acrescentaDigito (valor, 0);
+    }
+    *cursor = p;
+    return negativo ? -valor : valor;
+}
+
+// Função para pegar todos os dados do gps (uma única passada sobre a sentença)
+void dataCatch (char *mensagem, int n, dataGPS *data) {
+    const char *p = mensagem;
+    const char *fim = mensagem + n;
+    int campo = 0;
+    int32_t latitude = 0, longitude = 0, velocidade = 0, tempo;
+
+    reset (data);
+    data->date[0] = '\0';
+    data->checksum[0] = '\0';
+
+    while (p < fim) {
+        // Escolhendo que dado será pego
+        switch (campo) {
+            case 0:
+                copiaCampo (&p, fim, data->protocol, sizeof (data->protocol));
+                break;
+            case 1:
+                // hhmmss.ss -> hhmmss (UTC) e milissegundos
+                tempo = lerDecimalFixo (&p, fim, CASAS_MILISSEGUNDOS);
+                data->time = tempo / 1000;
+                data->millisecond = (uint16_t)(tempo % 1000);
+                break;
+            case 2:
+                data->valid = caractereDoCampo (&p, fim);
+                break;
+            case 3:
+                latitude = lerDecimalFixo (&p, fim, CASAS_COORDENADA);
+                break;
+            case 4:
+                data->direction1 = caractereDoCampo (&p, fim);
+                break;
+            case 5:
+                longitude = lerDecimalFixo (&p, fim, CASAS_COORDENADA);
+                break;
+            case 6:
+                data->direction2 = caractereDoCampo (&p, fim);
+                break;
+            case 7:
+                velocidade = lerDecimalFixo (&p, fim, CASAS_VELOCIDADE);
+                break;
+            case 8:
+                data->course = (uint16_t)lerDecimalFixo (&p, fim, CASAS_CURSO);
+                break;
+            case 9:
+                copiaCampo (&p, fim, data->date, sizeof (data->date));
+                break;
+            case 10:
+                data->magnetcVariationValue = (int16_t)lerDecimalFixo (&p, fim, CASAS_VARIACAO);
+                break;
+            case 11:
+                data->magnetcVariationIndicator = caractereDoCampo (&p, fim);
+                break;
+            case 12:
+                data->mode = caractereDoCampo (&p, fim);
+                break;
+            default:
+                pulaCampo (&p, fim);
+                break;
+        }
+
+        // A cada virgula o campo é incrementado; qualquer outro separador encerra a sentença
+        if (p < fim && *p == ',') {
+            p++;
+            campo++;
+        } else {
+            break;
+        }
+    }
+
+    // Soma de verificação: dois dígitos hexadecimais após o '*'
+    if (p < fim && *p == '*') {
+        p++;
+        copiaCampo (&p, fim, data->checksum, sizeof (data->checksum));
+    }
+
+    data->latitude = transformaCoordenada (latitude, data->direction1);
+    data->longitude = transformaCoordenada (longitude, data->direction2);
+    data->speed = transformaSpeed (velocidade);
+}
+
+// Avança o cursor para o campo seguinte; retorna false se a sentença terminou
+static inline bool proximoCampo (const char **cursor, const char *fim) {
+    pulaCampo (cursor, fim);
+    if (*cursor < fim && **cursor == ',') {
+        (*cursor)++;
+        return true;
+    }
+    return false;
+}
+
+/**
+ * $xxGGA,hhmmss.ss,lat,N,lon,E,qualidade,satélites,HDOP,altitude,M,separação,M,idade,estação*hh
+ * A posição só é usada se a época ainda não recebeu um RMC (que também traz a data).
+ */
+static void decodificaGGA (const char *p, const char *fim, dataGPS *data, bool temRMC) {
+    int32_t latitude, longitude, tempo;
+    char direcao1, direcao2;
+
+    if (!proximoCampo (&p, fim)) return;
+    tempo = lerDecimalFixo (&p, fim, CASAS_MILISSEGUNDOS);
+    data->time = tempo / 1000;
+    data->millisecond = (uint16_t)(tempo % 1000);
+    if (!proximoCampo (&p, fim)) return;
+    latitude = lerDecimalFixo (&p, fim, CASAS_COORDENADA);
+    if (!proximoCampo (&p, fim)) return;
+    direcao1 = caractereDoCampo (&p, fim);
+    if (!proximoCampo (&p, fim)) return;
+    longitude = lerDecimalFixo (&p, fim, CASAS_COORDENADA);
+    if (!proximoCampo (&p, fim)) return;
+    direcao2 = caractereDoCampo (&p, fim);
+    if (!temRMC) {
+        data->direction1 = direcao1;
+        data->direction2 = direcao2;
+        data->latitude = transformaCoordenada (latitude, direcao1);
+        data->longitude = transformaCoordenada (longitude, direcao2);
+    }
+    if (!proximoCampo (&p, fim)) return;
+    data->fixQuality = (uint8_t)lerDecimalFixo (&p, fim, 0);
+    if (!proximoCampo (&p, fim)) return;
+    data->satellites = (uint8_t)lerDecimalFixo (&p, fim, 0);
+    if (!proximoCampo (&p, fim)) return;
+    data->hdop = (uint16_t)lerDecimalFixo (&p, fim, CASAS_DOP);
+    if (!proximoCampo (&p, fim)) return;
+    data->altitude = lerDecimalFixo (&p, fim, CASAS_ALTITUDE);
+}
+
+/**
+ * $xxGSA,modo,tipo,sv1,...,sv12,PDOP,HDOP,VDOP[,sistema]*hh
+ * Receptores multi-constelação enviam um GSA por constelação, com os mesmos DOPs.
+ */
+static void decodificaGSA (const char *p, const char *fim, dataGPS *data) {
+    int campo;
+
+    if (!proximoCampo (&p, fim) || !proximoCampo (&p, fim)) return;
+    data->fixType = (uint8_t)lerDecimalFixo (&p, fim, 0);
+    // Os 12 campos de satélites utilizados não são armazenados
+    for (campo = 0; campo < 13; campo++) {
+        if (!proximoCampo (&p, fim)) return;
+    }
+    data->pdop = (uint16_t)lerDecimalFixo (&p, fim, CASAS_DOP);
+    if (!proximoCampo (&p, fim)) return;
+    data->hdop = (uint16_t)lerDecimalFixo (&p, fim, CASAS_DOP);
+    if (!proximoCampo (&p, fim)) return;
+    data->vdop = (uint16_t)lerDecimalFixo (&p, fim, CASAS_DOP);
+}
+
+/**
+ * $xxVTG,curso,T,curso magnético,M,velocidade,N,velocidade,K,modo*hh
+ * Curso e velocidade só são usados se a época ainda não recebeu um RMC.
+ */
+static void decodificaVTG (const char *p, const char *fim, dataGPS *data, bool temRMC) {
+    int32_t curso, velocidade;
+
+    if (temRMC || !proximoCampo (&p, fim)) return;
+    curso = lerDecimalFixo (&p, fim, CASAS_CURSO);
+    if (!proximoCampo (&p, fim) || !proximoCampo (&p, fim) || !proximoCampo (&p, fim) ||
+        !proximoCampo (&p, fim)) return;
+    velocidade = lerDecimalFixo (&p, fim, CASAS_VELOCIDADE);
+    data->course = (uint16_t)curso;
+    data->speed = transformaSpeed (velocidade);
+}
+
+/**
+ * $xxGSV,total de sentenças,número da sentença,satélites visíveis,...*hh
+ * Retorna 1 se for a última sentença do grupo. Os satélites visíveis de cada constelação
+ * são somados uma única vez (na primeira sentença do grupo).
+ */
+static int decodificaGSV (const char *p, const char *fim, dataGPS *data) {
+    int32_t total, numero;
+
+    if (!proximoCampo (&p, fim)) return 0;
+    total = lerDecimalFixo (&p, fim, 0);
+    if (!proximoCampo (&p, fim)) return 0;
+    numero = lerDecimalFixo (&p, fim, 0);
+    if (!proximoCampo (&p, fim)) return 0;
+    if (numero == 1) {
+        data->satellitesInView += (uint8_t)lerDecimalFixo (&p, fim, 0);
+    }
+    return numero >= total;
+}
+
+void iniciaFusaoNMEA (fusaoNMEA *fusao) {
+    memset (fusao, 0, sizeof (fusaoNMEA));
+}
+
+// Entrega a época em montagem e começa uma nova
+static void concluiEpoca (fusaoNMEA *fusao, dataGPS *data) {
+    dataGPS *epoca = &fusao->epoca;
+
+    // Sem RMC, a validade vem da qualidade informada pelo GGA
+    if (!(fusao->partes & PARTE_NMEA_RMC)) {
+        epoca->valid = (epoca->fixQuality > 0) ? 'A' : 'V';
+    }
+    memcpy (data, epoca, sizeof (dataGPS));
+    memset (epoca, 0, sizeof (dataGPS));
+    fusao->temTempo = false;
+    fusao->partes = 0;
+}
+
+int fundeNMEA (fusaoNMEA *fusao, char *cmd, int n, dataGPS *data) {
+    const char *p = cmd;
+    const char *fim = cmd + n;
+    const char *tipo = cmd + 2;
+    int concluida = 0, fimDeGrupo = 1;
+    uint8_t parte;
+    int32_t tempo;
+
+    if (n < 6 || cmd[5] != ',') {
+        return 0;
+    }
+    if (strncmp (tipo, "RMC", 3) == 0)      parte = PARTE_NMEA_RMC;
+    else if (strncmp (tipo, "GGA", 3) == 0) parte = PARTE_NMEA_GGA;
+    else if (strncmp (tipo, "GSA", 3) == 0) parte = PARTE_NMEA_GSA;
+    else if (strncmp (tipo, "VTG", 3) == 0) parte = PARTE_NMEA_VTG;
+    else if (strncmp (tipo, "GSV", 3) == 0) parte = PARTE_NMEA_GSV;
+    else return 0;
+
+    // Sentença sem tempo logo após uma época encerrada pela terminadora: ela ainda pertencia
+    // à época entregue (a ordem do receptor mudou), então passa a ser a nova terminadora
+    if (fusao->encerradaPelaTerminadora && !fusao->temTempo &&
+        parte != PARTE_NMEA_RMC && parte != PARTE_NMEA_GGA) {
+        if (parte != PARTE_NMEA_GSV || decodificaGSV (cmd, fim, &fusao->epoca) == 1) {
+            memcpy (fusao->terminadora, cmd, 5);
+        }
+        fusao->epoca.satellitesInView = 0;
+        return 0;
+    }
+
+    // RMC e GGA informam o tempo: um tempo diferente inicia uma nova época
+    if (parte == PARTE_NMEA_RMC || parte == PARTE_NMEA_GGA) {
+        p = cmd + 6;
+        tempo = lerDecimalFixo (&p, fim, CASAS_TEMPO);
+        if (fusao->temTempo && tempo != fusao->tempoDaEpoca) {
+            // A última sentença da época encerrada passa a indicar o fim das próximas
+            memcpy (fusao->terminadora, fusao->ultima, sizeof (fusao->terminadora));
+            concluiEpoca (fusao, data);
+            concluida = 1;
+        }
+        fusao->tempoDaEpoca = tempo;
+        fusao->temTempo = true;
+        fusao->encerradaPelaTerminadora = false;
+    }
+
+    switch (parte) {
+        case PARTE_NMEA_RMC:
+            // dataCatch reinicia apenas os campos do RMC
+            dataCatch (cmd, n, &fusao->epoca);
+            break;
+        case PARTE_NMEA_GGA:
+            decodificaGGA (cmd, fim, &fusao->epoca, fusao->partes & PARTE_NMEA_RMC);
+            break;
+        case PARTE_NMEA_GSA:
+            decodificaGSA (cmd, fim, &fusao->epoca);
+            break;
+        case PARTE_NMEA_VTG:
+            decodificaVTG (cmd, fim, &fusao->epoca, fusao->partes & PARTE_NMEA_RMC);
+            break;
+        case PARTE_NMEA_GSV:
+            fimDeGrupo = decodificaGSV (cmd, fim, &fusao->epoca);
+            break;
+    }
+    fusao->partes |= parte;
+
+    if (fimDeGrupo) {
+        memcpy (fusao->ultima, cmd, 5);
+        fusao->ultima[5] = '\0';
+
+        // A época termina na mesma sentença que encerrou a anterior, sem esperar a próxima
+        if (!concluida && fusao->temTempo && fusao->terminadora[0] != '\0' &&
+            strcmp (fusao->ultima, fusao->terminadora) == 0) {
+            concluiEpoca (fusao, data);
+            fusao->encerradaPelaTerminadora = true;
+            concluida = 1;
+        }
+    }
+    return concluida;
+}
+
+int fixConfiavel (const dataGPS *data, uint16_t hdopMaximo) {
+    if (data->valid != 'A') {
+        return 0;
+    }
+    // No modo UBX o HDOP sempre vem do NAV-DOP: zero indica um fix incompleto
+    if (data->hdop == 0) {
+        return strcmp (data->protocol, "UBX") != 0;
+    }
+    return data->hdop <= hdopMaximo;
+}
+
+/**
+ * Metros por 10^-7 graus de latitude (raio médio da Terra: 6371 km)
+ */
+#define METROS_POR_UNIDADE      0.011119508f
+#define PI_F                    3.14159265f
+
+// Ajusta um ângulo para o intervalo [-pi, pi)
+static float normalizaAngulo (float angulo) {
+    while (angulo >= PI_F) angulo -= 2.0f * PI_F;
+    while (angulo < -PI_F) angulo += 2.0f * PI_F;
+    return angulo;
+}
+
+// Faz do fix a âncora de um novo segmento
+static void ancoraSegmento (simplificadorGPS *simplificador, const dataGPS *fix) {
+    memcpy (&simplificador->ancora, fix, sizeof (dataGPS));
+    simplificador->metrosPorUnidadeLeste = METROS_POR_UNIDADE *
+            cosf ((float)fix->latitude * 1e-7f * PI_F / 180.0f);
+    simplificador->temAncora = true;
+    simplificador->temCandidato = false;
+    simplificador->coneAberto = false;
+    simplificador->distanciaMaxima = 0.0f;
+}
+
+/**
+ * Restringe o cone com o fix. Retorna false se o fix está fora do cone (o segmento
+ * não pode ser estendido até ele sem desrespeitar o erro máximo).
+ */
+static bool restringeCone (simplificadorGPS *simplificador, const dataGPS *fix) {
+    simplificadorGPS *s = simplificador;
+    float norte = (float)(fix->latitude - s->ancora.latitude) * METROS_POR_UNIDADE;
+    float leste = (float)(fix->longitude - s->ancora.longitude) * s->metrosPorUnidadeLeste;
+    float distancia = sqrtf (norte * norte + leste * leste);
+    float direcao, abertura;
+
+    // Ainda dentro da tolerância em torno da âncora: qualquer direção serve enquanto o cone não foi aberto
+    if (distancia <= s->erroMaximo && !s->coneAberto) {
+        return true;
+    }
+
+    // Um fim de segmento mais perto da âncora que um fix já aceito deixaria esse fix além do fim do
+    // segmento (carro voltando ou ruído com o carro parado), onde o cone não limita a distância
+    if (distancia < s->distanciaMaxima) {
+        return false;
+    }
+    s->distanciaMaxima = distancia;
+
+    direcao = atan2f (leste, norte);
+    abertura = asinf (s->erroMaximo / distancia);
+    if (!s->coneAberto) {
+        s->direcao = direcao;
+        s->coneMinimo = -abertura;
+        s->coneMaximo = abertura;
+        s->coneAberto = true;
+        return true;
+    }
+
+    direcao = normalizaAngulo (direcao - s->direcao);
+    if (direcao < s->coneMinimo || direcao > s->coneMaximo) {
+        return false;
+    }
+    if (direcao - abertura > s->coneMinimo) s->coneMinimo = direcao - abertura;
+    if (direcao + abertura < s->coneMaximo) s->coneMaximo = direcao + abertura;
+    return true;
+}
+
+void iniciaSimplificador (simplificadorGPS *simplificador, float erroMaximo) {
+    memset (simplificador, 0, sizeof (simplificadorGPS));
+    simplificador->erroMaximo = erroMaximo;
+}
+
+int simplificaGPS (simplificadorGPS *simplificador, const dataGPS *fix, dataGPS *mantido) {
+    simplificadorGPS *s = simplificador;
+
+    // Perda do sinal: encerra o segmento no último fix válido
+    if (fix->valid != 'A') {
+        if (s->temAncora && s->temCandidato) {
+            memcpy (mantido, &s->candidato, sizeof (dataGPS));
+            s->mantidos++;
+            s->temAncora = false;
+            return 1;
+        }
+        s->temAncora = false;
+        return 0;
+    }
+    s->recebidos++;
+
+    // Início de um trajeto: o primeiro fix é sempre mantido
+    if (!s->temAncora) {
+        ancoraSegmento (s, fix);
+        memcpy (mantido, fix, sizeof (dataGPS));
+        s->mantidos++;
+        return 1;
+    }
+
+    if (restringeCone (s, fix)) {
+        memcpy (&s->candidato, fix, sizeof (dataGPS));
+        s->temCandidato = true;
+        return 0;
+    }
+
+    // O fix não cabe no segmento: o candidato é mantido e o fix inicia o próximo segmento
+    memcpy (mantido, &s->candidato, sizeof (dataGPS));
+    s->mantidos++;
+    ancoraSegmento (s, mantido);
+    restringeCone (s, fix);
+    memcpy (&s->candidato, fix, sizeof (dataGPS));
+    s->temCandidato = true;
+    return 1;
+}
+
+
+// Função que ajusta o formato das coordenadas (ddmm.mmmmm * 10^5 -> graus * 10^7)
+int32_t transformaCoordenada (int32_t grausMinutos, char direcao) {
+    int32_t graus, minutos;
+
+    graus = grausMinutos / 10000000;     // dd (ou ddd)
+    minutos = grausMinutos % 10000000;   // mm.mmmmm * 10^5
+
+    // Campo corrompido (fora de -180..180 graus): descartado
+    if (graus > 180 || graus < -180) {
+        return 0;
+    }
+
+    // minutos / 60 -> graus, arredondado para o inteiro mais próximo em 10^-7 graus
+    graus = graus * 10000000 + (minutos * 100 + 30) / 60;
+
+    if (direcao == 'S' || direcao == 'W')
+        graus = -graus;
+
+    return graus;
+}
+
+// Função que passa a velocidade para mm/s (knots * 10^3 -> mm/s, arredondado)
+int32_t transformaSpeed (int32_t velocidade) {
+    // Limita a 1000 nós (campo corrompido) para não estourar o int32
+    if (velocidade > 1000000) {
+        velocidade = 1000000;
+    } else if (velocidade < -1000000) {
+        velocidade = -1000000;
+    }
+    return (velocidade * 1852 + 1800) / 3600;
+}
+
+// Função que escreve um valor em ponto fixo como texto decimal
+char *formataDecimal (char *saida, int tamanho, int32_t valor, int casasDoValor, int casas) {
+    uint32_t absoluto = (valor < 0) ? (uint32_t)(-(int64_t)valor) : (uint32_t)valor;
+    uint32_t divisor = 1, escala = 1;
+    int i;
+
+    // Um uint32_t tem no máximo 9 casas completas
+    if (casas > casasDoValor) {
+        casas = casasDoValor;
+    }
+    if (casas > 9) {
+        casas = 9;
+    } else if (casas < 0) {
+        casas = 0;
+    }
+
+    // Descarta as casas que não serão impressas, arredondando
+    for (i = casas; i < casasDoValor; i++) {
+        divisor *= 10;
+    }
+    absoluto = (absoluto + divisor / 2) / divisor;
+
+    for (i = 0; i < casas; i++) {
+        escala *= 10;
+    }
+    if (casas > 0) {
+        snprintf (saida, tamanho, "%s%lu.%0*lu", (valor < 0 && absoluto != 0) ? "-" : "",
+                  (unsigned long)(absoluto / escala), casas, (unsigned long)(absoluto % escala));
+    } else {
+        snprintf (saida, tamanho, "%s%lu", (valor < 0 && absoluto != 0) ? "-" : "", (unsigned long)absoluto);
+    }
+    return saida;
+}
+
+/**
+ * Etapas da decodificação de um quadro UBX
+ */
+#define UBX_ESPERA_SINCRONISMO_1    0
+#define UBX_ESPERA_SINCRONISMO_2    1
+#define UBX_CLASSE                  2
+#define UBX_ID                      3
+#define UBX_TAMANHO_1               4
+#define UBX_TAMANHO_2               5
+#define UBX_PAYLOAD                 6
+#define UBX_CK_A                    7
+#define UBX_CK_B                    8
+
+/**
+ * Mensagens NAV do NEO-6M que compõem um fix completo
+ */
+#define PARTE_POSLLH                0x01
+#define PARTE_STATUS                0x02
+#define PARTE_VELNED                0x04
+#define PARTE_TIMEUTC               0x08
+#define PARTE_DOP                   0x10
+#define PARTE_SOL                   0x20
+#define PARTE_PVT                   0x40
+#define PARTES_FIX_COMPLETO         (PARTE_POSLLH | PARTE_STATUS | PARTE_VELNED | PARTE_TIMEUTC | PARTE_DOP | \
+                                     PARTE_SOL)
+#define PARTES_FIX_PVT              (PARTE_PVT | PARTE_DOP)
+
+// Leitura de inteiros little-endian do payload
+static inline uint16_t leU16 (const uint8_t *p) {
+    return (uint16_t)(p[0] | (p[1] << 8));
+}
+
+static inline uint32_t leU32 (const uint8_t *p) {
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static inline int32_t leI32 (const uint8_t *p) {
+    return (int32_t)leU32 (p);
+}
+
+void iniciaDecodificadorUBX (decodificadorUBX *decodificador) {
+    memset (decodificador, 0, sizeof (decodificadorUBX));
+    decodificador->estado = UBX_ESPERA_SINCRONISMO_1;
+}
+
+int decodificaUBX (decodificadorUBX *decodificador, uint8_t c) {
+    decodificadorUBX *d = decodificador;
+
+    // Soma de verificação: cobre tudo entre o sincronismo e CK_A
+    if (d->estado >= UBX_CLASSE && d->estado <= UBX_PAYLOAD) {
+        d->ckA += c;
+        d->ckB += d->ckA;
+    }
+
+    switch (d->estado) {
+        case UBX_ESPERA_SINCRONISMO_1:
+            if (c != UBX_SINCRONISMO_1) {
+                return -1;
+            }
+            d->estado = UBX_ESPERA_SINCRONISMO_2;
+            return 0;
+
+        case UBX_ESPERA_SINCRONISMO_2:
+            if (c != UBX_SINCRONISMO_2) {
+                d->estado = UBX_ESPERA_SINCRONISMO_1;
+                return -1;
+            }
+            d->ckA = 0;
+            d->ckB = 0;
+            d->estado = UBX_CLASSE;
+            return 0;
+
+        case UBX_CLASSE:
+            d->classe = c;
+            d->estado = UBX_ID;
+            return 0;
+
+        case UBX_ID:
+            d->id = c;
+            d->estado = UBX_TAMANHO_1;
+            return 0;
+
+        case UBX_TAMANHO_1:
+            d->tamanho = c;
+            d->estado = UBX_TAMANHO_2;
+            return 0;
+
+        case UBX_TAMANHO_2:
+            d->tamanho |= (uint16_t)(c << 8);
+            d->posicao = 0;
+            if (d->tamanho > TAMANHO_PAYLOAD_UBX) {
+                // Mensagem maior que o buffer: não é uma das que interpretamos
+                d->estatisticas.truncadas++;
+                d->estado = UBX_ESPERA_SINCRONISMO_1;
+                return 0;
+            }
+            d->estado = (d->tamanho > 0) ? UBX_PAYLOAD : UBX_CK_A;
+            return 0;
+
+        case UBX_PAYLOAD:
+            d->payload[d->posicao++] = c;
+            if (d->posicao >= d->tamanho) {
+                d->estado = UBX_CK_A;
+            }
+            return 0;
+
+        case UBX_CK_A:
+            if (c != d->ckA) {
+                d->estatisticas.rejeitadas++;
+                d->estado = UBX_ESPERA_SINCRONISMO_1;
+                return 0;
+            }
+            d->estado = UBX_CK_B;
+            return 0;
+
+        case UBX_CK_B:
+            d->estado = UBX_ESPERA_SINCRONISMO_1;
+            if (c != d->ckB) {
+                d->estatisticas.rejeitadas++;
+                return 0;
+            }
+            d->estatisticas.aceitas++;
+            return 1;
+    }
+
+    d->estado = UBX_ESPERA_SINCRONISMO_1;
+    return -1;
+}
+
+// Escreve hhmmss, milissegundos e ddmmaa (como no $GPRMC) a partir dos campos UTC
+static void preencheDataHoraUBX (dataGPS *data, uint16_t ano, uint8_t mes, uint8_t dia,
+                                 uint8_t hora, uint8_t minuto, uint8_t segundo, int32_t nano) {
+    uint8_t aa = (uint8_t)(ano % 100);
+
+    data->time = (int32_t)hora * 10000 + minuto * 100 + segundo;
+    // nano pode ser negativo (o segundo informado já está arredondado)
+    data->millisecond = (nano > 0) ? (uint16_t)(nano / 1000000) : 0;
+    data->date[0] = '0' + dia / 10;  data->date[1] = '0' + dia % 10;
+    data->date[2] = '0' + mes / 10;  data->date[3] = '0' + mes % 10;
+    data->date[4] = '0' + aa / 10;   data->date[5] = '0' + aa % 10;
+    data->date[6] = '\0';
+}
+
+// Escreve latitude e longitude (graus * 10^7) e as respectivas direções
+static void preenchePosicaoUBX (dataGPS *data, int32_t latitude, int32_t longitude) {
+    data->latitude = latitude;
+    data->longitude = longitude;
+    data->direction1 = (latitude < 0) ? 'S' : 'N';
+    data->direction2 = (longitude < 0) ? 'W' : 'E';
+}
+
+int interpretaUBX (decodificadorUBX *decodificador, dataGPS *data) {
+    decodificadorUBX *d = decodificador;
+    const uint8_t *p = d->payload;
+    uint32_t iTOW;
+
+    if (d->classe != UBX_CLASSE_NAV || d->tamanho < 4) {
+        return 0;
+    }
+
+    // As mensagens de uma nova época descartam as partes da época anterior
+    iTOW = leU32 (p);
+    if (iTOW != d->iTOW) {
+        d->iTOW = iTOW;
+        d->partes = 0;
+    }
+
+    strcpy (data->protocol, "UBX");
+
+    switch (d->id) {
+        case UBX_NAV_PVT:
+            if (d->tamanho < 92) return 0;
+            preencheDataHoraUBX (data, leU16 (&p[4]), p[6], p[7], p[8], p[9], p[10], leI32 (&p[16]));
+            // fixType 2D/3D e gnssFixOK
+            data->valid = ( (p[20] == 2 || p[20] == 3) && (p[21] & 0x01) ) ? 'A' : 'V';
+            preenchePosicaoUBX (data, leI32 (&p[28]), leI32 (&p[24]));
+            // gSpeed em mm/s; headMot em 10^-5 graus -> 10^-2 graus
+            data->speed = leI32 (&p[60]);
+            data->course = (uint16_t)(leI32 (&p[64]) / 1000);
+            data->mode = (p[20] == 0) ? 'N' : 'A';
+            data->fixType = (p[20] == 2) ? 2 : ((p[20] == 3 || p[20] == 4) ? 3 : 1);
+            data->fixQuality = (p[21] & 0x01) ? 1 : 0;
+            data->satellites = p[23];
+            // hMSL em mm; pDOP em 10^-2 (o HDOP vem do NAV-DOP)
+            data->altitude = leI32 (&p[36]);
+            data->pdop = leU16 (&p[76]);
+            d->partes |= PARTE_PVT;
+            break;
+
+        case UBX_NAV_POSLLH:
+            if (d->tamanho < 28) return 0;
+            preenchePosicaoUBX (data, leI32 (&p[8]), leI32 (&p[4]));
+            // hMSL em mm
+            data->altitude = leI32 (&p[16]);
+            d->partes |= PARTE_POSLLH;
+            break;
+
+        case UBX_NAV_STATUS:
+            if (d->tamanho < 16) return 0;
+            data->valid = ( (p[4] == 2 || p[4] == 3) && (p[5] & 0x01) ) ? 'A' : 'V';
+            data->mode = (p[4] == 0) ? 'N' : 'A';
+            // gpsFix (0 = sem fix, 2 = 2D, 3 = 3D, 4 = GPS + estimado) -> tipo do fix como no GSA
+            data->fixType = (p[4] == 2) ? 2 : ((p[4] == 3 || p[4] == 4) ? 3 : 1);
+            data->fixQuality = (p[5] & 0x01) ? 1 : 0;
+            d->partes |= PARTE_STATUS;
+            break;
+
+        case UBX_NAV_DOP:
+            if (d->tamanho < 18) return 0;
+            // DOPs em 10^-2, como no GSA
+            data->pdop = leU16 (&p[6]);
+            data->vdop = leU16 (&p[10]);
+            data->hdop = leU16 (&p[12]);
+            d->partes |= PARTE_DOP;
+            break;
+
+        case UBX_NAV_SOL:
+            if (d->tamanho < 52) return 0;
+            data->satellites = p[47];
+            d->partes |= PARTE_SOL;
+            break;
+
+        case UBX_NAV_VELNED:
+            if (d->tamanho < 36) return 0;
+            // gSpeed em cm/s -> mm/s; heading em 10^-5 graus -> 10^-2 graus
+            data->speed = (int32_t)(leU32 (&p[20]) * 10);
+            data->course = (uint16_t)(leI32 (&p[24]) / 1000);
+            d->partes |= PARTE_VELNED;
+            break;
+
+        case UBX_NAV_TIMEUTC:
+            if (d->tamanho < 20) return 0;
+            preencheDataHoraUBX (data, leU16 (&p[12]), p[14], p[15], p[16], p[17], p[18], leI32 (&p[8]));
+            d->partes |= PARTE_TIMEUTC;
+            break;
+
+        default:
+            return 0;
+    }
+
+    if ((d->partes & PARTES_FIX_COMPLETO) == PARTES_FIX_COMPLETO || (d->partes & PARTES_FIX_PVT) == PARTES_FIX_PVT) {
+        d->partes = 0;
+        return 1;
+    }
+    return 0;
+}
+
+int montaMensagemUBX (uint8_t classe, uint8_t id, const uint8_t *payload, uint16_t tamanho, uint8_t *saida) {
+    uint8_t ckA = 0, ckB = 0;
+    int i;
+
+    saida[0] = UBX_SINCRONISMO_1;
+    saida[1] = UBX_SINCRONISMO_2;
+    saida[2] = classe;
+    saida[3] = id;
+    saida[4] = (uint8_t)(tamanho & 0xFF);
+    saida[5] = (uint8_t)(tamanho >> 8);
+    for (i = 0; i < tamanho; i++) {
+        saida[6 + i] = payload[i];
+    }
+    for (i = 2; i < 6 + tamanho; i++) {
+        ckA += saida[i];
+        ckB += ckA;
+    }
+    saida[6 + tamanho] = ckA;
+    saida[7 + tamanho] = ckB;
+
+    return tamanho + 8;
+}
+
+int fimDeQuadroUBX (delimitadorUBX *delimitador, uint8_t c) {
+    switch (delimitador->estado) {
+        case 0:
+            if (c == UBX_SINCRONISMO_1) delimitador->estado = 1;
+            return 0;
+        case 1:
+            delimitador->estado = (c == UBX_SINCRONISMO_2) ? 2 : 0;
+            return 0;
+        case 2: // classe
+        case 3: // id
+            delimitador->estado++;
+            return 0;
+        case 4: // tamanho (byte menos significativo)
+            delimitador->restante = c;
+            delimitador->estado = 5;
+            return 0;
+        case 5: // tamanho (byte mais significativo) + CK_A + CK_B
+            delimitador->restante |= (uint16_t)(c << 8);
+            delimitador->restante += 2;
+            delimitador->estado = 6;
+            return 0;
+        default:
+            if (--delimitador->restante == 0) {
+                delimitador->estado = 0;
+                return 1;
+            }
+            return 0;
+    }
+}
+
+// Envia um quadro UBX byte a byte pela serial
+static void enviaMensagemUBX (RawSerial *serial, uint8_t classe, uint8_t id, const uint8_t *payload, uint16_t tamanho) {
+    uint8_t quadro[TAMANHO_PAYLOAD_UBX + 8];
+    int n = montaMensagemUBX (classe, id, payload, tamanho, quadro);
+    for (int i = 0; i < n; i++) {
+        serial->putc (quadro[i]);
+    }
+}
+
+// Escreve um inteiro de 32 bits em little-endian, como nos payloads UBX
+static inline void escreveU32 (uint8_t *p, uint32_t valor) {
+    p[0] = (uint8_t)(valor);
+    p[1] = (uint8_t)(valor >> 8);
+    p[2] = (uint8_t)(valor >> 16);
+    p[3] = (uint8_t)(valor >> 24);
+}
+
+void configuraModoUBX (RawSerial *serial) {
+    // CFG-MSG (forma curta): classe, id e taxa (0 = desligada) na porta atual
+    static const uint8_t mensagens[][3] = {
+        { UBX_CLASSE_NMEA, 0x00, 0 },   // GGA
+        { UBX_CLASSE_NMEA, 0x01, 0 },   // GLL
+        { UBX_CLASSE_NMEA, 0x02, 0 },   // GSA
+        { UBX_CLASSE_NMEA, 0x03, 0 },   // GSV
+        { UBX_CLASSE_NMEA, 0x04, 0 },   // RMC
+        { UBX_CLASSE_NMEA, 0x05, 0 },   // VTG
+        { UBX_CLASSE_NAV, UBX_NAV_POSLLH, 1 },
+        { UBX_CLASSE_NAV, UBX_NAV_STATUS, 1 },
+        { UBX_CLASSE_NAV, UBX_NAV_DOP, 1 },
+        { UBX_CLASSE_NAV, UBX_NAV_SOL, 1 },
+        { UBX_CLASSE_NAV, UBX_NAV_VELNED, 1 },
+        { UBX_CLASSE_NAV, UBX_NAV_TIMEUTC, 1 },
+    };
+
+    for (unsigned int i = 0; i < sizeof (mensagens) / sizeof (mensagens[0]); i++) {
+        enviaMensagemUBX (serial, UBX_CLASSE_CFG, UBX_CFG_MSG, mensagens[i], 3);
+        // Dá tempo ao receptor para processar cada comando
+        wait_ms (20);
+    }
+}
+
+int esperaConfirmacaoUBX (RawSerial *serial, uint8_t classe, uint8_t id, int limiteMs) {
+    decodificadorUBX decodificador;
+    Timer temporizador;
+
+    iniciaDecodificadorUBX (&decodificador);
+    temporizador.start ();
+    while (temporizador.read_ms () < limiteMs) {
+        if (!serial->readable ()) {
+            continue;
+        }
+        if (decodificaUBX (&decodificador, (uint8_t)serial->getc ()) > 0 &&
+            decodificador.classe == UBX_CLASSE_ACK && decodificador.tamanho == 2 &&
+            decodificador.payload[0] == classe && decodificador.payload[1] == id) {
+            return (decodificador.id == UBX_ACK_ACK) ? 1 : 0;
+        }
+    }
+    return 0;
+}
+
+// Monta o payload do CFG-PRT para a UART1: 8N1, entrada e saída UBX + NMEA
+static void enviaConfiguracaoDePorta (RawSerial *serial, int baud) {
+    uint8_t prt[20] = { 0 };
+
+    prt[0] = 1;                     // portID: UART1
+    prt[4] = 0xD0; prt[5] = 0x08;   // mode: 8 bits, sem paridade, 1 stop bit
+    prt[8] = (uint8_t)(baud);
+    prt[9] = (uint8_t)(baud >> 8);
+    prt[10] = (uint8_t)(baud >> 16);
+    prt[11] = (uint8_t)(baud >> 24);
+    prt[12] = 0x03;                 // inProtoMask: UBX + NMEA
+    prt[14] = 0x03;                 // outProtoMask: UBX + NMEA
+    enviaMensagemUBX (serial, UBX_CLASSE_CFG, UBX_CFG_PRT, prt, sizeof (prt));
+    // O receptor troca de taxa logo após o comando: espera o último byte sair
+    wait_ms (50);
+    serial->baud (baud);
+    wait_ms (50);
+}
+
+// Envia o CFG-RATE (referência de tempo GPS, uma solução por medida) e espera a confirmação
+static int enviaConfiguracaoDeTaxa (RawSerial *serial, uint16_t periodoMs) {
+    uint8_t rate[6] = { 0 };
+
+    rate[0] = (uint8_t)(periodoMs);
+    rate[1] = (uint8_t)(periodoMs >> 8);
+    rate[2] = 1;                    // navRate: 1 solução por medida
+    rate[4] = 1;                    // timeRef: tempo GPS
+    enviaMensagemUBX (serial, UBX_CLASSE_CFG, UBX_CFG_RATE, rate, sizeof (rate));
+    return esperaConfirmacaoUBX (serial, UBX_CLASSE_CFG, UBX_CFG_RATE, 500);
+}
+
+int configuraTaxaGPS (RawSerial *serial, int baudAtual, int baudNovo, uint16_t periodoMs) {
+    // Receptor na taxa original: troca a taxa e confirma o CFG-RATE já na nova
+    enviaConfiguracaoDePorta (serial, baudNovo);
+    if (enviaConfiguracaoDeTaxa (serial, periodoMs)) {
+        return 1;
+    }
+
+    // Sem confirmação: depois de um reset só do microcontrolador, o receptor já está em baudNovo (guardada na memória
+    // com bateria) e o primeiro CFG-RATE pode ter se perdido enquanto a UART dele se recuperava dos bytes do CFG-PRT,
+    // enviados na taxa errada. Sonda baudNovo mais uma vez antes de desistir
+    serial->baud (baudNovo);
+    wait_ms (50);
+    if (enviaConfiguracaoDeTaxa (serial, periodoMs)) {
+        return 1;
+    }
+
+    // Nenhuma das duas tentativas foi confirmada: volta o receptor (caso tenha trocado) e a serial para a taxa original
+    enviaConfiguracaoDePorta (serial, baudAtual);
+    enviaConfiguracaoDeTaxa (serial, 1000);
+    return 0;
+}
+
+void enviaPartidaUBX (RawSerial *serial, const dataGPS *referencia, uint32_t precisaoPosicaoCm, uint32_t precisaoTempoMs) {
+    uint8_t ini[48] = { 0 };
+    uint32_t flags = 0;
+    uint16_t data;
+    int i;
+
+    // Posição em latitude/longitude (10^-7 graus) e altitude (cm)
+    if (referencia->latitude != 0 || referencia->longitude != 0) {
+        escreveU32 (&ini[0], (uint32_t)referencia->latitude);
+        escreveU32 (&ini[4], (uint32_t)referencia->longitude);
+        escreveU32 (&ini[8], (uint32_t)(referencia->altitude / 10));
+        escreveU32 (&ini[12], precisaoPosicaoCm);
+        flags |= 0x01 | 0x20;           // pos, lla
+    }
+
+    // Tempo UTC: wnoOrDate = ano desde 2000 * 100 + mês; towOrTime = dia * 10^6 + hhmmss
+    for (i = 0; i < 6; i++) {
+        if (referencia->date[i] < '0' || referencia->date[i] > '9') {
+            break;
+        }
+    }
+    if (i == 6) {
+        data = (uint16_t)(((referencia->date[4] - '0') * 10 + (referencia->date[5] - '0')) * 100 +
+                          (referencia->date[2] - '0') * 10 + (referencia->date[3] - '0'));
+        ini[18] = (uint8_t)(data);
+        ini[19] = (uint8_t)(data >> 8);
+        escreveU32 (&ini[20], (uint32_t)((referencia->date[0] - '0') * 10 + (referencia->date[1] - '0')) * 1000000 +
+                              (uint32_t)referencia->time);
+        escreveU32 (&ini[28], precisaoTempoMs);
+        flags |= 0x02 | 0x400;          // time, utc
+    }
+
+    if (flags == 0) {
+        return;
+    }
+    escreveU32 (&ini[44], flags);
+    enviaMensagemUBX (serial, UBX_CLASSE_AID, UBX_AID_INI, ini, sizeof (ini));
+}
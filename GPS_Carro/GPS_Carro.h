@@ -1,361 +1,712 @@
-/**
- * GPS_Carro.h       v0.0        22-10-2019 
- *
- * Orientador: Elias Teodoro da Silva Junior
- * Autores: Felipe Moura de Castro e Joao Bruno Costa Cruz,
- * Instituto Federal de Educação, Ciência e Tecnologia do Ceará (IFCE) - Campus Fortaleza
- *
- * @Opensource
- * Este código-fonte pode ser utilizado, copiado, estudado, modificado e redistribuído sem restrições.
- *
- * Copyright (c) 2019, Felipe Moura de Castro e Joao Bruno Costa Cruz.
- *
- */
- 
-#ifndef _GPS_CARRO_H_
-#define _GPS_CARRO_H_
- 
-#include "mbed.h"
-
-/**
- *----------------------------------------------------------------------------------------------------------------------
- * @brief   Definição da estrutura para armazenar os dados oriundos do GPS
- *          O protocolo escolhido para aquisição dos dados foi: $GPRMC
- *          Os protocolos restantes podem ser vistos no seguinte endereço:
- *              https://os.mbed.com/users/edodm85/notebook/gps-u-blox-neo-6m/
- *
- * @var protocol                      protocolo (GPGGA, GPGSA, GPGLL, GPRMC)
- * @var time                          tempo UTC (Fuso horário de referência (-3° em relação ao Brasil))  
- * @var valid                         validade dos dados fornecidos pelo GPS (Semelhante ao CheckSum)
- * @var latitude                      latitude
- * @var getDirection1                 direção da latitude (Norte ou Sul)
- * @var longitude                     longitude absoluta
- * @var direction2                    direção da longitude (Leste ou Oeste)
- * @var speed                         velocidae fornecida em knots (equivalente a 1.853km/h)
- * @var course                        angulo de movimentacao
- * @var data                          data no formato: ddmmaa
- * @var magnetcVariationValue         
- * @var magnetcVariationIndicator
- * @var mode
- * @var checksum                      soma de verificação (usado para checar a validade dos dados)
- *----------------------------------------------------------------------------------------------------------------------
- */
-typedef struct {
-    char protocol[8];
-    double time;
-    char valid;
-    double latitude;
-    char direction1;
-    double longitude;
-    char direction2;
-    double speed;
-    double course;
-    char date[7];
-    double magnetcVariationValue;
-    char magnetcVariationIndicator;
-    char mode;
-    char checksum[5];
-} dataGPS;
-
-/**
- *----------------------------------------------------------------------------------------------------------------------
- * Protótipo das funções
- *----------------------------------------------------------------------------------------------------------------------
- */
-
-/**
- *----------------------------------------------------------------------------------------------------------------------
- * @brief Verifica se o a string passada corresponde a "$GPRMC". Se for igual,
- *        é chamado um procedimento para a aquisição dos dados; caso contrário,
- *        a função apenas retorna para o ponto onde foi chamada.
- *
- * @param cmd           ponteiro para a string de dados obtida do GPS   
- * @param i             tamanho da string obtida (cmd)
- * @param data          ponteiro para a struct ao qual os dados serão armazenados    
- *
- * @return                      Não retorna nada, apenas
- *                              adiciona os valores lidos a 
- *                              estrutura apontada pelo ponteiro data.
- *----------------------------------------------------------------------------------------------------------------------
- */
-void parse (char *cmd, int n, dataGPS *data);
-
-/**
-*----------------------------------------------------------------------------------------------------------------------
-* @brief Procedimento utilizado para invocar cada um das funções que irão de fato
-*        obter os dados fornecidos pelo GPS. São utilizadas duas variáveis 'i' e 'j'
-*        como uma maneira para se obter cada um dos dados.
-*
-* @param mensagem      ponteiro para a string de dados obtida do GPS    
-* @param data          ponteiro para a struct ao qual os dados serão armazenados    
-*
-* @return                      Não retorna nada, apenas
-*                              invoca cada um dos procedimentos
-*                              para a aquisição dos dados.
-*----------------------------------------------------------------------------------------------------------------------
-*/
-void dataCatch (char *mensagem, dataGPS *data);
-
-/**
-*----------------------------------------------------------------------------------------------------------------------
-* @brief Reseta a estrutura para a aquisição dos dados mais atualizados
-*
-* @param data          ponteiro para a struct ao qual os dados serão resetados  
-*
-* @return                      Não retorna nada, apenas
-*                              reseta a estrutura apontada 
-*                              pelo ponteiro data.
-*----------------------------------------------------------------------------------------------------------------------
-*/
-void reset (dataGPS *data);
-
-/**
-*----------------------------------------------------------------------------------------------------------------------
-* @brief Pega o protocolo fornecido pelo GPS (nesse programa em específico, apenas $GPRMC)
-*        armazenado no vetor apontado por input
-*
-* @param input         ponteiro para a string de dados obtida do GPS   
-* @param pivot         utilizado para indicar qual parâmetro está sendo obtido
-* @param data          ponteiro para a struct ao qual os dados serão armazenados    
-*
-* @return                      Não retorna nada, apenas
-*                              adiciona o protocolo obtido de 'input' 
-*                              a estrutura apontada pelo ponteiro data.
-*----------------------------------------------------------------------------------------------------------------------
-*/
-int getProtocol (char *input, int pivot, dataGPS *data);
-
-/**
-*----------------------------------------------------------------------------------------------------------------------
-* @brief Pega o tempo armazenado no vetor apontado por input
-*
-* @param input         ponteiro para a string de dados obtida do GPS   
-* @param pivot         utilizado para indicar qual parâmetro está sendo obtido
-* @param data          ponteiro para a struct ao qual os dados serão armazenados    
-*
-* @return                      Não retorna nada, apenas
-*                              adiciona os valores de tempo a  
-*                              estrutura apontada pelo ponteiro data.
-*----------------------------------------------------------------------------------------------------------------------
-*/
-int getTime (char input, int pivot, dataGPS *data);
-
-/**
-*----------------------------------------------------------------------------------------------------------------------
-* @brief Pega o caractere que indica a validade dos dados (V ou A)
-*
-* @param input         ponteiro para a string de dados obtida do GPS   
-* @param pivot         utilizado para indicar qual parâmetro está sendo obtido
-* @param data          ponteiro para a struct ao qual os dados serão armazenados    
-*
-* @return                      Não retorna nada, apenas
-*                              adiciona o caractere de validade a
-*                              estrutura apontada pelo ponteiro data.
-*----------------------------------------------------------------------------------------------------------------------
-*/
-int getValid (char input, int pivot, dataGPS *data);
-
-/**
-*----------------------------------------------------------------------------------------------------------------------
-* @brief Pega a latitude armazenada no vetor apontado por input
-*
-* @param input         ponteiro para a string de dados obitda do GPS   
-* @param pivot         utilizado para indicar qual parâmetro está sendo obtido
-* @param data          ponteiro para a struct ao qual os dados serão armazenados    
-*
-* @return                      Não retorna nada, apenas
-*                              adiciona o valor da latitude a
-*                              estrutura apontada pelo ponteiro data.
-*----------------------------------------------------------------------------------------------------------------------
-*/
-int getLatitude (char input, int pivot, dataGPS *data);
-
-/**
-*----------------------------------------------------------------------------------------------------------------------
-* @brief Pega a direção da latitude (N ou S) armazenada no vetor apontado por input
-*
-* @param input         ponteiro para a string de dados obitda do GPS   
-* @param pivot         utilizado para indicar qual parâmetro está sendo obtido
-* @param data          ponteiro para a struct ao qual os dados serão armazenados     
-*
-* @return                      Não retorna nada, apenas
-*                              adiciona o valor de direção a 
-*                              estrutura apontada pelo ponteiro data.
-*----------------------------------------------------------------------------------------------------------------------
-*/
-int getDirection1 (char input, int pivot, dataGPS *data);
-
-/**
-*----------------------------------------------------------------------------------------------------------------------
-* @brief Pega a longitude armazenada no vetor apontado por input
-*
-* @param input         ponteiro para a string de dados obitda do GPS   
-* @param pivot         utilizado para indicar qual parâmetro está sendo obtido
-* @param data          ponteiro para a struct ao qual os dados serão armazenados    
-*
-* @return                      Não retorna nada, apenas
-*                              adiciona o valore da longitude a 
-*                              estrutura apontada pelo ponteiro data.
-*----------------------------------------------------------------------------------------------------------------------
-*/
-int getLongitude (char input, int pivot, dataGPS *data);
-
-/**
-*----------------------------------------------------------------------------------------------------------------------
-* @brief Pega a direção da latitude (L ou O) armazenada no vetor apontado por input
-*
-* @param input         ponteiro para a string de dados obitda do GPS   
-* @param pivot         utilizado para indicar qual parâmetro está sendo obtido
-* @param data          ponteiro para a struct ao qual os dados serão armazenados    
-*
-* @return                      Não retorna nada, apenas
-*                              adiciona o valor de direção a 
-*                              estrutura apontada pelo ponteiro data.
-*----------------------------------------------------------------------------------------------------------------------
-*/
-int getDirection2 (char input, int pivot, dataGPS *data);
-
-/**
-*----------------------------------------------------------------------------------------------------------------------
-* @brief Pega a velocidade armazenada no vetor apontado por input
-*
-* @param input         ponteiro para a string de dados obitda do GPS   
-* @param pivot         utilizado para indicar qual parâmetro está sendo obtido
-* @param data          ponteiro para a struct ao qual os dados serão armazenados   
-*
-* @return                      Não retorna nada, apenas
-*                              adiciona o valor de velocidade a 
-*                              estrutura apontada pelo ponteiro data.
-*----------------------------------------------------------------------------------------------------------------------
-*/
-int getSpeed (char input, int pivot, dataGPS *data);
-
-/**
-*----------------------------------------------------------------------------------------------------------------------
-* @brief Pega o valor do curso (angulo de movimentação) armazenada no vetor apontado por input
-*
-* @param input         ponteiro para a string de dados obitda do GPS   
-* @param pivot         utilizado para indicar qual parâmetro está sendo obtido
-* @param data          ponteiro para a struct ao qual os dados serão armazenados   
-*
-* @return                      Não retorna nada, apenas
-*                              adiciona o valor de curso a 
-*                              estrutura apontada pelo ponteiro data.
-*----------------------------------------------------------------------------------------------------------------------
-*/
-int getCourse (char input, int pivot, dataGPS *data);
-
-/**
-*----------------------------------------------------------------------------------------------------------------------
-* @brief Pega a data armazenada no vetor apontado por input
-*
-* @param input         ponteiro para a string de dados obitda do GPS   
-* @param pivot         utilizado para indicar qual parâmetro está sendo obtido
-* @param data          ponteiro para a struct ao qual os dados serão armazenados   
-*
-* @return                      Não retorna nada, apenas
-*                              adiciona os valores de data a 
-*                              estrutura apontada pelo ponteiro data.
-*----------------------------------------------------------------------------------------------------------------------
-*/
-int getDate (char input, int pivot, dataGPS *data);
-
-/**
-*----------------------------------------------------------------------------------------------------------------------
-* @brief Pega a variancia magnetica armazenada no vetor apontado por input
-*
-* @param input         ponteiro para a string de dados obitda do GPS   
-* @param pivot         utilizado para indicar qual parâmetro está sendo obtido
-* @param data          ponteiro para a struct ao qual os dados serão armazenados    
-*
-* @return                      Não retorna nada, apenas
-*                              adiciona os valores de variancia magnetica a 
-*                              estrutura apontada pelo ponteiro data.
-*----------------------------------------------------------------------------------------------------------------------
-*/
-int getMagnetcVariationValue (char input,int pivot,  dataGPS *data);
-
-/**
-*----------------------------------------------------------------------------------------------------------------------
-* @brief Pega o indicador de variancia magnetica armazenado no vetor apontado por input
-*
-* @param input         ponteiro para a string de dados obitda do GPS   
-* @param pivot         utilizado para indicar qual parâmetro está sendo obtido
-* @param data          ponteiro para a struct ao qual os dados serão armazenados    
-*
-* @return                      Não retorna nada, apenas
-*                              adiciona o indicador de variancia magnetica a 
-*                              estrutura apontada pelo ponteiro data.
-*----------------------------------------------------------------------------------------------------------------------
-*/
-int getMagnetcVariationIndicator (char input, int pivot, dataGPS *data);
-
-/**
-*----------------------------------------------------------------------------------------------------------------------
-* @brief Pega o modo armazenado no vetor apontado por input
-*
-* @param input         ponteiro para a string de dados obitda do GPS   
-* @param pivot         utilizado para indicar qual parâmetro está sendo obtido
-* @param data          ponteiro para a struct ao qual os dados serão armazenados     
-*
-* @return                      Não retorna nada, apenas
-*                              adiciona o modo a 
-*                              estrutura apontada pelo ponteiro data.
-*----------------------------------------------------------------------------------------------------------------------
-*/
-int getMode (char input, int pivot, dataGPS *data);
-
-/**
-*----------------------------------------------------------------------------------------------------------------------
-* @brief Pega a soma de verificação armazenada no vetor apontado por input
-*
-* @param input         ponteiro para a string de dados obitda do GPS   
-* @param pivot         utilizado para indicar qual parâmetro está sendo obtido
-* @param data          ponteiro para a struct ao qual os dados serão armazenados    
-*
-* @return                      Não retorna nada, apenas
-*                              adiciona os valores de CheckSum a 
-*                              estrutura apontada pelo ponteiro data.
-*----------------------------------------------------------------------------------------------------------------------
-*/
-void getChecksum (char input, int pivot, dataGPS *data);
-
-/**
-*----------------------------------------------------------------------------------------------------------------------
-* @brief Adiciona o sinal a coordenada com base na direção, uma vez que a coordenada é dada em valores absolutos
-*
-* @param data          ponteiro para a struct ao qual os dados serão armazenados    
-*
-* @return                      Não retorna nada, apenas
-*                              adiciona o sinal na longitude e latitude a 
-*                              estrutura apontada pelo ponteiro data.
-*----------------------------------------------------------------------------------------------------------------------
-*/
-void transformaCoordenada (dataGPS *data);
-
-/**
-*----------------------------------------------------------------------------------------------------------------------
-* @brief Transforma a velocidade de knots pra km/h
-*
-* @param data          ponteiro para a struct ao qual os dados serão armazenados    
-*
-* @return                      Não retorna nada, apenas
-*                              muda a unidade da velocidade na
-*                              estrutura apontada pelo ponteiro data.
-*----------------------------------------------------------------------------------------------------------------------
-*/
-void transformaSpeed (dataGPS *data);
-
-/**
-*----------------------------------------------------------------------------------------------------------------------
-* @brief Função para calcular potencia de 10
-*
-* @param val         expoente do 10    
-*
-* @return                      retorna a potencia de 10 
-*                              elevado a 'val'.
-*----------------------------------------------------------------------------------------------------------------------
-*/
-int potencia (int val);
- 
+/**
+ * GPS_Carro.h       v0.0        22-10-2019 
+ *
+ * Orientador: Elias Teodoro da Silva Junior
+ * Autores: Felipe Moura de Castro e Joao Bruno Costa Cruz,
+ * Instituto Federal de Educação, Ciência e Tecnologia do Ceará (IFCE) - Campus Fortaleza
+ *
+ * @Opensource
+ * Este código-fonte pode ser utilizado, copiado, estudado, modificado e redistribuído sem restrições.
+ *
+ * Copyright (c) 2019, Felipe Moura de Castro e Joao Bruno Costa Cruz.
+ *
+ */
+ 
+#ifndef _GPS_CARRO_H_
+#define _GPS_CARRO_H_
+ 
+#include "mbed.h"
+#include "FilaCarro/filaCarro.h"
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * @brief   Definição da estrutura para armazenar os dados oriundos do GPS
+ *          Cada estrutura corresponde a uma época (um instante UTC): os dados do $GPRMC são
+ *          complementados pelos do $GPGGA, $GPGSA, $GPVTG e $GPGSV da mesma época (ou pelos
+ *          equivalentes $GN.. de receptores multi-constelação).
+ *          Os protocolos podem ser vistos no seguinte endereço:
+ *              https://os.mbed.com/users/edodm85/notebook/gps-u-blox-neo-6m/
+ *
+ *          Todos os valores numéricos são inteiros em ponto fixo (o Cortex-M4F só tem
+ *          FPU de precisão simples, então double seria emulado em software).
+ *
+ * @var protocol                      protocolo (GPGGA, GPGSA, GPGLL, GPRMC)
+ * @var time                          tempo UTC no formato hhmmss (o horário local é obtido pelo TempoCarro)
+ * @var millisecond                   milissegundos do tempo UTC (fixes acima de 1 Hz)
+ * @var valid                         validade dos dados fornecidos pelo GPS (Semelhante ao CheckSum)
+ * @var latitude                      latitude em graus * 10^7 (negativa ao Sul)
+ * @var getDirection1                 direção da latitude (Norte ou Sul)
+ * @var longitude                     longitude em graus * 10^7 (negativa a Oeste)
+ * @var direction2                    direção da longitude (Leste ou Oeste)
+ * @var speed                         velocidade em mm/s
+ * @var course                        angulo de movimentacao em graus * 10^2
+ * @var data                          data no formato: ddmmaa
+ * @var magnetcVariationValue         variação magnética em graus * 10
+ * @var magnetcVariationIndicator
+ * @var mode
+ * @var checksum                      soma de verificação (usado para checar a validade dos dados)
+ * @var altitude                      altitude em relação ao nível médio do mar em mm (GGA)
+ * @var hdop, pdop, vdop              diluições de precisão horizontal, 3D e vertical * 10^2 (GGA/GSA; 0 = desconhecida)
+ * @var fixQuality                    qualidade do fix (GGA: 0 = sem fix, 1 = GPS, 2 = DGPS, 6 = estimado)
+ * @var fixType                       tipo do fix (GSA: 1 = sem fix, 2 = 2D, 3 = 3D)
+ * @var satellites                    satélites utilizados no fix (GGA)
+ * @var satellitesInView              satélites visíveis, somando todas as constelações (GSV)
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+typedef struct {
+    int32_t time;
+    int32_t latitude;
+    int32_t longitude;
+    int32_t speed;
+    uint16_t course;
+    int16_t magnetcVariationValue;
+    char protocol[8];
+    char date[7];
+    char valid;
+    char direction1;
+    char direction2;
+    char magnetcVariationIndicator;
+    char mode;
+    char checksum[5];
+    int32_t altitude;
+    uint16_t hdop;
+    uint16_t pdop;
+    uint16_t vdop;
+    uint8_t fixQuality;
+    uint8_t fixType;
+    uint8_t satellites;
+    uint8_t satellitesInView;
+    uint16_t millisecond;
+} dataGPS;
+
+/**
+ * Conversão da velocidade em mm/s para km/h * 10^4 (1 mm/s = 0,0036 km/h)
+ */
+#define MM_S_PARA_KMH_E4(v)     ((v) * 36)
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * @brief   Publicador do fix mais recente do GPS (sequence lock)
+ *          Um único escritor (a Thread do GPS) nunca bloqueia: incrementa a sequência
+ *          (ímpar = escrita em andamento), copia o fix e incrementa de novo. Os leitores
+ *          copiam o fix e repetem a cópia se a sequência mudou ou estava ímpar, obtendo
+ *          sempre um fix consistente em poucos ciclos, sem semáforo.
+ *
+ * @var sequencia                     contador de escritas (par quando não há escrita em andamento)
+ * @var dados                         fix mais recente publicado
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+typedef struct {
+    volatile uint32_t sequencia;
+    dataGPS dados;
+} publicadorGPS;
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * Tamanho máximo de uma sentença NMEA armazenada (o padrão limita a 82 caracteres,
+ * incluindo '$' e "\r\n")
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+#define TAMANHO_SENTENCA_GPS 100
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * @brief   Contadores de sentenças recebidas do GPS
+ *          Permitem distinguir ruído na linha (rejeitadas) de perda de bytes por
+ *          sobrecarga da CPU ou do buffer (truncadas).
+ *
+ * @var aceitas                       sentenças com soma de verificação correta
+ * @var rejeitadas                    sentenças com soma de verificação incorreta ou malformada
+ * @var truncadas                     sentenças interrompidas (sem '*', novo '$' no meio ou maiores que o buffer)
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+typedef struct {
+    uint32_t aceitas;
+    uint32_t rejeitadas;
+    uint32_t truncadas;
+} estatisticasGPS;
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * @brief   Estrutura para montar uma sentença NMEA a partir dos bytes recebidos um a um
+ *          A soma de verificação (XOR de todos os bytes entre '$' e '*') é calculada
+ *          à medida que os bytes chegam, de forma que a sentença pode ser descartada
+ *          antes de qualquer decodificação.
+ *
+ * @var sentenca                      sentença sem o '$' inicial, terminada com '\0' (inclui "*hh")
+ * @var tamanho                       quantidade de caracteres em sentenca
+ * @var checksum                      XOR calculado até o momento
+ * @var checksumRecebido              valor hexadecimal lido após o '*'
+ * @var estado                        etapa atual da montagem
+ * @var estatisticas                  contadores de sentenças aceitas, rejeitadas e truncadas
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+typedef struct {
+    char sentenca[TAMANHO_SENTENCA_GPS];
+    int tamanho;
+    uint8_t checksum;
+    uint8_t checksumRecebido;
+    uint8_t estado;
+    estatisticasGPS estatisticas;
+} montadorNMEA;
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * Tamanho do buffer circular de recepção do GPS (deve ser potência de 2).
+ * 512 bytes equivalem a ~44 ms de recepção contínua a 115200 baud.
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+#define TAMANHO_BUFFER_GPS 512
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * @brief   Buffer circular de bytes recebidos do GPS (filaCarro), com um único produtor (a interrupção de
+ *          recepção da UART) e um único consumidor (a Thread do GPS)
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+typedef filaCarro<uint8_t, TAMANHO_BUFFER_GPS> bufferCircularGPS;
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * Protocolo binário UBX (u-blox)
+ *
+ * Quadro: 0xB5 0x62 | classe | id | tamanho (2 bytes, little-endian) | payload | CK_A CK_B
+ * A soma de verificação (Fletcher de 8 bits) cobre classe, id, tamanho e payload.
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+#define UBX_SINCRONISMO_1       0xB5
+#define UBX_SINCRONISMO_2       0x62
+
+#define UBX_CLASSE_NAV          0x01
+#define UBX_CLASSE_ACK          0x05
+#define UBX_CLASSE_CFG          0x06
+#define UBX_CLASSE_AID          0x0B
+#define UBX_CLASSE_NMEA         0xF0
+
+#define UBX_NAV_POSLLH          0x02    // posição geodésica
+#define UBX_NAV_STATUS          0x03    // tipo e validade do fix
+#define UBX_NAV_DOP             0x04    // diluição da precisão (HDOP, PDOP e VDOP)
+#define UBX_NAV_SOL             0x06    // solução de navegação (satélites utilizados)
+#define UBX_NAV_PVT             0x07    // posição, velocidade e tempo (receptores u-blox 7 em diante)
+#define UBX_NAV_VELNED          0x12    // velocidade em relação ao solo e curso
+#define UBX_NAV_TIMEUTC         0x21    // data e hora UTC
+
+#define UBX_ACK_NAK             0x00
+#define UBX_ACK_ACK             0x01
+
+#define UBX_CFG_PRT             0x00
+#define UBX_CFG_MSG             0x01
+#define UBX_CFG_RATE            0x08
+
+#define UBX_AID_INI             0x01    // posição e tempo aproximados para a partida
+
+#define TAMANHO_PAYLOAD_UBX     100     // maior mensagem decodificada: NAV-PVT (92 bytes)
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * @brief   Estrutura para decodificar quadros UBX a partir dos bytes recebidos um a um
+ *          A soma de verificação é calculada à medida que os bytes chegam. As mensagens
+ *          NAV de uma mesma época (mesmo iTOW) são acumuladas em 'partes' até que o fix
+ *          esteja completo.
+ *
+ * @var classe                        classe da mensagem em decodificação
+ * @var id                            identificador da mensagem em decodificação
+ * @var tamanho                       tamanho do payload informado no quadro
+ * @var payload                       payload recebido
+ * @var posicao                       quantidade de bytes do payload já recebidos
+ * @var ckA, ckB                      soma de verificação calculada até o momento
+ * @var estado                        etapa atual da decodificação
+ * @var iTOW                          tempo da semana GPS (ms) da época em montagem
+ * @var partes                        mensagens NAV já recebidas na época em montagem
+ * @var estatisticas                  contadores de quadros aceitos, rejeitados e truncados
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+typedef struct {
+    uint8_t classe;
+    uint8_t id;
+    uint16_t tamanho;
+    uint8_t payload[TAMANHO_PAYLOAD_UBX];
+    uint16_t posicao;
+    uint8_t ckA;
+    uint8_t ckB;
+    uint8_t estado;
+    uint32_t iTOW;
+    uint8_t partes;
+    estatisticasGPS estatisticas;
+} decodificadorUBX;
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * @brief   Delimitador de quadros UBX usado pela interrupção de recepção
+ *          Apenas conta os bytes de cada quadro (sem conferir a soma) para saber quando
+ *          um quadro termina e a Thread do GPS deve ser acordada.
+ *
+ * @var estado                        etapa atual (sincronismo, cabeçalho ou payload)
+ * @var restante                      bytes restantes do quadro atual
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+typedef struct {
+    uint8_t estado;
+    uint16_t restante;
+} delimitadorUBX;
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * @brief   Fusão das sentenças NMEA de uma mesma época
+ *          Cada sentença decodificada é acumulada em 'epoca'. A época termina quando chega
+ *          uma sentença com outro tempo UTC ou, antes disso, quando chega a sentença que
+ *          encerrou a época anterior (o receptor repete a mesma ordem a cada época, sempre
+ *          começando por RMC ou GGA), de forma que o fix é entregue uma única vez por época
+ *          e sem esperar a próxima.
+ *
+ * @var epoca                         fix em montagem
+ * @var tempoDaEpoca                  tempo UTC da época em montagem (hhmmss * 10^2)
+ * @var temTempo                      indica se alguma sentença da época já informou o tempo
+ * @var partes                        sentenças já recebidas na época (PARTE_NMEA_*)
+ * @var ultima                        identificação (talker + tipo) da última sentença recebida
+ * @var terminadora                   identificação da sentença que encerrou a época anterior
+ * @var encerradaPelaTerminadora      indica que a última época foi entregue ao receber a terminadora
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+#define PARTE_NMEA_RMC          0x01
+#define PARTE_NMEA_GGA          0x02
+#define PARTE_NMEA_GSA          0x04
+#define PARTE_NMEA_VTG          0x08
+#define PARTE_NMEA_GSV          0x10
+
+typedef struct {
+    dataGPS epoca;
+    int32_t tempoDaEpoca;
+    bool temTempo;
+    uint8_t partes;
+    char ultima[6];
+    char terminadora[6];
+    bool encerradaPelaTerminadora;
+} fusaoNMEA;
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * @brief   Simplificador do trajeto (interseção de cones)
+ *          Mantém apenas os fixes necessários para que nenhum fix descartado fique a mais de
+ *          'erroMaximo' metros do segmento entre dois fixes mantidos. A partir da âncora (último
+ *          fix mantido), cada fix restringe o cone de direções que o segmento ainda pode ter;
+ *          quando um fix cai fora do cone, o fix anterior é mantido e passa a ser a nova âncora.
+ *          O fim do segmento nunca fica mais perto da âncora que um fix descartado, de forma que
+ *          o desvio vale para o segmento e não só para a reta. Usa memória e tempo constantes por
+ *          fix. Fixes a menos de 'erroMaximo' da âncora (carro parado) não geram novos pontos.
+ *
+ * @var erroMaximo                    desvio máximo permitido (m)
+ * @var ancora                        último fix mantido
+ * @var candidato                     último fix recebido (fim provisório do segmento)
+ * @var metrosPorUnidadeLeste         metros por 10^-7 graus de longitude na latitude da âncora
+ * @var direcao                       direção de referência do cone (rad, a partir do Norte)
+ * @var coneMinimo, coneMaximo        limites do cone em relação à direção de referência (rad)
+ * @var distanciaMaxima               maior distância entre a âncora e um fix do segmento (m)
+ * @var temAncora                     indica se há um segmento em andamento
+ * @var temCandidato                  indica se há um fix ainda não mantido
+ * @var coneAberto                    indica se algum fix já se afastou mais de erroMaximo da âncora
+ * @var recebidos                     fixes recebidos (taxa de compressão = mantidos / recebidos)
+ * @var mantidos                      fixes mantidos
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+typedef struct {
+    float erroMaximo;
+    dataGPS ancora;
+    dataGPS candidato;
+    float metrosPorUnidadeLeste;
+    float direcao;
+    float coneMinimo;
+    float coneMaximo;
+    float distanciaMaxima;
+    bool temAncora;
+    bool temCandidato;
+    bool coneAberto;
+    uint32_t recebidos;
+    uint32_t mantidos;
+} simplificadorGPS;
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * Tamanho da fila de fixes entre a Thread do GPS e um consumidor (deve ser potência de 2)
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+#define TAMANHO_FILA_GPS 8
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * @brief   Fila de fixes (filaCarro) com um único produtor e um único consumidor
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+typedef filaCarro<dataGPS, TAMANHO_FILA_GPS> filaGPS;
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * @brief   Medidas de desempenho da aquisição do GPS (contadores crescentes; a taxa é
+ *          obtida pela diferença entre duas leituras)
+ *
+ * @var fixes                         fixes completos decodificados
+ * @var bytes                         bytes retirados do buffer de recepção
+ * @var tempoDeProcessamentoUs        tempo de CPU gasto decodificando (microssegundos)
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+typedef struct {
+    volatile uint32_t fixes;
+    volatile uint32_t bytes;
+    volatile uint32_t tempoDeProcessamentoUs;
+} desempenhoGPS;
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * Protótipo das funções
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * @brief Verifica se o a string passada corresponde a um "$GPRMC" (ou "$GNRMC"). Se for igual,
+ *        é chamado um procedimento para a aquisição dos dados; caso contrário,
+ *        a função apenas retorna para o ponto onde foi chamada.
+ *
+ * @param cmd           ponteiro para a string de dados obtida do GPS   
+ * @param i             tamanho da string obtida (cmd)
+ * @param data          ponteiro para a struct ao qual os dados serão armazenados    
+ *
+ * @return                      1 se a sentença era um "$GPRMC" e os valores lidos
+ *                              foram adicionados a estrutura apontada pelo ponteiro
+ *                              data; 0 caso contrário.
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+int parse (char *cmd, int n, dataGPS *data);
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * @brief Inicializa a fusão de sentenças NMEA
+ *
+ * @param fusao         ponteiro para a estrutura de fusão
+ *
+ * @return                      Não retorna nada.
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+void iniciaFusaoNMEA (fusaoNMEA *fusao);
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * @brief Decodifica uma sentença RMC, GGA, GSA, VTG ou GSV (de qualquer talker: GP, GN, GL...)
+ *        e a acumula na época em montagem. Outras sentenças são ignoradas.
+ *
+ * @param fusao         ponteiro para a estrutura de fusão
+ * @param cmd           sentença sem o '$' (com a soma de verificação já conferida)
+ * @param n             tamanho da sentença
+ * @param data          ponteiro para a struct que recebe a época concluída
+ *
+ * @return                      1 se uma época foi concluída e copiada para data; 0 caso contrário.
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+int fundeNMEA (fusaoNMEA *fusao, char *cmd, int n, dataGPS *data);
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * @brief Verifica se um fix é válido e confiável o suficiente para ser gravado ou enviado
+ *
+ * @param data          fix a ser verificado
+ * @param hdopMaximo    maior HDOP aceito * 10^2 (fixes NMEA sem HDOP conhecido, só com o RMC, não são
+ *                      descartados por ele; fixes UBX sem HDOP são descartados)
+ *
+ * @return                      1 se o fix é válido e o HDOP não excede o limite; 0 caso contrário.
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+int fixConfiavel (const dataGPS *data, uint16_t hdopMaximo);
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * @brief Inicializa o simplificador do trajeto
+ *
+ * @param simplificador ponteiro para o simplificador
+ * @param erroMaximo    desvio máximo permitido entre o trajeto simplificado e os fixes (m)
+ *
+ * @return                      Não retorna nada.
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+void iniciaSimplificador (simplificadorGPS *simplificador, float erroMaximo);
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * @brief Recebe um fix e decide se um ponto do trajeto simplificado deve ser mantido.
+ *        Um fix inválido encerra o segmento atual (o último fix válido é mantido) e o próximo
+ *        fix válido inicia um novo trajeto.
+ *
+ * @param simplificador ponteiro para o simplificador
+ * @param fix           fix recebido
+ * @param mantido       ponteiro para a struct que recebe o ponto mantido
+ *
+ * @return                      1 se um ponto foi mantido e copiado para mantido; 0 caso contrário.
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+int simplificaGPS (simplificadorGPS *simplificador, const dataGPS *fix, dataGPS *mantido);
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * @brief Publica um novo fix. Deve ser chamada apenas pelo escritor (Thread do GPS).
+ *
+ * @param publicador    ponteiro para o publicador
+ * @param data          fix a ser publicado
+ *
+ * @return                      Não retorna nada.
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+void publicaGPS (publicadorGPS *publicador, const dataGPS *data);
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * @brief Copia o fix mais recente publicado, garantindo que a cópia não foi feita
+ *        durante uma escrita (sem leituras "rasgadas").
+ *
+ * @param publicador    ponteiro para o publicador
+ * @param data          ponteiro para a struct que receberá a cópia
+ *
+ * @return                      quantidade de fixes publicados até a cópia (permite
+ *                              ao leitor saber se há um fix novo desde a última leitura).
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+uint32_t leGPS (const publicadorGPS *publicador, dataGPS *data);
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * @brief Inicializa o montador de sentenças (estado e contadores zerados)
+ *
+ * @param montador      ponteiro para o montador a ser inicializado
+ *
+ * @return                      Não retorna nada.
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+void iniciaMontador (montadorNMEA *montador);
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * @brief Entrega um byte recebido do GPS ao montador de sentenças. O XOR é atualizado
+ *        a cada byte e, ao receber os dois dígitos após o '*', a soma é conferida.
+ *        Sentenças com soma incorreta ou truncadas são descartadas e contabilizadas.
+ *
+ * @param montador      ponteiro para o montador
+ * @param c             byte recebido do GPS
+ *
+ * @return                      1 se uma sentença válida acabou de ser montada
+ *                              (disponível em montador->sentenca, com montador->tamanho
+ *                              caracteres); 0 caso contrário.
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+int montaSentenca (montadorNMEA *montador, char c);
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * @brief Inicializa o decodificador UBX (estado e contadores zerados)
+ *
+ * @param decodificador ponteiro para o decodificador a ser inicializado
+ *
+ * @return                      Não retorna nada.
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+void iniciaDecodificadorUBX (decodificadorUBX *decodificador);
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * @brief Entrega um byte recebido do GPS ao decodificador UBX
+ *
+ * @param decodificador ponteiro para o decodificador
+ * @param c             byte recebido do GPS
+ *
+ * @return                      -1 se o byte não pertence a um quadro UBX (pode ser
+ *                              entregue ao montador NMEA); 0 se o quadro está em
+ *                              andamento ou foi descartado; 1 se um quadro válido
+ *                              acabou de ser recebido.
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+int decodificaUBX (decodificadorUBX *decodificador, uint8_t c);
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * @brief Interpreta o último quadro recebido pelo decodificador e preenche a estrutura
+ *        dataGPS diretamente a partir dos campos binários (little-endian).
+ *        São tratadas as mensagens NAV-PVT (u-blox 7 em diante) e, para o NEO-6M,
+ *        NAV-POSLLH, NAV-STATUS, NAV-VELNED e NAV-TIMEUTC, além de NAV-DOP (HDOP, PDOP e
+ *        VDOP) e NAV-SOL (satélites utilizados), que o NAV-PVT também precisa por não ter o HDOP.
+ *
+ * @param decodificador ponteiro para o decodificador com um quadro válido
+ * @param data          ponteiro para a struct ao qual os dados serão armazenados
+ *
+ * @return                      1 quando o fix da época está completo (NAV-PVT e NAV-DOP, ou
+ *                              as seis mensagens do NEO-6M com o mesmo iTOW); 0 caso contrário.
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+int interpretaUBX (decodificadorUBX *decodificador, dataGPS *data);
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * @brief Monta um quadro UBX completo (sincronismo, cabeçalho, payload e soma de verificação)
+ *
+ * @param classe        classe da mensagem
+ * @param id            identificador da mensagem
+ * @param payload       ponteiro para o payload (pode ser NULL se tamanho for 0)
+ * @param tamanho       tamanho do payload
+ * @param saida         vetor onde o quadro será escrito (no mínimo tamanho + 8 bytes)
+ *
+ * @return                      quantidade de bytes escritos em saida.
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+int montaMensagemUBX (uint8_t classe, uint8_t id, const uint8_t *payload, uint16_t tamanho, uint8_t *saida);
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * @brief Acompanha os bytes recebidos pela interrupção para detectar o fim de um quadro UBX
+ *
+ * @param delimitador   ponteiro para o delimitador (inicializado com zeros)
+ * @param c             byte recebido do GPS
+ *
+ * @return                      1 se o byte é o último de um quadro UBX; 0 caso contrário.
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+int fimDeQuadroUBX (delimitadorUBX *delimitador, uint8_t c);
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * @brief Configura o receptor para o modo UBX: desliga as sentenças NMEA (GGA, GLL, GSA,
+ *        GSV, RMC e VTG) e liga NAV-POSLLH, NAV-STATUS, NAV-DOP, NAV-SOL, NAV-VELNED e
+ *        NAV-TIMEUTC a cada solução. Reduz de ~450 bytes ASCII para ~220 bytes binários por fix.
+ *
+ * @param serial        porta serial conectada ao GPS
+ *
+ * @return                      Não retorna nada.
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+void configuraModoUBX (RawSerial *serial);
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * @brief Aguarda a confirmação (UBX-ACK-ACK) de um comando de configuração, lendo a serial
+ *        diretamente. Deve ser usada antes de a interrupção de recepção ser ligada.
+ *
+ * @param serial        porta serial conectada ao GPS
+ * @param classe        classe do comando enviado
+ * @param id            identificador do comando enviado
+ * @param limiteMs      tempo máximo de espera (ms)
+ *
+ * @return                      1 se o comando foi confirmado; 0 se foi recusado
+ *                              (ACK-NAK) ou se o tempo se esgotou.
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+int esperaConfirmacaoUBX (RawSerial *serial, uint8_t classe, uint8_t id, int limiteMs);
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * @brief Negocia com o receptor uma taxa de comunicação e uma taxa de fixes maiores
+ *        (UBX-CFG-PRT e UBX-CFG-RATE). A nova configuração só é aceita se o CFG-RATE
+ *        for confirmado já na nova taxa de comunicação. Sem confirmação, o CFG-RATE é
+ *        enviado mais uma vez em baudNovo (receptor que já estava nela, como após um
+ *        reset só do microcontrolador); só se as duas tentativas falharem o receptor e
+ *        a serial voltam para a taxa original com 1 fix por segundo.
+ *
+ *        Obs.: o NEO-6M aceita no máximo 5 Hz (200 ms); receptores mais novos chegam a 10 Hz.
+ *
+ * @param serial        porta serial conectada ao GPS
+ * @param baudAtual     taxa de comunicação atual do receptor
+ * @param baudNovo      taxa de comunicação desejada (ex.: 115200)
+ * @param periodoMs     intervalo entre fixes desejado (ex.: 200 para 5 Hz)
+ *
+ * @return                      1 se a nova configuração foi confirmada; 0 se foi
+ *                              necessário voltar para a configuração original.
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+int configuraTaxaGPS (RawSerial *serial, int baudAtual, int baudNovo, uint16_t periodoMs);
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * @brief Informa ao receptor a posição e o tempo aproximados (UBX-AID-INI), para que ele procure
+ *        apenas os satélites visíveis daquele lugar e horário e chegue ao primeiro fix mais cedo.
+ *        Funciona tanto no modo UBX quanto no NMEA (a entrada UBX fica sempre ligada).
+ *
+ * @param serial        porta serial conectada ao GPS
+ * @param referencia    latitude, longitude e altitude aproximadas (ignoradas se latitude e longitude
+ *                      forem 0) e data (ddmmaa) e hora (hhmmss, UTC) aproximadas (ignoradas se date
+ *                      estiver vazia)
+ * @param precisaoPosicaoCm   incerteza da posição (cm)
+ * @param precisaoTempoMs     incerteza do tempo (ms)
+ *
+ * @return                      Não retorna nada.
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+void enviaPartidaUBX (RawSerial *serial, const dataGPS *referencia, uint32_t precisaoPosicaoCm, uint32_t precisaoTempoMs);
+
+/**
+*----------------------------------------------------------------------------------------------------------------------
+* @brief Procedimento utilizado para obter os dados fornecidos pelo GPS. A sentença é
+*        percorrida uma única vez: cada vírgula encerra um campo e o campo seguinte é
+*        decodificado a partir dali. Os campos numéricos são lidos como inteiros em
+*        ponto fixo, sem aritmética em double por caractere.
+*
+* @param mensagem      ponteiro para a string de dados obtida do GPS
+* @param n             tamanho da string obtida (a leitura nunca passa desse limite)
+* @param data          ponteiro para a struct ao qual os dados serão armazenados
+*
+* @return                      Não retorna nada, apenas
+*                              adiciona os valores lidos a
+*                              estrutura apontada pelo ponteiro data.
+*----------------------------------------------------------------------------------------------------------------------
+*/
+void dataCatch (char *mensagem, int n, dataGPS *data);
+
+/**
+*----------------------------------------------------------------------------------------------------------------------
+* @brief Reseta a estrutura para a aquisição dos dados mais atualizados
+*
+* @param data          ponteiro para a struct ao qual os dados serão resetados
+*
+* @return                      Não retorna nada, apenas
+*                              reseta a estrutura apontada
+*                              pelo ponteiro data.
+*----------------------------------------------------------------------------------------------------------------------
+*/
+void reset (dataGPS *data);
+
+/**
+*----------------------------------------------------------------------------------------------------------------------
+* @brief Converte a coordenada do formato NMEA (graus e minutos) para graus, com o sinal
+*        dado pela direção, uma vez que a coordenada é fornecida em valores absolutos
+*
+* @param grausMinutos  coordenada no formato ddmm.mmmmm (ou dddmm.mmmmm) multiplicada por 10^5
+* @param direcao       direção da coordenada ('N', 'S', 'E' ou 'W')
+*
+* @return                      coordenada em graus multiplicada por 10^7
+*                              (negativa para 'S' e 'W').
+*----------------------------------------------------------------------------------------------------------------------
+*/
+int32_t transformaCoordenada (int32_t grausMinutos, char direcao);
+
+/**
+*----------------------------------------------------------------------------------------------------------------------
+* @brief Transforma a velocidade de knots pra mm/s (1 knot = 1852 m/h)
+*
+* @param velocidade    velocidade em knots multiplicada por 10^3
+*
+* @return                      velocidade em mm/s.
+*----------------------------------------------------------------------------------------------------------------------
+*/
+int32_t transformaSpeed (int32_t velocidade);
+
+/**
+*----------------------------------------------------------------------------------------------------------------------
+* @brief Escreve um valor em ponto fixo como texto decimal, sem usar ponto flutuante.
+*        O valor é arredondado para a quantidade de casas impressas.
+*        Ex.: formataDecimal (s, 10, -37345678, 7, 6) -> "-3.734568" (9 caracteres e o terminador)
+*
+* @param saida         vetor onde o texto será escrito
+* @param tamanho       tamanho do vetor saida
+* @param valor         valor em ponto fixo
+* @param casasDoValor  casas decimais representadas em valor (valor = número * 10^casasDoValor)
+* @param casas         casas decimais a serem impressas (no máximo casasDoValor e 9)
+*
+* @return                      ponteiro para saida (para uso direto em printf).
+*----------------------------------------------------------------------------------------------------------------------
+*/
+char *formataDecimal (char *saida, int tamanho, int32_t valor, int casasDoValor, int casas);
+
 #endif /*_GPS_CARRO_H_*/
\ No newline at end of file
@@ -0,0 +1,130 @@
+/**
+ * imuCarro.cpp       v0.0        17-10-2026
+ *
+ * Orientador: Elias Teodoro da Silva Junior
+ * Autores: Felipe Moura de Castro e Joao Bruno Costa Cruz,
+ * Instituto Federal de Educação, Ciência e Tecnologia do Ceará (IFCE) - Campus Fortaleza
+ *
+ * @Opensource
+ * Este código-fonte pode ser utilizado, copiado, estudado, modificado e redistribuído sem restrições.
+ *
+ * Copyright (c) 2019, Felipe Moura de Castro e Joao Bruno Costa Cruz.
+ *
+ */
+
+#include "imuCarro.h"
+
+
+void iniciaColetor (coletorIMU *coletor, MPU6050 *mpu, barramentoI2C *barramento, clienteI2C *cliente, filaIMU *fila,
+                    desempenhoIMU *desempenho) {
+    coletor->mpu = mpu;
+    coletor->barramento = barramento;
+    coletor->cliente = cliente;
+    coletor->fila = fila;
+    coletor->desempenho = desempenho;
+    memset (desempenho, 0, sizeof (desempenhoIMU));
+#if DEVICE_I2C_ASYNCH
+    coletor->eventos.clear (IMU_FIM_DA_LEITURA);
+    coletor->cronometro.start ();
+#endif
+}
+
+bool contaAmostraPronta (volatile uint32_t *sinalizadas, uint32_t marca) {
+    if (++(*sinalizadas) >= marca) {
+        *sinalizadas = 0;
+        return true;
+    }
+    return false;
+}
+
+// Leituras bloqueantes em rajada; o barramento é liberado entre as rajadas
+static int esvaziaFifoBloqueante (coletorIMU *coletor) {
+    MPU6050Motion6 amostras[MPU6050_FIFO_BURST];
+    int i, n, total = 0;
+
+    do {
+        obtemBarramento (coletor->barramento, coletor->cliente);
+        n = coletor->mpu->readFifoMotion6 (amostras, MPU6050_FIFO_BURST);
+        liberaBarramento (coletor->barramento, coletor->cliente);
+        if (n < 0) {
+            coletor->desempenho->estourosFIFO++;
+            return total > 0 ? total : -1;
+        }
+        coletor->desempenho->leituras++;
+        coletor->desempenho->amostras += n;
+        for (i = 0; i < n; i++) {
+            insereNaFila (coletor->fila, &amostras[i]);
+        }
+        total += n;
+    } while (n == MPU6050_FIFO_BURST);
+    return total;
+}
+
+#if DEVICE_I2C_ASYNCH
+// Callback do transfer (contexto de interrupção): só guarda o evento e acorda a Thread de coleta
+static void fimDaLeituraIMU (coletorIMU *coletor, int evento) {
+    coletor->resultado = evento;
+    coletor->eventos.set (IMU_FIM_DA_LEITURA);
+}
+#endif
+
+int esvaziaFifoIMU (coletorIMU *coletor) {
+#if DEVICE_I2C_ASYNCH
+    MPU6050Motion6 amostra;
+    desempenhoIMU *desempenho = coletor->desempenho;
+    int i, n, atual = 0, rajada, decodificar = 0, total = 0;
+    bool bloqueante = false;
+    uint32_t inicio;
+
+    obtemBarramento (coletor->barramento, coletor->cliente);
+    n = coletor->mpu->getFifoCount ();
+    if (n > (MPU6050_FIFO_SIZE / MPU6050_MOTION6_LENGTH) * MPU6050_MOTION6_LENGTH) {
+        // FIFO estourada: as amostras não estão mais alinhadas
+        coletor->mpu->resetFifo ();
+        liberaBarramento (coletor->barramento, coletor->cliente);
+        desempenho->estourosFIFO++;
+        return -1;
+    }
+    n /= MPU6050_MOTION6_LENGTH;
+    while (n > 0 || decodificar > 0) {
+        rajada = n > MPU6050_FIFO_BURST ? MPU6050_FIFO_BURST : n;
+        if (rajada > 0 &&
+            coletor->mpu->startFifoRead (coletor->rajadas[atual], rajada, callback (fimDaLeituraIMU, coletor)) != 0) {
+            bloqueante = true;      // I2C ocupado: o restante é lido com as leituras bloqueantes
+            rajada = n = 0;
+        }
+
+        // Enquanto a rajada atual é transferida, a anterior é decodificada e entregue à fila
+        for (i = 0; i < decodificar; i++) {
+            MPU6050::decodeMotion6 (&coletor->rajadas[atual ^ 1][i * MPU6050_MOTION6_LENGTH], &amostra);
+            insereNaFila (coletor->fila, &amostra);
+        }
+        desempenho->amostras += decodificar;
+        total += decodificar;
+
+        if (rajada > 0) {
+            inicio = coletor->cronometro.read_us ();
+            coletor->eventos.wait_any (IMU_FIM_DA_LEITURA);
+            desempenho->tempoLiberadoUs += coletor->cronometro.read_us () - inicio;
+            desempenho->leituras++;
+            if (coletor->resultado != I2C_EVENT_TRANSFER_COMPLETE) {
+                // NAK no endereço: a FIFO não foi lida e a rajada é lida de novo, bloqueante
+                desempenho->errosI2C++;
+                bloqueante = true;
+                rajada = n = 0;
+            }
+        }
+        decodificar = rajada;
+        n -= rajada;
+        atual ^= 1;
+    }
+    liberaBarramento (coletor->barramento, coletor->cliente);
+    if (!bloqueante) {
+        return total;
+    }
+    n = esvaziaFifoBloqueante (coletor);
+    return n < 0 ? (total > 0 ? total : -1) : total + n;
+#else
+    return esvaziaFifoBloqueante (coletor);
+#endif
+}
@@ -0,0 +1,150 @@
+/**
+ * imuCarro.h       v0.0        17-10-2026
+ *
+ * Orientador: Elias Teodoro da Silva Junior
+ * Autores: Felipe Moura de Castro e Joao Bruno Costa Cruz,
+ * Instituto Federal de Educação, Ciência e Tecnologia do Ceará (IFCE) - Campus Fortaleza
+ *
+ * @Opensource
+ * Este código-fonte pode ser utilizado, copiado, estudado, modificado e redistribuído sem restrições.
+ *
+ * Copyright (c) 2019, Felipe Moura de Castro e Joao Bruno Costa Cruz.
+ *
+ */
+
+#ifndef _IMU_CARRO_H_
+#define _IMU_CARRO_H_
+
+#include "mbed.h"
+#include "FilaCarro/filaCarro.h"
+#include "BarramentoCarro/barramentoCarro.h"
+#include "MPU6050.h"
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * Amostragem da MPU6050
+ *
+ * A MPU6050 amostra a uma taxa fixa (até 1 kHz) e guarda as amostras na sua FIFO. A cada amostra o pino INT
+ * gera um pulso; a interrupção apenas conta os pulsos e acorda a Thread de coleta a cada grupo de amostras.
+ * A Thread de coleta esvazia a FIFO em leituras em rajada e coloca as amostras brutas (sem conversão) na
+ * filaIMU, de onde a Thread de processamento as retira.
+ *
+ * Com DEVICE_I2C_ASYNCH, as rajadas são lidas com I2C::transfer em duas áreas alternadas: enquanto uma rajada é
+ * transferida, a anterior é decodificada e entregue à fila, e a Thread dorme no resto do tempo da transferência.
+ * Se o transfer não puder começar ou terminar com erro, o restante da FIFO é lido com as leituras bloqueantes.
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+#define IMU_FIM_DA_LEITURA          0x01    // sinal da leitura assíncrona concluída
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * Tamanho da fila de amostras (deve ser potência de 2): 256 ms a 1 kHz
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+#define TAMANHO_FILA_IMU 256
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * @brief   Fila de amostras brutas (filaCarro) com um único produtor e um único consumidor
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+typedef filaCarro<MPU6050Motion6, TAMANHO_FILA_IMU> filaIMU;
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * @brief   Medidas da coleta (as perdas ficam visíveis em cada ponto onde podem acontecer)
+ *
+ * @var amostras                      amostras lidas da FIFO
+ * @var leituras                      leituras em rajada da FIFO
+ * @var estourosFIFO                  vezes em que a FIFO da MPU6050 estourou (e foi zerada)
+ * @var errosI2C                      leituras assíncronas que terminaram com erro (rajada lida de novo, bloqueante)
+ * @var tempoLiberadoUs               tempo em que a Thread de coleta dormiu enquanto o I2C transferia (us)
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+typedef struct {
+    volatile uint32_t amostras;
+    volatile uint32_t leituras;
+    volatile uint32_t estourosFIFO;
+    volatile uint32_t errosI2C;
+    volatile uint32_t tempoLiberadoUs;
+} desempenhoIMU;
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * @brief   Coleta da FIFO da MPU6050 (usada apenas pela Thread de coleta)
+ *
+ * @var mpu                           sensor
+ * @var barramento                    gerenciador do I2C do sensor
+ * @var cliente                       cliente do barramento da Thread de coleta
+ * @var fila                          fila que recebe as amostras
+ * @var desempenho                    medidas da coleta
+ * @var eventos                       sinal IMU_FIM_DA_LEITURA do callback da leitura assíncrona
+ * @var resultado                     evento I2C da última leitura assíncrona
+ * @var cronometro                    mede o tempo em que a Thread dorme durante as transferências
+ * @var rajadas                       duas áreas de leitura: uma em transferência, a outra em decodificação
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+typedef struct {
+    MPU6050 *mpu;
+    barramentoI2C *barramento;
+    clienteI2C *cliente;
+    filaIMU *fila;
+    desempenhoIMU *desempenho;
+#if DEVICE_I2C_ASYNCH
+    EventFlags eventos;
+    volatile int resultado;
+    Timer cronometro;
+    char rajadas[2][MPU6050_FIFO_BURST * MPU6050_MOTION6_LENGTH];
+#endif
+} coletorIMU;
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * Protótipo das funções
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * @brief Prepara a coleta (o sensor já deve estar com a FIFO ligada)
+ *
+ * @param coletor       ponteiro para o coletor
+ * @param mpu           sensor
+ * @param barramento    gerenciador do I2C do sensor
+ * @param cliente       cliente do barramento cadastrado para a coleta
+ * @param fila          fila que recebe as amostras (já iniciada)
+ * @param desempenho    medidas da coleta (zeradas aqui)
+ *
+ * @return                      Não retorna nada.
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+void iniciaColetor (coletorIMU *coletor, MPU6050 *mpu, barramentoI2C *barramento, clienteI2C *cliente, filaIMU *fila,
+                    desempenhoIMU *desempenho);
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * @brief Conta um pulso de dado pronto do pino INT (chamada na interrupção) e indica quando a FIFO chegou à marca
+ *
+ * A MPU6050 não tem interrupção de nível da FIFO: a marca é contada aqui, e a contagem volta a zero ao atingi-la.
+ *
+ * @param sinalizadas   pulsos contados desde a última marca
+ * @param marca         amostras por coleta
+ *
+ * @return                      true se a Thread de coleta deve ser acordada.
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+bool contaAmostraPronta (volatile uint32_t *sinalizadas, uint32_t marca);
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * @brief Esvazia a FIFO da MPU6050 na fila, em rajadas de até MPU6050_FIFO_BURST amostras, na ordem da FIFO
+ *
+ * @param coletor       ponteiro para o coletor
+ *
+ * @return                      amostras entregues à fila; -1 se a FIFO estourou antes de entregar alguma (e foi
+ *                              zerada).
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+int esvaziaFifoIMU (coletorIMU *coletor);
+
+#endif /*_IMU_CARRO_H_*/
@@ -3,7 +3,7 @@
  */
 #include "MPU6050.h"
 
-MPU6050::MPU6050(PinName sda, PinName scl) : connection(sda, scl) {
+MPU6050::MPU6050(PinName sda, PinName scl) : ownConnection(new I2C(sda, scl)), connection(*ownConnection) {
     this->setSleepMode(false);
     
     //Initializations:
@@ -11,6 +11,18 @@ MPU6050::MPU6050(PinName sda, PinName scl) : connection(sda, scl) {
     currentAcceleroRange=0;
 }
 
+MPU6050::MPU6050(I2C &i2c) : ownConnection(NULL), connection(i2c) {
+    this->setSleepMode(false);
+    
+    //Initializations:
+    currentGyroRange = 0;
+    currentAcceleroRange=0;
+}
+
+MPU6050::~MPU6050() {
+    delete ownConnection;
+}
+
 //--------------------------------------------------
 //-------------------General------------------------
 //--------------------------------------------------
@@ -24,7 +36,7 @@ void MPU6050::write(char address, char data) {
 }
 
 char MPU6050::read(char address) {
-    char retval;
+    char retval = 0;
     connection.write(MPU6050_ADDRESS * 2, &address, 1, true);
     connection.read(MPU6050_ADDRESS * 2, &retval, 1);
     return retval;
@@ -45,6 +57,22 @@ void MPU6050::setSleepMode(bool state) {
     this->write(MPU6050_PWR_MGMT_1_REG, temp);
 }
 
+void MPU6050::setFrequency(int hz) {
+    connection.frequency(hz);
+}
+
+void MPU6050::setSampleRateDivider(char divider) {
+    this->write(MPU6050_SMPLRT_DIV_REG, divider);
+}
+
+void MPU6050::setInterrupts(char mask) {
+    this->write(MPU6050_INT_ENABLE_REG, mask);
+}
+
+char MPU6050::getInterruptStatus( void ) {
+    return this->read(MPU6050_INT_STATUS_REG);
+}
+
 bool MPU6050::testConnection( void ) {
     char temp;
     temp = this->read(MPU6050_WHO_AM_I_REG);
@@ -89,7 +117,7 @@ int MPU6050::getAcceleroRawX( void ) {
     short retval;
     char data[2];
     this->read(MPU6050_ACCEL_XOUT_H_REG, data, 2);
-    retval = (data[0]<<8) + data[1];
+    retval = (short)(((uint8_t)data[0]<<8) | (uint8_t)data[1]);
     return (int)retval;
 }
     
@@ -97,7 +125,7 @@ int MPU6050::getAcceleroRawY( void ) {
     short retval;
     char data[2];
     this->read(MPU6050_ACCEL_YOUT_H_REG, data, 2);
-    retval = (data[0]<<8) + data[1];
+    retval = (short)(((uint8_t)data[0]<<8) | (uint8_t)data[1]);
     return (int)retval;
 }
 
@@ -105,16 +133,16 @@ int MPU6050::getAcceleroRawZ( void ) {
     short retval;
     char data[2];
     this->read(MPU6050_ACCEL_ZOUT_H_REG, data, 2);
-    retval = (data[0]<<8) + data[1];
+    retval = (short)(((uint8_t)data[0]<<8) | (uint8_t)data[1]);
     return (int)retval;
 }
 
 void MPU6050::getAcceleroRaw( int *data ) {
     char temp[6];
     this->read(MPU6050_ACCEL_XOUT_H_REG, temp, 6);
-    data[0] = (int)(short)((temp[0]<<8) + temp[1]);
-    data[1] = (int)(short)((temp[2]<<8) + temp[3]);
-    data[2] = (int)(short)((temp[4]<<8) + temp[5]);
+    data[0] = (int)(short)(((uint8_t)temp[0]<<8) | (uint8_t)temp[1]);
+    data[1] = (int)(short)(((uint8_t)temp[2]<<8) | (uint8_t)temp[3]);
+    data[2] = (int)(short)(((uint8_t)temp[4]<<8) | (uint8_t)temp[5]);
 }
 
 void MPU6050::getAccelero( float *data ) {
@@ -157,7 +185,7 @@ void MPU6050::setGyroRange( char range ) {
     range = range & 0x03;
     temp = this->read(MPU6050_GYRO_CONFIG_REG);
     temp &= ~(3<<3);
-    temp = temp + range<<3;
+    temp = temp + (range<<3);
     this->write(MPU6050_GYRO_CONFIG_REG, temp);
 }
 
@@ -165,7 +193,7 @@ int MPU6050::getGyroRawX( void ) {
     short retval;
     char data[2];
     this->read(MPU6050_GYRO_XOUT_H_REG, data, 2);
-    retval = (data[0]<<8) + data[1];
+    retval = (short)(((uint8_t)data[0]<<8) | (uint8_t)data[1]);
     return (int)retval;
 }
     
@@ -173,7 +201,7 @@ int MPU6050::getGyroRawY( void ) {
     short retval;
     char data[2];
     this->read(MPU6050_GYRO_YOUT_H_REG, data, 2);
-    retval = (data[0]<<8) + data[1];
+    retval = (short)(((uint8_t)data[0]<<8) | (uint8_t)data[1]);
     return (int)retval;
 }
 
@@ -181,16 +209,16 @@ int MPU6050::getGyroRawZ( void ) {
     short retval;
     char data[2];
     this->read(MPU6050_GYRO_ZOUT_H_REG, data, 2);
-    retval = (data[0]<<8) + data[1];
+    retval = (short)(((uint8_t)data[0]<<8) | (uint8_t)data[1]);
     return (int)retval;
 }
 
 void MPU6050::getGyroRaw( int *data ) {
     char temp[6];
     this->read(MPU6050_GYRO_XOUT_H_REG, temp, 6);
-    data[0] = (int)(short)((temp[0]<<8) + temp[1]);
-    data[1] = (int)(short)((temp[2]<<8) + temp[3]);
-    data[2] = (int)(short)((temp[4]<<8) + temp[5]);
+    data[0] = (int)(short)(((uint8_t)temp[0]<<8) | (uint8_t)temp[1]);
+    data[1] = (int)(short)(((uint8_t)temp[2]<<8) | (uint8_t)temp[3]);
+    data[2] = (int)(short)(((uint8_t)temp[4]<<8) | (uint8_t)temp[5]);
 }
 
 void MPU6050::getGyro( float *data ) {
@@ -224,7 +252,7 @@ int MPU6050::getTempRaw( void ) {
     short retval;
     char data[2];
     this->read(MPU6050_TEMP_H_REG, data, 2);
-    retval = (data[0]<<8) + data[1];
+    retval = (short)(((uint8_t)data[0]<<8) | (uint8_t)data[1]);
     return (int)retval;
 }
 
@@ -235,3 +263,120 @@ float MPU6050::getTemp( void ) {
     return retval;
 }
 
+
+//--------------------------------------------------
+//------------Accelero, temperature, gyro-----------
+//--------------------------------------------------
+// Registers and FIFO share the layout: accelero X, Y, Z, temperature, gyro X, Y, Z (big endian)
+void MPU6050::decodeMotion6( const char *temp, MPU6050Motion6 *data ) {
+    int i;
+    for (i = 0; i < 3; i++) {
+        data->accelero[i] = (int16_t)(((uint8_t)temp[2 * i] << 8) | (uint8_t)temp[2 * i + 1]);
+        data->gyro[i] = (int16_t)(((uint8_t)temp[8 + 2 * i] << 8) | (uint8_t)temp[8 + 2 * i + 1]);
+    }
+    data->temp = (int16_t)(((uint8_t)temp[6] << 8) | (uint8_t)temp[7]);
+}
+
+void MPU6050::getMotion6Raw( MPU6050Motion6 *data ) {
+    char temp[MPU6050_MOTION6_LENGTH];
+    this->read(MPU6050_ACCEL_XOUT_H_REG, temp, MPU6050_MOTION6_LENGTH);
+    decodeMotion6(temp, data);
+}
+
+void MPU6050::convertMotion6( const MPU6050Motion6 *raw, float *accelero, float *gyro, float *temp ) {
+    // LSB per unit of each full scale range, the same values used by getAccelero and getGyro
+    static const float acceleroLSB[4] = { 16384.0f, 8192.0f, 4096.0f, 2048.0f };
+    static const float gyroLSB[4] = { 7505.7f, 3752.9f, 1879.3f, 939.7f };
+    float scale;
+    int i;
+
+    if (accelero != NULL) {
+        scale = 9.81f / acceleroLSB[currentAcceleroRange & 0x03];
+        #ifdef DOUBLE_ACCELERO
+            scale *= 2;
+        #endif
+        for (i = 0; i < 3; i++)
+            accelero[i] = (float)raw->accelero[i] * scale;
+    }
+    if (gyro != NULL) {
+        scale = 1.0f / gyroLSB[currentGyroRange & 0x03];
+        for (i = 0; i < 3; i++)
+            gyro[i] = (float)raw->gyro[i] * scale;
+    }
+    if (temp != NULL)
+        *temp = ((float)raw->temp + 521.0f) / 340.0f + 35.0f;
+}
+
+//--------------------------------------------------
+//----------------------FIFO------------------------
+//--------------------------------------------------
+void MPU6050::setMotion6Fifo(bool state) {
+    char temp;
+    if (state == true) {
+        this->write(MPU6050_FIFO_EN_REG, MPU6050_FIFO_MOTION6);
+        this->resetFifo();
+    } else {
+        this->write(MPU6050_FIFO_EN_REG, 0);
+        temp = this->read(MPU6050_USER_CTRL_REG);
+        this->write(MPU6050_USER_CTRL_REG, temp & ~(1<<MPU6050_FIFO_EN_BIT));
+    }
+}
+
+void MPU6050::resetFifo( void ) {
+    char temp;
+    temp = this->read(MPU6050_USER_CTRL_REG);
+    // The reset bit clears itself; the FIFO must be disabled while it is reset
+    this->write(MPU6050_USER_CTRL_REG, (temp & ~(1<<MPU6050_FIFO_EN_BIT)) | (1<<MPU6050_FIFO_RESET_BIT));
+    this->write(MPU6050_USER_CTRL_REG, (temp & ~(1<<MPU6050_FIFO_RESET_BIT)) | (1<<MPU6050_FIFO_EN_BIT));
+}
+
+int MPU6050::getFifoCount( void ) {
+    char data[2];
+    this->read(MPU6050_FIFO_COUNTH_REG, data, 2);
+    return ((uint8_t)data[0] << 8) | (uint8_t)data[1];
+}
+
+int MPU6050::readFifoMotion6( MPU6050Motion6 *data, int length ) {
+    char temp[MPU6050_FIFO_BURST * MPU6050_MOTION6_LENGTH];
+    int count, samples, burst, i, total = 0;
+
+    // More bytes than whole samples fit means the sensor has overwritten old data
+    count = this->getFifoCount();
+    if (count > (MPU6050_FIFO_SIZE / MPU6050_MOTION6_LENGTH) * MPU6050_MOTION6_LENGTH) {
+        this->resetFifo();
+        return -1;
+    }
+
+    samples = count / MPU6050_MOTION6_LENGTH;
+    if (samples > length)
+        samples = length;
+    while (total < samples) {
+        burst = samples - total;
+        if (burst > MPU6050_FIFO_BURST)
+            burst = MPU6050_FIFO_BURST;
+        this->read(MPU6050_FIFO_R_W_REG, temp, burst * MPU6050_MOTION6_LENGTH);
+        for (i = 0; i < burst; i++)
+            decodeMotion6(&temp[i * MPU6050_MOTION6_LENGTH], &data[total + i]);
+        total += burst;
+    }
+    return total;
+}
+
+//--------------------------------------------------
+//-------------------Asynchronous-------------------
+//--------------------------------------------------
+#if DEVICE_I2C_ASYNCH
+int MPU6050::readAsync( char address, char *data, int length, const event_callback_t &callback ) {
+    asyncRegister = address;
+    return connection.transfer(MPU6050_ADDRESS * 2, &asyncRegister, 1, data, length, callback,
+                               I2C_EVENT_ALL, false);
+}
+
+int MPU6050::startMotion6Read( char *data, const event_callback_t &callback ) {
+    return this->readAsync(MPU6050_ACCEL_XOUT_H_REG, data, MPU6050_MOTION6_LENGTH, callback);
+}
+
+int MPU6050::startFifoRead( char *data, int samples, const event_callback_t &callback ) {
+    return this->readAsync(MPU6050_FIFO_R_W_REG, data, samples * MPU6050_MOTION6_LENGTH, callback);
+}
+#endif
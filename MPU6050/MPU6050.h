@@ -26,11 +26,15 @@ If it is half of what you expected, and you still are on the correct planet, you
 /**
  * Registers
  */
+ #define MPU6050_SMPLRT_DIV_REG     0x19
  #define MPU6050_CONFIG_REG         0x1A
  #define MPU6050_GYRO_CONFIG_REG    0x1B
  #define MPU6050_ACCELERO_CONFIG_REG    0x1C
+ #define MPU6050_FIFO_EN_REG        0x23
   
  #define MPU6050_INT_PIN_CFG        0x37
+ #define MPU6050_INT_ENABLE_REG     0x38
+ #define MPU6050_INT_STATUS_REG     0x3A
  
  #define MPU6050_ACCEL_XOUT_H_REG   0x3B
  #define MPU6050_ACCEL_YOUT_H_REG   0x3D
@@ -42,9 +46,14 @@ If it is half of what you expected, and you still are on the correct planet, you
  #define MPU6050_GYRO_YOUT_H_REG    0x45
  #define MPU6050_GYRO_ZOUT_H_REG    0x47
  
+ #define MPU6050_MOTION6_LENGTH     14   // ACCEL_XOUT_H up to GYRO_ZOUT_L
  
  
+ 
+ #define MPU6050_USER_CTRL_REG      0x6A
  #define MPU6050_PWR_MGMT_1_REG     0x6B
+ #define MPU6050_FIFO_COUNTH_REG    0x72
+ #define MPU6050_FIFO_R_W_REG       0x74
  #define MPU6050_WHO_AM_I_REG       0x75
  
                  
@@ -54,6 +63,15 @@ If it is half of what you expected, and you still are on the correct planet, you
   */
 #define MPU6050_SLP_BIT             6
 #define MPU6050_BYPASS_BIT         1
+#define MPU6050_FIFO_EN_BIT         6   // USER_CTRL
+#define MPU6050_FIFO_RESET_BIT      2   // USER_CTRL
+
+#define MPU6050_FIFO_SIZE           1024
+#define MPU6050_FIFO_MOTION6        0xF8    // FIFO_EN: TEMP, XG, YG, ZG and ACCEL (same order as the registers)
+#define MPU6050_FIFO_BURST          16      // samples per I2C read of the FIFO
+
+#define MPU6050_INT_DATA_RDY        0x01
+#define MPU6050_INT_FIFO_OFLOW      0x10
 
 #define MPU6050_BW_256              0
 #define MPU6050_BW_188              1
@@ -74,6 +92,15 @@ If it is half of what you expected, and you still are on the correct planet, you
 #define MPU6050_GYRO_RANGE_2000     3
 
 
+/**
+ * Raw accelero, temperature and gyro registers, all from the same sample instant
+ */
+typedef struct {
+    int16_t accelero[3];
+    int16_t temp;
+    int16_t gyro[3];
+} MPU6050Motion6;
+
 /** MPU6050 IMU library.
   *
   * Example:
@@ -92,6 +119,17 @@ class MPU6050 {
      * @param scl - mbed pin to use for the SCL I2C line.
      */
      MPU6050(PinName sda, PinName scl);
+
+     /**
+     * Constructor for a sensor on a bus shared with other devices.
+     *
+     * Sleep mode of MPU6050 is immediatly disabled
+     *
+     * @param i2c - I2C bus the sensor is connected to (must outlive the object)
+     */
+     MPU6050(I2C &i2c);
+
+     ~MPU6050();
      
 
      /**
@@ -224,12 +262,139 @@ class MPU6050 {
      */  
      float getTemp( void );
 
+     /**
+     * Reads accelero, temperature and gyro in a single 14-byte I2C transaction (ACCEL_XOUT_H up to GYRO_ZOUT_L).
+     *
+     * The three sensors come from the same sample instant and the bus is used once instead of three times.
+     * Scaling is left to the caller (convertMotion6), so the read can be done while holding the bus.
+     *
+     * @param data - pointer to the struct that receives the raw registers
+     */
+     void getMotion6Raw( MPU6050Motion6 *data );
+
+     /**
+     * Converts a raw snapshot to m/s2, rad/s and degrees Celsius
+     *
+     * Function uses the last setup value of the full scale ranges, like getAccelero and getGyro.
+     *
+     * @param raw - snapshot read by getMotion6Raw
+     * @param accelero - pointer to float array with length three (X, Y, Z), or NULL if not needed
+     * @param gyro - pointer to float array with length three (X, Y, Z), or NULL if not needed
+     * @param temp - pointer to the temperature, or NULL if not needed
+     */
+     void convertMotion6( const MPU6050Motion6 *raw, float *accelero, float *gyro, float *temp );
+
      /**
      * Sets the sleep mode of the MPU6050 
      *
      * @param state - true for sleeping, false for wake up
      */     
      void setSleepMode( bool state );
+
+     /**
+     * Sets the I2C clock (the FIFO at 1 kHz needs 400 kHz: 14 kbytes/s plus protocol overhead)
+     *
+     * @param hz - 100000 or 400000
+     */
+     void setFrequency( int hz );
+
+     /**
+     * Sets the sample rate: gyro output rate / (1 + divider). The gyro output rate is 1 kHz with the
+     * low-pass filter enabled (setBW with anything but MPU6050_BW_256) and 8 kHz otherwise.
+     *
+     * @param divider - SMPLRT_DIV register value
+     */
+     void setSampleRateDivider( char divider );
+
+     /**
+     * Enables the interrupt sources on the INT pin (50 us pulse, active high: the default INT_PIN_CFG)
+     *
+     * Macros: MPU6050_INT_DATA_RDY - MPU6050_INT_FIFO_OFLOW
+     *
+     * @param mask - INT_ENABLE register value
+     */
+     void setInterrupts( char mask );
+
+     /**
+     * Reads (and clears) the interrupt status
+     *
+     * @return INT_STATUS register value
+     */
+     char getInterruptStatus( void );
+
+     /**
+     * Enables or disables the FIFO with accelero, temperature and gyro samples (14 bytes each)
+     *
+     * @param state - true to enable (the FIFO is reset), false to disable
+     */
+     void setMotion6Fifo( bool state );
+
+     /**
+     * Discards the FIFO contents and keeps it enabled
+     */
+     void resetFifo( void );
+
+     /**
+     * Reads the number of bytes in the FIFO
+     *
+     * @return FIFO count (0 up to MPU6050_FIFO_SIZE)
+     */
+     int getFifoCount( void );
+
+     /**
+     * Drains samples from the FIFO in bulk reads of up to MPU6050_FIFO_BURST samples
+     *
+     * When the FIFO has overflowed the sensor overwrites the oldest bytes and the samples are no longer
+     * aligned: the FIFO is reset and nothing is returned.
+     *
+     * @param data - pointer to the array that receives the samples
+     * @param length - size of the array
+     * @return number of samples read, or -1 if the FIFO had overflowed (and was reset)
+     */
+     int readFifoMotion6( MPU6050Motion6 *data, int length );
+
+     /**
+     * Decodes one 14-byte snapshot (registers or FIFO) read by the asynchronous functions
+     *
+     * @param raw - 14 bytes in the register order
+     * @param data - pointer to the struct that receives the decoded values
+     */
+     static void decodeMotion6( const char *raw, MPU6050Motion6 *data );
+
+#if DEVICE_I2C_ASYNCH
+     /**
+     * Starts a non-blocking read of several registers (I2C::transfer: register address, repeated start, read).
+     * The calling thread is free during the transfer; the callback runs in interrupt context with the I2C event
+     * (I2C_EVENT_TRANSFER_COMPLETE or an error). The data buffer must stay valid until the callback, and no other
+     * access to the sensor may be made in the meantime.
+     *
+     * @param address - first register to read
+     * @param data - buffer that receives the bytes
+     * @param length - number of bytes to read
+     * @param callback - function called at the end of the transfer
+     * @return 0 if the transfer was started, -1 if the bus is busy
+     */
+     int readAsync( char address, char *data, int length, const event_callback_t &callback );
+
+     /**
+     * Starts a non-blocking read of accelero, temperature and gyro (decode with decodeMotion6)
+     *
+     * @param data - buffer with MPU6050_MOTION6_LENGTH bytes
+     * @param callback - function called at the end of the transfer
+     * @return 0 if the transfer was started, -1 if the bus is busy
+     */
+     int startMotion6Read( char *data, const event_callback_t &callback );
+
+     /**
+     * Starts a non-blocking read of samples from the FIFO (the caller must have checked getFifoCount)
+     *
+     * @param data - buffer with samples * MPU6050_MOTION6_LENGTH bytes
+     * @param samples - number of samples to read
+     * @param callback - function called at the end of the transfer
+     * @return 0 if the transfer was started, -1 if the bus is busy
+     */
+     int startFifoRead( char *data, int samples, const event_callback_t &callback );
+#endif
      
      
      /**
@@ -262,9 +427,11 @@ class MPU6050 {
         
      private:
 
-     I2C connection;
+     I2C *ownConnection;     // bus created by the pin constructor (NULL when the bus is shared)
+     I2C &connection;
      char currentAcceleroRange;
      char currentGyroRange;
+     char asyncRegister;     // register address sent by the asynchronous transfer (must outlive the call)
      
 
 };
@@ -0,0 +1,243 @@
+/**
+ * navegacaoCarro.cpp       v0.0        17-10-2026
+ *
+ * Orientador: Elias Teodoro da Silva Junior
+ * Autores: Felipe Moura de Castro e Joao Bruno Costa Cruz,
+ * Instituto Federal de Educação, Ciência e Tecnologia do Ceará (IFCE) - Campus Fortaleza
+ *
+ * @Opensource
+ * Este código-fonte pode ser utilizado, copiado, estudado, modificado e redistribuído sem restrições.
+ *
+ * Copyright (c) 2019, Felipe Moura de Castro e Joao Bruno Costa Cruz.
+ *
+ */
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * Modelo de movimento (a cada média de IMU_DECIMACAO amostras da MPU6050, com intervalo dt):
+ *
+ *      norte      += velocidade * cos (rumo) * dt
+ *      leste      += velocidade * sin (rumo) * dt
+ *      rumo       += (guinada medida - bias do giroscópio) * dt
+ *      velocidade += (aceleração longitudinal - bias do acelerômetro) * dt
+ *
+ * A covariância é propagada com o jacobiano F desse modelo (P = F P F' + Q). A aceleração chega sem a
+ * gravidade, no referencial do carro nivelado (AtitudeCarro); o bias do acelerômetro absorve o bias do sensor
+ * e a gravidade que sobra do erro residual da atitude.
+ *
+ * Cada medida do GPS observa diretamente uma variável do estado, então a atualização escalar é:
+ *
+ *      K = P[:, i] / (P[i][i] + R),    x += K * (medida - x[i]),    P -= K * P[i, :]
+ *
+ * A origem do plano local é deslocada para perto da posição atual sempre que ela se afasta mais de
+ * NAV_DISTANCIA_REFERENCIA_M, mantendo a precisão do float em metros.
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+
+#include "navegacaoCarro.h"
+#include <math.h>
+
+#define NAV_PI                      3.14159265f
+
+/**
+ * Metros por 10^-7 graus de latitude (raio médio da Terra: 6371 km)
+ */
+#define NAV_METROS_POR_UNIDADE      0.011119508f
+
+#define NAV_DISTANCIA_REFERENCIA_M  1000.0f
+
+/**
+ * Ruído do processo (densidades espectrais)
+ */
+#define NAV_RUIDO_GIRO              (0.02f * 0.02f)       // (rad/s)² * s
+#define NAV_RUIDO_ACELERACAO        (0.5f * 0.5f)         // (m/s²)² * s
+#define NAV_RUIDO_BIAS_GIRO         (1e-4f * 1e-4f)
+#define NAV_RUIDO_BIAS_ACELERACAO   (1e-2f * 1e-2f)
+
+/**
+ * Ruído das medidas do GPS
+ */
+#define NAV_DESVIO_POSICAO_M        2.5f    // desvio por unidade de HDOP
+#define NAV_DESVIO_VELOCIDADE       0.3f    // m/s
+#define NAV_DESVIO_RUMO             0.1f    // rad (~6 graus)
+#define NAV_VELOCIDADE_MINIMA_RUMO  2.0f    // m/s: abaixo disso o curso do GPS não é confiável
+
+// Ajusta um ângulo para o intervalo [-pi, pi)
+static float normalizaAngulo (float angulo) {
+    while (angulo >= NAV_PI) angulo -= 2.0f * NAV_PI;
+    while (angulo < -NAV_PI) angulo += 2.0f * NAV_PI;
+    return angulo;
+}
+
+// Aplica uma medida escalar da variável i do estado (inovação já calculada)
+static void atualizaEscalar (navegacaoCarro *navegacao, int i, float inovacao, float variancia) {
+    float K[ESTADOS_NAVEGACAO];
+    float linha[ESTADOS_NAVEGACAO];
+    float S = navegacao->P[i][i] + variancia;
+    int l, c;
+
+    for (l = 0; l < ESTADOS_NAVEGACAO; l++) {
+        K[l] = navegacao->P[l][i] / S;
+        linha[l] = navegacao->P[i][l];
+    }
+    for (l = 0; l < ESTADOS_NAVEGACAO; l++) {
+        navegacao->x[l] += K[l] * inovacao;
+        for (c = 0; c < ESTADOS_NAVEGACAO; c++) {
+            navegacao->P[l][c] -= K[l] * linha[c];
+        }
+    }
+    navegacao->x[NAV_RUMO] = normalizaAngulo (navegacao->x[NAV_RUMO]);
+}
+
+// Desloca a origem do plano local para a posição estimada atual
+static void atualizaReferencia (navegacaoCarro *navegacao, int32_t latitude, int32_t longitude) {
+    navegacao->latitudeDeReferencia = latitude;
+    navegacao->longitudeDeReferencia = longitude;
+    navegacao->metrosPorUnidadeLeste = NAV_METROS_POR_UNIDADE * cosf ((float)latitude * 1e-7f * NAV_PI / 180.0f);
+}
+
+void iniciaNavegacao (navegacaoCarro *navegacao) {
+    memset (navegacao, 0, sizeof (navegacaoCarro));
+}
+
+void propagaNavegacao (navegacaoCarro *navegacao, const float *acce, const float *gyro, float dt) {
+    float *x = navegacao->x;
+    float F[ESTADOS_NAVEGACAO][ESTADOS_NAVEGACAO];
+    float FP[ESTADOS_NAVEGACAO][ESTADOS_NAVEGACAO];
+    float seno, cosseno, soma;
+    int l, c, k;
+
+    if (!navegacao->iniciada) {
+        return;
+    }
+    navegacao->tempoSemGPS += dt;
+
+    seno = sinf (x[NAV_RUMO]);
+    cosseno = cosf (x[NAV_RUMO]);
+
+    // Jacobiano do modelo, calculado com o estado anterior à predição
+    memset (F, 0, sizeof (F));
+    for (l = 0; l < ESTADOS_NAVEGACAO; l++) {
+        F[l][l] = 1.0f;
+    }
+    F[NAV_NORTE][NAV_RUMO] = -x[NAV_VELOCIDADE] * seno * dt;
+    F[NAV_NORTE][NAV_VELOCIDADE] = cosseno * dt;
+    F[NAV_LESTE][NAV_RUMO] = x[NAV_VELOCIDADE] * cosseno * dt;
+    F[NAV_LESTE][NAV_VELOCIDADE] = seno * dt;
+    F[NAV_RUMO][NAV_BIAS_GIRO] = -dt;
+    F[NAV_VELOCIDADE][NAV_BIAS_ACELERACAO] = -dt;
+
+    // Predição do estado
+    x[NAV_NORTE] += x[NAV_VELOCIDADE] * cosseno * dt;
+    x[NAV_LESTE] += x[NAV_VELOCIDADE] * seno * dt;
+    x[NAV_RUMO] = normalizaAngulo (x[NAV_RUMO] + (NAV_SINAL_GUINADA * gyro[NAV_EIXO_VERTICAL] - x[NAV_BIAS_GIRO]) * dt);
+    x[NAV_VELOCIDADE] += (acce[NAV_EIXO_AVANCO] - x[NAV_BIAS_ACELERACAO]) * dt;
+
+    // P = F P F' + Q
+    for (l = 0; l < ESTADOS_NAVEGACAO; l++) {
+        for (c = 0; c < ESTADOS_NAVEGACAO; c++) {
+            soma = 0.0f;
+            for (k = 0; k < ESTADOS_NAVEGACAO; k++) {
+                soma += F[l][k] * navegacao->P[k][c];
+            }
+            FP[l][c] = soma;
+        }
+    }
+    for (l = 0; l < ESTADOS_NAVEGACAO; l++) {
+        for (c = 0; c < ESTADOS_NAVEGACAO; c++) {
+            soma = 0.0f;
+            for (k = 0; k < ESTADOS_NAVEGACAO; k++) {
+                soma += FP[l][k] * F[c][k];
+            }
+            navegacao->P[l][c] = soma;
+        }
+    }
+    navegacao->P[NAV_RUMO][NAV_RUMO] += NAV_RUIDO_GIRO * dt;
+    navegacao->P[NAV_VELOCIDADE][NAV_VELOCIDADE] += NAV_RUIDO_ACELERACAO * dt;
+    navegacao->P[NAV_BIAS_GIRO][NAV_BIAS_GIRO] += NAV_RUIDO_BIAS_GIRO * dt;
+    navegacao->P[NAV_BIAS_ACELERACAO][NAV_BIAS_ACELERACAO] += NAV_RUIDO_BIAS_ACELERACAO * dt;
+}
+
+int corrigeNavegacao (navegacaoCarro *navegacao, const dataGPS *fix) {
+    float *x = navegacao->x;
+    float norte, leste, velocidade, rumo, desvio;
+    int32_t deslocamento;
+
+    if (fix->valid != 'A') {
+        return 0;
+    }
+
+    velocidade = (float)fix->speed * 0.001f;
+    rumo = normalizaAngulo ((float)fix->course * 0.01f * NAV_PI / 180.0f);
+
+    // Primeiro fix: o estado começa no próprio fix, com incerteza alta nos bias
+    if (!navegacao->iniciada) {
+        iniciaNavegacao (navegacao);
+        atualizaReferencia (navegacao, fix->latitude, fix->longitude);
+        x[NAV_VELOCIDADE] = velocidade;
+        x[NAV_RUMO] = rumo;
+        navegacao->P[NAV_NORTE][NAV_NORTE] = 25.0f;
+        navegacao->P[NAV_LESTE][NAV_LESTE] = 25.0f;
+        navegacao->P[NAV_RUMO][NAV_RUMO] = (velocidade >= NAV_VELOCIDADE_MINIMA_RUMO) ? 0.05f : NAV_PI * NAV_PI;
+        navegacao->P[NAV_VELOCIDADE][NAV_VELOCIDADE] = 1.0f;
+        navegacao->P[NAV_BIAS_GIRO][NAV_BIAS_GIRO] = 0.01f;
+        navegacao->P[NAV_BIAS_ACELERACAO][NAV_BIAS_ACELERACAO] = 0.25f;
+        navegacao->iniciada = true;
+        return 1;
+    }
+
+    // Mantém a origem do plano local perto da posição atual
+    if (fabsf (x[NAV_NORTE]) > NAV_DISTANCIA_REFERENCIA_M || fabsf (x[NAV_LESTE]) > NAV_DISTANCIA_REFERENCIA_M) {
+        int32_t latitude = navegacao->latitudeDeReferencia + (int32_t)(x[NAV_NORTE] / NAV_METROS_POR_UNIDADE);
+        int32_t longitude = navegacao->longitudeDeReferencia + (int32_t)(x[NAV_LESTE] / navegacao->metrosPorUnidadeLeste);
+        deslocamento = latitude - navegacao->latitudeDeReferencia;
+        x[NAV_NORTE] -= (float)deslocamento * NAV_METROS_POR_UNIDADE;
+        deslocamento = longitude - navegacao->longitudeDeReferencia;
+        x[NAV_LESTE] -= (float)deslocamento * navegacao->metrosPorUnidadeLeste;
+        atualizaReferencia (navegacao, latitude, longitude);
+    }
+
+    norte = (float)(fix->latitude - navegacao->latitudeDeReferencia) * NAV_METROS_POR_UNIDADE;
+    leste = (float)(fix->longitude - navegacao->longitudeDeReferencia) * navegacao->metrosPorUnidadeLeste;
+
+    // HDOP desconhecido (0) é tratado como 2
+    desvio = NAV_DESVIO_POSICAO_M * ((fix->hdop != 0) ? (float)fix->hdop * 0.01f : 2.0f);
+    atualizaEscalar (navegacao, NAV_NORTE, norte - x[NAV_NORTE], desvio * desvio);
+    atualizaEscalar (navegacao, NAV_LESTE, leste - x[NAV_LESTE], desvio * desvio);
+    atualizaEscalar (navegacao, NAV_VELOCIDADE, velocidade - x[NAV_VELOCIDADE],
+                     NAV_DESVIO_VELOCIDADE * NAV_DESVIO_VELOCIDADE);
+    if (velocidade >= NAV_VELOCIDADE_MINIMA_RUMO) {
+        atualizaEscalar (navegacao, NAV_RUMO, normalizaAngulo (rumo - x[NAV_RUMO]),
+                         NAV_DESVIO_RUMO * NAV_DESVIO_RUMO);
+    }
+
+    navegacao->tempoSemGPS = 0.0f;
+    return 1;
+}
+
+void estimaNavegacao (const navegacaoCarro *navegacao, const dataGPS *ultimoFix, dataGPS *estimativa) {
+    const float *x = navegacao->x;
+    float rumo;
+
+    memcpy (estimativa, ultimoFix, sizeof (dataGPS));
+    if (!navegacao->iniciada) {
+        return;
+    }
+
+    estimativa->latitude = navegacao->latitudeDeReferencia + (int32_t)(x[NAV_NORTE] / NAV_METROS_POR_UNIDADE);
+    estimativa->longitude = navegacao->longitudeDeReferencia + (int32_t)(x[NAV_LESTE] / navegacao->metrosPorUnidadeLeste);
+    estimativa->direction1 = (estimativa->latitude < 0) ? 'S' : 'N';
+    estimativa->direction2 = (estimativa->longitude < 0) ? 'W' : 'E';
+    estimativa->speed = (x[NAV_VELOCIDADE] > 0.0f) ? (int32_t)(x[NAV_VELOCIDADE] * 1000.0f) : 0;
+    rumo = x[NAV_RUMO] * 180.0f / NAV_PI;
+    if (rumo < 0.0f) {
+        rumo += 360.0f;
+    }
+    estimativa->course = (uint16_t)(rumo * 100.0f);
+
+    // Sem fix há mais de um segundo: posição apenas estimada
+    estimativa->valid = (navegacao->tempoSemGPS <= NAV_LIMITE_SEM_GPS_S) ? 'A' : 'V';
+    if (navegacao->tempoSemGPS > 1.0f) {
+        estimativa->mode = 'E';
+    }
+}
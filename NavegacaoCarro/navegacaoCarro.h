@@ -0,0 +1,144 @@
+/**
+ * navegacaoCarro.h       v0.0        17-10-2026
+ *
+ * Orientador: Elias Teodoro da Silva Junior
+ * Autores: Felipe Moura de Castro e Joao Bruno Costa Cruz,
+ * Instituto Federal de Educação, Ciência e Tecnologia do Ceará (IFCE) - Campus Fortaleza
+ *
+ * @Opensource
+ * Este código-fonte pode ser utilizado, copiado, estudado, modificado e redistribuído sem restrições.
+ *
+ * Copyright (c) 2019, Felipe Moura de Castro e Joao Bruno Costa Cruz.
+ *
+ */
+
+#ifndef _NAVEGACAO_CARRO_H_
+#define _NAVEGACAO_CARRO_H_
+
+#include "mbed.h"
+#include "GPS_Carro/GPS_Carro.h"
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * Navegação estimada (dead reckoning) com filtro de Kalman estendido
+ *
+ * O GPS fornece a posição no máximo 5 vezes por segundo, enquanto a MPU6050 é lida a 100 Hz. Entre
+ * dois fixes (e durante perdas de sinal, como em túneis) a posição é propagada com o modelo de um
+ * veículo que só anda para frente: a velocidade é integrada a partir da aceleração longitudinal e o
+ * rumo a partir da velocidade angular em torno do eixo vertical. Cada fix corrige o estado.
+ *
+ * Estado (6 variáveis, em um plano local Norte/Leste com origem em um fix recente):
+ *      norte, leste (m), rumo (rad, a partir do Norte no sentido horário), velocidade (m/s),
+ *      bias do giroscópio (rad/s) e bias do acelerômetro (m/s²)
+ *
+ * As medidas do GPS (norte, leste, velocidade e rumo) são aplicadas uma a uma (atualizações escalares),
+ * de forma que não há inversão de matrizes. Cada passo tem custo fixo em float (precisão simples,
+ * suportada pela FPU do Cortex-M4F): cerca de 900 operações na predição e 50 por medida.
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+#define ESTADOS_NAVEGACAO       6
+
+#define NAV_NORTE               0
+#define NAV_LESTE               1
+#define NAV_RUMO                2
+#define NAV_VELOCIDADE          3
+#define NAV_BIAS_GIRO           4
+#define NAV_BIAS_ACELERACAO     5
+
+/**
+ * Montagem da MPU6050 no carro: eixo que aponta para a frente e eixo vertical (0 = X, 1 = Y, 2 = Z).
+ * O sinal da guinada converte a rotação medida (anti-horária com o eixo para cima) em variação do rumo.
+ */
+#define NAV_EIXO_AVANCO         0
+#define NAV_EIXO_VERTICAL       2
+#define NAV_SINAL_GUINADA       (-1.0f)
+
+/**
+ * Tempo máximo sem fix (s) em que a posição estimada ainda é considerada válida
+ */
+#define NAV_LIMITE_SEM_GPS_S    30.0f
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * @brief   Estrutura do filtro de navegação
+ *
+ * @var x                             estado (índices NAV_*)
+ * @var P                             covariância do estado
+ * @var latitudeDeReferencia          origem do plano local: latitude em graus * 10^7
+ * @var longitudeDeReferencia         origem do plano local: longitude em graus * 10^7
+ * @var metrosPorUnidadeLeste         metros por 10^-7 graus de longitude na latitude de referência
+ * @var tempoSemGPS                   tempo desde o último fix aplicado (s)
+ * @var iniciada                      indica se o filtro já recebeu o primeiro fix válido
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+typedef struct {
+    float x[ESTADOS_NAVEGACAO];
+    float P[ESTADOS_NAVEGACAO][ESTADOS_NAVEGACAO];
+    int32_t latitudeDeReferencia;
+    int32_t longitudeDeReferencia;
+    float metrosPorUnidadeLeste;
+    float tempoSemGPS;
+    bool iniciada;
+} navegacaoCarro;
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * Protótipo das funções
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * @brief Inicializa o filtro. A posição só passa a ser estimada após o primeiro fix válido.
+ *
+ * @param navegacao     ponteiro para o filtro
+ *
+ * @return                      Não retorna nada.
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+void iniciaNavegacao (navegacaoCarro *navegacao);
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * @brief Propaga o estado com a média de um grupo de amostras da MPU6050 (predição do filtro)
+ *
+ * @param navegacao     ponteiro para o filtro
+ * @param acce          aceleração sem a gravidade nos eixos X, Y e Z do carro nivelado (m/s²), como em
+ *                      atitudeCarro::linear
+ * @param gyro          velocidade angular nos eixos X, Y e Z do carro nivelado (rad/s), como em atitudeCarro::giro
+ * @param dt            intervalo desde a amostra anterior (s)
+ *
+ * @return                      Não retorna nada.
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+void propagaNavegacao (navegacaoCarro *navegacao, const float *acce, const float *gyro, float dt);
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * @brief Corrige o estado com um novo fix do GPS. Fixes inválidos são ignorados.
+ *        O rumo só é corrigido acima de uma velocidade mínima, pois parado ele não é observável.
+ *
+ * @param navegacao     ponteiro para o filtro
+ * @param fix           fix recebido do GPS
+ *
+ * @return                      1 se o fix foi aplicado; 0 caso contrário.
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+int corrigeNavegacao (navegacaoCarro *navegacao, const dataGPS *fix);
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * @brief Escreve a posição, a velocidade e o rumo estimados em uma estrutura dataGPS. Os demais
+ *        campos (data, hora, DOP...) são copiados do último fix. Durante uma perda de sinal o modo
+ *        passa a ser 'E' (estimado, como no NMEA) e, após NAV_LIMITE_SEM_GPS_S, o fix fica inválido.
+ *
+ * @param navegacao     ponteiro para o filtro
+ * @param ultimoFix     último fix recebido do GPS
+ * @param estimativa    ponteiro para a struct que receberá a estimativa
+ *
+ * @return                      Não retorna nada.
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+void estimaNavegacao (const navegacaoCarro *navegacao, const dataGPS *ultimoFix, dataGPS *estimativa);
+
+#endif /*_NAVEGACAO_CARRO_H_*/
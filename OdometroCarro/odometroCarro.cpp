@@ -0,0 +1,165 @@
+/**
+ * odometroCarro.cpp       v0.0        17-10-2026
+ *
+ * Orientador: Elias Teodoro da Silva Junior
+ * Autores: Felipe Moura de Castro e Joao Bruno Costa Cruz,
+ * Instituto Federal de Educação, Ciência e Tecnologia do Ceará (IFCE) - Campus Fortaleza
+ *
+ * @Opensource
+ * Este código-fonte pode ser utilizado, copiado, estudado, modificado e redistribuído sem restrições.
+ *
+ * Copyright (c) 2019, Felipe Moura de Castro e Joao Bruno Costa Cruz.
+ *
+ */
+
+#include "odometroCarro.h"
+#include <math.h>
+
+/**
+ * Metros por 10^-7 graus de latitude (raio médio da Terra: 6371 km) e radianos por 10^-7 graus
+ */
+#define ODOMETRO_METROS_POR_UNIDADE     0.011119508f
+#define ODOMETRO_RADIANOS_POR_UNIDADE   1.745329252e-9f
+
+/**
+ * Histerese do detector de vibração: o motor só é considerado desligado abaixo desta fração do limiar
+ */
+#define ODOMETRO_HISTERESE_VIBRACAO     0.7f
+
+void iniciaVibracao (vibracaoCarro *vibracao) {
+    memset (vibracao, 0, sizeof (vibracaoCarro));
+}
+
+void atualizaVibracao (vibracaoCarro *vibracao, const float *acce) {
+    float modulo = sqrtf (acce[0] * acce[0] + acce[1] * acce[1] + acce[2] * acce[2]);
+    float desvio, limiar;
+
+    // Primeira amostra: a média parte da gravidade medida, não de zero
+    if (vibracao->media == 0.0f) {
+        vibracao->media = modulo;
+    }
+    desvio = modulo - vibracao->media;
+    vibracao->media += desvio / ODOMETRO_JANELA_VIBRACAO;
+    vibracao->variancia += (desvio * desvio - vibracao->variancia) / ODOMETRO_JANELA_VIBRACAO;
+
+    limiar = vibracao->ligado ? ODOMETRO_LIMIAR_VIBRACAO * ODOMETRO_HISTERESE_VIBRACAO : ODOMETRO_LIMIAR_VIBRACAO;
+    vibracao->ligado = vibracao->variancia > limiar * limiar;
+}
+
+float distanciaEntre (int32_t latitude1, int32_t longitude1, int32_t latitude2, int32_t longitude2) {
+    float latitudeMedia = ((float)latitude1 + (float)latitude2) * 0.5f * ODOMETRO_RADIANOS_POR_UNIDADE;
+    float norte = (float)((int64_t)latitude2 - latitude1) * ODOMETRO_METROS_POR_UNIDADE;
+    float leste = (float)((int64_t)longitude2 - longitude1) * ODOMETRO_METROS_POR_UNIDADE * cosf (latitudeMedia);
+
+    return sqrtf (norte * norte + leste * leste);
+}
+
+void iniciaOdometro (odometroCarro *odometro) {
+    memset (odometro, 0, sizeof (odometroCarro));
+}
+
+int atualizaOdometro (odometroCarro *odometro, const dataGPS *fix, bool motorLigado, uint64_t contadorMs,
+                      resumoViagem *resumo) {
+    bool valido = (fix->valid == 'A');
+    uint32_t velocidade = valido ? fix->speed : 0;
+    uint32_t dt = odometro->contadorAnterior ? (uint32_t)(contadorMs - odometro->contadorAnterior) : 0;
+    uint32_t distancia = 0;
+    uint64_t parada;
+
+    odometro->contadorAnterior = contadorMs;
+
+    // Distância: só em movimento, para não acumular o "passeio" do GPS parado
+    if (valido) {
+        if (odometro->temPosicao && velocidade >= ODOMETRO_VELOCIDADE_PARADO) {
+            distancia = (uint32_t)(distanciaEntre (odometro->latitudeAnterior, odometro->longitudeAnterior,
+                                                   fix->latitude, fix->longitude) * 1000.0f);
+            odometro->sequencia++;
+            __DMB ();
+            odometro->distanciaTotalMm += distancia;
+            __DMB ();
+            odometro->sequencia++;
+        }
+        odometro->latitudeAnterior = fix->latitude;
+        odometro->longitudeAnterior = fix->longitude;
+        odometro->temPosicao = true;
+    }
+
+    if (!odometro->emViagem) {
+        if (velocidade < ODOMETRO_VELOCIDADE_MOVIMENTO) {
+            odometro->inicioDoMovimento = 0;
+            return 0;
+        }
+        // Possível início de viagem: o resumo já começa a ser preenchido
+        if (odometro->inicioDoMovimento == 0) {
+            memset (&odometro->viagem, 0, sizeof (resumoViagem));
+            odometro->viagem.inicio = tempoDoFix (fix);
+            odometro->viagem.latitudeInicial = fix->latitude;
+            odometro->viagem.longitudeInicial = fix->longitude;
+            odometro->inicioDoMovimento = contadorMs;
+        }
+        odometro->viagem.distanciaMm += distancia;
+        if (velocidade > odometro->viagem.velocidadeMaxima) {
+            odometro->viagem.velocidadeMaxima = velocidade;
+        }
+        if (contadorMs - odometro->inicioDoMovimento >= ODOMETRO_TEMPO_PARA_INICIAR_MS) {
+            odometro->emViagem = true;
+            odometro->viagem.numero = odometro->viagens + 1;
+            odometro->inicioDaParada = 0;
+        }
+        return 0;
+    }
+
+    odometro->viagem.distanciaMm += distancia;
+    if (velocidade > odometro->viagem.velocidadeMaxima) {
+        odometro->viagem.velocidadeMaxima = velocidade;
+    }
+
+    // Em movimento: a parada anterior (se houve) foi só uma pausa da viagem
+    if (velocidade >= ODOMETRO_VELOCIDADE_PARADO) {
+        if (odometro->inicioDaParada) {
+            odometro->viagem.tempoParadoMs += odometro->marchaLentaNaParada;
+            odometro->inicioDaParada = 0;
+        }
+        return 0;
+    }
+
+    // Parado: a viagem termina aqui se a parada se prolongar
+    if (odometro->inicioDaParada == 0) {
+        odometro->inicioDaParada = contadorMs;
+        odometro->marchaLentaNaParada = 0;
+        odometro->semMotorNaParada = 0;
+        odometro->viagem.duracaoMs = (uint32_t)(contadorMs - odometro->inicioDoMovimento);
+        odometro->viagem.latitudeFinal = odometro->latitudeAnterior;
+        odometro->viagem.longitudeFinal = odometro->longitudeAnterior;
+    } else if (motorLigado) {
+        odometro->marchaLentaNaParada += dt;
+        odometro->semMotorNaParada = 0;
+    } else {
+        odometro->semMotorNaParada += dt;
+    }
+
+    parada = contadorMs - odometro->inicioDaParada;
+    if (odometro->semMotorNaParada < ODOMETRO_TEMPO_PARA_ENCERRAR_MS && parada < ODOMETRO_LIMITE_PARADO_MS) {
+        return 0;
+    }
+
+    memcpy (resumo, &odometro->viagem, sizeof (resumoViagem));
+    odometro->viagens++;
+    odometro->emViagem = false;
+    odometro->inicioDoMovimento = 0;
+    odometro->inicioDaParada = 0;
+    return 1;
+}
+
+uint64_t leDistanciaOdometro (const odometroCarro *odometro) {
+    uint32_t antes;
+    uint64_t distancia;
+
+    do {
+        antes = odometro->sequencia;
+        __DMB ();
+        distancia = odometro->distanciaTotalMm;
+        __DMB ();
+    } while ((antes & 1) || antes != odometro->sequencia);
+    return distancia;
+}
@@ -0,0 +1,228 @@
+/**
+ * odometroCarro.h       v0.0        17-10-2026
+ *
+ * Orientador: Elias Teodoro da Silva Junior
+ * Autores: Felipe Moura de Castro e Joao Bruno Costa Cruz,
+ * Instituto Federal de Educação, Ciência e Tecnologia do Ceará (IFCE) - Campus Fortaleza
+ *
+ * @Opensource
+ * Este código-fonte pode ser utilizado, copiado, estudado, modificado e redistribuído sem restrições.
+ *
+ * Copyright (c) 2019, Felipe Moura de Castro e Joao Bruno Costa Cruz.
+ *
+ */
+
+#ifndef _ODOMETRO_CARRO_H_
+#define _ODOMETRO_CARRO_H_
+
+#include "mbed.h"
+#include "FilaCarro/filaCarro.h"
+#include "GPS_Carro/GPS_Carro.h"
+#include "TempoCarro/tempoCarro.h"
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * Odômetro e viagens
+ *
+ * A distância é acumulada a cada fix válido pela aproximação equirretangular (plano tangente), em float:
+ * entre dois fixes consecutivos (poucos metros) o erro em relação ao grande círculo é desprezível.
+ * Parado, o GPS "passeia" alguns metros; por isso só há acúmulo acima de ODOMETRO_VELOCIDADE_PARADO.
+ *
+ * Uma viagem começa depois de ODOMETRO_TEMPO_PARA_INICIAR_MS acima de ODOMETRO_VELOCIDADE_MOVIMENTO e
+ * termina quando o carro fica parado com o motor desligado (sem vibração) por ODOMETRO_TEMPO_PARA_ENCERRAR_MS
+ * seguidos, ou parado por ODOMETRO_LIMITE_PARADO_MS mesmo com vibração. O resumo de cada viagem é atualizado
+ * com custo constante a cada fix.
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+#define ODOMETRO_VELOCIDADE_MOVIMENTO       2778        // mm/s (10 km/h)
+#define ODOMETRO_VELOCIDADE_PARADO          833         // mm/s (3 km/h)
+#define ODOMETRO_TEMPO_PARA_INICIAR_MS      5000
+#define ODOMETRO_TEMPO_PARA_ENCERRAR_MS     60000
+#define ODOMETRO_LIMITE_PARADO_MS           900000      // 15 minutos
+
+/**
+ * Vibração do motor: desvio padrão do módulo da aceleração (m/s²) acima do qual o motor é considerado
+ * ligado (o ruído da MPU6050 parada fica perto de 0,03 m/s²). O valor deve ser ajustado no carro.
+ * A média e a variância são filtros exponenciais com constante de tempo de ODOMETRO_JANELA_VIBRACAO amostras.
+ */
+#define ODOMETRO_LIMIAR_VIBRACAO            0.06f
+#define ODOMETRO_JANELA_VIBRACAO            100.0f
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * @brief   Detector de vibração (motor ligado), alimentado pelas amostras da MPU6050
+ *
+ * @var media                         média do módulo da aceleração (m/s²)
+ * @var variancia                     variância do módulo da aceleração ((m/s²)²)
+ * @var ligado                        indica se o motor está ligado (com histerese)
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+typedef struct {
+    float media;
+    float variancia;
+    volatile bool ligado;
+} vibracaoCarro;
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * @brief   Resumo de uma viagem
+ *
+ * @var numero                        número da viagem desde a inicialização
+ * @var inicio                        tempo Unix do início em milissegundos (0 se o relógio não estava sincronizado)
+ * @var duracaoMs                     duração da viagem (até o início da parada final)
+ * @var distanciaMm                   distância percorrida (mm)
+ * @var tempoParadoMs                 tempo parado com o motor ligado (marcha lenta)
+ * @var velocidadeMaxima              maior velocidade (mm/s)
+ * @var latitudeInicial               graus * 10^7
+ * @var longitudeInicial              graus * 10^7
+ * @var latitudeFinal                 graus * 10^7
+ * @var longitudeFinal                graus * 10^7
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+typedef struct {
+    uint32_t numero;
+    uint64_t inicio;
+    uint32_t duracaoMs;
+    uint32_t distanciaMm;
+    uint32_t tempoParadoMs;
+    uint32_t velocidadeMaxima;
+    int32_t latitudeInicial;
+    int32_t longitudeInicial;
+    int32_t latitudeFinal;
+    int32_t longitudeFinal;
+} resumoViagem;
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * @brief   Odômetro
+ *          Escrito apenas pela Thread do GPS. A distância total é lida por outras Threads com
+ *          leDistanciaOdometro, com o mesmo controle de sequência do relogioGPS (sem semáforo).
+ *
+ * @var sequencia                     contador de escritas da distância (par quando não há escrita em andamento)
+ * @var distanciaTotalMm              distância acumulada desde a inicialização (mm)
+ * @var viagem                        resumo da viagem atual (ou em confirmação)
+ * @var emViagem                      indica se há uma viagem em andamento
+ * @var latitudeAnterior              posição do último fix válido (graus * 10^7)
+ * @var longitudeAnterior             posição do último fix válido (graus * 10^7)
+ * @var temPosicao                    indica se já houve um fix válido
+ * @var contadorAnterior              contador do sistema (ms) na chamada anterior
+ * @var inicioDoMovimento             contador do sistema (ms) em que o carro começou a andar (0 = parado)
+ * @var inicioDaParada                contador do sistema (ms) em que o carro parou durante a viagem (0 = andando)
+ * @var marchaLentaNaParada           tempo com motor ligado na parada atual (só conta se a viagem continuar)
+ * @var semMotorNaParada              tempo contínuo com o motor desligado na parada atual
+ * @var viagens                       viagens concluídas
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+typedef struct {
+    volatile uint32_t sequencia;
+    uint64_t distanciaTotalMm;
+    resumoViagem viagem;
+    bool emViagem;
+    int32_t latitudeAnterior;
+    int32_t longitudeAnterior;
+    bool temPosicao;
+    uint64_t contadorAnterior;
+    uint64_t inicioDoMovimento;
+    uint64_t inicioDaParada;
+    uint32_t marchaLentaNaParada;
+    uint32_t semMotorNaParada;
+    uint32_t viagens;
+} odometroCarro;
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * Tamanho da fila de resumos (deve ser potência de 2)
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+#define TAMANHO_FILA_VIAGEM 4
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * @brief   Fila de resumos de viagem (filaCarro) com um único produtor e um único consumidor
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+typedef filaCarro<resumoViagem, TAMANHO_FILA_VIAGEM> filaViagem;
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * Protótipo das funções
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * @brief Inicializa o detector de vibração (motor desligado)
+ *
+ * @param vibracao      ponteiro para o detector
+ *
+ * @return                      Não retorna nada.
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+void iniciaVibracao (vibracaoCarro *vibracao);
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * @brief Atualiza o detector com uma amostra da MPU6050. Deve ser chamada a uma taxa fixa.
+ *
+ * @param vibracao      ponteiro para o detector
+ * @param acce          aceleração nos eixos X, Y e Z (m/s²), como em MPU6050::getAccelero
+ *
+ * @return                      Não retorna nada.
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+void atualizaVibracao (vibracaoCarro *vibracao, const float *acce);
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * @brief Distância entre dois pontos pela aproximação equirretangular
+ *
+ * @param latitude1     graus * 10^7
+ * @param longitude1    graus * 10^7
+ * @param latitude2     graus * 10^7
+ * @param longitude2    graus * 10^7
+ *
+ * @return                      distância em metros.
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+float distanciaEntre (int32_t latitude1, int32_t longitude1, int32_t latitude2, int32_t longitude2);
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * @brief Inicializa o odômetro (distância zero, sem viagem)
+ *
+ * @param odometro      ponteiro para o odômetro
+ *
+ * @return                      Não retorna nada.
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+void iniciaOdometro (odometroCarro *odometro);
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * @brief Atualiza o odômetro e a viagem com um fix. Fixes inválidos também devem ser passados: sem
+ *        posição o carro é considerado parado, o que permite encerrar uma viagem em uma garagem coberta.
+ *
+ * @param odometro      ponteiro para o odômetro
+ * @param fix           fix recebido do GPS
+ * @param motorLigado   indica se há vibração de motor (vibracaoCarro::ligado)
+ * @param contadorMs    valor atual do contador do sistema (ms)
+ * @param resumo        ponteiro para a struct que recebe o resumo quando uma viagem termina
+ *
+ * @return                      1 se uma viagem terminou (resumo preenchido); 0 caso contrário.
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+int atualizaOdometro (odometroCarro *odometro, const dataGPS *fix, bool motorLigado, uint64_t contadorMs,
+                      resumoViagem *resumo);
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * @brief Lê a distância total do odômetro de qualquer Thread (sem leitura rasgada dos 64 bits)
+ *
+ * @param odometro      ponteiro para o odômetro
+ *
+ * @return                      distância acumulada desde a inicialização (mm).
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+uint64_t leDistanciaOdometro (const odometroCarro *odometro);
+
+#endif /*_ODOMETRO_CARRO_H_*/
@@ -0,0 +1,285 @@
+/**
+ * pavimentoCarro.cpp       v0.0        17-10-2026
+ *
+ * Orientador: Elias Teodoro da Silva Junior
+ * Autores: Felipe Moura de Castro e Joao Bruno Costa Cruz,
+ * Instituto Federal de Educação, Ciência e Tecnologia do Ceará (IFCE) - Campus Fortaleza
+ *
+ * @Opensource
+ * Este código-fonte pode ser utilizado, copiado, estudado, modificado e redistribuído sem restrições.
+ *
+ * Copyright (c) 2019, Felipe Moura de Castro e Joao Bruno Costa Cruz.
+ *
+ */
+
+#include "pavimentoCarro.h"
+#include <math.h>
+
+#define BIQUAD_PI               3.14159265f
+#define BIQUAD_Q_BUTTERWORTH    0.70710678f
+
+void iniciaBiquad (biquadCascata *filtro) {
+    memset (filtro, 0, sizeof (biquadCascata));
+}
+
+int acrescentaBiquad (biquadCascata *filtro, char tipo, float corteHz, float taxaHz, float q) {
+    float *c;
+    float w0, cosseno, alfa, a0;
+
+    if (filtro->estagios >= BIQUAD_MAX_ESTAGIOS) {
+        return 0;
+    }
+    c = &filtro->coeficientes[5 * filtro->estagios];
+
+    // Transformação bilinear (Robert Bristow-Johnson, "Audio EQ Cookbook")
+    w0 = 2.0f * BIQUAD_PI * corteHz / taxaHz;
+    cosseno = cosf (w0);
+    alfa = sinf (w0) / (2.0f * q);
+    a0 = 1.0f + alfa;
+
+    if (tipo == BIQUAD_PASSA_ALTA) {
+        c[0] = (1.0f + cosseno) * 0.5f / a0;
+        c[1] = -(1.0f + cosseno) / a0;
+    } else {
+        c[0] = (1.0f - cosseno) * 0.5f / a0;
+        c[1] = (1.0f - cosseno) / a0;
+    }
+    c[2] = c[0];
+    c[3] = 2.0f * cosseno / a0;
+    c[4] = -(1.0f - alfa) / a0;
+
+    filtro->estado[2 * filtro->estagios] = 0.0f;
+    filtro->estado[2 * filtro->estagios + 1] = 0.0f;
+    filtro->estagios++;
+    return 1;
+}
+
+void preparaBiquad (biquadCascata *filtro, float entrada) {
+    const float *c = filtro->coeficientes;
+    float *d = filtro->estado;
+    float x = entrada, y;
+    int i;
+
+    for (i = 0; i < filtro->estagios; i++, c += 5, d += 2) {
+        // Ganho DC do estágio: H(1) = (b0 + b1 + b2) / (1 - a1 - a2)
+        y = x * (c[0] + c[1] + c[2]) / (1.0f - c[3] - c[4]);
+        d[1] = c[2] * x + c[4] * y;
+        d[0] = c[1] * x + c[3] * y + d[1];
+        x = y;
+    }
+}
+
+void filtraBiquad (biquadCascata *filtro, const float *entrada, float *saida, int n) {
+    const float *c = filtro->coeficientes;
+    float *d = filtro->estado;
+    const float *x = entrada;
+    float b0, b1, b2, a1, a2, d1, d2, e, y;
+    int i, k;
+
+    // Um estágio por vez sobre o bloco inteiro: coeficientes e estado ficam em registradores no laço interno
+    for (i = 0; i < filtro->estagios; i++, c += 5, d += 2) {
+        b0 = c[0]; b1 = c[1]; b2 = c[2]; a1 = c[3]; a2 = c[4];
+        d1 = d[0]; d2 = d[1];
+        for (k = 0; k < n; k++) {
+            e = x[k];
+            y = b0 * e + d1;
+            d1 = b1 * e + a1 * y + d2;
+            d2 = b2 * e + a2 * y;
+            saida[k] = y;
+        }
+        d[0] = d1;
+        d[1] = d2;
+        x = saida;
+    }
+}
+
+void iniciaPavimento (pavimentoCarro *pavimento, float taxaHz) {
+    memset (pavimento, 0, sizeof (pavimentoCarro));
+    pavimento->taxaHz = taxaHz;
+    iniciaBiquad (&pavimento->filtro);
+    acrescentaBiquad (&pavimento->filtro, BIQUAD_PASSA_ALTA, PAVIMENTO_PASSA_ALTA_HZ, taxaHz, BIQUAD_Q_BUTTERWORTH);
+    acrescentaBiquad (&pavimento->filtro, BIQUAD_PASSA_BAIXA, PAVIMENTO_PASSA_BAIXA_HZ, taxaHz, BIQUAD_Q_BUTTERWORTH);
+}
+
+/**
+ * Converte m/s² para mm/s², saturando em 16 bits
+ */
+static uint16_t milimetrosPorSegundo2 (float valor) {
+    valor *= 1000.0f;
+    return valor >= 65535.0f ? 65535 : (uint16_t)(valor + 0.5f);
+}
+
+int processaPavimento (pavimentoCarro *pavimento, const float *bloco, int n, uint32_t distanciaMm,
+                       const dataGPS *posicao, uint64_t instante, trechoPavimento *trecho) {
+    float *filtrado = pavimento->filtrado;
+    float amostra, rms;
+    uint32_t percorrido;
+    int k;
+
+    if (n > PAVIMENTO_BLOCO) {
+        n = PAVIMENTO_BLOCO;
+    }
+    if (n <= 0) {
+        return 0;
+    }
+
+    // Primeiro bloco: o filtro parte do regime permanente (a gravidade já removida)
+    if (!pavimento->iniciado) {
+        preparaBiquad (&pavimento->filtro, bloco[0]);
+        pavimento->inicioDoTrecho = distanciaMm;
+        pavimento->iniciado = true;
+    }
+
+    // O filtro roda sempre, para não ter transiente quando o carro volta a andar
+    filtraBiquad (&pavimento->filtro, bloco, filtrado, n);
+
+    if (posicao->speed >= PAVIMENTO_VELOCIDADE_MINIMA) {
+        for (k = 0; k < n; k++) {
+            amostra = filtrado[k];
+            pavimento->somaDosQuadrados += amostra * amostra;
+            if (fabsf (amostra) > pavimento->pico) {
+                pavimento->pico = fabsf (amostra);
+            }
+        }
+        pavimento->amostras += n;
+    }
+
+    percorrido = distanciaMm - pavimento->inicioDoTrecho;
+    if (percorrido < PAVIMENTO_TRECHO_MM) {
+        return 0;
+    }
+
+    // Fim do trecho. Depois de uma falha longa do GPS a distância salta; o trecho recomeça do ponto atual.
+    pavimento->inicioDoTrecho = distanciaMm;
+    if (pavimento->amostras == 0) {
+        return 0;
+    }
+
+    rms = sqrtf (pavimento->somaDosQuadrados / (float)pavimento->amostras);
+    trecho->latitude = posicao->latitude;
+    trecho->longitude = posicao->longitude;
+    trecho->instante = instante;
+    trecho->velocidade = (uint32_t)((float)percorrido * pavimento->taxaHz / (float)pavimento->amostras);
+    trecho->rms = milimetrosPorSegundo2 (rms);
+    trecho->pico = milimetrosPorSegundo2 (pavimento->pico);
+
+    pavimento->somaDosQuadrados = 0.0f;
+    pavimento->pico = 0.0f;
+    pavimento->amostras = 0;
+    return 1;
+}
+
+void iniciaDetectorBuraco (detectorBuraco *detector, float taxaHz) {
+    memset (detector, 0, sizeof (detectorBuraco));
+    detector->taxaHz = taxaHz;
+}
+
+/**
+ * Atualiza o pico e o jerk máximo do evento em andamento
+ */
+static void acompanhaBuraco (eventoBuraco *evento, float vertical, float jerk) {
+    float pico = fabsf (vertical) * 1000.0f;
+
+    jerk = fabsf (jerk);
+    if (pico > evento->pico) {
+        evento->pico = pico >= 65535.0f ? 65535 : (uint16_t)pico;
+    }
+    if (jerk > evento->jerk) {
+        evento->jerk = jerk >= 65535.0f ? 65535 : (uint16_t)jerk;
+    }
+}
+
+int detectaBuraco (detectorBuraco *detector, filaBuraco *fila, const MPU6050Motion6 *amostra, float vertical,
+                   const dataGPS *posicao, uint64_t instante, eventoBuraco *evento) {
+    capturaBuraco *captura = detector->captura;
+    float jerk = (vertical - detector->anterior) * detector->taxaHz;
+    float velocidade, limiarPico, limiarJerk;
+    uint32_t k;
+
+    detector->anterior = vertical;
+
+    // Capturando: a amostra anterior ao disparo é copiada antes que a escrita abaixo a alcance
+    // (BURACO_HISTORICO - BURACO_PRE_AMOSTRAS amostras de folga)
+    if (detector->restantes > 0) {
+        k = BURACO_POS_AMOSTRAS - detector->restantes;
+        if (captura) {
+            captura->amostras[BURACO_PRE_AMOSTRAS + k] = *amostra;
+            if (k < BURACO_PRE_AMOSTRAS) {
+                captura->amostras[k] = detector->historico[(detector->inicioDaCaptura + k) & (BURACO_HISTORICO - 1)];
+            }
+        }
+        detector->historico[detector->escritas++ & (BURACO_HISTORICO - 1)] = *amostra;
+        acompanhaBuraco (&detector->evento, vertical, jerk);
+
+        if (--detector->restantes > 0) {
+            return 0;
+        }
+        if (captura) {
+            memcpy (&captura->evento, &detector->evento, sizeof (eventoBuraco));
+            publicaNaFila (fila);
+            detector->captura = NULL;
+        }
+        memcpy (evento, &detector->evento, sizeof (eventoBuraco));
+        return 1;
+    }
+
+    detector->historico[detector->escritas++ & (BURACO_HISTORICO - 1)] = *amostra;
+
+    // Armado: limiares proporcionais à velocidade; parado ou devagar não há disparo
+    if (posicao->speed < PAVIMENTO_VELOCIDADE_MINIMA || detector->escritas < BURACO_PRE_AMOSTRAS) {
+        return 0;
+    }
+    velocidade = posicao->speed * 0.001f;
+    limiarPico = BURACO_PICO_MINIMO + BURACO_PICO_POR_VELOCIDADE * velocidade;
+    limiarJerk = BURACO_JERK_MINIMO + BURACO_JERK_POR_VELOCIDADE * velocidade;
+    if (fabsf (vertical) < limiarPico && fabsf (jerk) < limiarJerk) {
+        return 0;
+    }
+
+    // Disparo. Sem janela livre, o evento ainda é contado e resumido, mas a janela se perde.
+    detector->captura = reservaNaFila (fila);
+    if (!detector->captura) {
+        fila->perdidos++;
+    }
+    detector->restantes = BURACO_POS_AMOSTRAS;
+    // A parte anterior da janela termina no disparo: as BURACO_PRE_AMOSTRAS últimas escritas, incluindo a atual
+    detector->inicioDaCaptura = detector->escritas - BURACO_PRE_AMOSTRAS;
+    detector->eventos++;
+
+    memset (&detector->evento, 0, sizeof (eventoBuraco));
+    detector->evento.numero = detector->eventos;
+    detector->evento.tipo = vertical < 0.0f ? BURACO_BURACO : BURACO_LOMBADA;
+    detector->evento.latitude = posicao->latitude;
+    detector->evento.longitude = posicao->longitude;
+    detector->evento.instante = instante;
+    detector->evento.velocidade = posicao->speed;
+    acompanhaBuraco (&detector->evento, vertical, jerk);
+    return 0;
+}
+
+/**
+ * Escreve um inteiro de 32 bits em big-endian
+ */
+static uint8_t *escreve32 (uint8_t *saida, uint32_t valor) {
+    saida[0] = valor >> 24;
+    saida[1] = valor >> 16;
+    saida[2] = valor >> 8;
+    saida[3] = valor;
+    return saida + 4;
+}
+
+int codificaAvisoBuraco (const eventoBuraco *evento, uint8_t *saida) {
+    uint32_t velocidade = (evento->velocidade * 36 + 5000) / 10000;     // km/h
+    uint16_t pico = evento->pico / 10;                                  // cm/s²
+    uint8_t *p = saida;
+
+    *p++ = evento->tipo;
+    p = escreve32 (p, (uint32_t)evento->latitude);
+    p = escreve32 (p, (uint32_t)evento->longitude);
+    *p++ = velocidade > 255 ? 255 : velocidade;
+    *p++ = pico >> 8;
+    *p++ = pico;
+    p = escreve32 (p, (uint32_t)(evento->instante / 1000));
+    return p - saida;
+}
+
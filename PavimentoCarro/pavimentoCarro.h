@@ -0,0 +1,400 @@
+/**
+ * pavimentoCarro.h       v0.0        17-10-2026
+ *
+ * Orientador: Elias Teodoro da Silva Junior
+ * Autores: Felipe Moura de Castro e Joao Bruno Costa Cruz,
+ * Instituto Federal de Educação, Ciência e Tecnologia do Ceará (IFCE) - Campus Fortaleza
+ *
+ * @Opensource
+ * Este código-fonte pode ser utilizado, copiado, estudado, modificado e redistribuído sem restrições.
+ *
+ * Copyright (c) 2019, Felipe Moura de Castro e Joao Bruno Costa Cruz.
+ *
+ */
+
+#ifndef _PAVIMENTO_CARRO_H_
+#define _PAVIMENTO_CARRO_H_
+
+#include "mbed.h"
+#include "FilaCarro/filaCarro.h"
+#include "MPU6050.h"
+#include "GPS_Carro/GPS_Carro.h"
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * Irregularidade do pavimento
+ *
+ * A aceleração vertical (sem a gravidade, dada pelo estimador de atitude) é processada em blocos de
+ * PAVIMENTO_BLOCO amostras por uma cascata de biquads: um passa-altas que remove o nível contínuo que resta
+ * (bias do acelerômetro, erro de atitude) e um passa-baixas que limita o sinal à faixa da suspensão. O valor
+ * RMS da aceleração filtrada é acumulado a cada trecho de PAVIMENTO_TRECHO_MM percorrido (distância do
+ * odômetro) e entregue com a posição do fim do trecho.
+ * Parado ou abaixo de PAVIMENTO_VELOCIDADE_MINIMA, as amostras não entram no RMS (vibração do motor em
+ * marcha lenta não é irregularidade).
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+#define PAVIMENTO_BLOCO                 32
+#define PAVIMENTO_TRECHO_MM             10000       // 10 m
+#define PAVIMENTO_VELOCIDADE_MINIMA     2778        // mm/s (10 km/h)
+#define PAVIMENTO_PASSA_ALTA_HZ         1.0f
+#define PAVIMENTO_PASSA_BAIXA_HZ        25.0f
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * @brief   Cascata de biquads na forma direta II transposta, em float32
+ *
+ * Os coeficientes seguem a ordem do CMSIS-DSP (arm_biquad_cascade_df2T_f32): b0, b1, b2, a1, a2 por estágio,
+ * com a1 e a2 já com o sinal trocado (y = b0 x + b1 x[-1] + b2 x[-2] + a1 y[-1] + a2 y[-2]).
+ *
+ * @var estagios                      quantidade de estágios
+ * @var coeficientes                  5 coeficientes por estágio
+ * @var estado                        2 variáveis de estado por estágio
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+#define BIQUAD_MAX_ESTAGIOS     4
+
+typedef struct {
+    uint8_t estagios;
+    float coeficientes[5 * BIQUAD_MAX_ESTAGIOS];
+    float estado[2 * BIQUAD_MAX_ESTAGIOS];
+} biquadCascata;
+
+/**
+ * Tipos de estágio
+ */
+#define BIQUAD_PASSA_BAIXA      'L'
+#define BIQUAD_PASSA_ALTA       'H'
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * @brief   Irregularidade de um trecho
+ *
+ * @var latitude                      posição no fim do trecho (graus * 10^7)
+ * @var longitude                     posição no fim do trecho (graus * 10^7)
+ * @var instante                      tempo Unix do fim do trecho em milissegundos (0 se sem relógio)
+ * @var velocidade                    velocidade média no trecho (mm/s)
+ * @var rms                           RMS da aceleração vertical filtrada (mm/s²)
+ * @var pico                          maior valor absoluto da aceleração vertical filtrada (mm/s²)
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+typedef struct {
+    int32_t latitude;
+    int32_t longitude;
+    uint64_t instante;
+    uint32_t velocidade;
+    uint16_t rms;
+    uint16_t pico;
+} trechoPavimento;
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * @brief   Estimador de irregularidade
+ *
+ * @var filtro                        passa-altas + passa-baixas
+ * @var taxaHz                        taxa de amostragem (Hz)
+ * @var filtrado                      bloco filtrado (área de trabalho)
+ * @var somaDosQuadrados              soma dos quadrados das amostras do trecho ((m/s²)²)
+ * @var pico                          maior valor absoluto do trecho (m/s²)
+ * @var amostras                      amostras acumuladas no trecho (em movimento)
+ * @var inicioDoTrecho                distância do odômetro no início do trecho (mm)
+ * @var iniciado                      indica se o filtro e o trecho já foram iniciados
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+typedef struct {
+    biquadCascata filtro;
+    float taxaHz;
+    float filtrado[PAVIMENTO_BLOCO];
+    float somaDosQuadrados;
+    float pico;
+    uint32_t amostras;
+    uint32_t inicioDoTrecho;
+    bool iniciado;
+} pavimentoCarro;
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * Tamanho da fila de trechos (deve ser potência de 2)
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+#define TAMANHO_FILA_PAVIMENTO 16
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * @brief   Fila de trechos (filaCarro) com um único produtor e um único consumidor
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+typedef filaCarro<trechoPavimento, TAMANHO_FILA_PAVIMENTO> filaPavimento;
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * Buracos e lombadas
+ *
+ * O detector recebe, amostra a amostra, a leitura bruta da MPU6050 e a aceleração vertical já filtrada pelo
+ * estimador de irregularidade. As últimas BURACO_HISTORICO leituras brutas ficam em um vetor circular. O
+ * disparo ocorre quando o valor absoluto da aceleração ou do jerk (derivada da aceleração) passa de um limiar
+ * que cresce com a velocidade: o mesmo buraco produz acelerações maiores quanto mais rápido o carro passa.
+ *
+ * No disparo, uma janela da fila de capturas é reservada. Durante as BURACO_POS_AMOSTRAS seguintes, cada
+ * amostra nova é gravada na janela junto com uma das BURACO_PRE_AMOSTRAS anteriores ao disparo, copiada do
+ * vetor circular antes de ser sobrescrita. O custo por amostra é constante e não há alocação; a janela é
+ * publicada completa na fila ao fim da captura.
+ *
+ * O tipo é dado pelo sinal da aceleração no disparo: a roda cai no buraco (aceleração vertical negativa)
+ * e sobe na lombada (positiva). Os limiares devem ser ajustados no carro.
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+#define BURACO_PRE_AMOSTRAS             200         // 200 ms a 1 kHz
+#define BURACO_POS_AMOSTRAS             300         // 300 ms a 1 kHz (não menor que BURACO_PRE_AMOSTRAS)
+#define BURACO_JANELA                   (BURACO_PRE_AMOSTRAS + BURACO_POS_AMOSTRAS)
+#define BURACO_HISTORICO                256         // potência de 2 maior que BURACO_PRE_AMOSTRAS
+
+#define BURACO_PICO_MINIMO              3.0f        // m/s² parado
+#define BURACO_PICO_POR_VELOCIDADE      0.1f        // m/s² a mais por m/s
+#define BURACO_JERK_MINIMO              400.0f      // m/s³ parado
+#define BURACO_JERK_POR_VELOCIDADE      10.0f       // m/s³ a mais por m/s
+
+/**
+ * Tipos de evento
+ */
+#define BURACO_BURACO                   'B'
+#define BURACO_LOMBADA                  'L'
+
+/**
+ * Tamanho do aviso enviado pela rede LoRa (codificaAvisoBuraco)
+ */
+#define BURACO_TAMANHO_AVISO            16
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * @brief   Resumo de um buraco ou lombada
+ *
+ * @var numero                        número do evento desde a inicialização
+ * @var tipo                          BURACO_BURACO ou BURACO_LOMBADA
+ * @var latitude                      posição no disparo (graus * 10^7)
+ * @var longitude                     posição no disparo (graus * 10^7)
+ * @var instante                      tempo Unix do disparo em milissegundos (0 se sem relógio)
+ * @var velocidade                    velocidade no disparo (mm/s)
+ * @var pico                          maior valor absoluto da aceleração vertical filtrada após o disparo (mm/s²)
+ * @var jerk                          maior valor absoluto do jerk após o disparo (m/s³)
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+typedef struct {
+    uint32_t numero;
+    char tipo;
+    int32_t latitude;
+    int32_t longitude;
+    uint64_t instante;
+    uint32_t velocidade;
+    uint16_t pico;
+    uint16_t jerk;
+} eventoBuraco;
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * @brief   Janela capturada em torno de um evento
+ *
+ * @var evento                        resumo do evento
+ * @var amostras                      leituras brutas da MPU6050; o disparo é a amostra BURACO_PRE_AMOSTRAS - 1
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+typedef struct {
+    eventoBuraco evento;
+    MPU6050Motion6 amostras[BURACO_JANELA];
+} capturaBuraco;
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * Tamanho da fila de capturas (deve ser potência de 2; cada janela ocupa cerca de 7 kB)
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+#define TAMANHO_FILA_BURACO 2
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * @brief   Fila de capturas (filaCarro) com um único produtor e um único consumidor. Para não copiar as janelas, o
+ *          produtor preenche a janela diretamente na fila (reservaNaFila / publicaNaFila) e o consumidor a lê no
+ *          lugar (consultaFila / liberaDaFila). perdidos conta os eventos sem janela por falta de espaço.
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+typedef filaCarro<capturaBuraco, TAMANHO_FILA_BURACO> filaBuraco;
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * Tamanho da fila de avisos (deve ser potência de 2)
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+#define TAMANHO_FILA_AVISO_BURACO 8
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * @brief   Fila de resumos dos avisos (filaCarro) com um único produtor e um único consumidor
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+typedef filaCarro<eventoBuraco, TAMANHO_FILA_AVISO_BURACO> filaAvisoBuraco;
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * @brief   Detector de buracos e lombadas
+ *
+ * @var historico                     últimas leituras brutas (vetor circular)
+ * @var escritas                      total de leituras gravadas no histórico
+ * @var anterior                      aceleração vertical filtrada da amostra anterior (m/s²)
+ * @var taxaHz                        taxa de amostragem (Hz)
+ * @var captura                       janela em preenchimento (NULL se não há janela)
+ * @var inicioDaCaptura               índice no histórico da primeira amostra anterior ao disparo
+ * @var restantes                     amostras que faltam depois do disparo (0 = armado)
+ * @var evento                        resumo do evento em captura
+ * @var eventos                       eventos detectados
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+typedef struct {
+    MPU6050Motion6 historico[BURACO_HISTORICO];
+    uint32_t escritas;
+    float anterior;
+    float taxaHz;
+    capturaBuraco *captura;
+    uint32_t inicioDaCaptura;
+    uint16_t restantes;
+    eventoBuraco evento;
+    uint32_t eventos;
+} detectorBuraco;
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * Protótipo das funções
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * @brief Inicializa uma cascata de biquads vazia
+ *
+ * @param filtro        ponteiro para a cascata
+ *
+ * @return                      Não retorna nada.
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+void iniciaBiquad (biquadCascata *filtro);
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * @brief Acrescenta um estágio de 2ª ordem (Butterworth com q = 0,7071) à cascata
+ *
+ * @param filtro        ponteiro para a cascata
+ * @param tipo          BIQUAD_PASSA_BAIXA ou BIQUAD_PASSA_ALTA
+ * @param corteHz       frequência de corte (Hz)
+ * @param taxaHz        taxa de amostragem (Hz)
+ * @param q             fator de qualidade
+ *
+ * @return                      1 se o estágio foi acrescentado; 0 se a cascata já tem BIQUAD_MAX_ESTAGIOS.
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+int acrescentaBiquad (biquadCascata *filtro, char tipo, float corteHz, float taxaHz, float q);
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * @brief Leva o estado da cascata ao regime permanente para uma entrada constante (evita o transiente
+ *        inicial, por exemplo o degrau da gravidade no passa-altas)
+ *
+ * @param filtro        ponteiro para a cascata
+ * @param entrada       valor constante da entrada
+ *
+ * @return                      Não retorna nada.
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+void preparaBiquad (biquadCascata *filtro, float entrada);
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * @brief Filtra um bloco de amostras (a entrada e a saída podem ser o mesmo vetor)
+ *
+ * @param filtro        ponteiro para a cascata
+ * @param entrada       amostras de entrada
+ * @param saida         amostras filtradas
+ * @param n             quantidade de amostras
+ *
+ * @return                      Não retorna nada.
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+void filtraBiquad (biquadCascata *filtro, const float *entrada, float *saida, int n);
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * @brief Inicializa o estimador de irregularidade
+ *
+ * @param pavimento     ponteiro para o estimador
+ * @param taxaHz        taxa de amostragem da aceleração (Hz)
+ *
+ * @return                      Não retorna nada.
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+void iniciaPavimento (pavimentoCarro *pavimento, float taxaHz);
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * @brief Processa um bloco de aceleração vertical e encerra o trecho quando a distância chega a PAVIMENTO_TRECHO_MM
+ *
+ * A distância é comparada só pela diferença em 32 bits sem sinal (distanciaMm - inicioDoTrecho). Os 32 bits baixos
+ * do odômetro dão a volta a cada 2^32 mm (cerca de 4295 km), e a diferença continua correta na volta desde que
+ * entre duas chamadas o carro ande menos que isso.
+ *
+ * @param pavimento     ponteiro para o estimador
+ * @param bloco         aceleração vertical (m/s²), até PAVIMENTO_BLOCO amostras
+ * @param n             quantidade de amostras do bloco
+ * @param distanciaMm   32 bits baixos da distância total do odômetro (mm), lida com leDistanciaOdometro
+ * @param posicao       posição e velocidade atuais (fix ou estimativa da navegação)
+ * @param instante      tempo Unix atual em milissegundos (0 se sem relógio)
+ * @param trecho        ponteiro para a struct que recebe o trecho encerrado
+ *
+ * @return                      1 se um trecho foi encerrado (trecho preenchido); 0 caso contrário.
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+int processaPavimento (pavimentoCarro *pavimento, const float *bloco, int n, uint32_t distanciaMm,
+                       const dataGPS *posicao, uint64_t instante, trechoPavimento *trecho);
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * @brief Inicializa o detector de buracos (armado, histórico vazio)
+ *
+ * @param detector      ponteiro para o detector
+ * @param taxaHz        taxa de amostragem (Hz)
+ *
+ * @return                      Não retorna nada.
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+void iniciaDetectorBuraco (detectorBuraco *detector, float taxaHz);
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * @brief Processa uma amostra. Deve ser chamada a cada amostra, na taxa de amostragem.
+ *
+ * @param detector      ponteiro para o detector
+ * @param fila          fila onde as janelas são capturadas
+ * @param amostra       leitura bruta da MPU6050
+ * @param vertical      aceleração vertical filtrada da mesma amostra (m/s², pavimentoCarro::filtrado)
+ * @param posicao       posição e velocidade atuais (fix ou estimativa da navegação)
+ * @param instante      tempo Unix atual em milissegundos (0 se sem relógio)
+ * @param evento        ponteiro para a struct que recebe o resumo quando uma captura termina
+ *
+ * @return                      1 se uma captura terminou (evento preenchido e janela publicada na fila, ou
+ *                              descartada se a fila estava cheia no disparo); 0 caso contrário.
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+int detectaBuraco (detectorBuraco *detector, filaBuraco *fila, const MPU6050Motion6 *amostra, float vertical,
+                   const dataGPS *posicao, uint64_t instante, eventoBuraco *evento);
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * @brief Codifica um resumo para envio pela rede LoRa: tipo (1 byte), latitude e longitude (4 bytes cada,
+ *        graus * 10^7), velocidade (1 byte, km/h), pico (2 bytes, cm/s²) e instante (4 bytes, tempo Unix em
+ *        segundos), com os inteiros em big-endian
+ *
+ * @param evento        resumo do evento
+ * @param saida         vetor de BURACO_TAMANHO_AVISO bytes
+ *
+ * @return                      quantidade de bytes escritos (BURACO_TAMANHO_AVISO).
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+int codificaAvisoBuraco (const eventoBuraco *evento, uint8_t *saida);
+
+#endif /*_PAVIMENTO_CARRO_H_*/
@@ -1,172 +1,206 @@
-/**
- * payloadCarro.h       v0.0        08-10-2019 
- *
- * Orientador: Elias Teodoro da Silva Junior
- * Autor: Joao Bruno Costa Cruz,
- * Instituto Federal de Educação, Ciência e Tecnologia do Ceará (IFCE) - Campus Fortaleza
- *
- * @Opensource
- * Este código-fonte pode ser utilizado, copiado, estudado, modificado e redistribuído sem restrições.
- *
- * Copyright (c) 2019, Joao Bruno Costa Cruz.
- *
- */
-
-/** 
- *----------------------------------------------------------------------------------------------------------------------
- * No projeto, tinha-se a ideia de adicionar os seguintes
- * dados posteriormente (obtidos via rede CAN de um carro):
- * 
- * Velocidade - 1 float
- * Rotacao - 1 float
- * Temperatura da agua - 1 float
- * Posicao da borboleta	- 1 float
- * Pressao do coletor de admissao - 1 float  
- *----------------------------------------------------------------------------------------------------------------------
- */
-
-
-/**
- *----------------------------------------------------------------------------------------------------------------------
- * INCLUSÃO DE BIBLIOTECAS E DIRETIVAS 'DEFINE'
- *----------------------------------------------------------------------------------------------------------------------
- */
-
-#ifndef _PAYLOAD_CARRO_H_
-#define _PAYLOAD_CARRO_H_
-
-#include "mbed.h"
- 
-#define QUANTIDADE_DE_DADOS 28
-
-/**
- *----------------------------------------------------------------------------------------------------------------------
- * Classe de implementação do buffer de envio na rede LoRa
- * O buffer pode ter tamanho de no máximo 64 bytes (isso depende
- * das configurações LoRa, mas no meu caso é 64 bytes).
- * Se o seu buffer é maior ou menor, essa quantidade pode (ou deve)
- * ser alterada nessa classe também em: QUANTIDADE_DE_DADOS.
- *----------------------------------------------------------------------------------------------------------------------
- */
-class PayLoadCarro {
-	public:
-        //Outros dados podem ser adicionados (ou excluídos), contanto que não ultrapasse um total de 64 bytes		
-
-        /**
-        *----------------------------------------------------------------------------------------------------------------------
-        * Adiciona os dados de um acelerometro ao buffer de envio
-        *
-        * Cada um dos eixos é passado como parametro para função 
-        * A precisão é de duas casas decimais, o programador pode 
-        * ficar a vontade para aumentar essa quantidade tomando 
-        * cuidado para não exceder o tamanho do buffer (64 bytes).    
-        *
-        * @param x                     aceleração 1
-        * @param y                     aceleração 2
-        * @param z                     aceleração 3
-        *
-        * @return                      Não retorna nada, apenas
-        *                              adiciona os valores de aceleração
-        *                              ao buffer de envio ('dados[]')
-        *----------------------------------------------------------------------------------------------------------------------
-        */
-		uint8_t addAccelerometer (float x, float y, float z);
-
-        /**
-        *----------------------------------------------------------------------------------------------------------------------
-        * Adiciona os dados de um sensor de temperatura ao buffer
-        *
-        * A temperatura pode ser passada em qualquer escala
-        * A precisão é de duas casas decimais, o programador pode 
-        * ficar a vontade para aumentar essa quantidade tomando 
-        * cuidado para não exceder o tamanho do buffer (64 bytes).
-        *
-        * @param temperatura           o valor da temperatura a ser adicionado    
-        *
-        * @return                      Não retorna nada, apenas
-        *                              adiciona o valor de temperatura
-        *                              ao buffer de envio ('dados[]')
-        *----------------------------------------------------------------------------------------------------------------------
-        */
-		uint8_t addTemperature (float temperatura);
-        
-        /**
-        *----------------------------------------------------------------------------------------------------------------------
-        * Adiciona os dados de um calenderio e relogio ao buffer
-        *
-        * Os dados de um calendario e de relogio são passados como parametros
-        * para serem adicionados ao buffer de nvio.
-        *        
-        * @param dia                     Dia do ano [Dom..Sab]
-        * @param mes                     Mes do ano [Jan..Dez]
-        * @param ano                     Ano        [2000..2099]
-        * @param hora                    Formato escolhido de acordo com a necessidade [12h - 24h]
-        * @param minuto                  Minutos    [0..59]
-        * @param segundo                 Segundos   [0..59]
-        *
-        * @return                        Não retorna nada, apenas
-        *                                adiciona os valores de tempo
-        *                                ao buffer de envio ('dados[]')
-        *----------------------------------------------------------------------------------------------------------------------
-        */
-		uint8_t addRTC (uint8_t dia, uint8_t mes, uint16_t ano, uint8_t hora, uint8_t minuto, uint8_t segundo);
-
-        /**
-        *----------------------------------------------------------------------------------------------------------------------
-        * Adiciona os dados de um GPS ao buffer de envio
-        *
-        * Latitude, Longitude e Velocidade são passados como parametros para a função 
-        * A precisão é de duas casas decimais, o programador pode 
-        * ficar a vontade para aumentar essa quantidade tomando 
-        * cuidado para não exceder o tamanho do buffer (64 bytes).    
-        *
-        * @param Longitude                    Longitude
-        * @param Latitude                     Latitude
-        * @param Velocidade                   Velocidade
-        *
-        * @return                      Não retorna nada, apenas
-        *                              adiciona os valores de Longitude, Latitude e Velocidade
-        *                              ao buffer de envio ('dados[]')
-        *----------------------------------------------------------------------------------------------------------------------
-        */
-		uint8_t addGPS (double Latitude, double Longitude, double Velocidade);		
-
-        /**
-        *----------------------------------------------------------------------------------------------------------------------
-        * Adiciona os dados de um calenderio e relogio, oriundos de um GPS, ao buffer
-        *
-        * Os dados de um calendario e de relogio são passados como parametros
-        * para serem adicionados ao buffer de envio.
-        *        
-        * @param dia                     Dia do ano [01..31]
-        * @param mes                     Mes do ano [Jan..Dez]
-        * @param ano                     Ano        [2000..2099]
-        * @param hora                    Formato escolhido de acordo com a necessidade [12h - 24h]
-        * @param minuto                  Minutos    [0..59]
-        * @param segundo                 Segundos   [0..59]
-        *
-        * @return                        Não retorna nada, apenas
-        *                                adiciona os valores de tempo
-        *                                ao buffer de envio ('dados[]')
-        *----------------------------------------------------------------------------------------------------------------------
-        */
-        uint8_t addGPSData (uint8_t dia, uint8_t mes, uint16_t ano, uint8_t hora, uint8_t minuto, uint8_t segundo);
-
-    public:
-        /**
-        *----------------------------------------------------------------------------------------------------------------------
-        * Distruibuição dos dados no buffer
-        *
-        * acelerometro - bytes 0 a 8
-        * temperatura  - bytes 9 a 11
-        * relogio      - bytes 12 a 18
-        * Latitude      - bytes 19 a 21
-        * Longitude      - bytes 22 a 24
-        * Velocidade      - bytes 25 a 27
-        *----------------------------------------------------------------------------------------------------------------------
-        */
-        uint8_t dados[QUANTIDADE_DE_DADOS];
-        uint8_t tamanho = QUANTIDADE_DE_DADOS;        
-};
-  
-#endif /*_PAYLOAD_CARRO_H_*/
+/**
+ * payloadCarro.h       v0.0        08-10-2019 
+ *
+ * Orientador: Elias Teodoro da Silva Junior
+ * Autor: Joao Bruno Costa Cruz,
+ * Instituto Federal de Educação, Ciência e Tecnologia do Ceará (IFCE) - Campus Fortaleza
+ *
+ * @Opensource
+ * Este código-fonte pode ser utilizado, copiado, estudado, modificado e redistribuído sem restrições.
+ *
+ * Copyright (c) 2019, Joao Bruno Costa Cruz.
+ *
+ */
+
+/** 
+ *----------------------------------------------------------------------------------------------------------------------
+ * No projeto, tinha-se a ideia de adicionar os seguintes
+ * dados posteriormente (obtidos via rede CAN de um carro):
+ * 
+ * Velocidade - 1 float
+ * Rotacao - 1 float
+ * Temperatura da agua - 1 float
+ * Posicao da borboleta	- 1 float
+ * Pressao do coletor de admissao - 1 float  
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * INCLUSÃO DE BIBLIOTECAS E DIRETIVAS 'DEFINE'
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+
+#ifndef _PAYLOAD_CARRO_H_
+#define _PAYLOAD_CARRO_H_
+
+#include "mbed.h"
+ 
+#define QUANTIDADE_DE_DADOS 37
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * Classe de implementação do buffer de envio na rede LoRa
+ * O buffer pode ter tamanho de no máximo 64 bytes (isso depende
+ * das configurações LoRa, mas no meu caso é 64 bytes).
+ * Se o seu buffer é maior ou menor, essa quantidade pode (ou deve)
+ * ser alterada nessa classe também em: QUANTIDADE_DE_DADOS.
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+class PayLoadCarro {
+	public:
+        //Outros dados podem ser adicionados (ou excluídos), contanto que não ultrapasse um total de 64 bytes		
+
+        /**
+        *----------------------------------------------------------------------------------------------------------------------
+        * Adiciona os dados de um acelerometro ao buffer de envio
+        *
+        * Cada um dos eixos é passado como parametro para função 
+        * A precisão é de duas casas decimais, o programador pode 
+        * ficar a vontade para aumentar essa quantidade tomando 
+        * cuidado para não exceder o tamanho do buffer (64 bytes).    
+        *
+        * @param x                     aceleração 1
+        * @param y                     aceleração 2
+        * @param z                     aceleração 3
+        *
+        * @return                      Não retorna nada, apenas
+        *                              adiciona os valores de aceleração
+        *                              ao buffer de envio ('dados[]')
+        *----------------------------------------------------------------------------------------------------------------------
+        */
+		uint8_t addAccelerometer (float x, float y, float z);
+
+        /**
+        *----------------------------------------------------------------------------------------------------------------------
+        * Adiciona os dados de um sensor de temperatura ao buffer
+        *
+        * A temperatura pode ser passada em qualquer escala
+        * A precisão é de duas casas decimais, o programador pode 
+        * ficar a vontade para aumentar essa quantidade tomando 
+        * cuidado para não exceder o tamanho do buffer (64 bytes).
+        *
+        * @param temperatura           o valor da temperatura a ser adicionado    
+        *
+        * @return                      Não retorna nada, apenas
+        *                              adiciona o valor de temperatura
+        *                              ao buffer de envio ('dados[]')
+        *----------------------------------------------------------------------------------------------------------------------
+        */
+		uint8_t addTemperature (float temperatura);
+        
+        /**
+        *----------------------------------------------------------------------------------------------------------------------
+        * Adiciona os dados de um calenderio e relogio ao buffer
+        *
+        * Os dados de um calendario e de relogio são passados como parametros
+        * para serem adicionados ao buffer de nvio.
+        *        
+        * @param dia                     Dia do ano [Dom..Sab]
+        * @param mes                     Mes do ano [Jan..Dez]
+        * @param ano                     Ano        [2000..2099]
+        * @param hora                    Formato escolhido de acordo com a necessidade [12h - 24h]
+        * @param minuto                  Minutos    [0..59]
+        * @param segundo                 Segundos   [0..59]
+        *
+        * @return                        Não retorna nada, apenas
+        *                                adiciona os valores de tempo
+        *                                ao buffer de envio ('dados[]')
+        *----------------------------------------------------------------------------------------------------------------------
+        */
+		uint8_t addRTC (uint8_t dia, uint8_t mes, uint16_t ano, uint8_t hora, uint8_t minuto, uint8_t segundo);
+
+        /**
+        *----------------------------------------------------------------------------------------------------------------------
+        * Adiciona os dados de um GPS ao buffer de envio
+        *
+        * Latitude, Longitude e Velocidade são passados como parametros para a função 
+        * (inteiros em ponto fixo, no mesmo formato da estrutura dataGPS)
+        * A precisão é de duas casas decimais, o programador pode 
+        * ficar a vontade para aumentar essa quantidade tomando 
+        * cuidado para não exceder o tamanho do buffer (64 bytes).    
+        *
+        * @param Longitude                    Longitude em graus * 10^7
+        * @param Latitude                     Latitude em graus * 10^7
+        * @param Velocidade                   Velocidade em mm/s (enviada em km/h)
+        *
+        * @return                      Não retorna nada, apenas
+        *                              adiciona os valores de Longitude, Latitude e Velocidade
+        *                              ao buffer de envio ('dados[]')
+        *----------------------------------------------------------------------------------------------------------------------
+        */
+		uint8_t addGPS (int32_t Latitude, int32_t Longitude, int32_t Velocidade);		
+
+        /**
+        *----------------------------------------------------------------------------------------------------------------------
+        * Adiciona os dados de um calenderio e relogio, oriundos de um GPS, ao buffer
+        *
+        * Os dados de um calendario e de relogio são passados como parametros
+        * para serem adicionados ao buffer de envio.
+        *        
+        * @param dia                     Dia do ano [01..31]
+        * @param mes                     Mes do ano [Jan..Dez]
+        * @param ano                     Ano        [2000..2099]
+        * @param hora                    Formato escolhido de acordo com a necessidade [12h - 24h]
+        * @param minuto                  Minutos    [0..59]
+        * @param segundo                 Segundos   [0..59]
+        *
+        * @return                        Não retorna nada, apenas
+        *                                adiciona os valores de tempo
+        *                                ao buffer de envio ('dados[]')
+        *----------------------------------------------------------------------------------------------------------------------
+        */
+        uint8_t addGPSData (uint8_t dia, uint8_t mes, uint16_t ano, uint8_t hora, uint8_t minuto, uint8_t segundo);
+
+        /**
+        *----------------------------------------------------------------------------------------------------------------------
+        * Adiciona as bandas do espectro da vibração ao buffer de envio
+        *
+        * Cada banda ocupa 1 byte, em unidades de 0,02 m/s² (até 5,1 m/s²; valores maiores são saturados).
+        * São enviadas no máximo 6 bandas.
+        *
+        * @param bandas                       aceleração RMS de cada banda em mm/s² (mediaEspectro)
+        * @param quantidade                   quantidade de bandas
+        *
+        * @return                      Não retorna nada, apenas
+        *                              adiciona as bandas ao buffer de envio ('dados[]')
+        *----------------------------------------------------------------------------------------------------------------------
+        */
+        uint8_t addEspectro (const uint16_t *bandas, uint8_t quantidade);
+
+        /**
+        *----------------------------------------------------------------------------------------------------------------------
+        * Adiciona os eventos de condução brusca desde o envio anterior ao buffer de envio
+        *
+        * Um byte por tipo (frenagem, aceleração e curva): eventos normais no nibble alto e severos no
+        * nibble baixo, até 15 de cada.
+        *
+        * @param contagens                    3 bytes codificados por codificaConducao
+        *
+        * @return                      Não retorna nada, apenas
+        *                              adiciona as contagens ao buffer de envio ('dados[]')
+        *----------------------------------------------------------------------------------------------------------------------
+        */
+        uint8_t addConducao (const uint8_t *contagens);
+
+    public:
+        /**
+        *----------------------------------------------------------------------------------------------------------------------
+        * Distruibuição dos dados no buffer
+        *
+        * acelerometro - bytes 0 a 8
+        * temperatura  - bytes 9 a 11
+        * relogio      - bytes 12 a 18
+        * Latitude      - bytes 19 a 21
+        * Longitude      - bytes 22 a 24
+        * Velocidade      - bytes 25 a 27
+        * Espectro      - bytes 28 a 33
+        * Conducao      - bytes 34 a 36
+        *----------------------------------------------------------------------------------------------------------------------
+        */
+        uint8_t dados[QUANTIDADE_DE_DADOS];
+        uint8_t tamanho = QUANTIDADE_DE_DADOS;        
+};
+  
+#endif /*_PAYLOAD_CARRO_H_*/
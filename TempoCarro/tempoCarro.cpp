@@ -0,0 +1,207 @@
+/**
+ * tempoCarro.cpp       v0.0        17-10-2026
+ *
+ * Orientador: Elias Teodoro da Silva Junior
+ * Autores: Felipe Moura de Castro e Joao Bruno Costa Cruz,
+ * Instituto Federal de Educação, Ciência e Tecnologia do Ceará (IFCE) - Campus Fortaleza
+ *
+ * @Opensource
+ * Este código-fonte pode ser utilizado, copiado, estudado, modificado e redistribuído sem restrições.
+ *
+ * Copyright (c) 2019, Felipe Moura de Castro e Joao Bruno Costa Cruz.
+ *
+ */
+
+#include "tempoCarro.h"
+
+// Converte dois caracteres decimais em número
+static inline uint8_t doisDigitos (const char *texto) {
+    return (uint8_t)((texto[0] - '0') * 10 + (texto[1] - '0'));
+}
+
+void iniciaRelogio (relogioGPS *relogio) {
+    memset (relogio, 0, sizeof (relogioGPS));
+}
+
+uint64_t tempoDoFix (const dataGPS *fix) {
+    int i;
+
+    for (i = 0; i < 6; i++) {
+        if (fix->date[i] < '0' || fix->date[i] > '9') {
+            return 0;
+        }
+    }
+
+    // ddmmaa e hhmmss (UTC) -> tempo Unix
+    DateTime instante (2000 + doisDigitos (&fix->date[4]), doisDigitos (&fix->date[2]), doisDigitos (&fix->date[0]),
+                       fix->time / 10000, (fix->time / 100) % 100, fix->time % 100);
+    return (uint64_t)instante.unixtime () * 1000 + fix->millisecond;
+}
+
+int sincronizaRelogio (relogioGPS *relogio, const dataGPS *fix, uint64_t contadorMs) {
+    // Conversão feita uma única vez por fix
+    uint64_t milissegundos = tempoDoFix (fix);
+
+    if (milissegundos == 0) {
+        return 0;
+    }
+
+    relogio->sequencia++;
+    __DMB ();
+    relogio->milissegundosDoFix = milissegundos;
+    relogio->contadorDoFix = contadorMs;
+    relogio->sincronizado = true;
+    relogio->origem = RELOGIO_GPS;
+    __DMB ();
+    relogio->sequencia++;
+    return 1;
+}
+
+int sincronizaRelogioRTC (relogioGPS *relogio, RtcDs1307 *rtc, uint64_t contadorMs) {
+    DateTime agora;
+
+    if (relogio->origem == RELOGIO_GPS || !rtc->isRunning ()) {
+        return 0;
+    }
+    agora = rtc->now ();
+    if (agora.year () < PARTIDA_ANO_MINIMO) {
+        return 0;
+    }
+
+    relogio->sequencia++;
+    __DMB ();
+    relogio->milissegundosDoFix = (uint64_t)agora.unixtime () * 1000;
+    relogio->contadorDoFix = contadorMs;
+    relogio->sincronizado = true;
+    relogio->origem = RELOGIO_RTC;
+    __DMB ();
+    relogio->sequencia++;
+    return 1;
+}
+
+int ajustaRTC (const relogioGPS *relogio, RtcDs1307 *rtc, uint64_t contadorMs) {
+    uint32_t segundos, rtcS;
+
+    if (relogio->origem != RELOGIO_GPS) {
+        return 0;
+    }
+    segundos = (uint32_t)(tempoEmMs (relogio, contadorMs) / 1000);
+    rtcS = rtc->isRunning () ? rtc->now ().unixtime () : 0;
+    if (rtcS + PARTIDA_DIFERENCA_RTC_S > segundos && segundos + PARTIDA_DIFERENCA_RTC_S > rtcS) {
+        return 0;
+    }
+    return rtc->adjust (DateTime (segundos)) ? 1 : 0;
+}
+
+// Soma de verificação do registro: CRC-8 (polinômio 0x07), que detecta qualquer bit trocado; a Fletcher-16 reduzida
+// a 8 bits usada antes (a ^ b) deixava passar parte deles
+static uint8_t somaDaPartida (const uint8_t *dados, int n) {
+    uint8_t crc = 0;
+    int i, b;
+
+    for (i = 0; i < n; i++) {
+        crc ^= dados[i];
+        for (b = 0; b < 8; b++) {
+            crc = (crc & 0x80) ? (uint8_t)((crc << 1) ^ 0x07) : (uint8_t)(crc << 1);
+        }
+    }
+    return crc;
+}
+
+int salvaPartida (RtcDs1307 *rtc, const dataGPS *fix) {
+    partidaGPS partida;
+    uint8_t dados[sizeof (partidaGPS)];
+    uint64_t milissegundos = tempoDoFix (fix);
+    unsigned int i;
+
+    if (fix->valid != 'A' || milissegundos == 0) {
+        return 0;
+    }
+    partida.latitude = fix->latitude;
+    partida.longitude = fix->longitude;
+    partida.altitude = fix->altitude;
+    partida.tempoDoFix = (uint32_t)(milissegundos / 1000);
+    memcpy (dados, &partida, sizeof (dados));
+
+    // Memória do DS1307: marca, registro e CRC-8
+    (*rtc)[0] = PARTIDA_MARCA;
+    for (i = 0; i < sizeof (dados); i++) {
+        (*rtc)[1 + i] = dados[i];
+    }
+    (*rtc)[1 + sizeof (dados)] = somaDaPartida (dados, sizeof (dados));
+    return rtc->commit () ? 1 : 0;
+}
+
+int carregaPartida (RtcDs1307 *rtc, partidaGPS *partida) {
+    uint8_t dados[sizeof (partidaGPS)];
+    unsigned int i;
+
+    // A cópia da memória do DS1307 é lida na construção do RtcDs1307
+    if ((*rtc)[0] != PARTIDA_MARCA) {
+        return 0;
+    }
+    for (i = 0; i < sizeof (dados); i++) {
+        dados[i] = (*rtc)[1 + i];
+    }
+    if ((*rtc)[1 + sizeof (dados)] != somaDaPartida (dados, sizeof (dados))) {
+        return 0;
+    }
+    memcpy (partida, dados, sizeof (partidaGPS));
+    return 1;
+}
+
+void dataHoraDoTempo (uint64_t milissegundos, dataGPS *fix) {
+    DateTime instante ((uint32_t)(milissegundos / 1000));
+
+    fix->time = instante.hour () * 10000L + instante.minute () * 100 + instante.second ();
+    fix->millisecond = (uint16_t)(milissegundos % 1000);
+    // Cada campo limitado a dois dígitos: o texto sempre cabe nos 6 caracteres
+    snprintf (fix->date, sizeof (fix->date), "%02u%02u%02u",
+              instante.day () % 100u, instante.month () % 100u, instante.year () % 100u);
+}
+
+uint64_t tempoEmMs (const relogioGPS *relogio, uint64_t contadorMs) {
+    uint32_t antes;
+    uint64_t milissegundos, contador;
+    bool sincronizado;
+
+    do {
+        antes = relogio->sequencia;
+        __DMB ();
+        milissegundos = relogio->milissegundosDoFix;
+        contador = relogio->contadorDoFix;
+        sincronizado = relogio->sincronizado;
+        __DMB ();
+    } while ((antes & 1) || antes != relogio->sequencia);
+
+    if (!sincronizado) {
+        return 0;
+    }
+    return milissegundos + (contadorMs - contador);
+}
+
+DateTime horaLocal (uint64_t milissegundos) {
+    // Relógio não sincronizado
+    if (milissegundos == 0) {
+        return DateTime (2000, 1, 1);
+    }
+    return DateTime ((uint32_t)(milissegundos / 1000 + FUSO_HORARIO_S));
+}
+
+int dataDoArquivo (uint64_t milissegundos, const char *anterior, char *data) {
+    DateTime agora;
+    int i;
+
+    if (milissegundos != 0) {
+        agora = horaLocal (milissegundos);
+        snprintf (data, 7, "%02u%02u%02u", agora.year () % 100u, agora.month () % 100u, agora.day () % 100u);
+        return 1;
+    }
+
+    // Sem hora: a data anterior só é aproveitada se tiver os 6 dígitos
+    for (i = 0; i < 6 && anterior != NULL && anterior[i] >= '0' && anterior[i] <= '9'; i++) {
+    }
+    memcpy (data, i == 6 ? anterior : "000000", 6);
+    data[6] = '\0';
+    return 0;
+}
@@ -0,0 +1,237 @@
+/**
+ * tempoCarro.h       v0.0        17-10-2026
+ *
+ * Orientador: Elias Teodoro da Silva Junior
+ * Autores: Felipe Moura de Castro e Joao Bruno Costa Cruz,
+ * Instituto Federal de Educação, Ciência e Tecnologia do Ceará (IFCE) - Campus Fortaleza
+ *
+ * @Opensource
+ * Este código-fonte pode ser utilizado, copiado, estudado, modificado e redistribuído sem restrições.
+ *
+ * Copyright (c) 2019, Felipe Moura de Castro e Joao Bruno Costa Cruz.
+ *
+ */
+
+#ifndef _TEMPO_CARRO_H_
+#define _TEMPO_CARRO_H_
+
+#include "mbed.h"
+#include "DateTime.h"
+#include "DS1307.h"
+#include "GPS_Carro/GPS_Carro.h"
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * Serviço de tempo
+ *
+ * A data (ddmmaa) e a hora (hhmmss) de cada fix são convertidas uma única vez, pela DateTime, em
+ * tempo Unix. Entre dois fixes, os milissegundos são obtidos do contador do sistema (Kernel::get_ms_count),
+ * de forma que qualquer amostra de sensor recebe um carimbo de tempo com custo constante, sem
+ * manipular texto.
+ *
+ * Todos os tempos são UTC; o horário local é obtido somando FUSO_HORARIO_S.
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+#define FUSO_HORARIO_S          (-3 * 3600)     // Brasília (UTC-3)
+
+/**
+ * Origem do tempo do relógio
+ */
+#define RELOGIO_GPS             'G'
+#define RELOGIO_RTC             'R'
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * Partida rápida
+ *
+ * O DS1307 mantém a hora (em UTC) e 56 bytes de memória enquanto a placa está desligada, pela bateria.
+ * O último fix bom fica guardado nessa memória. Na inicialização, o relógio começa com a hora do RTC
+ * (a gravação no cartão não precisa esperar o GPS) e a posição guardada e a hora do RTC são enviadas
+ * ao receptor (enviaPartidaUBX). O RTC é acertado pela hora do GPS.
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+#define PARTIDA_MARCA           0xA5            // identifica um registro gravado por este programa
+#define PARTIDA_ANO_MINIMO      2019            // RTC com data anterior é considerado desacertado
+#define PARTIDA_DIFERENCA_RTC_S 2               // diferença a partir da qual o RTC é acertado pelo GPS
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * @brief   Relógio sincronizado pelo GPS
+ *          Escrito apenas pela Thread do GPS e lido por qualquer Thread, com o mesmo controle de
+ *          sequência do publicadorGPS (sem semáforo).
+ *
+ * @var sequencia                     contador de escritas (par quando não há escrita em andamento)
+ * @var milissegundosDoFix            tempo Unix do último fix, em milissegundos
+ * @var contadorDoFix                 valor do contador do sistema (ms) quando o fix foi recebido
+ * @var sincronizado                  indica se o relógio já tem uma hora (do GPS ou do RTC)
+ * @var origem                        RELOGIO_GPS ou RELOGIO_RTC (a hora do GPS sempre prevalece)
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+typedef struct {
+    volatile uint32_t sequencia;
+    uint64_t milissegundosDoFix;
+    uint64_t contadorDoFix;
+    bool sincronizado;
+    volatile char origem;
+} relogioGPS;
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * @brief   Último fix bom, guardado na memória do DS1307
+ *
+ * @var latitude                      graus * 10^7
+ * @var longitude                     graus * 10^7
+ * @var altitude                      mm
+ * @var tempoDoFix                    tempo Unix do fix (s)
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+typedef struct {
+    int32_t latitude;
+    int32_t longitude;
+    int32_t altitude;
+    uint32_t tempoDoFix;
+} partidaGPS;
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * Protótipo das funções
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * @brief Inicializa o relógio (não sincronizado)
+ *
+ * @param relogio       ponteiro para o relógio
+ *
+ * @return                      Não retorna nada.
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+void iniciaRelogio (relogioGPS *relogio);
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * @brief Converte a data e a hora de um fix em tempo Unix
+ *
+ * @param fix           fix com data (ddmmaa), hora (hhmmss, UTC) e milissegundos
+ *
+ * @return                      tempo Unix em milissegundos; 0 se o fix não tem data.
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+uint64_t tempoDoFix (const dataGPS *fix);
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * @brief Sincroniza o relógio com a data e a hora de um fix. Deve ser chamada apenas pela Thread do GPS.
+ *
+ * @param relogio       ponteiro para o relógio
+ * @param fix           fix recebido (a data precisa estar preenchida)
+ * @param contadorMs    valor do contador do sistema (ms) no momento em que o fix foi recebido
+ *
+ * @return                      1 se o relógio foi sincronizado; 0 se o fix não tem data.
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+int sincronizaRelogio (relogioGPS *relogio, const dataGPS *fix, uint64_t contadorMs);
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * @brief Inicia o relógio com a hora do RTC, se ele estiver funcionando e acertado. Não altera um
+ *        relógio já sincronizado pelo GPS.
+ *
+ * @param relogio       ponteiro para o relógio
+ * @param rtc           DS1307 (hora em UTC)
+ * @param contadorMs    valor atual do contador do sistema (ms)
+ *
+ * @return                      1 se o relógio passou a usar a hora do RTC; 0 caso contrário.
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+int sincronizaRelogioRTC (relogioGPS *relogio, RtcDs1307 *rtc, uint64_t contadorMs);
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * @brief Acerta o RTC pela hora do GPS quando a diferença chega a PARTIDA_DIFERENCA_RTC_S
+ *
+ * @param relogio       ponteiro para o relógio
+ * @param rtc           DS1307 (hora em UTC)
+ * @param contadorMs    valor atual do contador do sistema (ms)
+ *
+ * @return                      1 se o RTC foi acertado; 0 caso contrário (sem hora do GPS ou RTC já certo).
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+int ajustaRTC (const relogioGPS *relogio, RtcDs1307 *rtc, uint64_t contadorMs);
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * @brief Guarda um fix na memória do DS1307 (marca, registro e CRC-8, nos bytes 0 a 17)
+ *
+ * @param rtc           DS1307
+ * @param fix           fix válido com data
+ *
+ * @return                      1 se o registro foi gravado; 0 se o fix não serve ou a gravação falhou.
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+int salvaPartida (RtcDs1307 *rtc, const dataGPS *fix);
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * @brief Lê o último fix guardado na memória do DS1307
+ *
+ * @param rtc           DS1307
+ * @param partida       ponteiro para a struct que recebe o registro
+ *
+ * @return                      1 se havia um registro íntegro; 0 caso contrário.
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+int carregaPartida (RtcDs1307 *rtc, partidaGPS *partida);
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * @brief Escreve um tempo Unix na data (ddmmaa) e na hora (hhmmss, UTC) de um dataGPS (inverso de tempoDoFix)
+ *
+ * @param milissegundos tempo Unix em milissegundos
+ * @param fix           ponteiro para a struct que recebe a data e a hora
+ *
+ * @return                      Não retorna nada.
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+void dataHoraDoTempo (uint64_t milissegundos, dataGPS *fix);
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * @brief Retorna o tempo Unix (UTC) em milissegundos, interpolado a partir do último fix
+ *
+ * @param relogio       ponteiro para o relógio
+ * @param contadorMs    valor atual do contador do sistema (ms)
+ *
+ * @return                      tempo Unix em milissegundos; 0 se o relógio ainda não foi sincronizado.
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+uint64_t tempoEmMs (const relogioGPS *relogio, uint64_t contadorMs);
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * @brief Converte um tempo Unix (UTC, em milissegundos) para data e hora locais
+ *
+ * @param milissegundos tempo Unix em milissegundos
+ *
+ * @return                      data e hora locais (FUSO_HORARIO_S); 01/01/2000 00:00:00 se milissegundos = 0.
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+DateTime horaLocal (uint64_t milissegundos);
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * @brief Data local (aammdd) usada no nome dos arquivos do SD. Sem hora (GPS sem fix e RTC parado), mantém a data do
+ *        arquivo anterior, para que as partidas continuem a sequência de sufixos dele em vez de esgotar os de
+ *        01/01/2000.
+ *
+ * @param milissegundos tempo Unix (UTC) em milissegundos; 0 se o relógio não está sincronizado
+ * @param anterior      data do último arquivo (aammdd, do controle.txt); NULL se não há
+ * @param data          recebe a data com o terminador (7 caracteres)
+ *
+ * @return                      1 se a data é a do relógio; 0 se foi mantida a anterior (ou 000000, sem anterior).
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+int dataDoArquivo (uint64_t milissegundos, const char *anterior, char *data);
+
+#endif /*_TEMPO_CARRO_H_*/
@@ -45,7 +45,7 @@
   *
   * Os periférico utilizados no projeto são:
   *         - MPU6050 [I2C]
-  *         - DS1307 RTC (Removido temporariamente - Sua função foi substituída pelo GPS)
+  *         - DS1307 RTC (Guarda a hora e o último fix com a placa desligada, para a partida rápida do GPS)
   *         - Módulo Cartão SD Card micro
   *         - Antena LoRa: SEMTECH - SX1272MB2DAS Shield
   *         - Modulo GPS: NEO-6M-0-001
@@ -117,10 +117,57 @@
 #include <stdio.h>
 #include <errno.h>
 #include "GPS_Carro/GPS_Carro.h"
+#include "NavegacaoCarro/navegacaoCarro.h"
+#include "TempoCarro/tempoCarro.h"
+#include "CercaCarro/cercaCarro.h"
+#include "CercaCarro/gradeDasCercas.h"
+#include "OdometroCarro/odometroCarro.h"
+#include "ImuCarro/imuCarro.h"
+#include "BarramentoCarro/barramentoCarro.h"
+#include "PavimentoCarro/pavimentoCarro.h"
+#include "EspectroCarro/espectroCarro.h"
+#include "AtitudeCarro/atitudeCarro.h"
+#include "CalibracaoCarro/calibracaoCarro.h"
+#include "ConducaoCarro/conducaoCarro.h"
 #include <string.h>
 
 #define TX_INTERVAL         60000
 
+/**
+ * Protocolo de comunicação com o GPS
+ * 1 -> UBX binário (NAV-POSLLH, NAV-STATUS, NAV-DOP, NAV-SOL, NAV-VELNED e NAV-TIMEUTC), sentenças NMEA desligadas no receptor
+ * 0 -> NMEA (RMC, GGA, GSA, VTG e GSV fundidas em um único fix por época)
+ * Em ambos os casos os dois decodificadores permanecem ativos.
+ */
+#define GPS_MODO_UBX        1
+
+/**
+ * Taxa de comunicação e intervalo entre fixes negociados com o GPS na inicialização
+ * (o NEO-6M aceita no máximo 5 Hz; receptores mais novos aceitam 100 ms -> 10 Hz).
+ * Se o receptor não confirmar, volta-se para 9600 baud e 1 fix por segundo.
+ */
+#define GPS_BAUD_INICIAL    9600
+#define GPS_BAUD_ALTA       115200
+#define GPS_PERIODO_MS      200
+
+/**
+ * Maior HDOP (* 10^2) aceito para gravar ou enviar um fix
+ */
+#define GPS_HDOP_MAXIMO     500
+
+/**
+ * Desvio máximo (m) entre o trajeto gravado e os fixes recebidos
+ */
+#define TRAJETO_ERRO_MAXIMO_M   5.0f
+
+/**
+ * Partida rápida do GPS: incerteza informada ao receptor para a posição guardada no DS1307 (o carro pode
+ * ter sido rebocado) e para a hora do RTC, e intervalo entre as gravações do último fix bom no DS1307
+ */
+#define PARTIDA_PRECISAO_POSICAO_CM     200000
+#define PARTIDA_PRECISAO_TEMPO_MS       2000
+#define PARTIDA_INTERVALO_MS            60000
+
 /*
  *----------------------------------------------------------------------------------------------------------------------
  * VARIÁVEIS GLOBAIS, OBJETOS E PROTÓTIPOS DE FUNÇÕES
@@ -130,13 +177,67 @@
  Serial pc(USBTX, USBRX);
 
 /**
- * Struct para armazenar os dados do GPS
+ * Publicador do fix mais recente do GPS (a Thread do GPS escreve sem bloquear e
+ * os leitores obtêm uma cópia consistente com leGPS, sem semáforo)
  * Declaração da Thread GPS
- * Declaração do Semaforo para acessar o GPS (Semaforo utilizado para garantir a atomicidade dos dados)
  */
-dataGPS dadosDoGPS;
+publicadorGPS publicadorDoGPS;
 Thread thread_gps;
-Semaphore semaforo_acessar_gps (1);
+
+/**
+ * Relógio sincronizado a cada fix: fornece o tempo Unix (ms) a qualquer Thread com custo constante.
+ * Até o primeiro fix com data, usa a hora do DS1307.
+ */
+relogioGPS relogioDoGPS;
+
+/**
+ * Trajeto simplificado: a Thread do GPS mantém apenas os fixes necessários para descrever o
+ * trajeto com erro de até TRAJETO_ERRO_MAXIMO_M e os entrega à gravação no cartão pela fila
+ */
+simplificadorGPS simplificadorDoTrajeto;
+filaGPS filaDoTrajeto;
+
+/**
+ * Cercas virtuais (garagens e áreas restritas): os vértices, as cercas e a grade ficam na FLASH, em
+ * CercaCarro/gradeDasCercas.cpp, gerado no computador a partir de CercaCarro/cercas.txt. A Thread do GPS
+ * verifica cada fix confiável e entrega as entradas e saídas à gravação no cartão pela fila.
+ */
+cercasCarro cercasDoCarro;
+filaCerca filaDasCercas;
+bool cercasAtivas = false;
+
+/**
+ * Odômetro e viagens: a Thread do GPS acumula a distância e detecta início e fim das viagens (velocidade e
+ * vibração do motor, medida pela Thread da MPU6050). O resumo de cada viagem concluída é entregue à gravação
+ * no cartão pela fila e acrescentado a ARQUIVO_VIAGENS.
+ */
+#define ARQUIVO_VIAGENS     "/fs/viagens/viagens.csv"
+odometroCarro odometroDoCarro;
+vibracaoCarro vibracaoDoCarro;
+filaViagem filaDeViagens;
+
+/**
+ * Montador das sentenças NMEA (soma de verificação e contadores de sentenças aceitas,
+ * rejeitadas e truncadas)
+ */
+montadorNMEA montadorGPS;
+
+/**
+ * Fusão das sentenças NMEA de uma mesma época (posição, altitude, DOP e satélites)
+ */
+fusaoNMEA fusaoGPS;
+
+/**
+ * Decodificador dos quadros UBX (binário u-blox)
+ */
+decodificadorUBX decodificadorGPS;
+
+/**
+ * Medidas de desempenho da Thread do GPS (fixes, bytes e tempo de CPU de decodificação)
+ * e taxa de fixes efetivamente configurada no receptor
+ */
+desempenhoGPS desempenhoDoGPS;
+int periodoDoGPSMs = 1000;
 
 /**
  * Objeto buffer de envio LoRa
@@ -148,36 +249,155 @@ PayLoadCarro payloader;
  * Objeto para aquisição do GPS
  *----------------------------------------------------------------------------------------------------------------------
  */
-Serial gps (PA_15, PB_7); /* TX, RX */
+RawSerial gps (PA_15, PB_7); /* TX, RX */
+
+/**
+ * Buffer circular alimentado pela interrupção de recepção da UART do GPS.
+ * A Thread do GPS só é acordada (semaforo_linha_gps) quando uma linha completa ('\n') chega.
+ */
+bufferCircularGPS bufferGPS;
+delimitadorUBX delimitadorGPS;
+Semaphore semaforo_linha_gps (0);
 
 /**
  *----------------------------------------------------------------------------------------------------------------------
  * Objeto para aquisição de: acelerometro, giroscopio e temperatura
  *----------------------------------------------------------------------------------------------------------------------
  */
-MPU6050 ark (PB_9, PB_8);
+I2C i2cDaMPU (PB_9, PB_8); /* SDA, SCL */
+MPU6050 ark (i2cDaMPU);
 
 /**
  *----------------------------------------------------------------------------------------------------------------------
- * Objeto para aquisição de: calendario e relogio
- * 
- * Opções de frequência: (hz == 100000) || (hz == 400000) || (hz == 1000000)
- *
- * Obs: A frequencia escolhida deve ser colocada dividida por 100
+ * Amostragem da MPU6050: as amostras vão para a FIFO do sensor a IMU_TAXA_HZ e o pino INT sinaliza cada uma.
+ * A interrupção acorda a Thread de coleta a cada IMU_AMOSTRAS_POR_LEITURA amostras; a coleta esvazia a FIFO
+ * e entrega as amostras brutas à Thread de navegação pela filaDaIMU.
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+#define IMU_TAXA_HZ                 1000    // 1 kHz / (1 + SMPLRT_DIV), com o filtro passa-baixa ligado
+#define IMU_AMOSTRAS_POR_LEITURA    10
+#define IMU_ESPERA_MAXIMA_MS        50      // coleta mesmo sem interrupção (pino INT desligado)
+
+InterruptIn interrupcaoDaMPU (PC_10);
+Semaphore semaforo_fifo_imu (0);
+Semaphore semaforo_fila_imu (0);
+volatile uint32_t amostrasSinalizadas = 0;
+filaIMU filaDaIMU;
+desempenhoIMU desempenhoDaIMU;
+coletorIMU coletorDaIMU;
+Thread thread_coleta_imu (osPriorityAboveNormal);
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * Navegação estimada: a posição é propagada entre os fixes do GPS (e durante perdas de sinal) com a média
+ * de cada grupo de IMU_DECIMACAO amostras (100 Hz). A estimativa é publicada como um dataGPS, da mesma forma
+ * que o fix.
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+#define IMU_DECIMACAO       10
+
+navegacaoCarro navegacao;
+publicadorGPS publicadorDaNavegacao;
+Thread thread_imu;
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * Atitude: a Thread da navegação atualiza o filtro de atitude a cada amostra (1 kHz). A navegação, o pavimento,
+ * os buracos e o espectro usam a aceleração sem a gravidade e a velocidade angular no referencial do carro
+ * nivelado, de forma que a inclinação da montagem não precisa mais ser acertada à mão.
  *
- * Ex: 100000 hz -> 1000
+ * Os LEDs indicam a inclinação da MPU6050 em relação à vertical (atualizados pela gravação no cartão):
+ * até ATITUDE_LED_NIVELADA graus acende ledOkay, até ATITUDE_LED_INCLINADA acende ledMedio e acima dela
+ * ledPouco (montagem muito inclinada: a faixa útil do eixo vertical diminui).
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+#define ATITUDE_LED_NIVELADA        5.0f
+#define ATITUDE_LED_INCLINADA       30.0f
+
+atitudeCarro atitudeDoCarro;
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * Calibração: o registro guardado no DS1307 (bias e montagem) é lido antes das Threads e aplicado pela Thread
+ * da navegação antes da primeira amostra. A navegação refaz o registro quando mede uma deriva (carro parado ou
+ * acelerando em linha reta) e a gravação no cartão o guarda no DS1307.
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+calibracaoCarro calibracaoDoCarro;
+registroCalibracao calibracaoGuardada;
+bool temCalibracaoGuardada = false;
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * Irregularidade do pavimento: a Thread da navegação filtra a aceleração vertical em blocos de PAVIMENTO_BLOCO
+ * amostras (1 kHz, sem decimação) e encerra um trecho a cada PAVIMENTO_TRECHO_MM do odômetro. Os trechos são
+ * entregues à gravação no cartão pela fila (colunas: Data;Hora;Latitude;Longitude;Velocidade;RMS;Pico).
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+pavimentoCarro pavimentoDoCarro;
+filaPavimento filaDoPavimento;
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * Buracos e lombadas: a Thread da navegação passa cada amostra ao detector, que captura uma janela de
+ * BURACO_PRE_AMOSTRAS antes e BURACO_POS_AMOSTRAS depois do disparo. As janelas vão para o cartão pela
+ * filaDosBuracos (resumo em /fs/buracos/ e amostras em /fs/janelas/) e os resumos vão para a rede LoRa pela
+ * filaDeAvisos, na porta BURACO_PORTA_LORA, sem esperar o envio periódico.
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+#define BURACO_PORTA_LORA           16
+#define BURACO_VERIFICACAO_MS       1000
+
+detectorBuraco detectorDoCarro;
+filaBuraco filaDosBuracos;
+filaAvisoBuraco filaDeAvisos;
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * Espectro da vibração: a Thread da navegação calcula as bandas de cada janela de ESPECTRO_N amostras da
+ * aceleração vertical. As janelas vão para o cartão pela filaDoEspectro; a gravação soma cada janela ao
+ * acumuladorDoEspectro, cuja média é enviada pela rede LoRa (protegido por seção crítica: duas Threads o usam).
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+espectroCarro espectroDoCarro;
+filaEspectro filaDoEspectro;
+acumuladorEspectro acumuladorDoEspectro;
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * Condução brusca: a Thread da navegação classifica cada amostra da aceleração no referencial do carro
+ * (frenagem, aceleração e curva). Os eventos vão para o cartão pela filaDaConducao; os contadores desde o envio
+ * anterior vão pela rede LoRa em 3 bytes (conducaoEnviada guarda o que já foi enviado).
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+conducaoCarro conducaoDoCarro;
+filaConducao filaDaConducao;
+uint32_t conducaoEnviada[CONDUCAO_TIPOS][2];
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * Objeto para aquisição de: calendario e relogio
  *
  * Ordem da pinagem I2C -> SDA / SDL
  *----------------------------------------------------------------------------------------------------------------------
  */
-class myI2C2 : public I2C
-{
-public:
-    myI2C2 (PinName sda, PinName scl, int hz, const char *name = NULL) : I2C (sda, scl) { frequency (hz * 100); };
-};
-myI2C2 gI2c (PC_9, PA_8, 1000); 
+I2C gI2c (PC_9, PA_8);
 RtcDs1307 gRtc ( gI2c );
 
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * Gerenciadores dos barramentos I2C: a MPU6050 em 400 kHz e o DS1307 em 100 kHz (o máximo dele). Cada Thread
+ * que usa um dispositivo é um cliente do barramento; o barramento é entregue ao cliente de maior prioridade
+ * que estiver esperando. A ocupação e a espera de cada cliente são impressas a cada BARRAMENTO_RELATORIO_MS.
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+#define BARRAMENTO_RELATORIO_MS     10000
+
+barramentoI2C barramentoDaMPU;
+clienteI2C clienteColetaIMU, clienteGravacao, clienteLoRa;
+barramentoI2C barramentoDoRTC;
+clienteI2C clienteRelogio;
+
 /**
  *----------------------------------------------------------------------------------------------------------------------
  * Objeto para gravar no cartão micro SD / Thread de gravação no cartão micro SD
@@ -319,6 +539,14 @@ static void LoRa_send_message ();
  */
 static void receive_message ();
 
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * Envia pela rede LoRa o aviso de buraco mais antigo da filaDeAvisos (verificada a cada BURACO_VERIFICACAO_MS).
+ * Se o envio falhar (ciclo de trabalho, por exemplo), o aviso é mantido para a verificação seguinte.
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+static void enviarAvisoDeBuraco ();
+
 /**
  *----------------------------------------------------------------------------------------------------------------------
  * Manipula os eventos relacionados a rede LoRa
@@ -334,24 +562,149 @@ static void lora_event_handler (lorawan_event_t event);
  *----------------------------------------------------------------------------------------------------------------------
  * Adquire constantemente os dados fornecidos por um GPS
  *
+ * Os bytes são recebidos por interrupção (receberByteDoGPS) em um buffer circular; a Thread
+ * permanece bloqueada até que uma linha completa esteja disponível, liberando a CPU (e o modo
+ * de baixo consumo) enquanto o GPS transmite.
+ *
  * Os dados adquiridos são armazenados em uma estrutura do tipo: dataGPS
  *
  * Estrutura definida em GPS_Carro.h
  *   
- * Utiliza-se um semaforo na tentativa de manter a atomicidade dos dados
+ * O fix é montado em uma estrutura privada da Thread e publicado com publicaGPS apenas quando
+ * completo; os leitores obtêm uma cópia consistente com leGPS, sem semáforo.
  *----------------------------------------------------------------------------------------------------------------------
  */
 void adquirirDadosDoGPS (void);
 
 /**
- * Calibração
+ *----------------------------------------------------------------------------------------------------------------------
+ * Entrega um fix completo (chamada apenas pela Thread do GPS): publica o fix, sincroniza o relógio
+ * e alimenta o simplificador do trajeto
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+static void publicarFix (const dataGPS *fix);
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * Grava no arquivo de trajeto os pontos do trajeto simplificado acumulados na fila
+ * (colunas: Data;Hora;Latitude;Longitude;Velocidade). Se não houver pontos, o arquivo não é aberto.
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+void gravarTrajeto (const char *nomeTrajeto);
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * Grava no arquivo de cercas as entradas e saídas acumuladas na fila
+ * (colunas: Data;Hora;Cerca;Tipo;Evento;Latitude;Longitude). Se não houver eventos, o arquivo não é aberto.
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+void gravarEventosDeCerca (const char *nomeCercas);
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * Acrescenta a ARQUIVO_VIAGENS os resumos das viagens concluídas (colunas: Viagem;Data;Hora;Duracao;
+ * Distancia;MarchaLenta;VelocidadeMaxima;LatitudeInicial;LongitudeInicial;LatitudeFinal;LongitudeFinal).
+ * Um relatório diário só precisa ler este arquivo, sem percorrer os dados de todos os fixes.
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+void gravarViagens (void);
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * Grava no arquivo de pavimento os trechos acumulados na fila (colunas: Data;Hora;Latitude;Longitude;
+ * Velocidade;RMS;Pico, com a velocidade em km/h e a aceleração em m/s²). Se não houver trechos, o arquivo
+ * não é aberto.
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+void gravarPavimento (const char *nomePavimento);
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * Grava as janelas capturadas pelo detector de buracos: o resumo no arquivo de buracos (colunas: Evento;Data;
+ * Hora;Tipo;Latitude;Longitude;Velocidade;Pico;Jerk) e as amostras no arquivo de janelas (colunas: Evento;
+ * Amostra;Ace 1;Ace 2;Ace 3;Gyro 1;Gyro 2;Gyro 3, com a amostra numerada a partir do disparo). Se não houver
+ * janelas, os arquivos não são abertos.
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+void gravarBuracos (const char *nomeBuracos, const char *nomeJanelas);
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * Grava no arquivo de espectro as janelas acumuladas na fila (colunas: Data;Hora;Latitude;Longitude;Velocidade
+ * e a aceleração RMS de cada banda em m/s²) e as soma ao acumuladorDoEspectro. Se não houver janelas, o
+ * arquivo não é aberto.
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+void gravarEspectro (const char *nomeEspectro);
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * Grava no arquivo de condução os eventos acumulados na fila (colunas: Evento;Data;Hora;Tipo;Severo;Latitude;
+ * Longitude;Velocidade;Pico;Duracao). Se não houver eventos, o arquivo não é aberto.
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+void gravarConducao (const char *nomeConducao);
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * Partida rápida: inicia o relógio com a hora do DS1307 e envia ao GPS a hora e o último fix guardados
+ * (UBX-AID-INI). Deve ser chamada depois da configuração do GPS e antes da Thread do GPS.
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+static void prepararPartidaRapida (void);
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * Calibração guardada: lê o registro de calibração da memória do DS1307 (calibracaoGuardada). Deve ser
+ * chamada antes da Thread da navegação.
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+static void prepararCalibracao (void);
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * Interrupção de recepção da UART do GPS
+ *
+ * Copia os bytes recebidos para o buffer circular e acorda a Thread do GPS ao fim de cada linha
+ * (NMEA) ou de cada quadro (UBX).
+ * Não faz nenhuma decodificação, para manter a interrupção curta.
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+void receberByteDoGPS (void);
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * Interrupção de dado pronto da MPU6050: conta as amostras e acorda a Thread de coleta a cada
+ * IMU_AMOSTRAS_POR_LEITURA (sem acesso ao I2C dentro da interrupção)
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+void amostraProntaDaMPU (void);
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * Configura a amostragem da MPU6050 (taxa, FIFO e interrupção) e, a cada sinal da interrupção, esvazia a
+ * FIFO em leituras em rajada para a filaDaIMU (esvaziaFifoIMU). As rajadas são lidas de forma assíncrona: a
+ * Thread dorme durante a transferência e, enquanto uma rajada é transferida, decodifica a anterior.
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+void coletarIMU (void);
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * Retira as amostras da filaDaIMU, propaga o filtro de navegação a cada IMU_DECIMACAO amostras, o corrige
+ * a cada novo fix do GPS e publica a posição estimada (publicadorDaNavegacao). A aceleração vertical de
+ * todas as amostras alimenta o estimador de irregularidade do pavimento, o detector de buracos e o espectro;
+ * a horizontal alimenta o classificador de condução brusca.
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+void estimarPosicao (void);
+
+/**
+ * Indicação da inclinação da montagem
  */
 DigitalOut ledPouco (PC_8);
 DigitalOut ledMedio (PC_6);
 DigitalOut ledOkay (PC_5);
-void calibracao (void);
-Thread thread_calibrador;
-Semaphore dadosMPU (1);
 
 
 //------------------------------------------------------------------------------------------------------------------
@@ -373,7 +726,26 @@ Semaphore dadosMPU (1);
  */
 int main (void) {
     //Configurações de comunicação com o modulo do GPS
-    gps.baud (9600); //Taxa de comunição serial com o GPS
+    gps.baud (GPS_BAUD_INICIAL); //Taxa de comunição serial com o GPS
+#if GPS_MODO_UBX
+    configuraModoUBX (&gps); //Desliga as sentenças NMEA e liga as mensagens UBX
+#endif
+    if (configuraTaxaGPS (&gps, GPS_BAUD_INICIAL, GPS_BAUD_ALTA, GPS_PERIODO_MS)) {
+        periodoDoGPSMs = GPS_PERIODO_MS;
+        printf ("GPS: %d baud, 1 fix a cada %d ms\r\n", GPS_BAUD_ALTA, GPS_PERIODO_MS);
+    } else {
+        printf ("GPS: sem confirmacao do receptor, mantendo %d baud e 1 fix por segundo\r\n", GPS_BAUD_INICIAL);
+    }
+    //Barramentos I2C e seus clientes (a coleta da IMU, a 1 kHz, tem a maior prioridade)
+    iniciaBarramento (&barramentoDaMPU, &i2cDaMPU, BARRAMENTO_RAPIDO_HZ);
+    cadastraClienteI2C (&barramentoDaMPU, &clienteColetaIMU, "Coleta IMU", 3);
+    cadastraClienteI2C (&barramentoDaMPU, &clienteGravacao, "Gravacao", 2);
+    cadastraClienteI2C (&barramentoDaMPU, &clienteLoRa, "LoRa", 2);
+    iniciaBarramento (&barramentoDoRTC, &gI2c, BARRAMENTO_NORMAL_HZ);
+    cadastraClienteI2C (&barramentoDoRTC, &clienteRelogio, "Relogio", 1);
+
+    iniciaRelogio (&relogioDoGPS);
+    prepararPartidaRapida ();
   
     mbed_trace_init ();
     
@@ -436,16 +808,17 @@ int main (void) {
 
 
     //------------------------------------------------------------------------------------------------------------------
-    //-- PASSO 6: Inicialização do método de calibração do acelerometro
+    //-- PASSO 6: Inicialização do Fluxo de Controle de aquisição dos dados do GPS
     //------------------------------------------------------------------------------------------------------------------
-    thread_calibrador.start (calibracao);
-    wait (2);
+    thread_gps.start (adquirirDadosDoGPS);
+    wait (3);
 
     //------------------------------------------------------------------------------------------------------------------
-    //-- PASSO 7: Inicialização do Fluxo de Controle de aquisição dos dados do GPS
+    //-- PASSO 7: Inicialização da amostragem da MPU6050 e da navegação estimada (MPU6050 + GPS)
     //------------------------------------------------------------------------------------------------------------------
-    thread_gps.start (adquirirDadosDoGPS);
-    wait (3);
+    prepararCalibracao ();
+    thread_imu.start (estimarPosicao);
+    thread_coleta_imu.start (coletarIMU);
 
     //------------------------------------------------------------------------------------------------------------------
     //-- PASSO 8: Inicialização do Fluxo de Controle da gravação no cartão
@@ -467,8 +840,6 @@ int main (void) {
  */
 void escrever_no_arquivo () {
     
-    //calibracao ();
-
     //thread_gps.start (adquirirDadosDoGPS);
 
     //wait (3);
@@ -478,11 +849,42 @@ void escrever_no_arquivo () {
     /**
      * Perifericos
      *
-     * Acelerometro, Sensor de temperatura, Giroscópio, GPS e RTC (Temporariamente não utilizado)
+     * Acelerometro, Sensor de temperatura, Giroscópio, GPS e RTC (hora antes do primeiro fix)
      *
      */    
     float acce[3], temperatura, gyro[3];
-    //DateTime dt; Esse era o objeto para o RTC
+    MPU6050Motion6 amostraMPU;
+
+    // Cópia do fix mais recente do GPS e seus valores convertidos para texto
+    dataGPS dadosDoGPS, fixDoGPS;
+    char textoLatitude[16], textoLongitude[16], textoVelocidade[16];
+    DateTime agora;
+    long horaDoGPS;
+    uint64_t instante;
+    bool comPosicao;
+
+    // Partida: próxima gravação do último fix no DS1307 e instantes (ms desde a inicialização) da
+    // primeira linha gravada e da primeira linha com posição
+    uint64_t proximaPartida = 0, primeiraLinhaMs = 0, primeiraPosicaoMs = 0;
+
+    // Relatório dos barramentos: cópia dos clientes no relatório anterior
+    clienteI2C anterioresDaMPU[BARRAMENTO_MAX_CLIENTES], anterioresDoRTC[BARRAMENTO_MAX_CLIENTES];
+    uint64_t proximoRelatorio = BARRAMENTO_RELATORIO_MS;
+    uint32_t relatorioAnteriorUs = us_ticker_read (), agoraUs;
+
+    memset (anterioresDaMPU, 0, sizeof (anterioresDaMPU));
+    memset (anterioresDoRTC, 0, sizeof (anterioresDoRTC));
+
+    // Leitura anterior das medidas de desempenho do GPS (a taxa é a diferença entre leituras)
+    desempenhoGPS desempenhoAnterior = desempenhoDoGPS;
+    uint32_t amostrasAnteriores = 0, leiturasAnteriores = 0, liberadoAnterior = 0;
+    uint32_t transformadasAnteriores = 0, tempoDeFFTAnterior = 0, transformadas;
+    uint32_t correcoesAnteriores = 0, amostrasDeAtitude = 0;
+    float inclinacao;
+
+    // Calibração: última publicação da navegação já guardada no DS1307
+    registroCalibracao calibracao;
+    uint32_t publicacaoDaCalibracao, calibracaoGravada = 0;
 
     //Montagem do sistema em blocos
     int err = fs.mount (bd);
@@ -497,6 +899,14 @@ void escrever_no_arquivo () {
 
     mkdir ("fs/dados", 1); //Pasta que contém os arquivos que contém os dados
     mkdir ("fs/controle", 1); //Pasta que contém o arquivo de controle dos arquivos que contém os dados
+    mkdir ("fs/trajeto", 1); //Pasta que contém os arquivos com o trajeto simplificado
+    mkdir ("fs/cercas", 1); //Pasta que contém os arquivos com as entradas e saídas das cercas virtuais
+    mkdir ("fs/viagens", 1); //Pasta que contém o arquivo com o resumo das viagens
+    mkdir ("fs/pavimento", 1); //Pasta que contém os arquivos com a irregularidade do pavimento por trecho
+    mkdir ("fs/buracos", 1); //Pasta que contém os arquivos com o resumo dos buracos e lombadas
+    mkdir ("fs/janelas", 1); //Pasta que contém os arquivos com as amostras em torno de cada buraco ou lombada
+    mkdir ("fs/espectro", 1); //Pasta que contém os arquivos com as bandas do espectro da vibração
+    mkdir ("fs/conducao", 1); //Pasta que contém os arquivos com os eventos de condução brusca
 
     //Cria um novo arquivo a cada dia ou a cada vez que o carro for ligado
     
@@ -520,6 +930,34 @@ void escrever_no_arquivo () {
     strcat(nomeArquivo, extensao);    
     printf ("%s\r\n", nomeArquivo);
 
+    char nomeTrajeto[29] = "/fs/trajeto/";
+    strcat(nomeTrajeto, novoNomeDeArquivo);
+    strcat(nomeTrajeto, extensao);
+
+    char nomeCercas[28] = "/fs/cercas/";
+    strcat(nomeCercas, novoNomeDeArquivo);
+    strcat(nomeCercas, extensao);
+
+    char nomePavimento[31] = "/fs/pavimento/";
+    strcat(nomePavimento, novoNomeDeArquivo);
+    strcat(nomePavimento, extensao);
+
+    char nomeBuracos[29] = "/fs/buracos/";
+    strcat(nomeBuracos, novoNomeDeArquivo);
+    strcat(nomeBuracos, extensao);
+
+    char nomeJanelas[29] = "/fs/janelas/";
+    strcat(nomeJanelas, novoNomeDeArquivo);
+    strcat(nomeJanelas, extensao);
+
+    char nomeEspectro[30] = "/fs/espectro/";
+    strcat(nomeEspectro, novoNomeDeArquivo);
+    strcat(nomeEspectro, extensao);
+
+    char nomeConducao[30] = "/fs/conducao/";
+    strcat(nomeConducao, novoNomeDeArquivo);
+    strcat(nomeConducao, extensao);
+
     /**
      * Verificando a existencia do arquivo   
      * Verifica se o arquivo já existe para poder nomear as colunas
@@ -566,35 +1004,57 @@ void escrever_no_arquivo () {
             }
         }
 
-        // Lendo os dados dos perifericos
-        ark.getAccelero (acce);                    
-        temperatura = ark.getTemp ();
-        ark.getGyro (gyro);
+        // Lendo os dados dos perifericos (uma única leitura da MPU6050; a conversão é feita fora do barramento)
+        obtemBarramento (&barramentoDaMPU, &clienteGravacao);
+        ark.getMotion6Raw (&amostraMPU);
+        liberaBarramento (&barramentoDaMPU, &clienteGravacao);
+        ark.convertMotion6 (&amostraMPU, acce, gyro, &temperatura);
         
-        //Escrevendo_no_arquivo
-        if (dadosDoGPS.valid == 'A') {
-            semaforo_acessar_gps.acquire ();
-            err = fprintf (f, "%.2f;%.2f;%.2f;%.2f;%.2f;%.2f;%.2f;%.6lf;%.6lf;%c%c%c%c%c%c;%.0lf;%.4lf\r\n", 
+        //Escrevendo_no_arquivo (posição do GPS, ou estimada entre os fixes e durante perdas de sinal)
+        leGPS (&publicadorDaNavegacao, &dadosDoGPS);
+        comPosicao = fixConfiavel (&dadosDoGPS, GPS_HDOP_MAXIMO);
+        if (comPosicao) {
+            // Os valores do GPS são inteiros em ponto fixo: convertidos para texto uma única vez
+            formataDecimal (textoLatitude, sizeof (textoLatitude), dadosDoGPS.latitude, 7, 6);
+            formataDecimal (textoLongitude, sizeof (textoLongitude), dadosDoGPS.longitude, 7, 6);
+            formataDecimal (textoVelocidade, sizeof (textoVelocidade), MM_S_PARA_KMH_E4 (dadosDoGPS.speed), 4, 4);
+        } else {
+            printf ("GPS conectando... (Satelites: %u; HDOP: %s; Sentencas aceitas: %lu; rejeitadas: %lu; truncadas: %lu; bytes perdidos: %lu)\r\n",
+                    dadosDoGPS.satellites,
+                    formataDecimal (textoVelocidade, sizeof (textoVelocidade), dadosDoGPS.hdop, 2, 2),
+                    montadorGPS.estatisticas.aceitas,
+                    montadorGPS.estatisticas.rejeitadas,
+                    montadorGPS.estatisticas.truncadas,
+                    bufferGPS.perdidos);
+            // Sem posição, a linha é gravada com as colunas do GPS vazias (hora do RTC)
+            textoLatitude[0] = textoLongitude[0] = textoVelocidade[0] = '\0';
+        }
+
+        // Sem posição e sem hora (RTC desacertado e GPS sem fix) não há o que gravar
+        instante = tempoEmMs (&relogioDoGPS, Kernel::get_ms_count ());
+        if (comPosicao || instante != 0) {
+            // Data e hora locais obtidas do relógio, sem manipulação de texto
+            agora = horaLocal (instante);
+            horaDoGPS = agora.hour () * 10000L + agora.minute () * 100 + agora.second ();
+
+            err = fprintf (f, "%.2f;%.2f;%.2f;%.2f;%.2f;%.2f;%.2f;%s;%s;%02u%02u%02u;%ld;%s\r\n", 
                         acce[0], acce[1], acce[2],
                         gyro[0], gyro[1], gyro[2],
                         temperatura, 
-                        dadosDoGPS.latitude, dadosDoGPS.longitude,
-                        dadosDoGPS.date[0], dadosDoGPS.date[1], dadosDoGPS.date[2], dadosDoGPS.date[3], dadosDoGPS.date[4], dadosDoGPS.date[5],
-                        dadosDoGPS.time,
-                        dadosDoGPS.speed);
-            semaforo_acessar_gps.release ();
+                        textoLatitude, textoLongitude,
+                        agora.day (), agora.month (), agora.year () % 100,
+                        horaDoGPS,
+                        textoVelocidade);
             if (err < 0) {
                 wait_ms (500);
-                semaforo_acessar_gps.acquire ();        
-                err = fprintf (f, "%.2f;%.2f;%.2f;%.2f;%.2f;%.2f;%.2f;%.6lf;%.6lf;%c%c%c%c%c%c;%.0lf;%.4lf\r\n", 
+                err = fprintf (f, "%.2f;%.2f;%.2f;%.2f;%.2f;%.2f;%.2f;%s;%s;%02u%02u%02u;%ld;%s\r\n", 
                         acce[0], acce[1], acce[2],
                         gyro[0], gyro[1], gyro[2],
                         temperatura, 
-                        dadosDoGPS.latitude, dadosDoGPS.longitude,
-                        dadosDoGPS.date[0], dadosDoGPS.date[1], dadosDoGPS.date[2], dadosDoGPS.date[3], dadosDoGPS.date[4], dadosDoGPS.date[5],
-                        dadosDoGPS.time,
-                        dadosDoGPS.speed);
-                semaforo_acessar_gps.release ();
+                        textoLatitude, textoLongitude,
+                        agora.day (), agora.month (), agora.year () % 100,
+                        horaDoGPS,
+                        textoVelocidade);
                 if (err < 0) {
                     fclose (f);
                     wait (1);
@@ -602,22 +1062,120 @@ void escrever_no_arquivo () {
                     continue; 
                 }       
             }
-            semaforo_acessar_gps.acquire ();
-            printf ("A1: %.2f; A2: %.2f; A3: %.2f;G1: %.2f; G2: %.2f; G3: %.2f; Temp: %.2f; Lat: %lf; Long: %lf; Vel: %lf; Dat: %c%c%c%c%c%c; Tempo: %.0lf\r\n\n", 
+            printf ("A1: %.2f; A2: %.2f; A3: %.2f;G1: %.2f; G2: %.2f; G3: %.2f; Temp: %.2f; Lat: %s; Long: %s; Vel: %s; Dat: %02u%02u%02u; Tempo: %ld\r\n\n", 
                     acce[0], acce[1], acce[2],
                     gyro[0], gyro[1], gyro[2], 
                     temperatura,
-                    dadosDoGPS.latitude, dadosDoGPS.longitude,
-                    dadosDoGPS.speed,
-                    dadosDoGPS.date[0], dadosDoGPS.date[1], dadosDoGPS.date[2], dadosDoGPS.date[3], dadosDoGPS.date[4], dadosDoGPS.date[5],
-                    dadosDoGPS.time);
-            semaforo_acessar_gps.release ();    
-        } else {
-            printf ("GPS conectando...\r\n");
+                    textoLatitude, textoLongitude,
+                    textoVelocidade,
+                    agora.day (), agora.month (), agora.year () % 100,
+                    horaDoGPS);
+
+            // Tempo de partida: da inicialização até a primeira linha e até a primeira linha com posição
+            if (primeiraLinhaMs == 0) {
+                primeiraLinhaMs = Kernel::get_ms_count ();
+                printf ("Partida: primeira linha gravada em %lu ms (hora do %s)\r\n", (uint32_t)primeiraLinhaMs,
+                        relogioDoGPS.origem == RELOGIO_GPS ? "GPS" : "RTC");
+            }
+            if (comPosicao && primeiraPosicaoMs == 0) {
+                primeiraPosicaoMs = Kernel::get_ms_count ();
+                printf ("Partida: primeira linha com posicao gravada em %lu ms\r\n", (uint32_t)primeiraPosicaoMs);
+            }
+        }
+
+        // Relatório de vazão do GPS no último segundo: fixes, bytes e tempo de CPU de decodificação
+        printf ("GPS (%d ms): %lu fixes/s; %lu bytes/s; %lu us de CPU/s\r\n", periodoDoGPSMs,
+                desempenhoDoGPS.fixes - desempenhoAnterior.fixes,
+                desempenhoDoGPS.bytes - desempenhoAnterior.bytes,
+                desempenhoDoGPS.tempoDeProcessamentoUs - desempenhoAnterior.tempoDeProcessamentoUs);
+        desempenhoAnterior = desempenhoDoGPS;
+        printf ("IMU: %lu amostras/s; %lu leituras/s; %lu us livres/s durante o I2C; estouros da FIFO: %lu; "
+                "perdidas na fila: %lu; erros I2C: %lu\r\n",
+                desempenhoDaIMU.amostras - amostrasAnteriores,
+                desempenhoDaIMU.leituras - leiturasAnteriores,
+                desempenhoDaIMU.tempoLiberadoUs - liberadoAnterior,
+                desempenhoDaIMU.estourosFIFO, filaDaIMU.perdidos, desempenhoDaIMU.errosI2C);
+        amostrasAnteriores = desempenhoDaIMU.amostras;
+        leiturasAnteriores = desempenhoDaIMU.leituras;
+        liberadoAnterior = desempenhoDaIMU.tempoLiberadoUs;
+        // Custo da FFT no alvo (us por janela de ESPECTRO_N amostras)
+        transformadas = espectroDoCarro.transformadas - transformadasAnteriores;
+        if (transformadas > 0) {
+            printf ("Espectro: %lu janelas/s; %lu us por FFT\r\n", transformadas,
+                    (espectroDoCarro.tempoDeFFTUs - tempoDeFFTAnterior) / transformadas);
+        }
+        transformadasAnteriores = espectroDoCarro.transformadas;
+        tempoDeFFTAnterior = espectroDoCarro.tempoDeFFTUs;
+        // Inclinação da montagem (LEDs) e fração das amostras em que a gravidade corrigiu a atitude
+        inclinacao = inclinacaoAtitude (&atitudeDoCarro);
+        ledOkay = inclinacao <= ATITUDE_LED_NIVELADA;
+        ledMedio = inclinacao > ATITUDE_LED_NIVELADA && inclinacao <= ATITUDE_LED_INCLINADA;
+        ledPouco = inclinacao > ATITUDE_LED_INCLINADA;
+        printf ("Atitude: inclinacao de %.1f graus; %lu de %lu amostras corrigidas pela gravidade\r\n", inclinacao,
+                atitudeDoCarro.correcoes - correcoesAnteriores, atitudeDoCarro.amostras - amostrasDeAtitude);
+        printf ("Calibracao: %lu janelas paradas; %lu recalibracoes\r\n", calibracaoDoCarro.janelas,
+                calibracaoDoCarro.recalibracoes);
+        printf ("Conducao: %lu frenagens, %lu aceleracoes e %lu curvas bruscas; %lu amostras sem guinada\r\n",
+                conducaoDoCarro.contagens[CONDUCAO_FRENAGEM][0] + conducaoDoCarro.contagens[CONDUCAO_FRENAGEM][1],
+                conducaoDoCarro.contagens[CONDUCAO_ACELERACAO][0] + conducaoDoCarro.contagens[CONDUCAO_ACELERACAO][1],
+                conducaoDoCarro.contagens[CONDUCAO_CURVA][0] + conducaoDoCarro.contagens[CONDUCAO_CURVA][1],
+                conducaoDoCarro.amostrasSemGuinada);
+        correcoesAnteriores = atitudeDoCarro.correcoes;
+        amostrasDeAtitude = atitudeDoCarro.amostras;
+        printf ("Trajeto: %lu de %lu fixes mantidos\r\n",
+                simplificadorDoTrajeto.mantidos, simplificadorDoTrajeto.recebidos);
+        if (odometroDoCarro.emViagem) {
+            printf ("Viagem %lu: %lu m\r\n", odometroDoCarro.viagem.numero, odometroDoCarro.viagem.distanciaMm / 1000);
         }
 
         // Close the file which also flushes any cached writes    
         fclose (f);        
+
+        // Partida rápida: guarda o último fix bom no DS1307 e mantém o RTC acertado pela hora do GPS
+        if (Kernel::get_ms_count () >= proximaPartida) {
+            leGPS (&publicadorDoGPS, &fixDoGPS);
+            if (fixConfiavel (&fixDoGPS, GPS_HDOP_MAXIMO)) {
+                obtemBarramento (&barramentoDoRTC, &clienteRelogio);
+                if (salvaPartida (&gRtc, &fixDoGPS)) {
+                    proximaPartida = Kernel::get_ms_count () + PARTIDA_INTERVALO_MS;
+                    if (ajustaRTC (&relogioDoGPS, &gRtc, Kernel::get_ms_count ())) {
+                        printf ("RTC acertado pela hora do GPS\r\n");
+                    }
+                }
+                liberaBarramento (&barramentoDoRTC, &clienteRelogio);
+            }
+        }
+
+        // Calibração refeita pela navegação: guardada no DS1307 para a próxima partida
+        publicacaoDaCalibracao = leCalibracao (&calibracaoDoCarro, &calibracao);
+        if (publicacaoDaCalibracao != calibracaoGravada) {
+            obtemBarramento (&barramentoDoRTC, &clienteRelogio);
+            if (salvaCalibracao (&gRtc, &calibracao)) {
+                calibracaoGravada = publicacaoDaCalibracao;
+                printf ("Calibracao guardada: giro %d %d %d (10^-4 rad/s); acelerometro %d %d %d (mm/s2); "
+                        "montagem %d %d %d (10^-4 rad)\r\n", calibracao.gyro[0], calibracao.gyro[1],
+                        calibracao.gyro[2], calibracao.acce[0], calibracao.acce[1], calibracao.acce[2],
+                        calibracao.rolagem, calibracao.arfagem, calibracao.guinada);
+            }
+            liberaBarramento (&barramentoDoRTC, &clienteRelogio);
+        }
+
+        // Ocupação dos barramentos I2C e espera de cada cliente
+        if (Kernel::get_ms_count () >= proximoRelatorio) {
+            agoraUs = us_ticker_read ();
+            relatorioBarramento (&barramentoDaMPU, "I2C MPU6050", anterioresDaMPU, agoraUs - relatorioAnteriorUs);
+            relatorioBarramento (&barramentoDoRTC, "I2C DS1307", anterioresDoRTC, agoraUs - relatorioAnteriorUs);
+            relatorioAnteriorUs = agoraUs;
+            proximoRelatorio = Kernel::get_ms_count () + BARRAMENTO_RELATORIO_MS;
+        }
+
+        gravarTrajeto (nomeTrajeto);
+        gravarEventosDeCerca (nomeCercas);
+        gravarViagens ();
+        gravarPavimento (nomePavimento);
+        gravarBuracos (nomeBuracos, nomeJanelas);
+        gravarEspectro (nomeEspectro);
+        gravarConducao (nomeConducao);
         //Espera por 1000 ms (gravação a cada 1 segundo aproximadamente)
         wait_ms (1000);
     }    
@@ -663,22 +1221,47 @@ static void LoRa_send_message () {
 
         //DateTime dt;
         float acce[3];
+        MPU6050Motion6 amostraMPU;
         float temperatura;
         int16_t retcode;            
+        char textoLatitude[16], textoLongitude[16], textoVelocidade[16];
+        dataGPS dadosDoGPS;
+        uint64_t instante;
+        uint16_t bandas[ESPECTRO_BANDAS];
+        uint8_t conducao[CONDUCAO_TIPOS];
         
-        ark.getAccelero (acce);
-        temperatura = ark.getTemp ();
+        obtemBarramento (&barramentoDaMPU, &clienteLoRa);
+        ark.getMotion6Raw (&amostraMPU);
+        liberaBarramento (&barramentoDaMPU, &clienteLoRa);
+        ark.convertMotion6 (&amostraMPU, acce, NULL, &temperatura);
         //dt = gRtc.now ();        
 
         payloader.addAccelerometer (acce[0], acce[1], acce[2]);                
         payloader.addTemperature (temperatura);
-        semaforo_acessar_gps.acquire ();
-        if (dadosDoGPS.valid == 'A') {
+
+        // Média das bandas do espectro desde o envio anterior
+        core_util_critical_section_enter ();
+        mediaEspectro (&acumuladorDoEspectro, bandas);
+        core_util_critical_section_exit ();
+        payloader.addEspectro (bandas, ESPECTRO_BANDAS);
+
+        // Eventos de condução brusca desde o envio anterior
+        codificaConducao (&conducaoDoCarro, conducaoEnviada, conducao);
+        payloader.addConducao (conducao);
+        leGPS (&publicadorDaNavegacao, &dadosDoGPS);
+        if (fixConfiavel (&dadosDoGPS, GPS_HDOP_MAXIMO)) {
             payloader.addGPS (dadosDoGPS.latitude, dadosDoGPS.longitude, dadosDoGPS.speed);
-            payloader.addGPSData (&dadosDoGPS.date[0], dadosDoGPS.time);
-            printf ("Latitude: %.2lf / Longitude: %.2lf / Velocidade: %.2lf\r\n", dadosDoGPS.latitude, dadosDoGPS.longitude, dadosDoGPS.speed);
+            instante = tempoEmMs (&relogioDoGPS, Kernel::get_ms_count ());
+            if (instante != 0) {
+                DateTime agora = horaLocal (instante);
+                payloader.addGPSData (agora.day (), agora.month (), agora.year (),
+                                      agora.hour (), agora.minute (), agora.second ());
+            }
+            printf ("Latitude: %s / Longitude: %s / Velocidade: %s\r\n",
+                    formataDecimal (textoLatitude, sizeof (textoLatitude), dadosDoGPS.latitude, 7, 2),
+                    formataDecimal (textoLongitude, sizeof (textoLongitude), dadosDoGPS.longitude, 7, 2),
+                    formataDecimal (textoVelocidade, sizeof (textoVelocidade), MM_S_PARA_KMH_E4 (dadosDoGPS.speed), 4, 2));
         }            
-        semaforo_acessar_gps.release ();
 
         // Envia os dados para o servidor
         retcode = lorawan.send (15, payloader.dados, payloader.tamanho, MSG_UNCONFIRMED_FLAG);
@@ -689,6 +1272,33 @@ static void LoRa_send_message () {
         ev_queue.call_in (TX_INTERVAL, LoRa_send_message);       
 }
 
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * Manda o aviso de buraco para o servidor da rede
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+static void enviarAvisoDeBuraco () {
+    // Só esta função (Thread da ev_queue) usa o aviso pendente
+    static eventoBuraco aviso;
+    static bool pendente = false;
+    uint8_t mensagem[BURACO_TAMANHO_AVISO];
+    int16_t retcode;
+
+    if (!pendente) {
+        pendente = retiraDaFila (&filaDeAvisos, &aviso);
+        if (!pendente) {
+            return;
+        }
+    }
+
+    retcode = lorawan.send (BURACO_PORTA_LORA, mensagem, codificaAvisoBuraco (&aviso, mensagem), MSG_UNCONFIRMED_FLAG);
+    if (retcode < 0) {
+        return;
+    }
+    printf ("Aviso de buraco %lu enviado\r\n", aviso.numero);
+    pendente = false;
+}
+
 /**
  *----------------------------------------------------------------------------------------------------------------------
  * Recebe mensagem do servidor da rede
@@ -726,6 +1336,7 @@ static void lora_event_handler (lorawan_event_t event) {
             } else {
                 ev_queue.call_every (TX_INTERVAL, LoRa_send_message);
             }
+            ev_queue.call_every (BURACO_VERIFICACAO_MS, enviarAvisoDeBuraco);
             break;
         case DISCONNECTED:
             ev_queue.break_dispatch ();
@@ -766,52 +1377,615 @@ static void lora_event_handler (lorawan_event_t event) {
  *----------------------------------------------------------------------------------------------------------------------
  */
 void adquirirDadosDoGPS (void) {
-    char c;
-    char cDataBuffer[200];
+    // Fix em montagem: privado desta Thread, publicado apenas quando completo
+    dataGPS dadosDoGPS;
+    uint8_t c;
+    uint32_t inicio;
+    Timer cronometro;
+
+    memset (&dadosDoGPS, 0, sizeof (dadosDoGPS));
+    iniciaSimplificador (&simplificadorDoTrajeto, TRAJETO_ERRO_MAXIMO_M);
+    iniciaFila (&filaDoTrajeto);
+    iniciaFila (&filaDasCercas);
+    iniciaOdometro (&odometroDoCarro);
+    iniciaFila (&filaDeViagens);
+    cercasAtivas = iniciaCercas (&cercasDoCarro, verticesDasCercas, poligonosDasCercas, quantidadeDeCercas,
+                                 &gradeDasCercas);
+    if (!cercasAtivas) {
+        printf ("Cercas: mais de %d cercas em gradeDasCercas.cpp\r\n", CERCA_MAX_POLIGONOS);
+    }
+    iniciaMontador (&montadorGPS);
+    iniciaFusaoNMEA (&fusaoGPS);
+    iniciaDecodificadorUBX (&decodificadorGPS);
+    iniciaFila (&bufferGPS);
+    gps.attach (callback (receberByteDoGPS), RawSerial::RxIrq);
+    cronometro.start ();
+
     while (true) {
-        if (gps.readable ()) {
-            if (gps.getc () == '$') { // Espera um $ (Identifica o inicio de um mensagem)
-                for (int i = 0; i < sizeof (cDataBuffer); i++) {
-                    c = gps.getc();
-                    if (c == '\r' ) {
-                        semaforo_acessar_gps.acquire ();
-                        parse (cDataBuffer, i, &dadosDoGPS);
-                        semaforo_acessar_gps.release ();
-                        i = sizeof (cDataBuffer);                        
-                    } else {
-                        cDataBuffer[i] = c;
-                    }                
+        // Dorme até que a interrupção sinalize uma linha completa
+        semaforo_linha_gps.acquire ();
+
+        inicio = cronometro.read_us ();
+        while (retiraDaFila (&bufferGPS, &c)) {
+            desempenhoDoGPS.bytes++;
+            // Bytes que não pertencem a um quadro UBX seguem para o montador NMEA
+            int quadroUBX = decodificaUBX (&decodificadorGPS, c);
+            if (quadroUBX > 0) {
+                if (interpretaUBX (&decodificadorGPS, &dadosDoGPS)) {
+                    publicarFix (&dadosDoGPS);
                 }
-            } 
+            } else if (quadroUBX < 0) {
+                // A soma de verificação é conferida byte a byte; sentenças inválidas
+                // são descartadas sem decodificação. O fix é publicado uma vez por época.
+                if (montaSentenca (&montadorGPS, c) &&
+                    fundeNMEA (&fusaoGPS, montadorGPS.sentenca, montadorGPS.tamanho, &dadosDoGPS)) {
+                    publicarFix (&dadosDoGPS);
+                }
+            }
         }
+        desempenhoDoGPS.tempoDeProcessamentoUs += cronometro.read_us () - inicio;
     }
     return;
 }
 
-void calibracao (void) {
-    //printf ("Calibrando...\r\n\n");
-    float acceCalib[3];
-    bool controle = true;
+static void publicarFix (const dataGPS *fix) {
+    dataGPS ponto;
+    eventoCerca eventos[TAMANHO_FILA_CERCA];
+    resumoViagem resumo;
+    int i, n;
+
+    publicaGPS (&publicadorDoGPS, fix);
+    if (fix->valid == 'A') {
+        sincronizaRelogio (&relogioDoGPS, fix, Kernel::get_ms_count ());
+    }
+    if (simplificaGPS (&simplificadorDoTrajeto, fix, &ponto)) {
+        insereNaFila (&filaDoTrajeto, &ponto);
+    }
+    if (cercasAtivas && fixConfiavel (fix, GPS_HDOP_MAXIMO)) {
+        n = verificaCercas (&cercasDoCarro, fix, eventos, TAMANHO_FILA_CERCA);
+        for (i = 0; i < n; i++) {
+            insereNaFila (&filaDasCercas, &eventos[i]);
+        }
+    }
+    if (atualizaOdometro (&odometroDoCarro, fix, vibracaoDoCarro.ligado, Kernel::get_ms_count (), &resumo)) {
+        insereNaFila (&filaDeViagens, &resumo);
+    }
+    desempenhoDoGPS.fixes++;
+}
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * Trajeto simplificado
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+void gravarTrajeto (const char *nomeTrajeto) {
+    dataGPS ponto;
+    char textoLatitude[16], textoLongitude[16], textoVelocidade[16];
+    DateTime instante;
+    FILE *arq;
+
+    if (filaDoTrajeto.inicio == filaDoTrajeto.fim) {
+        return;
+    }
+
+    // Se o arquivo não abrir, os pontos permanecem na fila até a próxima tentativa
+    arq = fopen (nomeTrajeto, "a+");
+    if (!arq) {
+        printf ("Falha ao abrir o arquivo de trajeto.\r\n");
+        return;
+    }
+    fseek (arq, 0, SEEK_END);
+    if (ftell (arq) == 0) {
+        fprintf (arq, "Data;Hora;Latitude;Longitude;Velocidade\r\n");
+    }
+
+    while (retiraDaFila (&filaDoTrajeto, &ponto)) {
+        instante = horaLocal (tempoDoFix (&ponto));
+        fprintf (arq, "%02u%02u%02u;%ld;%s;%s;%s\r\n",
+                 instante.day (), instante.month (), instante.year () % 100,
+                 instante.hour () * 10000L + instante.minute () * 100 + instante.second (),
+                 formataDecimal (textoLatitude, sizeof (textoLatitude), ponto.latitude, 7, 6),
+                 formataDecimal (textoLongitude, sizeof (textoLongitude), ponto.longitude, 7, 6),
+                 formataDecimal (textoVelocidade, sizeof (textoVelocidade), MM_S_PARA_KMH_E4 (ponto.speed), 4, 4));
+    }
+    fclose (arq);
+}
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * Cercas virtuais
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+void gravarEventosDeCerca (const char *nomeCercas) {
+    eventoCerca evento;
+    const poligonoCerca *cerca;
+    char textoLatitude[16], textoLongitude[16];
+    DateTime instante;
+    FILE *arq;
+
+    if (filaDasCercas.inicio == filaDasCercas.fim) {
+        return;
+    }
+
+    // Se o arquivo não abrir, os eventos permanecem na fila até a próxima tentativa
+    arq = fopen (nomeCercas, "a+");
+    if (!arq) {
+        printf ("Falha ao abrir o arquivo de cercas.\r\n");
+        return;
+    }
+    fseek (arq, 0, SEEK_END);
+    if (ftell (arq) == 0) {
+        fprintf (arq, "Data;Hora;Cerca;Tipo;Evento;Latitude;Longitude\r\n");
+    }
+
+    while (retiraDaFila (&filaDasCercas, &evento)) {
+        cerca = &poligonosDasCercas[evento.poligono];
+        instante = horaLocal (evento.instante);
+        formataDecimal (textoLatitude, sizeof (textoLatitude), evento.latitude, 7, 6);
+        formataDecimal (textoLongitude, sizeof (textoLongitude), evento.longitude, 7, 6);
+        fprintf (arq, "%02u%02u%02u;%ld;%s;%c;%c;%s;%s\r\n",
+                 instante.day (), instante.month (), instante.year () % 100,
+                 instante.hour () * 10000L + instante.minute () * 100 + instante.second (),
+                 cerca->nome, cerca->tipo, evento.transicao, textoLatitude, textoLongitude);
+        printf ("Cerca %s: %s\r\n", cerca->nome, evento.transicao == CERCA_ENTRADA ? "entrada" : "saida");
+    }
+    fclose (arq);
+}
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * Resumo das viagens
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+void gravarViagens (void) {
+    resumoViagem viagem;
+    char texto[6][16];
+    DateTime instante;
+    FILE *arq;
+
+    if (filaDeViagens.inicio == filaDeViagens.fim) {
+        return;
+    }
+
+    // Se o arquivo não abrir, os resumos permanecem na fila até a próxima tentativa
+    arq = fopen (ARQUIVO_VIAGENS, "a+");
+    if (!arq) {
+        printf ("Falha ao abrir o arquivo de viagens.\r\n");
+        return;
+    }
+    fseek (arq, 0, SEEK_END);
+    if (ftell (arq) == 0) {
+        fprintf (arq, "Viagem;Data;Hora;Duracao;Distancia;MarchaLenta;VelocidadeMaxima;"
+                      "LatitudeInicial;LongitudeInicial;LatitudeFinal;LongitudeFinal\r\n");
+    }
+
+    while (retiraDaFila (&filaDeViagens, &viagem)) {
+        instante = horaLocal (viagem.inicio);
+        // Distância em km, durações em segundos e velocidade em km/h
+        fprintf (arq, "%lu;%02u%02u%02u;%ld;%lu;%s;%lu;%s;%s;%s;%s;%s\r\n",
+                 viagem.numero,
+                 instante.day (), instante.month (), instante.year () % 100,
+                 instante.hour () * 10000L + instante.minute () * 100 + instante.second (),
+                 viagem.duracaoMs / 1000,
+                 formataDecimal (texto[0], sizeof (texto[0]), viagem.distanciaMm, 6, 3),
+                 viagem.tempoParadoMs / 1000,
+                 formataDecimal (texto[1], sizeof (texto[1]), MM_S_PARA_KMH_E4 (viagem.velocidadeMaxima), 4, 1),
+                 formataDecimal (texto[2], sizeof (texto[2]), viagem.latitudeInicial, 7, 6),
+                 formataDecimal (texto[3], sizeof (texto[3]), viagem.longitudeInicial, 7, 6),
+                 formataDecimal (texto[4], sizeof (texto[4]), viagem.latitudeFinal, 7, 6),
+                 formataDecimal (texto[5], sizeof (texto[5]), viagem.longitudeFinal, 7, 6));
+        printf ("Viagem %lu concluida: %s km\r\n", viagem.numero, texto[0]);
+    }
+    fclose (arq);
+}
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * Irregularidade do pavimento
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+void gravarPavimento (const char *nomePavimento) {
+    trechoPavimento trecho;
+    char texto[5][16];
+    DateTime instante;
+    FILE *arq;
+
+    if (filaDoPavimento.inicio == filaDoPavimento.fim) {
+        return;
+    }
+
+    // Se o arquivo não abrir, os trechos permanecem na fila até a próxima tentativa
+    arq = fopen (nomePavimento, "a+");
+    if (!arq) {
+        printf ("Falha ao abrir o arquivo de pavimento.\r\n");
+        return;
+    }
+    fseek (arq, 0, SEEK_END);
+    if (ftell (arq) == 0) {
+        fprintf (arq, "Data;Hora;Latitude;Longitude;Velocidade;RMS;Pico\r\n");
+    }
+
+    while (retiraDaFila (&filaDoPavimento, &trecho)) {
+        instante = horaLocal (trecho.instante);
+        fprintf (arq, "%02u%02u%02u;%ld;%s;%s;%s;%s;%s\r\n",
+                 instante.day (), instante.month (), instante.year () % 100,
+                 instante.hour () * 10000L + instante.minute () * 100 + instante.second (),
+                 formataDecimal (texto[0], sizeof (texto[0]), trecho.latitude, 7, 6),
+                 formataDecimal (texto[1], sizeof (texto[1]), trecho.longitude, 7, 6),
+                 formataDecimal (texto[2], sizeof (texto[2]), MM_S_PARA_KMH_E4 (trecho.velocidade), 4, 1),
+                 formataDecimal (texto[3], sizeof (texto[3]), trecho.rms, 3, 3),
+                 formataDecimal (texto[4], sizeof (texto[4]), trecho.pico, 3, 3));
+    }
+    fclose (arq);
+}
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * Buracos e lombadas
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+void gravarBuracos (const char *nomeBuracos, const char *nomeJanelas) {
+    const capturaBuraco *captura;
+    const eventoBuraco *evento;
+    float acce[3], gyro[3];
+    char texto[5][16];
+    DateTime instante;
+    FILE *arq, *janelas;
+    int i;
+
+    if (filaDosBuracos.inicio == filaDosBuracos.fim) {
+        return;
+    }
+
+    // Se um dos arquivos não abrir, as janelas permanecem na fila até a próxima tentativa
+    arq = fopen (nomeBuracos, "a+");
+    if (!arq) {
+        printf ("Falha ao abrir o arquivo de buracos.\r\n");
+        return;
+    }
+    janelas = fopen (nomeJanelas, "a+");
+    if (!janelas) {
+        printf ("Falha ao abrir o arquivo de janelas.\r\n");
+        fclose (arq);
+        return;
+    }
+    fseek (arq, 0, SEEK_END);
+    if (ftell (arq) == 0) {
+        fprintf (arq, "Evento;Data;Hora;Tipo;Latitude;Longitude;Velocidade;Pico;Jerk\r\n");
+    }
+    fseek (janelas, 0, SEEK_END);
+    if (ftell (janelas) == 0) {
+        fprintf (janelas, "Evento;Amostra;Ace 1;Ace 2;Ace 3;Gyro 1;Gyro 2;Gyro 3\r\n");
+    }
+
+    while ((captura = consultaFila (&filaDosBuracos)) != NULL) {
+        evento = &captura->evento;
+        instante = horaLocal (evento->instante);
+        fprintf (arq, "%lu;%02u%02u%02u;%ld;%c;%s;%s;%s;%s;%u\r\n",
+                 evento->numero,
+                 instante.day (), instante.month (), instante.year () % 100,
+                 instante.hour () * 10000L + instante.minute () * 100 + instante.second (),
+                 evento->tipo,
+                 formataDecimal (texto[0], sizeof (texto[0]), evento->latitude, 7, 6),
+                 formataDecimal (texto[1], sizeof (texto[1]), evento->longitude, 7, 6),
+                 formataDecimal (texto[2], sizeof (texto[2]), MM_S_PARA_KMH_E4 (evento->velocidade), 4, 1),
+                 formataDecimal (texto[3], sizeof (texto[3]), evento->pico, 3, 2),
+                 evento->jerk);
+        for (i = 0; i < BURACO_JANELA; i++) {
+            ark.convertMotion6 (&captura->amostras[i], acce, gyro, NULL);
+            fprintf (janelas, "%lu;%d;%.2f;%.2f;%.2f;%.2f;%.2f;%.2f\r\n",
+                     evento->numero, i - (BURACO_PRE_AMOSTRAS - 1),
+                     acce[0], acce[1], acce[2], gyro[0], gyro[1], gyro[2]);
+        }
+        printf ("%s %lu: %s m/s2 a %s km/h\r\n", evento->tipo == BURACO_BURACO ? "Buraco" : "Lombada",
+                evento->numero, texto[3], texto[2]);
+        liberaDaFila (&filaDosBuracos);
+    }
+    fclose (janelas);
+    fclose (arq);
+}
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * Espectro da vibração
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+void gravarEspectro (const char *nomeEspectro) {
+    static const float limites[ESPECTRO_BANDAS + 1] = ESPECTRO_LIMITES_HZ;
+    janelaEspectro janela;
+    char texto[3][16];
+    DateTime instante;
+    FILE *arq;
+    int b;
+
+    if (filaDoEspectro.inicio == filaDoEspectro.fim) {
+        return;
+    }
+
+    // Se o arquivo não abrir, as janelas permanecem na fila até a próxima tentativa
+    arq = fopen (nomeEspectro, "a+");
+    if (!arq) {
+        printf ("Falha ao abrir o arquivo de espectro.\r\n");
+        return;
+    }
+    fseek (arq, 0, SEEK_END);
+    if (ftell (arq) == 0) {
+        fprintf (arq, "Data;Hora;Latitude;Longitude;Velocidade");
+        for (b = 0; b < ESPECTRO_BANDAS; b++) {
+            fprintf (arq, ";%d-%d Hz", (int)limites[b], (int)limites[b + 1]);
+        }
+        fprintf (arq, "\r\n");
+    }
+
+    while (retiraDaFila (&filaDoEspectro, &janela)) {
+        instante = horaLocal (janela.instante);
+        fprintf (arq, "%02u%02u%02u;%ld;%s;%s;%s",
+                 instante.day (), instante.month (), instante.year () % 100,
+                 instante.hour () * 10000L + instante.minute () * 100 + instante.second (),
+                 formataDecimal (texto[0], sizeof (texto[0]), janela.latitude, 7, 6),
+                 formataDecimal (texto[1], sizeof (texto[1]), janela.longitude, 7, 6),
+                 formataDecimal (texto[2], sizeof (texto[2]), MM_S_PARA_KMH_E4 (janela.velocidade), 4, 1));
+        for (b = 0; b < ESPECTRO_BANDAS; b++) {
+            fprintf (arq, ";%s", formataDecimal (texto[0], sizeof (texto[0]), janela.bandas[b], 3, 3));
+        }
+        fprintf (arq, "\r\n");
+
+        core_util_critical_section_enter ();
+        acumulaEspectro (&acumuladorDoEspectro, &janela);
+        core_util_critical_section_exit ();
+    }
+    fclose (arq);
+}
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * Condução brusca
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+void gravarConducao (const char *nomeConducao) {
+    eventoConducao evento;
+    char texto[4][16];
+    DateTime instante;
+    FILE *arq;
+
+    if (filaDaConducao.inicio == filaDaConducao.fim) {
+        return;
+    }
+
+    // Se o arquivo não abrir, os eventos permanecem na fila até a próxima tentativa
+    arq = fopen (nomeConducao, "a+");
+    if (!arq) {
+        printf ("Falha ao abrir o arquivo de conducao.\r\n");
+        return;
+    }
+    fseek (arq, 0, SEEK_END);
+    if (ftell (arq) == 0) {
+        fprintf (arq, "Evento;Data;Hora;Tipo;Severo;Latitude;Longitude;Velocidade;Pico;Duracao\r\n");
+    }
+
+    while (retiraDaFila (&filaDaConducao, &evento)) {
+        instante = horaLocal (evento.instante);
+        fprintf (arq, "%lu;%02u%02u%02u;%ld;%c;%d;%s;%s;%s;%s;%u\r\n", evento.numero,
+                 instante.day (), instante.month (), instante.year () % 100,
+                 instante.hour () * 10000L + instante.minute () * 100 + instante.second (),
+                 CONDUCAO_CODIGOS[evento.tipo], evento.severo ? 1 : 0,
+                 formataDecimal (texto[0], sizeof (texto[0]), evento.latitude, 7, 6),
+                 formataDecimal (texto[1], sizeof (texto[1]), evento.longitude, 7, 6),
+                 formataDecimal (texto[2], sizeof (texto[2]), MM_S_PARA_KMH_E4 (evento.velocidade), 4, 1),
+                 formataDecimal (texto[3], sizeof (texto[3]), evento.pico, 3, 2),
+                 evento.duracaoMs);
+    }
+    fclose (arq);
+}
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * Partida rápida
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+static void prepararPartidaRapida (void) {
+    partidaGPS partida;
+    dataGPS referencia;
+    uint64_t instante = 0;
+    int sincronizado;
+
+    memset (&referencia, 0, sizeof (referencia));
+    obtemBarramento (&barramentoDoRTC, &clienteRelogio);
+    sincronizado = sincronizaRelogioRTC (&relogioDoGPS, &gRtc, Kernel::get_ms_count ());
+    liberaBarramento (&barramentoDoRTC, &clienteRelogio);
+    if (sincronizado) {
+        instante = tempoEmMs (&relogioDoGPS, Kernel::get_ms_count ());
+        dataHoraDoTempo (instante, &referencia);
+    } else {
+        printf ("Partida: RTC parado ou desacertado, aguardando a hora do GPS\r\n");
+    }
+
+    if (carregaPartida (&gRtc, &partida)) {
+        referencia.latitude = partida.latitude;
+        referencia.longitude = partida.longitude;
+        referencia.altitude = partida.altitude;
+        // Com a bateria do GPS, efemérides de menos de 4 horas ainda valem (partida quente)
+        if (instante != 0 && instante / 1000 >= partida.tempoDoFix) {
+            printf ("Partida: ultimo fix ha %lu min\r\n", (uint32_t)(instante / 1000 - partida.tempoDoFix) / 60);
+        }
+    } else {
+        printf ("Partida: nenhum fix guardado no RTC\r\n");
+    }
+
+    enviaPartidaUBX (&gps, &referencia, PARTIDA_PRECISAO_POSICAO_CM, PARTIDA_PRECISAO_TEMPO_MS);
+}
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * Calibração guardada
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+static void prepararCalibracao (void) {
+    // Só lê a cópia da memória feita na construção do RtcDs1307: não usa o barramento
+    temCalibracaoGuardada = carregaCalibracao (&gRtc, &calibracaoGuardada);
+    if (!temCalibracaoGuardada) {
+        printf ("Calibracao: nenhum registro no RTC, aguardando o carro parar\r\n");
+        return;
+    }
+    printf ("Calibracao: bias %s, nivel %s, guinada da montagem %s\r\n",
+            (calibracaoGuardada.validos & CALIBRACAO_BIAS) ? "guardado" : "desconhecido",
+            (calibracaoGuardada.validos & CALIBRACAO_NIVEL) ? "guardado" : "desconhecido",
+            (calibracaoGuardada.validos & CALIBRACAO_GUINADA) ? "guardada" : "desconhecida");
+}
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * Interrupção de recepção do GPS
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+void receberByteDoGPS (void) {
+    uint8_t c;
+    while (gps.readable ()) {
+        c = gps.getc ();
+        insereNaFila (&bufferGPS, &c);
+        // Acorda a Thread ao fim de uma sentença NMEA ou de um quadro UBX
+        if (c == '\n' || fimDeQuadroUBX (&delimitadorGPS, c)) {
+            semaforo_linha_gps.release ();
+        }
+    }
+}
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * Navegação estimada
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+void amostraProntaDaMPU (void) {
+    if (contaAmostraPronta (&amostrasSinalizadas, IMU_AMOSTRAS_POR_LEITURA)) {
+        semaforo_fifo_imu.release ();
+    }
+}
+
+void coletarIMU (void) {
+    iniciaFila (&filaDaIMU);
+    obtemBarramento (&barramentoDaMPU, &clienteColetaIMU);
+    ark.setBW (MPU6050_BW_188);
+    ark.setSampleRateDivider (1000 / IMU_TAXA_HZ - 1);
+    ark.setMotion6Fifo (true);
+    ark.setInterrupts (MPU6050_INT_DATA_RDY);
+    liberaBarramento (&barramentoDaMPU, &clienteColetaIMU);
+    iniciaColetor (&coletorDaIMU, &ark, &barramentoDaMPU, &clienteColetaIMU, &filaDaIMU, &desempenhoDaIMU);
+    interrupcaoDaMPU.rise (callback (amostraProntaDaMPU));
+
+    while (true) {
+        semaforo_fifo_imu.try_acquire_for (IMU_ESPERA_MAXIMA_MS);
+        esvaziaFifoIMU (&coletorDaIMU);
+        semaforo_fila_imu.release ();
+    }
+}
+
+void estimarPosicao (void) {
+    float acce[3], gyro[3], somaAcce[3] = { 0 }, somaGyro[3] = { 0 };
+    float vertical[PAVIMENTO_BLOCO];
+    MPU6050Motion6 amostra, brutas[PAVIMENTO_BLOCO];
+    dataGPS ultimoFix, estimativa;
+    trechoPavimento trecho;
+    eventoBuraco buraco;
+    janelaEspectro janela;
+    eventoConducao conducao;
+    uint64_t instante = 0;
+    uint32_t fixAnterior = 0, fixAtual;
+    int acumuladas = 0, noBloco = 0, k;
+
+    memset (&ultimoFix, 0, sizeof (ultimoFix));
+    memset (&estimativa, 0, sizeof (estimativa));
+    iniciaNavegacao (&navegacao);
+    iniciaAtitude (&atitudeDoCarro);
+    iniciaCalibracao (&calibracaoDoCarro, IMU_TAXA_HZ);
+    if (temCalibracaoGuardada) {
+        aplicaCalibracao (&calibracaoDoCarro, &atitudeDoCarro, &calibracaoGuardada);
+    }
+    iniciaVibracao (&vibracaoDoCarro);
+    iniciaPavimento (&pavimentoDoCarro, IMU_TAXA_HZ);
+    iniciaFila (&filaDoPavimento);
+    iniciaDetectorBuraco (&detectorDoCarro, IMU_TAXA_HZ);
+    iniciaFila (&filaDosBuracos);
+    iniciaFila (&filaDeAvisos);
+    iniciaEspectro (&espectroDoCarro, IMU_TAXA_HZ);
+    iniciaFila (&filaDoEspectro);
+    iniciaConducao (&conducaoDoCarro, IMU_TAXA_HZ);
+    iniciaFila (&filaDaConducao);
+    printf ("Espectro: FFT %s\r\n", ESPECTRO_CMSIS_DSP ? "CMSIS-DSP" : "portatil");
 
     while (true) {
-        ark.getAccelero (acceCalib);
-
-        if (acceCalib[2] <= 7.5) {
-            ledPouco = 1; // LED is OFF
-            ledMedio = 0; // LED is OFF
-            ledOkay = 0; // LED is ON            
-        } else if (acceCalib[2] > 7.9 && acceCalib[2] < 10.7) {
-            ledPouco = 0; // LED is ON
-            ledMedio = 1; // LED is OFF
-            ledOkay = 0; // LED is OFF 
-        } else if (acceCalib[2] >= 10.8) {
-            ledPouco = 0; // LED is OFF
-            ledMedio = 0; // LED is ON
-            ledOkay = 1; // LED is OFF
+        semaforo_fila_imu.acquire ();
+
+        while (retiraDaFila (&filaDaIMU, &amostra)) {
+            ark.convertMotion6 (&amostra, acce, gyro, NULL);
+            corrigeCalibracao (&calibracaoDoCarro, acce, gyro);
+
+            // Atitude a cada amostra: daqui em diante, aceleração sem a gravidade no referencial do carro nivelado
+            atualizaAtitude (&atitudeDoCarro, acce, gyro, 1.0f / IMU_TAXA_HZ);
+            acumulaCalibracao (&calibracaoDoCarro, &atitudeDoCarro, acce, gyro);
+
+            // Condução brusca: todas as amostras, com a posição da última estimativa e o instante do último bloco.
+            // Só conta depois que a calibração mediu a guinada da montagem (antes, X não é a frente do carro).
+            if (classificaConducao (&conducaoDoCarro, atitudeDoCarro.linear, &estimativa, instante,
+                                    (calibracaoDoCarro.registro.validos & CALIBRACAO_GUINADA) != 0, &conducao)) {
+                insereNaFila (&filaDaConducao, &conducao);
+            }
+            for (k = 0; k < 3; k++) {
+                somaAcce[k] += atitudeDoCarro.linear[k];
+                somaGyro[k] += atitudeDoCarro.giro[k];
+            }
+
+            // Pavimento: todas as amostras, com a posição e a velocidade da última estimativa. A distância é lida
+            // pela sequência do odômetro (escrito pela Thread do GPS) e só os 32 bits baixos são usados: o valor
+            // dá a volta a cada 4295 km, mas a diferença entre trechos não depende da volta do contador.
+            // O detector de buracos recebe, amostra a amostra, a leitura bruta e o valor filtrado do bloco.
+            brutas[noBloco] = amostra;
+            vertical[noBloco++] = atitudeDoCarro.linear[2];
+            if (noBloco == PAVIMENTO_BLOCO) {
+                noBloco = 0;
+                instante = tempoEmMs (&relogioDoGPS, Kernel::get_ms_count ());
+                if (processaPavimento (&pavimentoDoCarro, vertical, PAVIMENTO_BLOCO,
+                                       (uint32_t)leDistanciaOdometro (&odometroDoCarro), &estimativa,
+                                       instante, &trecho)) {
+                    insereNaFila (&filaDoPavimento, &trecho);
+                }
+                for (k = 0; k < PAVIMENTO_BLOCO; k++) {
+                    if (detectaBuraco (&detectorDoCarro, &filaDosBuracos, &brutas[k], pavimentoDoCarro.filtrado[k],
+                                       &estimativa, instante, &buraco)) {
+                        insereNaFila (&filaDeAvisos, &buraco);
+                    }
+                }
+                if (acrescentaEspectro (&espectroDoCarro, vertical, PAVIMENTO_BLOCO, &estimativa, instante, &janela)) {
+                    insereNaFila (&filaDoEspectro, &janela);
+                }
+            }
+
+            if (++acumuladas < IMU_DECIMACAO) {
+                continue;
+            }
+            // A vibração usa a última amostra do grupo: a média atenuaria a vibração do motor
+            atualizaVibracao (&vibracaoDoCarro, acce);
+
+            // Média do grupo: o intervalo é exato, dado pela taxa de amostragem do sensor
+            for (k = 0; k < 3; k++) {
+                acce[k] = somaAcce[k] / IMU_DECIMACAO;
+                gyro[k] = somaGyro[k] / IMU_DECIMACAO;
+                somaAcce[k] = somaGyro[k] = 0.0f;
+            }
+            acumuladas = 0;
+            propagaNavegacao (&navegacao, acce, gyro, (float)IMU_DECIMACAO / IMU_TAXA_HZ);
+
+            // Corrige apenas quando há um fix novo
+            fixAtual = leGPS (&publicadorDoGPS, &ultimoFix);
+            if (fixAtual != fixAnterior) {
+                fixAnterior = fixAtual;
+                corrigeNavegacao (&navegacao, &ultimoFix);
+                fixCalibracao (&calibracaoDoCarro, &atitudeDoCarro, &ultimoFix);
+            }
+
+            estimaNavegacao (&navegacao, &ultimoFix, &estimativa);
+            publicaGPS (&publicadorDaNavegacao, &estimativa);
         }
-        wait_ms (700);
-    }  
-    return;
+    }
 }
 
 /**
@@ -835,14 +2009,17 @@ int controleDeGravacao (char *novoNomeDeArquivo) {
     }
     
     char ajuste[2];
-    char texto[9];
+    char texto[9] = "";
     int tamanho;
     int err = 0;
 
     fseek (arq, 0, SEEK_END);
     tamanho = ftell (arq);
-    fseek (arq, (tamanho - 10), SEEK_SET);
-    fgets (texto, 9, arq);
+    // Controle vazio (cartão novo): não há arquivo anterior
+    if (tamanho >= 10) {
+        fseek (arq, (tamanho - 10), SEEK_SET);
+        fgets (texto, 9, arq);
+    }
     fclose (arq);
     printf ("\r\nLido: %s \r\n", texto);
 
@@ -850,11 +2027,13 @@ int controleDeGravacao (char *novoNomeDeArquivo) {
 
     arq = fopen ("/fs/controle/controle.txt","a+");
 
-    semaforo_acessar_gps.acquire ();
-    if (dadosDoGPS.date[4] == texto[0] && dadosDoGPS.date[5] == texto[1] && dadosDoGPS.date[2] == texto[2] &&
-        dadosDoGPS.date[3] == texto[3] && dadosDoGPS.date[0] == texto[4] && dadosDoGPS.date[1] == texto[5] ) {
+    // Data local no formato aammdd, a mesma usada no nome dos arquivos; sem hora do GPS nem do RTC, a do arquivo anterior
+    char hoje[7];
+    if (!dataDoArquivo (tempoEmMs (&relogioDoGPS, Kernel::get_ms_count ()), texto, hoje)) {
+        printf ("Sem hora do GPS ou do RTC: mantendo a data %s\r\n", hoje);
+    }
+    if (strncmp (hoje, texto, 6) == 0) {
         
-        semaforo_acessar_gps.release ();
 
         printf ("Mesma data!\r\n");
 
@@ -889,17 +2068,10 @@ int controleDeGravacao (char *novoNomeDeArquivo) {
           novoNomeDeArquivo[6] = ajuste[0]; novoNomeDeArquivo[7] = ajuste[1];
 
     } else {
-        semaforo_acessar_gps.release ();
         fseek (arq, 0, SEEK_END);
         printf ("Data diferente!\r\n");
 
-        semaforo_acessar_gps.acquire ();
-        fprintf (arq, "%d%d%d%d%d%d%c%c\r\n", 
-                 dadosDoGPS.date[4] - 48,  dadosDoGPS.date[5] - 48,
-                 dadosDoGPS.date[2] - 48,  dadosDoGPS.date[3] - 48,
-                 dadosDoGPS.date[0] - 48,  dadosDoGPS.date[1] - 48,
-                 'A', 'A');
-        semaforo_acessar_gps.release ();
+        err = fprintf (arq, "%s%c%c\r\n", hoje, 'A', 'A');
 
         if (err < 0) {
             fclose (arq);
@@ -907,12 +2079,8 @@ int controleDeGravacao (char *novoNomeDeArquivo) {
             return 1;
         }
         
-        semaforo_acessar_gps.acquire ();
-        novoNomeDeArquivo[0] = dadosDoGPS.date[4] ; novoNomeDeArquivo[1] = dadosDoGPS.date[5] ;
-        novoNomeDeArquivo[2] = dadosDoGPS.date[2] ; novoNomeDeArquivo[3] = dadosDoGPS.date[3] ;
-        novoNomeDeArquivo[4] = dadosDoGPS.date[0] ; novoNomeDeArquivo[5] = dadosDoGPS.date[1] ;
-        novoNomeDeArquivo[6] = 'A'; novoNomeDeArquivo[7] = 'A';
-        semaforo_acessar_gps.release ();         
+        memcpy (novoNomeDeArquivo, hoje, 6);
+        novoNomeDeArquivo[6] = 'A'; novoNomeDeArquivo[7] = 'A';         
     }
     
     fclose (arq);
@@ -0,0 +1,229 @@
+/**
+ * benchmarkCercas.cpp       v0.0        17-10-2026
+ *
+ * Orientador: Elias Teodoro da Silva Junior
+ * Autores: Felipe Moura de Castro e Joao Bruno Costa Cruz,
+ * Instituto Federal de Educação, Ciência e Tecnologia do Ceará (IFCE) - Campus Fortaleza
+ *
+ * @Opensource
+ * Este código-fonte pode ser utilizado, copiado, estudado, modificado e redistribuído sem restrições.
+ *
+ * Copyright (c) 2019, Felipe Moura de Castro e Joao Bruno Costa Cruz.
+ *
+ */
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * Benchmark das cercas virtuais com BENCHMARK_CERCAS cercas (compilado com CERCA_MAX_POLIGONOS = 1024)
+ *
+ * As cercas (retângulos, polígonos convexos e estrelas côncavas de 50 a 400 m) são espalhadas por uma área de
+ * ~28 x 28 km ao redor de Fortaleza. Para cada tamanho de grade são informados o tempo de montagem no computador, o
+ * tamanho da grade na FLASH, as arestas por célula e o custo de localizaNasCercas por ponto, comparado com o teste
+ * par-ímpar sobre todas as arestas de todas as cercas (força bruta). Os resultados das duas formas são conferidos em
+ * BENCHMARK_CONFERIDOS pontos. Por fim, é medido o custo de verificaCercas por fix ao longo de um trajeto que entra e
+ * sai de várias cercas.
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+#include "teste.h"
+#include <stdlib.h>
+#include "CercaCarro/cercaCarro.h"
+
+#define BENCHMARK_CERCAS        1000
+#define BENCHMARK_PONTOS        200000
+#define BENCHMARK_CONFERIDOS    20000
+#define BENCHMARK_FIXES         100000
+#define BENCHMARK_MAX_VERTICES  (BENCHMARK_CERCAS * 12)
+#define BENCHMARK_GRADE_MAXIMA  (128 * 128)
+
+static verticeCerca vertices[BENCHMARK_MAX_VERTICES];
+static poligonoCerca poligonos[BENCHMARK_CERCAS];
+static uint16_t inicioDaCelula[BENCHMARK_GRADE_MAXIMA + 1];
+static registroCerca registros[CERCA_MAX_INDICE + 1];
+static uint16_t arestas[CERCA_MAX_INDICE];
+static int32_t pontos[BENCHMARK_PONTOS][2];
+static uint32_t semente = 88172645u;
+
+static uint32_t aleatorio (void) {
+    semente ^= semente << 13;
+    semente ^= semente >> 17;
+    semente ^= semente << 5;
+    return semente;
+}
+
+static int32_t entre (int32_t minimo, int32_t maximo) {
+    return minimo + (int32_t)(aleatorio () % (uint32_t)(maximo - minimo + 1));
+}
+
+// Cerca com centro (latitude, longitude) e raio aproximado (graus * 10^7); retorna os vértices usados
+static int criaCerca (int indice, int primeiro, int32_t latitude, int32_t longitude, int32_t raio) {
+    int forma = (int)(aleatorio () % 3), n, k;
+    double angulo, r;
+
+    poligonos[indice].nome = "benchmark";
+    poligonos[indice].tipo = CERCA_RESTRITA;
+    poligonos[indice].primeiroVertice = (uint16_t)primeiro;
+    if (forma == 0) {
+        int32_t altura = entre (raio / 3, raio), largura = entre (raio / 3, raio);
+        verticeCerca retangulo[4] = { { latitude + altura, longitude - largura }, { latitude + altura, longitude + largura },
+                                      { latitude - altura, longitude + largura }, { latitude - altura, longitude - largura } };
+        memcpy (&vertices[primeiro], retangulo, sizeof (retangulo));
+        n = 4;
+    } else {
+        n = (forma == 1) ? entre (3, 8) : 2 * entre (3, 6);
+        for (k = 0; k < n; k++) {
+            angulo = 2.0 * 3.14159265358979 * (k + 0.3 * (aleatorio () % 1000) / 1000.0) / n;
+            r = (forma == 2 && (k & 1)) ? raio * 0.35 : raio * (0.7 + 0.3 * (aleatorio () % 1000) / 1000.0);
+            vertices[primeiro + k].latitude = latitude + (int32_t)(r * cos (angulo));
+            vertices[primeiro + k].longitude = longitude + (int32_t)(r * sin (angulo));
+        }
+    }
+    poligonos[indice].quantidadeDeVertices = (uint16_t)n;
+    return n;
+}
+
+// Teste par-ímpar com todas as arestas de uma cerca
+static int dentroPorForcaBruta (const poligonoCerca *poligono, int32_t latitude, int32_t longitude) {
+    const verticeCerca *a, *b;
+    int dentro = 0, i;
+    int64_t o;
+
+    for (i = 0; i < poligono->quantidadeDeVertices; i++) {
+        a = &vertices[poligono->primeiroVertice + i];
+        b = &vertices[poligono->primeiroVertice + (i + 1) % poligono->quantidadeDeVertices];
+        if ((a->latitude > latitude) != (b->latitude > latitude)) {
+            o = ((int64_t)b->longitude - a->longitude) * ((int64_t)latitude - a->latitude) -
+                ((int64_t)b->latitude - a->latitude) * ((int64_t)longitude - a->longitude);
+            dentro ^= (b->latitude > a->latitude) ? (o > 0) : (o < 0);
+        }
+    }
+    return dentro;
+}
+
+static void forcaBruta (int32_t latitude, int32_t longitude, uint32_t *dentro) {
+    int p;
+
+    memset (dentro, 0, CERCA_PALAVRAS * sizeof (uint32_t));
+    for (p = 0; p < BENCHMARK_CERCAS; p++) {
+        if (dentroPorForcaBruta (&poligonos[p], latitude, longitude)) {
+            dentro[p >> 5] |= (uint32_t)1 << (p & 31);
+        }
+    }
+}
+
+int main (void) {
+    static const uint16_t lados[] = { 16, 32, 64, 128 };
+    montagemCerca montagem;
+    cercasCarro cercas;
+    eventoCerca eventos[8];
+    dataGPS fix;
+    uint32_t dentro[CERCA_PALAVRAS], esperado[CERCA_PALAVRAS], celulas, c, arestasNaCelula, maiorNaCelula, ocupadas;
+    uint64_t inicio, nsMontagem, nsGrade, nsForcaBruta, nsVerificacao;
+    unsigned long soma = 0, somaBruta = 0;
+    int i, t, usados = 0, diferentes, eventosGerados = 0;
+    double nsPorPontoBruta, nsPorPonto64 = 0.0;
+    size_t bytes;
+
+    for (i = 0; i < BENCHMARK_CERCAS; i++) {
+        usados += criaCerca (i, usados, entre (-38500000, -36000000), entre (-386500000, -384000000),
+                             entre (4500, 36000));
+    }
+    for (i = 0; i < BENCHMARK_PONTOS; i++) {
+        pontos[i][0] = entre (-38600000, -35900000);
+        pontos[i][1] = entre (-386600000, -383900000);
+    }
+    printf ("%d cercas, %d vertices\n", BENCHMARK_CERCAS, usados);
+
+    // Força bruta: todas as arestas de todas as cercas a cada ponto
+    inicio = agoraNs ();
+    for (i = 0; i < BENCHMARK_CONFERIDOS; i++) {
+        forcaBruta (pontos[i][0], pontos[i][1], esperado);
+        somaBruta += esperado[i % CERCA_PALAVRAS];
+    }
+    nsForcaBruta = agoraNs () - inicio;
+    nsPorPontoBruta = (double)nsForcaBruta / BENCHMARK_CONFERIDOS;
+    printf ("forca bruta: %.0f ns/ponto\n", nsPorPontoBruta);
+
+    for (t = 0; t < (int)(sizeof (lados) / sizeof (lados[0])); t++) {
+        memset (&montagem, 0, sizeof (montagem));
+        montagem.inicioDaCelula = inicioDaCelula;
+        montagem.registros = registros;
+        montagem.arestas = arestas;
+        montagem.maximoDeRegistros = CERCA_MAX_INDICE;
+        montagem.maximoDeArestas = CERCA_MAX_INDICE;
+
+        inicio = agoraNs ();
+        if (!montaGradeCerca (&montagem, lados[t], lados[t], vertices, poligonos, BENCHMARK_CERCAS)) {
+            printf ("grade %3u x %3u: nao montada (centro sobre aresta ou grade cheia)\n", lados[t], lados[t]);
+            continue;
+        }
+        nsMontagem = agoraNs () - inicio;
+        CONFERE (iniciaCercas (&cercas, vertices, poligonos, BENCHMARK_CERCAS, &montagem.grade));
+
+        celulas = (uint32_t)lados[t] * lados[t];
+        maiorNaCelula = ocupadas = 0;
+        for (c = 0; c < celulas; c++) {
+            arestasNaCelula = registros[inicioDaCelula[c + 1]].primeiraAresta - registros[inicioDaCelula[c]].primeiraAresta;
+            maiorNaCelula = (arestasNaCelula > maiorNaCelula) ? arestasNaCelula : maiorNaCelula;
+            ocupadas += (inicioDaCelula[c + 1] != inicioDaCelula[c]);
+        }
+        bytes = (celulas + 1) * sizeof (uint16_t) + (montagem.quantidadeDeRegistros + 1) * sizeof (registroCerca) +
+                montagem.quantidadeDeArestas * sizeof (uint16_t) + sizeof (gradeCerca);
+
+        // Melhor de 3 passadas por todos os pontos
+        nsGrade = UINT64_MAX;
+        for (i = 0; i < 3; i++) {
+            inicio = agoraNs ();
+            for (int k = 0; k < BENCHMARK_PONTOS; k++) {
+                localizaNasCercas (&cercas, pontos[k][0], pontos[k][1], dentro);
+                soma += dentro[k % CERCA_PALAVRAS];
+            }
+            inicio = agoraNs () - inicio;
+            nsGrade = (inicio < nsGrade) ? inicio : nsGrade;
+        }
+
+        diferentes = 0;
+        for (i = 0; i < BENCHMARK_CONFERIDOS; i++) {
+            localizaNasCercas (&cercas, pontos[i][0], pontos[i][1], dentro);
+            forcaBruta (pontos[i][0], pontos[i][1], esperado);
+            diferentes += memcmp (dentro, esperado, sizeof (dentro)) != 0;
+        }
+
+        printf ("grade %3u x %3u: montada em %6.1f ms, %6lu bytes de FLASH, %5u registros, %5u arestas, "
+                "%4.1f arestas por celula ocupada (maior %3u), %6.1f ns/ponto (%5.0fx a forca bruta), %d diferencas\n",
+                lados[t], lados[t], nsMontagem / 1e6, (unsigned long)bytes, montagem.quantidadeDeRegistros,
+                montagem.quantidadeDeArestas, ocupadas ? (double)montagem.quantidadeDeArestas / ocupadas : 0.0,
+                maiorNaCelula, (double)nsGrade / BENCHMARK_PONTOS,
+                nsPorPontoBruta / ((double)nsGrade / BENCHMARK_PONTOS), diferentes);
+        CONFERE (diferentes == 0);
+        if (lados[t] == 64) {
+            nsPorPonto64 = (double)nsGrade / BENCHMARK_PONTOS;
+        }
+    }
+    CONFERE (nsPorPonto64 > 0.0 && nsPorPonto64 * 20.0 < nsPorPontoBruta);
+
+    // verificaCercas por fix, em zigue-zague pela área (entra e sai de várias cercas) com a grade de 64 x 64
+    memset (&montagem, 0, sizeof (montagem));
+    montagem.inicioDaCelula = inicioDaCelula;
+    montagem.registros = registros;
+    montagem.arestas = arestas;
+    montagem.maximoDeRegistros = CERCA_MAX_INDICE;
+    montagem.maximoDeArestas = CERCA_MAX_INDICE;
+    CONFERE (montaGradeCerca (&montagem, 64, 64, vertices, poligonos, BENCHMARK_CERCAS));
+    CONFERE (iniciaCercas (&cercas, vertices, poligonos, BENCHMARK_CERCAS, &montagem.grade));
+    memset (&fix, 0, sizeof (fix));
+    fix.valid = 'A';
+    inicio = agoraNs ();
+    for (i = 0; i < BENCHMARK_FIXES; i++) {
+        fix.latitude = -38500000 + (i % 1000) * 2500;
+        fix.longitude = -386500000 + (i / 1000) * 25000 + (i % 7) * 50;
+        eventosGerados += verificaCercas (&cercas, &fix, eventos, 8);
+    }
+    nsVerificacao = agoraNs () - inicio;
+    printf ("verificaCercas: %.1f ns/fix, %d eventos em %d fixes\n", (double)nsVerificacao / BENCHMARK_FIXES,
+            eventosGerados, BENCHMARK_FIXES);
+    CONFERE (eventosGerados > 0);
+
+    // As somas só impedem que o compilador descarte as consultas
+    printf ("(%lu %lu)\n", soma & 0xFF, somaBruta & 0xFF);
+    return FIM_DO_TESTE ();
+}
@@ -0,0 +1,207 @@
+/**
+ * benchmarkDataCatch.cpp       v0.0        17-10-2026
+ *
+ * Orientador: Elias Teodoro da Silva Junior
+ * Autores: Felipe Moura de Castro e Joao Bruno Costa Cruz,
+ * Instituto Federal de Educação, Ciência e Tecnologia do Ceará (IFCE) - Campus Fortaleza
+ *
+ * @Opensource
+ * Este código-fonte pode ser utilizado, copiado, estudado, modificado e redistribuído sem restrições.
+ *
+ * Copyright (c) 2019, Felipe Moura de Castro e Joao Bruno Costa Cruz.
+ *
+ */
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * Benchmark do dataCatch atual (uma passada, inteiros em ponto fixo) contra o da primeira versão (campo a campo, em
+ * double), sobre as mesmas sentenças $GPRMC
+ *
+ * Uso: benchmarkDataCatch [arquivo ...]
+ *
+ * As sentenças vêm das capturas informadas (linhas "$GPRMC") ou, sem arquivos, de 3600 épocas simuladas. Para cada
+ * sentença, a posição e a velocidade da versão atual são conferidas com os valores exatos do texto, os demais campos
+ * são conferidos com a versão original e o tempo médio de cada versão é informado em ns/sentença (melhor de
+ * BENCHMARK_RODADAS rodadas).
+ *
+ * A versão original erra a longitude quando o 5º decimal dos minutos não é zero (potencia (10) estoura o int) e a
+ * velocidade e o curso quando eles não têm 3 dígitos inteiros (o peso dos dígitos é fixo); essas diferenças são
+ * contadas.
+ *
+ * No computador o double é calculado em hardware; no Cortex-M4F ele é emulado em software, de forma que a diferença de
+ * tempo entre as versões no NUCLEO_F411RE é maior que a medida aqui.
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+#include "teste.h"
+#include "GPS_Carro/GPS_Carro.h"
+#include "gpsOriginal.h"
+#include "trajetoSimulado.h"
+
+#define BENCHMARK_EPOCAS        3600
+#define BENCHMARK_RODADAS       5
+#define BENCHMARK_MAXIMO        100000
+
+static char sentencas[BENCHMARK_MAXIMO][TAMANHO_SENTENCA_GPS];
+static int tamanhos[BENCHMARK_MAXIMO];
+static int quantidade = 0;
+
+// Guarda as linhas $GPRMC da captura sem o '$' e sem o "\r\n" (com a soma "*hh"), como entregues pelo montador
+static void separaSentencas (const char *captura, int tamanho) {
+    const char *p = captura, *fim = captura + tamanho, *linha;
+    int n;
+
+    while (p < fim && quantidade < BENCHMARK_MAXIMO) {
+        linha = p;
+        while (p < fim && *p != '\n') {
+            p++;
+        }
+        n = (int)(p - linha);
+        while (n > 0 && (linha[n - 1] == '\r' || linha[n - 1] == '\n')) {
+            n--;
+        }
+        if (n > 6 && n < TAMANHO_SENTENCA_GPS - 8 && strncmp (linha, "$GPRMC", 6) == 0) {
+            memcpy (sentencas[quantidade], linha + 1, n - 1);
+            // A versão original não tem limite de tamanho: a sentença termina com '\0' e folga
+            memset (sentencas[quantidade] + n - 1, 0, TAMANHO_SENTENCA_GPS - n + 1);
+            tamanhos[quantidade++] = n - 1;
+        }
+        p++;
+    }
+}
+
+static void carregaArquivo (const char *caminho) {
+    FILE *arquivo = fopen (caminho, "rb");
+    static char bloco[1 << 20];
+    size_t n;
+
+    if (arquivo == NULL) {
+        printf ("%s: nao foi possivel ler\n", caminho);
+        return;
+    }
+    n = fread (bloco, 1, sizeof (bloco), arquivo);
+    fclose (arquivo);
+    separaSentencas (bloco, (int)n);
+}
+
+// Diferenças da versão original em relação aos valores exatos
+static int diferencasLatitude = 0, diferencasLongitude = 0, diferencasVelocidade = 0, diferencasCurso = 0;
+
+/**
+ * Valores exatos dos campos da sentença, lidos do texto com sscanf e convertidos em long double (independente do
+ * GPS_Carro): posição em graus * 10^7, velocidade em mm/s e curso em graus * 10^2
+ */
+static bool valoresExatos (const char *sentenca, long long *latitude, long long *longitude, long long *velocidade,
+                           long long *curso) {
+    int grausLat, minutosLat, fracaoLat, grausLon, minutosLon, fracaoLon, nos, milesimos, graus, centesimos;
+    char norteSul, lesteOeste;
+
+    if (sscanf (sentenca, "GPRMC,%*[^,],%*c,%2d%2d.%5d,%c,%3d%2d.%5d,%c,%d.%3d,%d.%2d", &grausLat, &minutosLat,
+                &fracaoLat, &norteSul, &grausLon, &minutosLon, &fracaoLon, &lesteOeste, &nos, &milesimos, &graus,
+                &centesimos) != 12) {
+        return false;
+    }
+    *latitude = llroundl ((grausLat + (minutosLat + fracaoLat / 100000.0L) / 60.0L) * 1e7L) * (norteSul == 'S' ? -1 : 1);
+    *longitude = llroundl ((grausLon + (minutosLon + fracaoLon / 100000.0L) / 60.0L) * 1e7L) *
+                 (lesteOeste == 'W' ? -1 : 1);
+    *velocidade = llroundl ((nos + milesimos / 1000.0L) * 1852000.0L / 3600.0L);
+    *curso = graus * 100LL + centesimos;
+    return true;
+}
+
+/**
+ * A versão atual deve dar os valores exatos. A versão original deve concordar nos campos de texto, no tempo e no
+ * curso; as diferenças dela na posição e na velocidade são apenas contadas (ver o resumo impresso no main)
+ */
+static void comparaResultados (int i) {
+    char copia[TAMANHO_SENTENCA_GPS];
+    original::dataGPS antigo;
+    dataGPS atual;
+    long long latitude = 0, longitude = 0, velocidade = 0, curso = 0;
+
+    memset (&antigo, 0, sizeof (antigo));
+    memset (&atual, 0, sizeof (atual));
+    memcpy (copia, sentencas[i], sizeof (copia));
+    original::dataCatch (copia, &antigo);
+    dataCatch (sentencas[i], tamanhos[i], &atual);
+
+    CONFERE (valoresExatos (sentencas[i], &latitude, &longitude, &velocidade, &curso));
+    CONFERE (atual.latitude == latitude);
+    CONFERE (atual.longitude == longitude);
+    CONFERE (atual.speed == velocidade);
+    CONFERE (atual.course == curso);
+
+    CONFERE (antigo.valid == atual.valid);
+    CONFERE (strncmp (antigo.date, atual.date, 6) == 0);
+    // A versão original já subtraía 3 h do tempo UTC
+    CONFERE ((int32_t)antigo.time == atual.time - 30000);
+
+    diferencasLatitude += llabs (llround (antigo.latitude * 1e7) - latitude) > 5;
+    diferencasLongitude += llabs (llround (antigo.longitude * 1e7) - longitude) > 5;
+    // A versão original dava km/h com 1 knot = 1,853 km/h
+    diferencasVelocidade += llabs (llround (antigo.speed / 1.853 * 1852.0 / 3.6) - velocidade) > 1;
+    diferencasCurso += llround (antigo.course * 100.0) != curso;
+}
+
+static double mede (bool versaoOriginal) {
+    char copia[TAMANHO_SENTENCA_GPS];
+    original::dataGPS antigo;
+    dataGPS atual;
+    uint64_t inicio, melhor = UINT64_MAX;
+    volatile int32_t soma = 0;
+    int rodada, i;
+
+    for (rodada = 0; rodada < BENCHMARK_RODADAS; rodada++) {
+        inicio = agoraNs ();
+        for (i = 0; i < quantidade; i++) {
+            // As duas versões pagam a mesma cópia da sentença; a soma impede que o compilador descarte a decodificação
+            if (versaoOriginal) {
+                memcpy (copia, sentencas[i], TAMANHO_SENTENCA_GPS);
+                original::dataCatch (copia, &antigo);
+                soma += (int32_t)antigo.latitude;
+            } else {
+                memcpy (copia, sentencas[i], TAMANHO_SENTENCA_GPS);
+                dataCatch (copia, tamanhos[i], &atual);
+                soma += atual.latitude;
+            }
+        }
+        if (agoraNs () - inicio < melhor) {
+            melhor = agoraNs () - inicio;
+        }
+    }
+    return (double)melhor / quantidade;
+}
+
+int main (int argc, char **argv) {
+    double nsOriginal, nsAtual;
+    uint8_t *captura;
+    int tamanho, i;
+
+    if (argc > 1) {
+        for (i = 1; i < argc; i++) {
+            carregaArquivo (argv[i]);
+        }
+    } else {
+        captura = geraCaptura (RECEPTOR_GPS, BENCHMARK_EPOCAS, 1.5, &tamanho);
+        separaSentencas ((const char *)captura, tamanho);
+        free (captura);
+        CONFERE (quantidade == BENCHMARK_EPOCAS);
+    }
+    if (quantidade == 0) {
+        printf ("nenhuma sentenca $GPRMC\n");
+        return 1;
+    }
+
+    for (i = 0; i < quantidade; i++) {
+        comparaResultados (i);
+    }
+
+    nsOriginal = mede (true);
+    nsAtual = mede (false);
+    printf ("%d sentencas $GPRMC\n", quantidade);
+    printf ("dataCatch original: %7.1f ns/sentenca\n", nsOriginal);
+    printf ("dataCatch atual:    %7.1f ns/sentenca (%.2fx)\n", nsAtual, nsOriginal / nsAtual);
+    printf ("versao original difere do valor exato (mais de 5 * 10^-7 graus ou 1 mm/s) em %d latitudes, "
+            "%d longitudes, %d velocidades e %d cursos\n", diferencasLatitude, diferencasLongitude, diferencasVelocidade,
+            diferencasCurso);
+    return FIM_DO_TESTE ();
+}
@@ -0,0 +1,115 @@
+/**
+ * benchmarkRelogio.cpp       v0.0        17-10-2026
+ *
+ * Orientador: Elias Teodoro da Silva Junior
+ * Autores: Felipe Moura de Castro e Joao Bruno Costa Cruz,
+ * Instituto Federal de Educação, Ciência e Tecnologia do Ceará (IFCE) - Campus Fortaleza
+ *
+ * @Opensource
+ * Este código-fonte pode ser utilizado, copiado, estudado, modificado e redistribuído sem restrições.
+ *
+ * Copyright (c) 2019, Felipe Moura de Castro e Joao Bruno Costa Cruz.
+ *
+ */
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * Benchmark da leitura da hora do DS1307 a 1 kHz: bloqueante x assíncrona (DEVICE_I2C_ASYNCH = 1)
+ *
+ * O I2C do stub simula o tempo no fio a 100 kHz: a leitura bloqueante ocupa a Thread em espera ativa, como o driver do
+ * STM32, e I2C::transfer conclui a transferência em outra Thread (a "interrupção"). A cada 1 ms uma leitura é feita de
+ * cada forma: a bloqueante com as mesmas operações write/read da versão anterior do RtcDs1307::now, e a assíncrona pelo
+ * now atual, que dorme no EventFlags até o fim do transfer. Para cada uma são informados a latência (da chamada ao
+ * retorno) e o tempo de CPU da Thread que chamou (CLOCK_THREAD_CPUTIME_ID), que é o que as outras Threads ganham.
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+#include "teste.h"
+#include "Adafruit_RTCLib/DS1307.h"
+#include <thread>
+#include <chrono>
+
+#define TESTE_LEITURAS          500
+#define TESTE_PERIODO_US        1000
+#define TESTE_DS1307            0xD0
+
+static I2C i2c;
+
+static uint64_t cpuDaThreadNs (void) {
+    struct timespec agora;
+    clock_gettime (CLOCK_THREAD_CPUTIME_ID, &agora);
+    return (uint64_t)agora.tv_sec * 1000000000u + (uint64_t)agora.tv_nsec;
+}
+
+// Leitura bloqueante dos 7 registros da hora, como a versão anterior do RtcDs1307::now
+static void leituraBloqueante (void) {
+    char registro = 0, hora[7];
+
+    if (i2c.write (TESTE_DS1307, &registro, 1, true) == 0) {
+        i2c.read (TESTE_DS1307, hora, sizeof (hora));
+    }
+}
+
+// Repete a leitura a 1 kHz e informa a latência e a CPU médias e a maior latência (em us)
+static void mede (const char *nome, RtcDs1307 *rtc, bool assincrona, double *cpuMedia, double *latenciaMedia) {
+    std::chrono::steady_clock::time_point proxima = std::chrono::steady_clock::now ();
+    uint64_t inicio, cpu, latencia, somaCpu = 0, somaLatencia = 0, maiorLatencia = 0;
+    int i;
+
+    for (i = 0; i < TESTE_LEITURAS; i++) {
+        proxima += std::chrono::microseconds (TESTE_PERIODO_US);
+        std::this_thread::sleep_until (proxima);
+
+        inicio = agoraNs ();
+        cpu = cpuDaThreadNs ();
+        if (assincrona) {
+            rtc->now ();
+        } else {
+            leituraBloqueante ();
+        }
+        somaCpu += cpuDaThreadNs () - cpu;
+        latencia = agoraNs () - inicio;
+        somaLatencia += latencia;
+        if (latencia > maiorLatencia) {
+            maiorLatencia = latencia;
+        }
+    }
+    *cpuMedia = somaCpu / 1000.0 / TESTE_LEITURAS;
+    *latenciaMedia = somaLatencia / 1000.0 / TESTE_LEITURAS;
+    printf ("%-12s latencia media %6.1f us (maior %6.1f us), CPU da Thread %6.1f us por leitura\n", nome,
+            *latenciaMedia, maiorLatencia / 1000.0, *cpuMedia);
+}
+
+int main (void) {
+    RtcDs1307 rtc (i2c);
+    DateTime acerto (2026, 10, 17, 13, 45, 30);
+    DateTime lida;
+    double cpuBloqueante, latenciaBloqueante, cpuAssincrona, latenciaAssincrona, fio;
+
+    // A hora lida pelo transfer deve ser a escrita pelo adjust
+    CONFERE (rtc.adjust (acerto));
+    lida = rtc.now ();
+    CONFERE (lida.unixtime () == acerto.unixtime ());
+
+    // Falha no barramento: o now não fica esperando e não inventa uma hora
+    i2c.falha = true;
+    lida = rtc.now ();
+    CONFERE (lida.unixtime () != acerto.unixtime ());
+    i2c.falha = false;
+
+    i2c.hz = 100000;
+    i2c.simulaTempo = true;
+    // Endereço + registro, endereço + 7 bytes da hora
+    fio = i2c.tempoNoFioUs (2) + i2c.tempoNoFioUs (8);
+    printf ("DS1307 a %d Hz: %.0f us no fio por leitura, %d leituras a 1 kHz\n", i2c.hz, fio, TESTE_LEITURAS);
+    mede ("bloqueante", &rtc, false, &cpuBloqueante, &latenciaBloqueante);
+    mede ("assincrona", &rtc, true, &cpuAssincrona, &latenciaAssincrona);
+    printf ("liberados %.1f us de CPU por leitura (%.0f%% do tempo no fio)\n", cpuBloqueante - cpuAssincrona,
+            100.0 * (cpuBloqueante - cpuAssincrona) / fio);
+
+    CONFERE (latenciaBloqueante >= fio && latenciaAssincrona >= fio);
+    CONFERE (cpuBloqueante >= 0.9 * fio);
+    CONFERE (cpuBloqueante - cpuAssincrona > 0.5 * fio);
+    lida = rtc.now ();
+    CONFERE (lida.unixtime () >= acerto.unixtime ());
+    return FIM_DO_TESTE ();
+}
@@ -0,0 +1,212 @@
+/**
+ * benchmarkSimplificaGPS.cpp       v0.0        17-10-2026
+ *
+ * Orientador: Elias Teodoro da Silva Junior
+ * Autores: Felipe Moura de Castro e Joao Bruno Costa Cruz,
+ * Instituto Federal de Educação, Ciência e Tecnologia do Ceará (IFCE) - Campus Fortaleza
+ *
+ * @Opensource
+ * Este código-fonte pode ser utilizado, copiado, estudado, modificado e redistribuído sem restrições.
+ *
+ * Copyright (c) 2019, Felipe Moura de Castro e Joao Bruno Costa Cruz.
+ *
+ */
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * Benchmark do simplificador do trajeto (simplificaGPS)
+ *
+ * Uso: benchmarkSimplificaGPS [arquivo ...]
+ *
+ * Os fixes vêm das capturas informadas (NMEA ou UBX, decodificadas como na Thread do GPS) ou, sem arquivos, de
+ * BENCHMARK_EPOCAS épocas do trajetoSimulado, com e sem ruído. Para cada erro máximo são informados a taxa de
+ * compressão (fixes recebidos / pontos mantidos) e o custo do simplificaGPS em ns/fix (melhor de BENCHMARK_RODADAS
+ * rodadas).
+ *
+ * A garantia do simplificador também é conferida, em double e independente do GPS_Carro: cada fix descartado fica a no
+ * máximo erroMaximo do segmento entre os dois pontos mantidos que o cercam (e não só da reta, o que importa quando o
+ * carro volta sobre o próprio trajeto ou no ruído com o carro parado).
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+#include "teste.h"
+#include "receptorGPS.h"
+#include "trajetoSimulado.h"
+
+#define BENCHMARK_EPOCAS        3000
+#define BENCHMARK_RODADAS       5
+#define BENCHMARK_MAXIMO        200000
+#define RAIO_DA_TERRA_M         6371000.0
+#define TOLERANCIA_M            0.05        // arredondamento do float no simplificador
+
+static dataGPS fixes[BENCHMARK_MAXIMO];
+static dataGPS mantidos[BENCHMARK_MAXIMO];
+static int indicesMantidos[BENCHMARK_MAXIMO];
+static int quantidade;
+
+// Decodifica a captura e acrescenta os fixes válidos
+static void acrescentaCaptura (const uint8_t *captura, int tamanho) {
+    receptorGPS receptor;
+    dataGPS fix;
+    int i;
+
+    iniciaReceptor (&receptor);
+    for (i = 0; i < tamanho && quantidade < BENCHMARK_MAXIMO; i++) {
+        if (recebeByte (&receptor, captura[i], &fix) && fix.valid == 'A') {
+            fixes[quantidade++] = fix;
+        }
+    }
+}
+
+static bool carregaArquivo (const char *caminho) {
+    FILE *arquivo = fopen (caminho, "rb");
+    static uint8_t bloco[16 << 20];
+    size_t n;
+
+    if (arquivo == NULL) {
+        printf ("%s: nao foi possivel ler\n", caminho);
+        return false;
+    }
+    n = fread (bloco, 1, sizeof (bloco), arquivo);
+    fclose (arquivo);
+    acrescentaCaptura (bloco, (int)n);
+    return true;
+}
+
+// Posição do fix em metros (norte, leste) em relação à referência
+static void emMetros (const dataGPS *referencia, const dataGPS *fix, double *norte, double *leste) {
+    double grausParaMetros = RAIO_DA_TERRA_M * 3.14159265358979323846 / 180.0 * 1e-7;
+
+    *norte = (fix->latitude - referencia->latitude) * grausParaMetros;
+    *leste = (fix->longitude - referencia->longitude) * grausParaMetros *
+             cos (referencia->latitude * 1e-7 * 3.14159265358979323846 / 180.0);
+}
+
+// Distâncias do fix à reta e ao segmento entre a e b (m)
+static void distancias (const dataGPS *a, const dataGPS *b, const dataGPS *fix, double *reta, double *segmento) {
+    double bn, be, pn, pe, comprimento, projecao;
+
+    emMetros (a, b, &bn, &be);
+    emMetros (a, fix, &pn, &pe);
+    comprimento = sqrt (bn * bn + be * be);
+    if (comprimento < 1e-9) {
+        *reta = *segmento = sqrt (pn * pn + pe * pe);
+        return;
+    }
+    *reta = fabs (pn * be - pe * bn) / comprimento;
+    projecao = (pn * bn + pe * be) / comprimento;
+    if (projecao < 0.0) {
+        *segmento = sqrt (pn * pn + pe * pe);
+    } else if (projecao > comprimento) {
+        *segmento = sqrt ((pn - bn) * (pn - bn) + (pe - be) * (pe - be));
+    } else {
+        *segmento = *reta;
+    }
+}
+
+// Simplifica todos os fixes; a perda de sinal no fim encerra o último segmento
+static int simplificaTudo (float erroMaximo, bool guardaIndices) {
+    simplificadorGPS simplificador;
+    dataGPS fim;
+    int i, n = 0;
+
+    iniciaSimplificador (&simplificador, erroMaximo);
+    for (i = 0; i < quantidade; i++) {
+        if (simplificaGPS (&simplificador, &fixes[i], &mantidos[n])) {
+            n++;
+        }
+    }
+    memset (&fim, 0, sizeof (fim));
+    fim.valid = 'V';
+    if (simplificaGPS (&simplificador, &fim, &mantidos[n])) {
+        n++;
+    }
+
+    // Cada ponto mantido é um dos fixes recebidos, na ordem
+    if (guardaIndices) {
+        int j = 0;
+        for (i = 0; i < n; i++) {
+            while (j < quantidade && memcmp (&fixes[j], &mantidos[i], sizeof (dataGPS)) != 0) {
+                j++;
+            }
+            indicesMantidos[i] = j;
+        }
+    }
+    return n;
+}
+
+static void avalia (const char *nome, float erroMaximo) {
+    uint64_t inicio, ns, melhor = UINT64_MAX;
+    double reta, segmento, maiorReta = 0.0, maiorSegmento = 0.0;
+    int rodada, n = 0, i, j, foraDaOrdem = 0, foraDoErro = 0;
+
+    for (rodada = 0; rodada < BENCHMARK_RODADAS; rodada++) {
+        inicio = agoraNs ();
+        n = simplificaTudo (erroMaximo, false);
+        ns = agoraNs () - inicio;
+        melhor = (ns < melhor) ? ns : melhor;
+    }
+
+    simplificaTudo (erroMaximo, true);
+    CONFERE (n >= 2);
+    CONFERE (indicesMantidos[0] == 0);
+    CONFERE (indicesMantidos[n - 1] == quantidade - 1);
+    for (i = 0; i < n; i++) {
+        foraDaOrdem += (indicesMantidos[i] >= quantidade || (i > 0 && indicesMantidos[i] <= indicesMantidos[i - 1]));
+    }
+    CONFERE (foraDaOrdem == 0);
+    if (foraDaOrdem) {
+        return;
+    }
+
+    // Fixes descartados entre cada par de pontos mantidos
+    for (i = 1; i < n; i++) {
+        for (j = indicesMantidos[i - 1] + 1; j < indicesMantidos[i]; j++) {
+            distancias (&mantidos[i - 1], &mantidos[i], &fixes[j], &reta, &segmento);
+            maiorReta = (reta > maiorReta) ? reta : maiorReta;
+            maiorSegmento = (segmento > maiorSegmento) ? segmento : maiorSegmento;
+            foraDoErro += segmento > erroMaximo + TOLERANCIA_M;
+        }
+    }
+
+    printf ("%-26s erro %4.1f m: %6d fixes -> %5d pontos (%5.1f:1) %6.1f ns/fix | maior desvio: reta %5.2f m, "
+            "segmento %6.2f m\n", nome, erroMaximo, quantidade, n, (double)quantidade / n,
+            (double)melhor / quantidade, maiorReta, maiorSegmento);
+    CONFERE (foraDoErro == 0);
+}
+
+static void avaliaTodos (const char *nome) {
+    static const float erros[] = { 2.0f, 5.0f, 10.0f, 25.0f };
+    int i;
+
+    for (i = 0; i < (int)(sizeof (erros) / sizeof (erros[0])); i++) {
+        avalia (nome, erros[i]);
+    }
+}
+
+int main (int argc, char **argv) {
+    static const double ruidos[] = { 0.0, 1.5, 5.0 };
+    char nome[64];
+    uint8_t *captura;
+    int tamanho, i;
+
+    if (argc > 1) {
+        for (i = 1; i < argc; i++) {
+            quantidade = 0;
+            if (carregaArquivo (argv[i]) && quantidade > 1) {
+                avaliaTodos (argv[i]);
+            }
+        }
+        return FIM_DO_TESTE ();
+    }
+
+    for (i = 0; i < (int)(sizeof (ruidos) / sizeof (ruidos[0])); i++) {
+        quantidade = 0;
+        captura = geraCaptura (RECEPTOR_GPS, BENCHMARK_EPOCAS, ruidos[i], &tamanho);
+        acrescentaCaptura (captura, tamanho);
+        free (captura);
+        CONFERE (quantidade == BENCHMARK_EPOCAS);
+        snprintf (nome, sizeof (nome), "simulado, ruido %.1f m", ruidos[i]);
+        avaliaTodos (nome);
+    }
+    return FIM_DO_TESTE ();
+}
@@ -0,0 +1,124 @@
+/**
+ * benchmarkTaxaGPS.cpp       v0.0        17-10-2026
+ *
+ * Orientador: Elias Teodoro da Silva Junior
+ * Autores: Felipe Moura de Castro e Joao Bruno Costa Cruz,
+ * Instituto Federal de Educação, Ciência e Tecnologia do Ceará (IFCE) - Campus Fortaleza
+ *
+ * @Opensource
+ * Este código-fonte pode ser utilizado, copiado, estudado, modificado e redistribuído sem restrições.
+ *
+ * Copyright (c) 2019, Felipe Moura de Castro e Joao Bruno Costa Cruz.
+ *
+ */
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * Carga do GPS a 1, 5 e 10 Hz em 115200 baud
+ *
+ * Para cada taxa de fixes e cada receptor simulado (NEO-6M em NMEA, receptor multi-constelação em NMEA e NEO-6M em
+ * UBX), BENCHMARK_SEGUNDOS de trajeto são escritos como o receptor enviaria e decodificados pela mesma sequência da
+ * Thread do GPS (receptorGPS: UBX, montador e fusão NMEA). São informados:
+ * - bytes/s, que também são as interrupções de recepção por segundo, e a ocupação da serial (10 bits por byte em 8N1);
+ * - o tempo de decodificação por fix e por segundo de tráfego, e a fração de um núcleo do computador que isso ocupa.
+ * Confere que cada época gera um fix, sem sentenças rejeitadas, e que as configurações usadas pelo firmware (NEO-6M a
+ * 5 Hz em NMEA ou UBX) cabem em 115200 baud.
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+#include "teste.h"
+#include "receptorGPS.h"
+#include "trajetoSimulado.h"
+#include <stdlib.h>
+
+#define BENCHMARK_SEGUNDOS      60
+#define BENCHMARK_BAUD          115200
+#define BENCHMARK_TEMPO_MINIMO  0.2
+#define BENCHMARK_EPOCA_MAXIMA  4096
+
+// Tráfego de BENCHMARK_SEGUNDOS a 'taxa' fixes por segundo; receptor -1 é o modo UBX
+static uint8_t *geraTrafego (int receptor, int taxa, int *tamanho) {
+    int epocas = BENCHMARK_SEGUNDOS * taxa, capacidade = epocas * BENCHMARK_EPOCA_MAXIMA, n, i;
+    uint8_t *dados = (uint8_t *)malloc (capacidade);
+    trajetoSimulado trajeto;
+
+    *tamanho = 0;
+    if (dados == NULL) {
+        return NULL;
+    }
+    iniciaTrajeto (&trajeto, 1.5, 2019);
+    for (i = 0; i < epocas; i++) {
+        avancaTrajeto (&trajeto, 1.0 / taxa);
+        if (receptor < 0) {
+            n = escreveEpocaUBX (&trajeto, dados + *tamanho, capacidade - *tamanho);
+        } else {
+            n = escreveEpocaNMEA (&trajeto, receptor, (char *)dados + *tamanho, capacidade - *tamanho);
+        }
+        *tamanho += n;
+    }
+    return dados;
+}
+
+// Decodifica o tráfego até somar BENCHMARK_TEMPO_MINIMO; retorna ns por passada e os contadores da última
+static double decodifica (const uint8_t *dados, int tamanho, uint32_t *fixes, uint32_t *rejeitadas) {
+    receptorGPS receptor;
+    dataGPS fix;
+    uint64_t inicio = agoraNs ();
+    uint32_t passadas = 0;
+    int i;
+
+    do {
+        iniciaReceptor (&receptor);
+        for (i = 0; i < tamanho; i++) {
+            recebeByte (&receptor, dados[i], &fix);
+        }
+        passadas++;
+    } while ((agoraNs () - inicio) * 1e-9 < BENCHMARK_TEMPO_MINIMO);
+
+    *fixes = receptor.fixes;
+    *rejeitadas = receptor.montador.estatisticas.rejeitadas + receptor.decodificador.estatisticas.rejeitadas +
+                  receptor.montador.estatisticas.truncadas + receptor.decodificador.estatisticas.truncadas;
+    return (double)(agoraNs () - inicio) / passadas;
+}
+
+int main (void) {
+    static const struct {
+        const char *nome;
+        int receptor;
+        bool usadoNoFirmware;
+    } receptores[] = {
+        { "NEO-6M NMEA", RECEPTOR_GPS, true },
+        { "M8 NMEA", RECEPTOR_MULTI, false },
+        { "NEO-6M UBX", -1, true },
+    };
+    static const int taxas[] = { 1, 5, 10 };
+    uint32_t fixes, rejeitadas;
+    double ns, bytesPorSegundo, ocupacao;
+    uint8_t *dados;
+    int r, t, tamanho;
+
+    printf ("%-12s %5s %9s %9s %11s %10s %12s\n", "receptor", "Hz", "bytes/s", "serial", "ns/fix", "us/s", "CPU");
+    for (r = 0; r < (int)(sizeof (receptores) / sizeof (receptores[0])); r++) {
+        for (t = 0; t < (int)(sizeof (taxas) / sizeof (taxas[0])); t++) {
+            dados = geraTrafego (receptores[r].receptor, taxas[t], &tamanho);
+            CONFERE (dados != NULL);
+            if (dados == NULL) {
+                continue;
+            }
+            ns = decodifica (dados, tamanho, &fixes, &rejeitadas);
+            bytesPorSegundo = (double)tamanho / BENCHMARK_SEGUNDOS;
+            ocupacao = bytesPorSegundo * 10.0 / BENCHMARK_BAUD;
+            printf ("%-12s %5d %9.0f %8.1f%% %11.0f %10.1f %11.3f%%%s\n", receptores[r].nome, taxas[t],
+                    bytesPorSegundo, 100.0 * ocupacao, ns / (BENCHMARK_SEGUNDOS * taxas[t]),
+                    ns / 1000.0 / BENCHMARK_SEGUNDOS, 100.0 * ns / BENCHMARK_SEGUNDOS / 1e9,
+                    ocupacao > 1.0 ? "  (nao cabe em 115200 baud)" : "");
+
+            CONFERE (fixes == (uint32_t)(BENCHMARK_SEGUNDOS * taxas[t]));
+            CONFERE (rejeitadas == 0);
+            if (receptores[r].usadoNoFirmware && taxas[t] <= 5) {
+                CONFERE (ocupacao < 1.0);
+            }
+            free (dados);
+        }
+    }
+    return FIM_DO_TESTE ();
+}
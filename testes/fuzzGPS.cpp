@@ -0,0 +1,188 @@
+/**
+ * fuzzGPS.cpp       v0.0        17-10-2026
+ *
+ * Orientador: Elias Teodoro da Silva Junior
+ * Autores: Felipe Moura de Castro e Joao Bruno Costa Cruz,
+ * Instituto Federal de Educação, Ciência e Tecnologia do Ceará (IFCE) - Campus Fortaleza
+ *
+ * @Opensource
+ * Este código-fonte pode ser utilizado, copiado, estudado, modificado e redistribuído sem restrições.
+ *
+ * Copyright (c) 2019, Felipe Moura de Castro e Joao Bruno Costa Cruz.
+ *
+ */
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * Fuzzing dos decodificadores do GPS
+ *
+ * LLVMFuzzerTestOneInput entrega a mesma entrada a parse, dataCatch, fundeNMEA (linha a linha, mantendo a fusão entre
+ * as linhas), decodificaUBX/interpretaUBX e à decodificação completa da Thread do GPS. Cada linha é copiada para um
+ * vetor do tamanho exato, de forma que o AddressSanitizer acusa qualquer leitura além do tamanho informado.
+ *
+ * Com clang, o alvo é compilado com -fsanitize=fuzzer (libFuzzer). Com outros compiladores, o main abaixo:
+ * - fuzzGPS arquivo ...      executa cada arquivo (reprodução de um caso encontrado, ou alvo do AFL com @@);
+ * - fuzzGPS -runs=N          executa N entradas obtidas por mutações aleatórias (semente fixa) de capturas simuladas.
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+#include "receptorGPS.h"
+#include "trajetoSimulado.h"
+
+// Entrega a linha (sem o terminador) aos decodificadores de sentença
+static void decodificaLinha (fusaoNMEA *fusao, const uint8_t *linha, size_t n) {
+    char *copia = (char *)malloc (n ? n : 1);
+    dataGPS data;
+
+    memcpy (copia, linha, n);
+    memset (&data, 0, sizeof (data));
+    parse (copia, (int)n, &data);
+    dataCatch (copia, (int)n, &data);
+    fundeNMEA (fusao, copia, (int)n, &data);
+    fixConfiavel (&data, 500);
+    free (copia);
+}
+
+extern "C" int LLVMFuzzerTestOneInput (const uint8_t *dados, size_t tamanho) {
+    fusaoNMEA fusao;
+    decodificadorUBX decodificador;
+    receptorGPS receptor;
+    dataGPS fix;
+    size_t inicio = 0, i;
+
+    // Linhas separadas por '\n', com ou sem o '$' inicial
+    iniciaFusaoNMEA (&fusao);
+    for (i = 0; i <= tamanho; i++) {
+        if (i == tamanho || dados[i] == '\n') {
+            if (inicio < i && dados[inicio] == '$') {
+                inicio++;
+            }
+            decodificaLinha (&fusao, dados + inicio, i - inicio);
+            inicio = i + 1;
+        }
+    }
+
+    // Quadros UBX
+    memset (&fix, 0, sizeof (fix));
+    iniciaDecodificadorUBX (&decodificador);
+    for (i = 0; i < tamanho; i++) {
+        if (decodificaUBX (&decodificador, dados[i]) > 0) {
+            interpretaUBX (&decodificador, &fix);
+        }
+    }
+
+    // Decodificação completa, como na Thread do GPS
+    iniciaReceptor (&receptor);
+    for (i = 0; i < tamanho; i++) {
+        recebeByte (&receptor, dados[i], &fix);
+    }
+    return 0;
+}
+
+#ifndef FUZZ_LIBFUZZER
+
+#define FUZZ_TAMANHO_MAXIMO     4096
+
+static uint32_t sementeDoFuzz = 2463534242u;
+
+static uint32_t aleatorio (void) {
+    sementeDoFuzz ^= sementeDoFuzz << 13;
+    sementeDoFuzz ^= sementeDoFuzz >> 17;
+    sementeDoFuzz ^= sementeDoFuzz << 5;
+    return sementeDoFuzz;
+}
+
+// Bytes que costumam mudar o caminho dos decodificadores
+static uint8_t byteInteressante (void) {
+    static const uint8_t bytes[] = { ',', '*', '$', '\r', '\n', '.', '-', '0', '9', 'A', 'F', 'N', 'S', 'E', 'W',
+                                     0x00, 0xFF, 0xB5, 0x62, 0x01, 0x07 };
+    return (aleatorio () & 1) ? bytes[aleatorio () % sizeof (bytes)] : (uint8_t)aleatorio ();
+}
+
+// Aplica de 1 a 8 mutações: troca de byte, inserção, remoção, corte e repetição de um trecho
+static size_t mutaEntrada (uint8_t *dados, size_t tamanho) {
+    int mutacoes = 1 + aleatorio () % 8, m;
+    size_t posicao, n;
+
+    for (m = 0; m < mutacoes; m++) {
+        posicao = tamanho ? aleatorio () % tamanho : 0;
+        switch (aleatorio () % 5) {
+            case 0:
+                if (tamanho) dados[posicao] = byteInteressante ();
+                break;
+            case 1:
+                if (tamanho < FUZZ_TAMANHO_MAXIMO) {
+                    memmove (dados + posicao + 1, dados + posicao, tamanho - posicao);
+                    dados[posicao] = byteInteressante ();
+                    tamanho++;
+                }
+                break;
+            case 2:
+                if (tamanho) {
+                    memmove (dados + posicao, dados + posicao + 1, tamanho - posicao - 1);
+                    tamanho--;
+                }
+                break;
+            case 3:
+                tamanho = posicao;
+                break;
+            case 4:
+                n = 1 + aleatorio () % 64;
+                if (posicao + n <= tamanho && tamanho + n <= FUZZ_TAMANHO_MAXIMO) {
+                    memmove (dados + posicao + n, dados + posicao, tamanho - posicao);
+                    tamanho += n;
+                }
+                break;
+        }
+    }
+    return tamanho;
+}
+
+int main (int argc, char **argv) {
+    uint8_t *sementes[3], entrada[FUZZ_TAMANHO_MAXIMO];
+    int tamanhos[3], i;
+    long execucoes = 0, n;
+    size_t inicio, tamanho;
+    FILE *arquivo;
+
+    if (argc > 1 && strncmp (argv[1], "-runs=", 6) == 0) {
+        execucoes = atol (argv[1] + 6);
+    } else if (argc > 1) {
+        for (i = 1; i < argc; i++) {
+            arquivo = fopen (argv[i], "rb");
+            if (arquivo == NULL) {
+                printf ("%s: nao foi possivel ler\n", argv[i]);
+                return 1;
+            }
+            tamanho = fread (entrada, 1, sizeof (entrada), arquivo);
+            fclose (arquivo);
+            LLVMFuzzerTestOneInput (entrada, tamanho);
+        }
+        printf ("%d entradas executadas\n", argc - 1);
+        return 0;
+    } else {
+        execucoes = 10000;
+    }
+
+    sementes[0] = geraCaptura (RECEPTOR_GPS, 8, 1.5, &tamanhos[0]);
+    sementes[1] = geraCaptura (RECEPTOR_MULTI, 4, 1.5, &tamanhos[1]);
+    sementes[2] = geraCaptura (-1, 16, 1.5, &tamanhos[2]);
+    for (n = 0; n < execucoes; n++) {
+        // Um trecho aleatório de uma das capturas, mutado
+        i = aleatorio () % 3;
+        inicio = aleatorio () % tamanhos[i];
+        tamanho = 1 + aleatorio () % 512;
+        if (inicio + tamanho > (size_t)tamanhos[i]) {
+            tamanho = tamanhos[i] - inicio;
+        }
+        memcpy (entrada, sementes[i] + inicio, tamanho);
+        tamanho = mutaEntrada (entrada, tamanho);
+        LLVMFuzzerTestOneInput (entrada, tamanho);
+    }
+    for (i = 0; i < 3; i++) {
+        free (sementes[i]);
+    }
+    printf ("%ld entradas executadas\n", execucoes);
+    return 0;
+}
+
+#endif
@@ -0,0 +1,304 @@
+/**
+ * geraGradeCercas.cpp       v0.0        17-10-2026
+ *
+ * Orientador: Elias Teodoro da Silva Junior
+ * Autores: Felipe Moura de Castro e Joao Bruno Costa Cruz,
+ * Instituto Federal de Educação, Ciência e Tecnologia do Ceará (IFCE) - Campus Fortaleza
+ *
+ * @Opensource
+ * Este código-fonte pode ser utilizado, copiado, estudado, modificado e redistribuído sem restrições.
+ *
+ * Copyright (c) 2019, Felipe Moura de Castro e Joao Bruno Costa Cruz.
+ *
+ */
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * Ferramenta que monta no computador o índice em grade das cercas e o escreve como vetores constantes
+ *
+ * Uso: geraGradeCercas [-l linhas -c colunas] cercas.txt gradeDasCercas.cpp
+ *      geraGradeCercas --confere [-l linhas -c colunas] cercas.txt gradeDasCercas.cpp
+ *
+ * O arquivo de entrada tem uma linha "cerca <tipo> <nome>" para cada cerca (tipo G para garagem ou R para área
+ * restrita), seguida de uma linha "<latitude> <longitude>" para cada vértice, em graus * 10^7; linhas vazias e
+ * linhas que começam com '#' são ignoradas. A saída define verticesDasCercas, poligonosDasCercas, quantidadeDeCercas e
+ * gradeDasCercas (declarados em CercaCarro/gradeDasCercas.h), com a grade montada por montaGradeCerca: no carro, tudo
+ * fica na FLASH.
+ *
+ * Sem -l e -c, são montadas grades quadradas de 1 a GRADE_LADO_MAXIMO células de lado (potências de 2) e fica a de
+ * menor quantidade de arestas na pior célula (o custo da consulta no pior caso) entre as que ocupam até
+ * GRADE_FLASH_MAXIMA bytes; no empate, a menor.
+ *
+ * Com --confere nada é escrito: a saída que seria gerada é comparada com o arquivo existente (sem considerar o '\r'
+ * do fim das linhas), e o retorno é 1 se o arquivo está desatualizado.
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdarg.h>
+#include <string.h>
+#include <string>
+#include <vector>
+#include "CercaCarro/cercaCarro.h"
+
+#define GRADE_LADO_MAXIMO       128
+#define GRADE_FLASH_MAXIMA      65536
+#define TAMANHO_NOME_CERCA      64
+
+typedef struct {
+    std::vector<verticeCerca> vertices;
+    std::vector<poligonoCerca> poligonos;
+    std::vector<std::string> nomes;
+} cercasLidas;
+
+static bool leCercas (const char *caminho, cercasLidas *cercas) {
+    FILE *arquivo = fopen (caminho, "r");
+    char linha[256], tipo, nome[TAMANHO_NOME_CERCA];
+    long latitude, longitude;
+    int numero = 0;
+    size_t n;
+
+    if (arquivo == NULL) {
+        fprintf (stderr, "%s: nao foi possivel ler\n", caminho);
+        return false;
+    }
+    while (fgets (linha, sizeof (linha), arquivo) != NULL) {
+        numero++;
+        n = strcspn (linha, "\r\n");
+        linha[n] = '\0';
+        if (n == 0 || linha[0] == '#') {
+            continue;
+        }
+        if (sscanf (linha, "cerca %c %63[^\n]", &tipo, nome) == 2) {
+            poligonoCerca poligono = { NULL, tipo, (uint16_t)cercas->vertices.size (), 0 };
+            cercas->poligonos.push_back (poligono);
+            cercas->nomes.push_back (nome);
+        } else if (sscanf (linha, "%ld %ld", &latitude, &longitude) == 2 && !cercas->poligonos.empty () &&
+                   cercas->vertices.size () < CERCA_MAX_INDICE) {
+            verticeCerca vertice = { (int32_t)latitude, (int32_t)longitude };
+            cercas->vertices.push_back (vertice);
+            cercas->poligonos.back ().quantidadeDeVertices++;
+        } else {
+            fprintf (stderr, "%s:%d: linha invalida: %s\n", caminho, numero, linha);
+            fclose (arquivo);
+            return false;
+        }
+    }
+    fclose (arquivo);
+    if (cercas->poligonos.empty ()) {
+        fprintf (stderr, "%s: nenhuma cerca\n", caminho);
+        return false;
+    }
+    return true;
+}
+
+// Acrescenta o texto formatado à saída, com "\r\n" no fim das linhas como os demais fontes do projeto
+static void escreve (std::string *saida, const char *formato, ...) __attribute__ ((format (printf, 2, 3)));
+static void escreve (std::string *saida, const char *formato, ...) {
+    char texto[512];
+    va_list argumentos;
+    const char *p;
+
+    va_start (argumentos, formato);
+    vsnprintf (texto, sizeof (texto), formato, argumentos);
+    va_end (argumentos);
+    for (p = texto; *p != '\0'; p++) {
+        if (*p == '\n') {
+            *saida += '\r';
+        }
+        *saida += *p;
+    }
+}
+
+static void geraFonte (const cercasLidas *cercas, const montagemCerca *montagem, const char *entrada,
+                       std::string *saida) {
+    const gradeCerca *grade = &montagem->grade;
+    const char *nomeDaEntrada = strrchr (entrada, '/') ? strrchr (entrada, '/') + 1 : entrada;
+    uint32_t i, celulas = (uint32_t)grade->linhas * grade->colunas;
+    size_t c;
+
+    escreve (saida, "/**\n * gradeDasCercas.cpp       v0.0        17-10-2026\n *\n"
+                    " * Orientador: Elias Teodoro da Silva Junior\n"
+                    " * Autores: Felipe Moura de Castro e Joao Bruno Costa Cruz,\n"
+                    " * Instituto Federal de Educação, Ciência e Tecnologia do Ceará (IFCE) - Campus Fortaleza\n"
+                    " *\n * @Opensource\n"
+                    " * Este código-fonte pode ser utilizado, copiado, estudado, modificado e redistribuído sem restrições.\n"
+                    " *\n * Copyright (c) 2019, Felipe Moura de Castro e Joao Bruno Costa Cruz.\n *\n */\n\n");
+    escreve (saida, "/**\n * Gerado por testes/geraGradeCercas a partir de CercaCarro/%s (não edite: altere as cercas e gere\n"
+                    " * de novo). Grade de %u x %u células, %u registros e %u arestas.\n */\n\n",
+             nomeDaEntrada, grade->linhas, grade->colunas, montagem->quantidadeDeRegistros,
+             montagem->quantidadeDeArestas);
+    escreve (saida, "#include \"gradeDasCercas.h\"\n\n");
+
+    escreve (saida, "const verticeCerca verticesDasCercas[%u] = {\n", (unsigned)cercas->vertices.size ());
+    for (i = 0; i < cercas->vertices.size (); i++) {
+        escreve (saida, "    { %ld, %ld },\n", (long)cercas->vertices[i].latitude, (long)cercas->vertices[i].longitude);
+    }
+    escreve (saida, "};\n\n");
+
+    escreve (saida, "const poligonoCerca poligonosDasCercas[%u] = {\n", (unsigned)cercas->poligonos.size ());
+    for (i = 0; i < cercas->poligonos.size (); i++) {
+        escreve (saida, "    { \"");
+        for (c = 0; c < cercas->nomes[i].size (); c++) {
+            if (cercas->nomes[i][c] == '"' || cercas->nomes[i][c] == '\\') {
+                escreve (saida, "\\");
+            }
+            escreve (saida, "%c", cercas->nomes[i][c]);
+        }
+        escreve (saida, "\", '%c', %u, %u },\n", cercas->poligonos[i].tipo, cercas->poligonos[i].primeiroVertice,
+                 cercas->poligonos[i].quantidadeDeVertices);
+    }
+    escreve (saida, "};\n\nconst uint16_t quantidadeDeCercas = %u;\n\n", (unsigned)cercas->poligonos.size ());
+
+    escreve (saida, "static const uint16_t inicioDaCelula[%u] = {", celulas + 1);
+    for (i = 0; i <= celulas; i++) {
+        escreve (saida, "%s%u,", (i % 16 == 0) ? "\n    " : " ", montagem->inicioDaCelula[i]);
+    }
+    escreve (saida, "\n};\n\n");
+
+    escreve (saida, "static const registroCerca registros[%u] = {", montagem->quantidadeDeRegistros + 1);
+    for (i = 0; i <= montagem->quantidadeDeRegistros; i++) {
+        escreve (saida, "%s{ %u, %u, %u },", (i % 4 == 0) ? "\n    " : " ", montagem->registros[i].poligono,
+                 montagem->registros[i].centroDentro, montagem->registros[i].primeiraAresta);
+    }
+    escreve (saida, "\n};\n\n");
+
+    // Um vetor vazio não é permitido em C++: sem arestas, fica uma posição que nunca é lida
+    escreve (saida, "static const uint16_t arestas[%u] = {", montagem->quantidadeDeArestas ? montagem->quantidadeDeArestas : 1);
+    for (i = 0; i < montagem->quantidadeDeArestas; i++) {
+        escreve (saida, "%s%u,", (i % 16 == 0) ? "\n    " : " ", montagem->arestas[i]);
+    }
+    escreve (saida, "%s\n};\n\n", montagem->quantidadeDeArestas ? "" : "\n    0,");
+
+    escreve (saida, "const gradeCerca gradeDasCercas = {\n    %ld, %ld, %ld, %ld, %u, %u, inicioDaCelula, registros, arestas\n};\n",
+             (long)grade->latitudeMinima, (long)grade->longitudeMinima, (long)grade->alturaDaCelula,
+             (long)grade->larguraDaCelula, grade->linhas, grade->colunas);
+}
+
+// Bytes da grade na FLASH
+static size_t bytesDaGrade (const montagemCerca *montagem) {
+    return ((size_t)montagem->grade.linhas * montagem->grade.colunas + 1) * sizeof (uint16_t) +
+           (montagem->quantidadeDeRegistros + 1) * sizeof (registroCerca) +
+           montagem->quantidadeDeArestas * sizeof (uint16_t) + sizeof (gradeCerca);
+}
+
+// Arestas da célula com mais arestas
+static uint32_t piorCelula (const montagemCerca *montagem) {
+    uint32_t c, n, pior = 0;
+
+    for (c = 0; c < (uint32_t)montagem->grade.linhas * montagem->grade.colunas; c++) {
+        n = montagem->registros[montagem->inicioDaCelula[c + 1]].primeiraAresta -
+            montagem->registros[montagem->inicioDaCelula[c]].primeiraAresta;
+        pior = (n > pior) ? n : pior;
+    }
+    return pior;
+}
+
+static int monta (montagemCerca *montagem, const cercasLidas *cercas, int linhas, int colunas) {
+    return montaGradeCerca (montagem, (uint16_t)linhas, (uint16_t)colunas, cercas->vertices.data (),
+                            cercas->poligonos.data (), (uint16_t)cercas->poligonos.size ());
+}
+
+// Conteúdo do arquivo sem os '\r'
+static bool leSemRetorno (const char *caminho, std::string *conteudo) {
+    FILE *arquivo = fopen (caminho, "rb");
+    int c;
+
+    if (arquivo == NULL) {
+        return false;
+    }
+    while ((c = fgetc (arquivo)) != EOF) {
+        if (c != '\r') {
+            *conteudo += (char)c;
+        }
+    }
+    fclose (arquivo);
+    return true;
+}
+
+int main (int argc, char **argv) {
+    cercasLidas cercas;
+    montagemCerca montagem;
+    std::string fonte, existente, esperado;
+    int linhas = 0, colunas = 0, lado, i = 1;
+    uint32_t pior, menorPior = UINT32_MAX;
+    size_t menorBytes = 0;
+    bool confere = false;
+    size_t c;
+    FILE *arquivo;
+
+    for (; i < argc && argv[i][0] == '-'; i++) {
+        if (strcmp (argv[i], "--confere") == 0) {
+            confere = true;
+        } else if (strcmp (argv[i], "-l") == 0 && i + 1 < argc) {
+            linhas = atoi (argv[++i]);
+        } else if (strcmp (argv[i], "-c") == 0 && i + 1 < argc) {
+            colunas = atoi (argv[++i]);
+        } else {
+            break;
+        }
+    }
+    if (argc - i != 2 || linhas < 0 || colunas < 0 || (linhas == 0) != (colunas == 0) ||
+        (long)linhas * colunas > CERCA_MAX_INDICE) {
+        fprintf (stderr, "uso: geraGradeCercas [--confere] [-l linhas -c colunas] cercas.txt gradeDasCercas.cpp\n");
+        return 2;
+    }
+    if (!leCercas (argv[i], &cercas)) {
+        return 2;
+    }
+
+    montagem.maximoDeRegistros = CERCA_MAX_INDICE;
+    montagem.maximoDeArestas = CERCA_MAX_INDICE;
+    montagem.inicioDaCelula = (uint16_t *)malloc ((CERCA_MAX_INDICE + 1) * sizeof (uint16_t));
+    montagem.registros = (registroCerca *)malloc ((CERCA_MAX_INDICE + 1) * sizeof (registroCerca));
+    montagem.arestas = (uint16_t *)malloc (CERCA_MAX_INDICE * sizeof (uint16_t));
+
+    // Escolha do tamanho da grade
+    if (linhas == 0) {
+        for (lado = 1; lado <= GRADE_LADO_MAXIMO; lado *= 2) {
+            if (!monta (&montagem, &cercas, lado, lado) || bytesDaGrade (&montagem) > GRADE_FLASH_MAXIMA) {
+                continue;
+            }
+            pior = piorCelula (&montagem);
+            if (pior < menorPior || (pior == menorPior && bytesDaGrade (&montagem) < menorBytes)) {
+                menorPior = pior;
+                menorBytes = bytesDaGrade (&montagem);
+                linhas = colunas = lado;
+            }
+        }
+    }
+    if (linhas == 0 || !monta (&montagem, &cercas, linhas, colunas)) {
+        fprintf (stderr, "%s: cerca invalida (menos de 3 vertices), centro de celula sobre uma aresta ou grade "
+                 "grande demais; tente outra quantidade de linhas e colunas\n", argv[i]);
+        return 2;
+    }
+    geraFonte (&cercas, &montagem, argv[i], &fonte);
+    printf ("%u cercas, %u vertices, grade de %d x %d: %u registros, %u arestas, no maximo %u por celula "
+            "(%u bytes de FLASH na grade)\n",
+            (unsigned)cercas.poligonos.size (), (unsigned)cercas.vertices.size (), linhas, colunas,
+            montagem.quantidadeDeRegistros, montagem.quantidadeDeArestas, piorCelula (&montagem),
+            (unsigned)bytesDaGrade (&montagem));
+
+    if (confere) {
+        for (c = 0; c < fonte.size (); c++) {
+            if (fonte[c] != '\r') {
+                esperado += fonte[c];
+            }
+        }
+        if (!leSemRetorno (argv[i + 1], &existente) || existente != esperado) {
+            printf ("%s esta desatualizado: gere de novo com geraGradeCercas %s %s\n", argv[i + 1], argv[i],
+                    argv[i + 1]);
+            return 1;
+        }
+        printf ("%s esta atualizado\n", argv[i + 1]);
+        return 0;
+    }
+
+    arquivo = fopen (argv[i + 1], "wb");
+    if (arquivo == NULL || fwrite (fonte.data (), 1, fonte.size (), arquivo) != fonte.size ()) {
+        fprintf (stderr, "%s: nao foi possivel gravar\n", argv[i + 1]);
+        return 2;
+    }
+    fclose (arquivo);
+    return 0;
+}
@@ -0,0 +1,359 @@
+/**
+ * gpsOriginal.cpp       v0.0        17-10-2026
+ *
+ * Orientador: Elias Teodoro da Silva Junior
+ * Autores: Felipe Moura de Castro e Joao Bruno Costa Cruz,
+ * Instituto Federal de Educação, Ciência e Tecnologia do Ceará (IFCE) - Campus Fortaleza
+ *
+ * @Opensource
+ * Este código-fonte pode ser utilizado, copiado, estudado, modificado e redistribuído sem restrições.
+ *
+ * Copyright (c) 2019, Felipe Moura de Castro e Joao Bruno Costa Cruz.
+ *
+ */
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * Decodificação do $GPRMC da primeira versão do GPS_Carro.cpp (campo a campo, em double), sem alterações além do
+ * namespace e da acentuação dos comentários. Serve apenas de referência para os benchmarks e para conferir que a
+ * versão atual produz a mesma saída.
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+#include "gpsOriginal.h"
+
+namespace original {
+
+void parse (char *cmd, int n, dataGPS *data) {
+    (void)n;
+    if (strncmp (cmd,"GPRMC", 5) == 0) {
+        dataCatch (cmd, data);
+    }
+    return;
+}
+
+
+// Função para reiniciar as variaveis numericas
+void reset (dataGPS *data) {
+    data->time = 0;
+    data->latitude = 0;
+    data->longitude = 0;
+    data->speed = 0;
+    data->course = 0;
+    data->magnetcVariationValue = 0;
+}
+
+
+// Função para pegar o protocolo
+int getProtocol (char *input, int pivot, dataGPS *data) {
+    int i;
+    // Executa até encontrar uma virgula
+    for (i = 0; (int)input[pivot + i] != ',' ; i++) //i < 6
+    {
+        data->protocol[i] = input[pivot + i];
+    }
+
+    // Retorna a posição do ultimo dado pego
+    return pivot + i - 1;
+}
+
+// Função para calcular uma potencia de 10
+int potencia (int val) {
+    int i, j;
+    j = 1;
+    for (i = 0; i < val; i++) {
+        j *= 10;
+    }
+
+    return j;
+}
+
+// Função para pegar o tempo do gps
+int getTime (char *input, int pivot, dataGPS *data) {
+    int i, j;
+    // Executa até encontrar uma virgula
+    for (i = 0; (int)input[pivot + i] != ',' ; i++) { // i < 9
+        // Pega os valores diferentes de '.'
+        if ( (double)input[pivot + i] != '.') {
+            j = potencia (i);
+            data->time += ( (double)input[pivot + i] - '0')* (100000/j);
+        }
+    }
+     //Retorna a posição do ultimo dado pego
+     data->time -= 30000.0;
+    return pivot + i - 1;
+}
+
+// Função para pegar o bit de validade do gps
+int getValid (char *input, int pivot, dataGPS *data) {
+    data->valid = input[pivot];
+
+    return pivot;
+}
+
+// Função para pegar a latitude do gps
+int getLatitude (char *input, int pivot, dataGPS *data) {
+    int i = 0, j;
+    double k = 1000.00;
+    // Executa até encontrar uma virgula
+    for(i = 0; (int)input[pivot + i] != ',' ; i++) {
+        // Pega os valores diferentes de '.'
+        if( (double)input[pivot + i] != '.') {
+            j = potencia (i);
+            data->latitude += ( (double)input[pivot + i] - '0')* (k/j);
+        }
+        else {
+            // Ajusta a potencia
+            k *= 10;
+        }
+    }
+
+    //Retorna a posição do ultimo dado pego
+    return pivot + i - 1;
+}
+
+// Função para pegar a direção da latitude do gps
+int getDirection1 (char *input, int pivot, dataGPS *data)
+{
+    data->direction1 = input[pivot];
+
+    return pivot;
+}
+
+// Função para pegar a longitude do gps
+int getLongitude (char *input, int pivot, dataGPS *data)
+{
+    int i = 0, j;
+    double k = 10000.00;
+    // Executa até encontrar uma virgula
+    for(i = 0; (int)input[pivot + i] != ',' ; i++) { // i < 10
+        // Pega os valores diferentes de '.'
+        if((double)input[pivot + i] != '.') {
+            j = potencia (i);
+            data->longitude += ( (double)input[pivot + i] - '0')* (k/j);
+        }
+        else {
+            // Ajusta a potencia
+            k *= 10;
+        }
+    }
+
+    //Retorna a posição do ultimo dado pego
+    return pivot + i - 1;
+}
+
+// Função para pegar a direção da longitude do gps
+int getDirection2 (char *input, int pivot, dataGPS *data)
+{
+    data->direction2 = input[pivot];
+
+    return pivot;
+}
+
+// Função para pegar a velocidade do gps
+int getSpeed (char *input, int pivot, dataGPS *data)
+{
+    int i = 0, j;
+    double k = 100.00;
+    // Executa até encontrar uma virgula
+    for(i = 0; (int) input[pivot + i] != ',' ; i++) {
+        // Pega os valores diferentes de '.'
+        if( (double) input[pivot + i] != '.') {
+            j = potencia (i);
+            data->speed += ( (double)input[pivot + i] - '0')* (k/j);
+        }
+        else {
+            // Ajusta a potencia
+            k *= 10;
+        }
+    }
+
+    //Retorna a posição do ultimo dado pego
+    return pivot + i - 1;
+}
+
+// Função para pegar a direção do deslocamento do gps
+int getCourse(char *input, int pivot, dataGPS *data) {
+    int i = 0, j;
+    double k = 100.00;
+    // Executa até encontrar uma virgula
+    for(i = 0; (int)input[pivot + i] != ',' ; i++) {
+        // Pega os valores diferentes de '.'
+        if( (double)input[pivot + i] != '.') {
+            j = potencia(i);
+            data->course += ((double)input[pivot + i] - '0')* (k/j);
+        }
+        else {
+            // Ajusta a potencia
+            k *= 10;
+        }
+    }
+
+    //Retorna a posição do ultimo dado pego
+    return pivot + i - 1;
+}
+
+// Função para pegar a data do gps
+int getDate (char *input, int pivot, dataGPS *data) {
+    int i;
+    // Executa até encontrar uma virgula
+    for(i = 0; (int) input[pivot + i] != ',' ; i++) { //i < 6
+        data->date[i] = input[pivot + i];
+    }
+
+    //Retorna a posição do ultimo dado pego
+    return pivot + i - 1;
+}
+
+// Função para pegar a variação magnética do gps
+int getMagnetcVariationValue (char *input, int pivot, dataGPS *data) {
+    int i = 0, j;
+    double k = 100.00;
+    // Executa até encontrar uma virgula
+    for(i = 0; (int)input[pivot + i] != ',' ; i++) {
+        // Pega os valores diferentes de '.'
+        if( (double)input[pivot + i] != '.') {
+            j = potencia(i);
+            data->magnetcVariationValue += ((double)input[pivot + i] - '0')* (k/j);
+        }
+        else {
+            // Ajusta a potencia
+            k *= 10;
+        }
+    }
+
+    //Retorna a posição do ultimo dado pego
+    return pivot + i - 1;
+}
+
+// Função para pegar o modo do gps
+int getMode (char *input, int pivot, dataGPS *data) {
+    data->mode = input[pivot];
+    if( (int)data->mode == ',')
+        return pivot - 1;
+    else
+        return pivot;
+}
+
+// Função para pegar o checksum do gps
+void getChecksum (char *input, int pivot, dataGPS *data)
+{
+    int i;
+    for(i = 0; i < 4 ; i++) { //i < 6
+        data->checksum[i] = input[pivot + i];
+    }
+}
+
+
+// Função para pegar todos os dados do gps
+void dataCatch (char  *mensagem, dataGPS *data) {
+    int i = 0, j = 0;
+    reset (data);
+    while(j < 12) {
+        // A cada virgula o j é incrementado
+        if( (int)mensagem[i] == ',') {
+            j++;
+            i++;
+        }
+        // Escolhendo que dado será pego
+        switch (j) {
+            case 0:
+                //funééo getProtocol
+                i = getProtocol (mensagem, i, data);
+                break;
+            case 1:
+                //funééo getTime
+                i = getTime (mensagem, i, data);
+                break;
+            case 2:
+                //funééo getValid
+                i = getValid (mensagem, i, data);
+                break;
+            case 3:
+                //funééo getLatitude
+                i = getLatitude (mensagem, i, data);
+                break;
+            case 4:
+                //funééo getDirection1
+                i = getDirection1 (mensagem, i, data);
+                break;
+            case 5:
+                //funééo getLongitude
+                i = getLongitude (mensagem, i, data);
+                break;
+            case 6:
+                //funééo getDirection2
+                i = getDirection2 (mensagem, i, data);
+                break;
+            case 7:
+                //funééo getSpeed
+                i = getSpeed (mensagem, i, data);
+                break;
+            case 8:
+                //funééo getCourse
+                i = getCourse (mensagem, i, data);
+                break;
+            case 9:
+                //funééo getDate
+                i = getDate (mensagem, i, data);
+                break;
+            case 10:
+                //funééo getMagnetcVariationValue
+                i = getMagnetcVariationValue (mensagem, i, data);
+                break;
+            case 11:
+                //funééo getMagnetcVariationIndicator
+                i = getMode (mensagem, i, data);
+                break;
+            case 12:
+                //funééo getChecksum
+                getChecksum (mensagem, i, data);
+                break;
+        }
+
+        i++;
+    }
+    transformaCoordenada (data);
+    transformaSpeed (data);
+
+}
+
+
+// Função que ajusta o formato das coordenadas
+void transformaCoordenada (dataGPS *data)
+{
+    double num1, num2;
+    double aux, aux2;
+
+    num1 = data->latitude;
+    num2 = data->longitude;
+
+    num1 = num1/100;
+    aux = num1;
+    aux = aux - (int)aux;
+    aux = aux*100;
+    aux = aux/60;
+    num1 = (int)num1;
+
+    num2 = num2/100;
+    aux2 = num2;
+    aux2 = aux2 - (int)aux2;
+    aux2 = aux2*100;
+    aux2 = aux2/60;
+    num2 = (int)num2;
+
+    data->latitude =  num1 + aux;
+    data->longitude =  num2 + aux2;
+
+    if ( (int)data->direction1 == 'S')
+        data->latitude *= -1;
+
+    if ( (int)data->direction2 == 'W')
+        data->longitude *= -1;
+}
+
+// Função que passa a velocidade para km/h
+void transformaSpeed (dataGPS *data) {
+    data->speed = data->speed * 1.853;
+}
+
+} // namespace original
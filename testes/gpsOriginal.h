@@ -0,0 +1,53 @@
+/**
+ * gpsOriginal.h       v0.0        17-10-2026
+ *
+ * Orientador: Elias Teodoro da Silva Junior
+ * Autores: Felipe Moura de Castro e Joao Bruno Costa Cruz,
+ * Instituto Federal de Educação, Ciência e Tecnologia do Ceará (IFCE) - Campus Fortaleza
+ *
+ * @Opensource
+ * Este código-fonte pode ser utilizado, copiado, estudado, modificado e redistribuído sem restrições.
+ *
+ * Copyright (c) 2019, Felipe Moura de Castro e Joao Bruno Costa Cruz.
+ *
+ */
+
+#ifndef _GPS_ORIGINAL_H_
+#define _GPS_ORIGINAL_H_
+
+#include <string.h>
+
+namespace original {
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * @brief   Estrutura dataGPS da primeira versão: valores em double, tempo no fuso de -3 h, latitude e longitude em
+ *          graus e velocidade em km/h (knots * 1,853)
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+typedef struct {
+    char protocol[8];
+    double time;
+    char valid;
+    double latitude;
+    char direction1;
+    double longitude;
+    char direction2;
+    double speed;
+    double course;
+    char date[7];
+    double magnetcVariationValue;
+    char magnetcVariationIndicator;
+    char mode;
+    char checksum[5];
+} dataGPS;
+
+void parse (char *cmd, int n, dataGPS *data);
+void dataCatch (char *mensagem, dataGPS *data);
+void reset (dataGPS *data);
+void transformaCoordenada (dataGPS *data);
+void transformaSpeed (dataGPS *data);
+
+} // namespace original
+
+#endif /*_GPS_ORIGINAL_H_*/
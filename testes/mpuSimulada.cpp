@@ -0,0 +1,102 @@
+/**
+ * mpuSimulada.cpp       v0.0        17-10-2026
+ *
+ * Orientador: Elias Teodoro da Silva Junior
+ * Autores: Felipe Moura de Castro e Joao Bruno Costa Cruz,
+ * Instituto Federal de Educação, Ciência e Tecnologia do Ceará (IFCE) - Campus Fortaleza
+ *
+ * @Opensource
+ * Este código-fonte pode ser utilizado, copiado, estudado, modificado e redistribuído sem restrições.
+ *
+ * Copyright (c) 2019, Felipe Moura de Castro e Joao Bruno Costa Cruz.
+ *
+ */
+
+#include "mpuSimulada.h"
+
+// Campos da amostra 'numero', iguais aos decodificados por decodeMotion6
+static void amostraNumero (uint32_t numero, MPU6050Motion6 *amostra) {
+    amostra->accelero[0] = (int16_t)numero;
+    amostra->accelero[1] = (int16_t)(numero >> 16);
+    amostra->accelero[2] = (int16_t)~numero;
+    amostra->temp = (int16_t)(numero * 7u);
+    amostra->gyro[0] = (int16_t)(numero * 3u);
+    amostra->gyro[1] = (int16_t)(0x5A5A ^ numero);
+    amostra->gyro[2] = (int16_t)(numero + 1000u);
+}
+
+static uint8_t atendeRegistro (mpuSimulada *mpu, uint8_t registro, uint8_t *valor, bool escrita) {
+    std::lock_guard<std::mutex> guarda (mpu->trava);
+
+    registro &= 0x7F;
+    if (escrita) {
+        if (registro == MPU6050_USER_CTRL_REG && (*valor & (1 << MPU6050_FIFO_RESET_BIT))) {
+            mpu->inicio = mpu->contagem = 0;
+            *valor &= (uint8_t)~(1 << MPU6050_FIFO_RESET_BIT);
+        }
+        mpu->registros[registro] = *valor;
+        return registro + 1;
+    }
+    if (registro == MPU6050_FIFO_R_W_REG) {
+        if (mpu->contagem > 0) {
+            *valor = mpu->fifo[mpu->inicio];
+            mpu->inicio = (mpu->inicio + 1) % MPU6050_FIFO_SIZE;
+            mpu->contagem--;
+        }
+        return registro;
+    }
+    if (registro == MPU6050_FIFO_COUNTH_REG) {
+        mpu->contagemLida = mpu->contagem;
+        *valor = (uint8_t)(mpu->contagemLida >> 8);
+    } else if (registro == MPU6050_FIFO_COUNTH_REG + 1) {
+        *valor = (uint8_t)mpu->contagemLida;
+    } else {
+        *valor = mpu->registros[registro];
+    }
+    return registro + 1;
+}
+
+void ligaMpuSimulada (mpuSimulada *mpu, I2C *i2c) {
+    std::lock_guard<std::mutex> guarda (mpu->trava);
+
+    memset (mpu->registros, 0, sizeof (mpu->registros));
+    mpu->inicio = mpu->contagem = mpu->contagemLida = 0;
+    mpu->produzidas = 0;
+    i2c->dispositivo = [mpu] (uint8_t registro, uint8_t *valor, bool escrita) {
+        return atendeRegistro (mpu, registro, valor, escrita);
+    };
+}
+
+void produzAmostras (mpuSimulada *mpu, int amostras) {
+    std::lock_guard<std::mutex> guarda (mpu->trava);
+    MPU6050Motion6 amostra;
+    int16_t campos[7];
+    int i, k;
+
+    for (i = 0; i < amostras; i++) {
+        amostraNumero (mpu->produzidas++, &amostra);
+        memcpy (campos, amostra.accelero, sizeof (amostra.accelero));
+        campos[3] = amostra.temp;
+        memcpy (&campos[4], amostra.gyro, sizeof (amostra.gyro));
+        for (k = 0; k < MPU6050_MOTION6_LENGTH; k++) {
+            if (mpu->contagem == MPU6050_FIFO_SIZE) {
+                mpu->inicio = (mpu->inicio + 1) % MPU6050_FIFO_SIZE;
+                mpu->contagem--;
+            }
+            mpu->fifo[(mpu->inicio + mpu->contagem++) % MPU6050_FIFO_SIZE] =
+                (uint8_t)((uint16_t)campos[k / 2] >> (k % 2 ? 0 : 8));
+        }
+    }
+}
+
+int bytesNaFifo (mpuSimulada *mpu) {
+    std::lock_guard<std::mutex> guarda (mpu->trava);
+    return mpu->contagem;
+}
+
+bool amostraConfere (const MPU6050Motion6 *lida, uint32_t numero) {
+    MPU6050Motion6 esperada;
+
+    amostraNumero (numero, &esperada);
+    return memcmp (lida, &esperada, sizeof (esperada)) == 0;
+}
@@ -0,0 +1,113 @@
+/**
+ * mpuSimulada.h       v0.0        17-10-2026
+ *
+ * Orientador: Elias Teodoro da Silva Junior
+ * Autores: Felipe Moura de Castro e Joao Bruno Costa Cruz,
+ * Instituto Federal de Educação, Ciência e Tecnologia do Ceará (IFCE) - Campus Fortaleza
+ *
+ * @Opensource
+ * Este código-fonte pode ser utilizado, copiado, estudado, modificado e redistribuído sem restrições.
+ *
+ * Copyright (c) 2019, Felipe Moura de Castro e Joao Bruno Costa Cruz.
+ *
+ */
+
+#ifndef _MPU_SIMULADA_H_
+#define _MPU_SIMULADA_H_
+
+#include "mbed.h"
+#include "MPU6050.h"
+#include <mutex>
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * MPU6050 simulada para os testes no computador, ligada ao I2C do stub
+ *
+ * Atende 128 registros; só USER_CTRL, FIFO_COUNT e FIFO_R_W têm comportamento próprio: o bit FIFO_RESET do USER_CTRL
+ * esvazia a FIFO, a leitura do FIFO_COUNTH guarda a contagem que o FIFO_COUNTL completa, e a leitura do FIFO_R_W
+ * retira um byte da FIFO sem avançar o ponteiro (como no sensor). A FIFO tem MPU6050_FIFO_SIZE bytes e, cheia,
+ * sobrescreve os mais antigos: a contagem fica em 1024, que não é múltiplo de 14, como no estouro do sensor.
+ *
+ * Cada amostra produzida leva o seu número de sequência em todos os campos (amostraNumero), o que permite conferir a
+ * ordem e a integridade do que a coleta entrega. O acesso é protegido por um mutex: as amostras podem ser produzidas
+ * por uma Thread enquanto o transfer do stub lê a FIFO em outra.
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * @brief   Estado da MPU6050 simulada
+ *
+ * @var trava                         exclui o sensor (produção) e o I2C (leitura)
+ * @var registros                     registros sem comportamento próprio
+ * @var fifo                          FIFO circular do sensor
+ * @var inicio                        posição do byte mais antigo
+ * @var contagem                      bytes na FIFO
+ * @var contagemLida                  contagem guardada na leitura do FIFO_COUNTH
+ * @var produzidas                    número da próxima amostra
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+typedef struct {
+    std::mutex trava;
+    uint8_t registros[128];
+    uint8_t fifo[MPU6050_FIFO_SIZE];
+    int inicio;
+    int contagem;
+    int contagemLida;
+    uint32_t produzidas;
+} mpuSimulada;
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * Protótipo das funções
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * @brief Zera o sensor simulado (FIFO vazia, registros zerados) e o liga ao I2C como dispositivo
+ *
+ * @param mpu           ponteiro para o sensor simulado
+ * @param i2c           I2C do stub
+ *
+ * @return                      Não retorna nada.
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+void ligaMpuSimulada (mpuSimulada *mpu, I2C *i2c);
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * @brief Acrescenta amostras numeradas à FIFO (big endian, na ordem dos registros)
+ *
+ * @param mpu           ponteiro para o sensor simulado
+ * @param amostras      quantidade de amostras
+ *
+ * @return                      Não retorna nada.
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+void produzAmostras (mpuSimulada *mpu, int amostras);
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * @brief Bytes na FIFO do sensor simulado
+ *
+ * @param mpu           ponteiro para o sensor simulado
+ *
+ * @return                      contagem da FIFO (0 a MPU6050_FIFO_SIZE).
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+int bytesNaFifo (mpuSimulada *mpu);
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * @brief Confere se uma amostra decodificada é a de número 'numero'
+ *
+ * @param lida          amostra decodificada pela coleta
+ * @param numero        número de sequência esperado
+ *
+ * @return                      true se todos os campos conferem.
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+bool amostraConfere (const MPU6050Motion6 *lida, uint32_t numero);
+
+#endif /*_MPU_SIMULADA_H_*/
@@ -0,0 +1,40 @@
+/**
+ * receptorGPS.cpp       v0.0        17-10-2026
+ *
+ * Orientador: Elias Teodoro da Silva Junior
+ * Autores: Felipe Moura de Castro e Joao Bruno Costa Cruz,
+ * Instituto Federal de Educação, Ciência e Tecnologia do Ceará (IFCE) - Campus Fortaleza
+ *
+ * @Opensource
+ * Este código-fonte pode ser utilizado, copiado, estudado, modificado e redistribuído sem restrições.
+ *
+ * Copyright (c) 2019, Felipe Moura de Castro e Joao Bruno Costa Cruz.
+ *
+ */
+
+#include "receptorGPS.h"
+
+void iniciaReceptor (receptorGPS *receptor) {
+    memset (receptor, 0, sizeof (receptorGPS));
+    iniciaMontador (&receptor->montador);
+    iniciaFusaoNMEA (&receptor->fusao);
+    iniciaDecodificadorUBX (&receptor->decodificador);
+}
+
+int recebeByte (receptorGPS *receptor, uint8_t c, dataGPS *fix) {
+    int quadroUBX = decodificaUBX (&receptor->decodificador, c);
+    int completo = 0;
+
+    if (quadroUBX > 0) {
+        completo = interpretaUBX (&receptor->decodificador, &receptor->fix);
+    } else if (quadroUBX < 0) {
+        completo = montaSentenca (&receptor->montador, (char)c) &&
+                   fundeNMEA (&receptor->fusao, receptor->montador.sentenca, receptor->montador.tamanho,
+                              &receptor->fix);
+    }
+    if (completo) {
+        memcpy (fix, &receptor->fix, sizeof (dataGPS));
+        receptor->fixes++;
+    }
+    return completo;
+}
@@ -0,0 +1,64 @@
+/**
+ * receptorGPS.h       v0.0        17-10-2026
+ *
+ * Orientador: Elias Teodoro da Silva Junior
+ * Autores: Felipe Moura de Castro e Joao Bruno Costa Cruz,
+ * Instituto Federal de Educação, Ciência e Tecnologia do Ceará (IFCE) - Campus Fortaleza
+ *
+ * @Opensource
+ * Este código-fonte pode ser utilizado, copiado, estudado, modificado e redistribuído sem restrições.
+ *
+ * Copyright (c) 2019, Felipe Moura de Castro e Joao Bruno Costa Cruz.
+ *
+ */
+
+#ifndef _RECEPTOR_GPS_H_
+#define _RECEPTOR_GPS_H_
+
+#include "GPS_Carro/GPS_Carro.h"
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * @brief   Decodificação dos bytes do GPS como na Thread do GPS (adquirirDadosDoGPS, em main.cpp): cada byte passa
+ *          pelo decodificador UBX e, se não pertence a um quadro UBX, pelo montador e pela fusão NMEA.
+ *
+ * @var montador                      montador de sentenças NMEA
+ * @var fusao                         fusão das sentenças de uma época
+ * @var decodificador                 decodificador de quadros UBX
+ * @var fix                           fix em montagem (privado, como na Thread)
+ * @var fixes                         fixes completos entregues
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+typedef struct {
+    montadorNMEA montador;
+    fusaoNMEA fusao;
+    decodificadorUBX decodificador;
+    dataGPS fix;
+    uint32_t fixes;
+} receptorGPS;
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * @brief Inicializa o receptor (sem sentenças, quadros ou fixes)
+ *
+ * @param receptor      ponteiro para o receptor
+ *
+ * @return                      Não retorna nada.
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+void iniciaReceptor (receptorGPS *receptor);
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * @brief Entrega um byte recebido do GPS
+ *
+ * @param receptor      ponteiro para o receptor
+ * @param c             byte recebido
+ * @param fix           ponteiro para a struct que recebe o fix completo
+ *
+ * @return                      1 se um fix foi completado (fix preenchido); 0 caso contrário.
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+int recebeByte (receptorGPS *receptor, uint8_t c, dataGPS *fix);
+
+#endif /*_RECEPTOR_GPS_H_*/
@@ -0,0 +1,144 @@
+/**
+ * replayGPS.cpp       v0.0        17-10-2026
+ *
+ * Orientador: Elias Teodoro da Silva Junior
+ * Autores: Felipe Moura de Castro e Joao Bruno Costa Cruz,
+ * Instituto Federal de Educação, Ciência e Tecnologia do Ceará (IFCE) - Campus Fortaleza
+ *
+ * @Opensource
+ * Este código-fonte pode ser utilizado, copiado, estudado, modificado e redistribuído sem restrições.
+ *
+ * Copyright (c) 2019, Felipe Moura de Castro e Joao Bruno Costa Cruz.
+ *
+ */
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * Reprodução de capturas do GPS no computador
+ *
+ * Uso: replayGPS [arquivo ...]
+ *
+ * Cada arquivo é uma captura bruta da serial do GPS (NMEA, UBX ou os dois misturados, como gravada por um terminal
+ * serial). Os bytes passam pela mesma decodificação da Thread do GPS e a captura é repetida até somar
+ * REPLAY_TEMPO_MINIMO_S, para medir a vazão: sentenças (ou quadros UBX) por segundo, fixes por segundo e ns por byte.
+ *
+ * Sem arquivos, são reproduzidas três capturas geradas pelo trajetoSimulado (NEO-6M em NMEA, receptor
+ * multi-constelação em NMEA e NEO-6M em UBX), e a quantidade de fixes e de sentenças rejeitadas é conferida.
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+#include "teste.h"
+#include "receptorGPS.h"
+#include "trajetoSimulado.h"
+
+#define REPLAY_TEMPO_MINIMO_S   0.2
+#define REPLAY_EPOCAS           600
+
+typedef struct {
+    uint32_t sentencas;
+    uint32_t rejeitadas;
+    uint32_t truncadas;
+    uint32_t fixes;
+    double segundos;
+    uint32_t repeticoes;
+} resultadoReplay;
+
+// Decodifica a captura uma vez; os contadores são os da última passada
+static void decodificaCaptura (const uint8_t *captura, int tamanho, resultadoReplay *resultado) {
+    receptorGPS receptor;
+    dataGPS fix;
+    int i;
+
+    iniciaReceptor (&receptor);
+    for (i = 0; i < tamanho; i++) {
+        recebeByte (&receptor, captura[i], &fix);
+    }
+    resultado->sentencas = receptor.montador.estatisticas.aceitas + receptor.decodificador.estatisticas.aceitas;
+    resultado->rejeitadas = receptor.montador.estatisticas.rejeitadas +
+                            receptor.decodificador.estatisticas.rejeitadas;
+    resultado->truncadas = receptor.montador.estatisticas.truncadas + receptor.decodificador.estatisticas.truncadas;
+    resultado->fixes = receptor.fixes;
+}
+
+static void reproduz (const char *nome, const uint8_t *captura, int tamanho, resultadoReplay *resultado) {
+    uint64_t inicio = agoraNs ();
+    double segundos;
+
+    resultado->repeticoes = 0;
+    do {
+        decodificaCaptura (captura, tamanho, resultado);
+        resultado->repeticoes++;
+        segundos = (agoraNs () - inicio) * 1e-9;
+    } while (segundos < REPLAY_TEMPO_MINIMO_S);
+    resultado->segundos = segundos / resultado->repeticoes;
+
+    printf ("%-22s %8d bytes %6lu sentencas/quadros (%lu rejeitados, %lu truncados) %5lu fixes | "
+            "%9.0f sentencas/s %8.0f fixes/s %6.1f ns/byte\n",
+            nome, tamanho, (unsigned long)resultado->sentencas, (unsigned long)resultado->rejeitadas,
+            (unsigned long)resultado->truncadas, (unsigned long)resultado->fixes,
+            resultado->sentencas / resultado->segundos, resultado->fixes / resultado->segundos,
+            resultado->segundos * 1e9 / (tamanho ? tamanho : 1));
+}
+
+// Lê um arquivo inteiro; retorna NULL se não foi possível
+static uint8_t *leArquivo (const char *caminho, int *tamanho) {
+    FILE *arquivo = fopen (caminho, "rb");
+    uint8_t *dados = NULL;
+    long n;
+
+    if (arquivo == NULL) {
+        return NULL;
+    }
+    if (fseek (arquivo, 0, SEEK_END) == 0 && (n = ftell (arquivo)) >= 0 && fseek (arquivo, 0, SEEK_SET) == 0) {
+        dados = (uint8_t *)malloc (n + 1);
+        if (dados != NULL && fread (dados, 1, n, arquivo) != (size_t)n) {
+            free (dados);
+            dados = NULL;
+        }
+        *tamanho = (int)n;
+    }
+    fclose (arquivo);
+    return dados;
+}
+
+int main (int argc, char **argv) {
+    static const struct {
+        const char *nome;
+        int receptor;
+    } simuladas[] = {
+        { "simulada NEO-6M NMEA", RECEPTOR_GPS },
+        { "simulada M8 NMEA", RECEPTOR_MULTI },
+        { "simulada NEO-6M UBX", -1 },
+    };
+    resultadoReplay resultado;
+    uint8_t *captura;
+    int tamanho, i, erros = 0;
+
+    if (argc > 1) {
+        for (i = 1; i < argc; i++) {
+            captura = leArquivo (argv[i], &tamanho);
+            if (captura == NULL) {
+                printf ("%s: nao foi possivel ler\n", argv[i]);
+                erros++;
+                continue;
+            }
+            reproduz (argv[i], captura, tamanho, &resultado);
+            free (captura);
+        }
+        return erros ? 1 : 0;
+    }
+
+    for (i = 0; i < (int)(sizeof (simuladas) / sizeof (simuladas[0])); i++) {
+        captura = geraCaptura (simuladas[i].receptor, REPLAY_EPOCAS, 1.5, &tamanho);
+        CONFERE (captura != NULL);
+        if (captura == NULL) {
+            continue;
+        }
+        reproduz (simuladas[i].nome, captura, tamanho, &resultado);
+        // Um fix por época, sem sentenças perdidas
+        CONFERE (resultado.fixes == REPLAY_EPOCAS);
+        CONFERE (resultado.rejeitadas == 0);
+        CONFERE (resultado.truncadas == 0);
+        free (captura);
+    }
+    return FIM_DO_TESTE ();
+}
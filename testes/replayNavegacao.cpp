@@ -0,0 +1,293 @@
+/**
+ * replayNavegacao.cpp       v0.0        17-10-2026
+ *
+ * Orientador: Elias Teodoro da Silva Junior
+ * Autores: Felipe Moura de Castro e Joao Bruno Costa Cruz,
+ * Instituto Federal de Educação, Ciência e Tecnologia do Ceará (IFCE) - Campus Fortaleza
+ *
+ * @Opensource
+ * Este código-fonte pode ser utilizado, copiado, estudado, modificado e redistribuído sem restrições.
+ *
+ * Copyright (c) 2019, Felipe Moura de Castro e Joao Bruno Costa Cruz.
+ *
+ */
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * Replay da navegação estimada (NavegacaoCarro) contra a verdade do trajeto simulado
+ *
+ * Uso: replayNavegacao [saida.csv]
+ *
+ * A MPU6050 é simulada a 1 kHz a partir das acelerações longitudinal e lateral e da guinada verdadeiras do
+ * trajetoSimulado (referencial do carro nivelado, como atitudeCarro::linear e atitudeCarro::giro), com bias e ruído
+ * branco, e o filtro é propagado com a média de cada grupo de IMU_DECIMACAO amostras, como na Thread da navegação. O GPS
+ * envia uma época NMEA por segundo, decodificada como na Thread do GPS, e cada fix corrige o filtro.
+ *
+ * São REPLAY_CICLOS voltas do trajeto; na última, o sinal é perdido nos trechos de perdas[] (reta, curva e arrancada com
+ * retorno). A cada propagação, a estimativa (estimaNavegacao) é comparada com a verdade: erro de posição, de velocidade
+ * e de rumo com sinal e, durante cada perda, o maior erro de posição da estimativa e o de repetir o último fix. Também
+ * são informados os bias estimados e o custo de cada passo em ns. Com um arquivo, cada propagação é gravada em CSV
+ * (tempo, verdade, estimativa e fix em metros) para ser comparada em um gráfico.
+ *
+ * A MPU6050 simulada não tem erro de escala nem erro residual da atitude: os números medem o filtro, não o sensor.
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+#include "teste.h"
+#include "receptorGPS.h"
+#include "trajetoSimulado.h"
+#include "NavegacaoCarro/navegacaoCarro.h"
+
+#define REPLAY_CICLOS               2
+#define REPLAY_TAXA_HZ              1000        // IMU_TAXA_HZ em main.cpp
+#define REPLAY_DECIMACAO            10          // IMU_DECIMACAO em main.cpp
+#define REPLAY_RUIDO_GPS_M          1.5
+#define REPLAY_CONVERGENCIA_S       10.0        // início ignorado nas estatísticas
+
+/**
+ * MPU6050 simulada: bias e desvio do ruído branco por amostra (a 1 kHz com o filtro passa-baixa ligado)
+ */
+#define REPLAY_BIAS_ACELERACAO      0.15        // m/s²
+#define REPLAY_BIAS_GIRO            0.01        // rad/s (~0,6 graus/s)
+#define REPLAY_RUIDO_ACELERACAO     0.05        // m/s²
+#define REPLAY_RUIDO_GIRO           0.005       // rad/s
+
+/**
+ * Limites conferidos (com a semente fixa, a execução é sempre a mesma)
+ */
+#define LIMITE_POSICAO_RMS_M        1.5         // com GPS: abaixo do ruído do próprio GPS
+#define LIMITE_VELOCIDADE_RMS       0.3         // m/s
+#define LIMITE_RUMO_RMS_GRAUS       3.0
+#define LIMITE_PERDA_FRACAO         0.05        // erro máximo na perda / erro de repetir o último fix
+#define LIMITE_RECUPERACAO_M        3.0         // erro 2 s depois do fim da perda
+
+#define RAIO_DA_TERRA_M             6371000.0
+#define PI_D                        3.14159265358979323846
+
+typedef struct {
+    double inicio;
+    double fim;
+    const char *trecho;
+    double maiorErro;
+    double maiorErroParado;
+    double erroDepois;
+    int marcacoesErradas;
+} perdaDeSinal;
+
+// Perdas na última volta (segundos desde o início da volta): os fixes de inicio a fim - 1 não são aplicados
+static perdaDeSinal perdas[] = {
+    { 35.0,  75.0,  "reta a 15 m/s",            0.0, 0.0, 0.0, 0 },
+    { 85.0,  100.0, "curva de 90 graus",        0.0, 0.0, 0.0, 0 },
+    { 205.0, 225.0, "arrancada e retorno",      0.0, 0.0, 0.0, 0 },
+};
+#define QUANTIDADE_PERDAS   ((int)(sizeof (perdas) / sizeof (perdas[0])))
+
+typedef struct {
+    double somaPosicao2, maiorPosicao;
+    double somaVelocidade2, somaRumo2;
+    double somaFix2;
+    long amostras, amostrasRumo, fixes;
+} estatisticas;
+
+// Posição (graus * 10^7) em metros (norte, leste) em relação à verdade
+static void erroEmMetros (const trajetoSimulado *verdade, int32_t latitude, int32_t longitude, double *norte,
+                          double *leste) {
+    double metrosPorGrau = RAIO_DA_TERRA_M * PI_D / 180.0;
+
+    *norte = (latitude * 1e-7 - verdade->latitude) * metrosPorGrau;
+    *leste = (longitude * 1e-7 - verdade->longitude) * metrosPorGrau * cos (verdade->latitude * PI_D / 180.0);
+}
+
+static double diferencaAngular (double a, double b) {
+    double d = fmod (a - b + 540.0, 360.0) - 180.0;
+    return d;
+}
+
+// Perda que contém o fix do segundo informado, ou -1
+static int fixPerdido (long segundo) {
+    double t = segundo - (REPLAY_CICLOS - 1) * TRAJETO_CICLO_S;
+    int i;
+
+    for (i = 0; i < QUANTIDADE_PERDAS; i++) {
+        if (t >= perdas[i].inicio && t < perdas[i].fim) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+// Perda durante a qual a estimativa do instante informado é feita sem fix, ou -1: de inicio (exclusive, o último fix
+// aplicado é o de inicio - 1) a fim (inclusive, o fix de fim é aplicado depois da amostra desse instante)
+static int estimativaSemFix (long milissegundo) {
+    long inicioDaVolta = (long)((REPLAY_CICLOS - 1) * TRAJETO_CICLO_S) * REPLAY_TAXA_HZ;
+    int i;
+
+    for (i = 0; i < QUANTIDADE_PERDAS; i++) {
+        if (milissegundo > inicioDaVolta + (long)perdas[i].inicio * REPLAY_TAXA_HZ &&
+            milissegundo <= inicioDaVolta + (long)perdas[i].fim * REPLAY_TAXA_HZ) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+// Confere o modo ('E' sem fix há mais de 1 s) e a validade ('V' sem fix há mais de NAV_LIMITE_SEM_GPS_S)
+static bool marcacaoCerta (const dataGPS *estimativa, double semFix) {
+    if (fabs (semFix - 1.0) < 0.02 || fabs (semFix - NAV_LIMITE_SEM_GPS_S) < 0.02) {
+        return true;
+    }
+    return (estimativa->mode == 'E') == (semFix > 1.0) && (estimativa->valid == 'A') == (semFix <= NAV_LIMITE_SEM_GPS_S);
+}
+
+// Lê a época NMEA do instante atual como a Thread do GPS; retorna 1 se um fix foi completado
+static int recebeEpoca (trajetoSimulado *trajeto, receptorGPS *receptor, dataGPS *fix) {
+    static char epoca[4096];
+    int n = escreveEpocaNMEA (trajeto, RECEPTOR_GPS, epoca, sizeof (epoca)), i, completo = 0;
+
+    for (i = 0; i < n; i++) {
+        completo |= recebeByte (receptor, (uint8_t)epoca[i], fix);
+    }
+    return completo;
+}
+
+int main (int argc, char **argv) {
+    static navegacaoCarro navegacao;
+    trajetoSimulado trajeto, imu;
+    receptorGPS receptor;
+    dataGPS fix, ultimoFix, estimativa;
+    estatisticas com;
+    FILE *csv = NULL;
+    float acce[3], gyro[3], somaAcce[3] = { 0 }, somaGyro[3] = { 0 };
+    double norte, leste, erro, fixNorte = 0.0, fixLeste = 0.0;
+    uint64_t inicio, nsPropagacao = 0, nsCorrecao = 0;
+    long passo, passos = (long)(REPLAY_CICLOS * TRAJETO_CICLO_S * REPLAY_TAXA_HZ), propagacoes = 0, correcoes = 0;
+    int acumuladas = 0, k, perda;
+
+    if (argc > 1) {
+        csv = fopen (argv[1], "w");
+        if (csv == NULL) {
+            printf ("%s: nao foi possivel gravar\n", argv[1]);
+            return 1;
+        }
+        fprintf (csv, "tempo,verdadeNorte,verdadeLeste,erroNorte,erroLeste,fixNorte,fixLeste,sinal\n");
+    }
+
+    memset (&com, 0, sizeof (com));
+    memset (&ultimoFix, 0, sizeof (ultimoFix));
+    iniciaTrajeto (&trajeto, REPLAY_RUIDO_GPS_M, 12345);
+    iniciaTrajeto (&imu, 0.0, 777);                 // só o gerador do ruído da MPU6050
+    iniciaReceptor (&receptor);
+    iniciaNavegacao (&navegacao);
+
+    for (passo = 0; passo < passos; passo++) {
+        // Uma época do GPS por segundo, no instante exato da posição informada
+        if (passo % REPLAY_TAXA_HZ == 0 && recebeEpoca (&trajeto, &receptor, &fix)) {
+            erroEmMetros (&trajeto, fix.latitude, fix.longitude, &fixNorte, &fixLeste);
+            if (fixPerdido (passo / REPLAY_TAXA_HZ) < 0) {
+                if (trajeto.tempo >= REPLAY_CONVERGENCIA_S) {
+                    com.somaFix2 += fixNorte * fixNorte + fixLeste * fixLeste;
+                    com.fixes++;
+                }
+                ultimoFix = fix;
+                inicio = agoraNs ();
+                corrigeNavegacao (&navegacao, &fix);
+                nsCorrecao += agoraNs () - inicio;
+                correcoes++;
+            }
+        }
+
+        // Amostra da MPU6050 ao fim do próximo milissegundo
+        avancaTrajeto (&trajeto, 1.0 / REPLAY_TAXA_HZ);
+        somaAcce[0] += (float)(trajeto.longitudinal + REPLAY_BIAS_ACELERACAO + REPLAY_RUIDO_ACELERACAO * normalSimulada (&imu));
+        somaAcce[1] += (float)(trajeto.lateral + REPLAY_RUIDO_ACELERACAO * normalSimulada (&imu));
+        somaAcce[2] += (float)(REPLAY_RUIDO_ACELERACAO * normalSimulada (&imu));
+        somaGyro[0] += (float)(REPLAY_RUIDO_GIRO * normalSimulada (&imu));
+        somaGyro[1] += (float)(REPLAY_RUIDO_GIRO * normalSimulada (&imu));
+        somaGyro[2] += (float)(trajeto.guinada + REPLAY_BIAS_GIRO + REPLAY_RUIDO_GIRO * normalSimulada (&imu));
+        if (++acumuladas < REPLAY_DECIMACAO) {
+            continue;
+        }
+        for (k = 0; k < 3; k++) {
+            acce[k] = somaAcce[k] / REPLAY_DECIMACAO;
+            gyro[k] = somaGyro[k] / REPLAY_DECIMACAO;
+            somaAcce[k] = somaGyro[k] = 0.0f;
+        }
+        acumuladas = 0;
+        inicio = agoraNs ();
+        propagaNavegacao (&navegacao, acce, gyro, (float)REPLAY_DECIMACAO / REPLAY_TAXA_HZ);
+        nsPropagacao += agoraNs () - inicio;
+        propagacoes++;
+
+        if (!navegacao.iniciada) {
+            continue;
+        }
+        estimaNavegacao (&navegacao, &ultimoFix, &estimativa);
+        erroEmMetros (&trajeto, estimativa.latitude, estimativa.longitude, &norte, &leste);
+        erro = sqrt (norte * norte + leste * leste);
+        perda = estimativaSemFix (passo + 1);
+
+        if (perda >= 0) {
+            perdaDeSinal *p = &perdas[perda];
+            double paradoNorte, paradoLeste, parado, semFix;
+            erroEmMetros (&trajeto, ultimoFix.latitude, ultimoFix.longitude, &paradoNorte, &paradoLeste);
+            parado = sqrt (paradoNorte * paradoNorte + paradoLeste * paradoLeste);
+            semFix = (double)(passo + 1) / REPLAY_TAXA_HZ - ((REPLAY_CICLOS - 1) * TRAJETO_CICLO_S + p->inicio - 1.0);
+            p->maiorErro = (erro > p->maiorErro) ? erro : p->maiorErro;
+            p->maiorErroParado = (parado > p->maiorErroParado) ? parado : p->maiorErroParado;
+            p->marcacoesErradas += !marcacaoCerta (&estimativa, semFix);
+        } else if (trajeto.tempo >= REPLAY_CONVERGENCIA_S) {
+            com.somaPosicao2 += erro * erro;
+            com.maiorPosicao = (erro > com.maiorPosicao) ? erro : com.maiorPosicao;
+            com.somaVelocidade2 += pow (estimativa.speed * 0.001 - trajeto.velocidade, 2.0);
+            if (trajeto.velocidade >= 2.0) {
+                com.somaRumo2 += pow (diferencaAngular (estimativa.course * 0.01, trajeto.curso), 2.0);
+                com.amostrasRumo++;
+            }
+            com.amostras++;
+            for (k = 0; k < QUANTIDADE_PERDAS; k++) {
+                if (passo + 1 == (long)((REPLAY_CICLOS - 1) * TRAJETO_CICLO_S + perdas[k].fim + 2.0) * REPLAY_TAXA_HZ) {
+                    perdas[k].erroDepois = erro;
+                }
+            }
+        }
+
+        if (csv != NULL) {
+            double verdadeNorte = (trajeto.latitude - TRAJETO_LATITUDE_INICIAL) * RAIO_DA_TERRA_M * PI_D / 180.0;
+            double verdadeLeste = (trajeto.longitude - TRAJETO_LONGITUDE_INICIAL) * RAIO_DA_TERRA_M * PI_D / 180.0 *
+                                  cos (TRAJETO_LATITUDE_INICIAL * PI_D / 180.0);
+            fprintf (csv, "%.2f,%.3f,%.3f,%.3f,%.3f,%.3f,%.3f,%d\n", trajeto.tempo, verdadeNorte, verdadeLeste, norte,
+                     leste, fixNorte, fixLeste, perda < 0);
+        }
+    }
+    if (csv != NULL) {
+        fclose (csv);
+    }
+
+    printf ("%d voltas de %.0f s, GPS a 1 Hz com ruido de %.1f m, MPU6050 com bias de %.2f m/s2 e %.3f rad/s\n",
+            REPLAY_CICLOS, TRAJETO_CICLO_S, REPLAY_RUIDO_GPS_M, REPLAY_BIAS_ACELERACAO, REPLAY_BIAS_GIRO);
+    printf ("com GPS: posicao %.2f m RMS (maior %.2f m; fixes %.2f m RMS), velocidade %.3f m/s RMS, rumo %.2f graus RMS\n",
+            sqrt (com.somaPosicao2 / com.amostras), com.maiorPosicao, sqrt (com.somaFix2 / com.fixes),
+            sqrt (com.somaVelocidade2 / com.amostras), sqrt (com.somaRumo2 / com.amostrasRumo));
+    CONFERE (sqrt (com.somaPosicao2 / com.amostras) < LIMITE_POSICAO_RMS_M);
+    CONFERE (sqrt (com.somaPosicao2 / com.amostras) < sqrt (com.somaFix2 / com.fixes));
+    CONFERE (sqrt (com.somaVelocidade2 / com.amostras) < LIMITE_VELOCIDADE_RMS);
+    CONFERE (sqrt (com.somaRumo2 / com.amostrasRumo) < LIMITE_RUMO_RMS_GRAUS);
+
+    for (k = 0; k < QUANTIDADE_PERDAS; k++) {
+        printf ("perda de %2.0f s (%s): maior erro %6.2f m (repetindo o ultimo fix: %7.2f m), %.2f m 2 s depois, "
+                "%d estimativas com modo ou validade errados\n", perdas[k].fim - perdas[k].inicio, perdas[k].trecho,
+                perdas[k].maiorErro, perdas[k].maiorErroParado, perdas[k].erroDepois, perdas[k].marcacoesErradas);
+        CONFERE (perdas[k].maiorErro < LIMITE_PERDA_FRACAO * perdas[k].maiorErroParado);
+        CONFERE (perdas[k].erroDepois < LIMITE_RECUPERACAO_M);
+        CONFERE (perdas[k].marcacoesErradas == 0);
+    }
+
+    printf ("bias estimados: giroscopio %.4f rad/s (simulado %.4f), acelerometro %.3f m/s2 (simulado %.3f)\n",
+            NAV_SINAL_GUINADA * navegacao.x[NAV_BIAS_GIRO], REPLAY_BIAS_GIRO, navegacao.x[NAV_BIAS_ACELERACAO],
+            REPLAY_BIAS_ACELERACAO);
+    CONFERE (fabs (NAV_SINAL_GUINADA * navegacao.x[NAV_BIAS_GIRO] - REPLAY_BIAS_GIRO) < 0.3 * REPLAY_BIAS_GIRO);
+    CONFERE (fabs (navegacao.x[NAV_BIAS_ACELERACAO] - REPLAY_BIAS_ACELERACAO) < 0.3 * REPLAY_BIAS_ACELERACAO);
+
+    printf ("custo: propagaNavegacao %.0f ns/passo (%ld passos), corrigeNavegacao %.0f ns/fix (%ld fixes)\n",
+            (double)nsPropagacao / propagacoes, propagacoes, (double)nsCorrecao / correcoes, correcoes);
+    return FIM_DO_TESTE ();
+}
@@ -0,0 +1,382 @@
+/**
+ * mbed.h       v0.0        17-10-2026
+ *
+ * Orientador: Elias Teodoro da Silva Junior
+ * Autores: Felipe Moura de Castro e Joao Bruno Costa Cruz,
+ * Instituto Federal de Educação, Ciência e Tecnologia do Ceará (IFCE) - Campus Fortaleza
+ *
+ * @Opensource
+ * Este código-fonte pode ser utilizado, copiado, estudado, modificado e redistribuído sem restrições.
+ *
+ * Copyright (c) 2019, Felipe Moura de Castro e Joao Bruno Costa Cruz.
+ *
+ */
+
+#ifndef _MBED_STUB_H_
+#define _MBED_STUB_H_
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * Substituto do mbed.h para compilar os módulos no computador (Linux), sem o mbed OS
+ *
+ * Contém apenas o que os módulos usam:
+ * - __DMB é uma barreira completa do compilador e do processador;
+ * - RawSerial guarda os bytes enviados e devolve os bytes de uma entrada preparada pelo teste; um dispositivo simulado
+ *   (opcional) recebe cada byte enviado e pode responder por essa entrada;
+ * - I2C simula um dispositivo de 64 registros com ponteiro de endereço (como o DS1307): a escrita define o ponteiro
+ *   e grava os bytes seguintes, a leitura devolve os registros a partir do ponteiro; um dispositivo simulado (opcional)
+ *   pode atender os registros no lugar deles (a FIFO da MPU6050, por exemplo);
+ * - Timer, us_ticker_read e Kernel::get_ms_count usam o relógio monotônico do sistema;
+ * - wait_ms não espera (os testes não dependem do tempo de resposta do receptor);
+ * - as seções críticas são um mutex recursivo global (excluem as outras Threads, como as interrupções desligadas no
+ *   alvo com um só núcleo), e os sinais das Threads (ThisThread::flags_wait_any, osThreadFlagsSet) são um contador
+ *   por Thread com uma variável de condição;
+ * - com DEVICE_I2C_ASYNCH = 1 (definido pelo alvo do teste), I2C::transfer conclui a transferência em outra Thread
+ *   depois do tempo que ela levaria no fio e chama o callback, como a interrupção do I2C no alvo; EventFlags,
+ *   callback (objeto, método) e callback (função, argumento) são os mínimos para esperar por ela;
+ * - com simulaTempo ligado, I2C::write e I2C::read ocupam a Thread pelo tempo do fio, como a espera ativa do I2C
+ *   bloqueante no alvo.
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <time.h>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <thread>
+
+#define __DMB()     __sync_synchronize ()
+
+typedef enum {
+    NC = -1
+} PinName;
+
+// Relógio monotônico do sistema em microssegundos
+static inline uint64_t relogioStubUs (void) {
+    struct timespec agora;
+    clock_gettime (CLOCK_MONOTONIC, &agora);
+    return (uint64_t)agora.tv_sec * 1000000u + (uint64_t)agora.tv_nsec / 1000u;
+}
+
+static inline uint32_t us_ticker_read (void) {
+    return (uint32_t)relogioStubUs ();
+}
+
+static inline void wait_ms (int ms) {
+    (void)ms;
+}
+
+static inline std::recursive_mutex &secaoCriticaStub (void) {
+    static std::recursive_mutex secao;
+    return secao;
+}
+
+static inline void core_util_critical_section_enter (void) {
+    secaoCriticaStub ().lock ();
+}
+
+static inline void core_util_critical_section_exit (void) {
+    secaoCriticaStub ().unlock ();
+}
+
+// Sinais de uma Thread (ThisThread::flags)
+typedef struct {
+    std::mutex trava;
+    std::condition_variable condicao;
+    uint32_t sinais;
+} sinaisStub;
+
+typedef sinaisStub *osThreadId_t;
+
+static inline uint32_t osThreadFlagsSet (osThreadId_t thread, uint32_t sinais) {
+    std::lock_guard<std::mutex> trava (thread->trava);
+    thread->sinais |= sinais;
+    thread->condicao.notify_all ();
+    return thread->sinais;
+}
+
+namespace ThisThread {
+    static inline osThreadId_t get_id (void) {
+        static thread_local sinaisStub sinais;
+        return &sinais;
+    }
+    static inline uint32_t flags_wait_any (uint32_t sinais) {
+        osThreadId_t thread = get_id ();
+        std::unique_lock<std::mutex> trava (thread->trava);
+        uint32_t recebidos;
+
+        thread->condicao.wait (trava, [&] () { return (thread->sinais & sinais) != 0; });
+        recebidos = thread->sinais;
+        thread->sinais &= ~sinais;
+        return recebidos;
+    }
+};
+
+namespace Kernel {
+    static inline uint64_t get_ms_count (void) {
+        return relogioStubUs () / 1000u;
+    }
+}
+
+class Timer {
+public:
+    Timer () : _inicio (0), _acumulado (0), _ligado (false) {}
+    void start (void) { if (!_ligado) { _inicio = relogioStubUs (); _ligado = true; } }
+    void stop (void) { if (_ligado) { _acumulado += relogioStubUs () - _inicio; _ligado = false; } }
+    void reset (void) { _acumulado = 0; _inicio = relogioStubUs (); }
+    int read_us (void) { return (int)decorrido (); }
+    int read_ms (void) { return (int)(decorrido () / 1000u); }
+    float read (void) { return decorrido () / 1000000.0f; }
+
+private:
+    uint64_t decorrido (void) { return _acumulado + (_ligado ? relogioStubUs () - _inicio : 0); }
+    uint64_t _inicio;
+    uint64_t _acumulado;
+    bool _ligado;
+};
+
+#define TAMANHO_SAIDA_STUB  4096
+
+class RawSerial {
+public:
+    RawSerial (PinName tx = NC, PinName rx = NC, int baud = 9600)
+        : taxa (baud), enviados (0), _entrada (NULL), _tamanhoEntrada (0), _lidos (0) {
+        (void)tx;
+        (void)rx;
+    }
+    int putc (int c) {
+        if (enviados < TAMANHO_SAIDA_STUB) {
+            saida[enviados] = (uint8_t)c;
+        }
+        enviados++;
+        if (dispositivo) {
+            dispositivo (this, (uint8_t)c);
+        }
+        return c;
+    }
+    int getc (void) { return (_lidos < _tamanhoEntrada) ? _entrada[_lidos++] : -1; }
+    int readable (void) { return _lidos < _tamanhoEntrada; }
+    void baud (int b) { taxa = b; }
+
+    // Prepara os bytes que getc vai devolver (o vetor deve continuar válido durante o uso)
+    void recebe (const uint8_t *dados, size_t tamanho) {
+        _entrada = dados;
+        _tamanhoEntrada = tamanho;
+        _lidos = 0;
+    }
+
+    int taxa;
+    uint8_t saida[TAMANHO_SAIDA_STUB];
+    size_t enviados;
+    // Dispositivo simulado do outro lado (opcional): recebe cada byte enviado e responde com recebe
+    std::function<void (RawSerial *serial, uint8_t c)> dispositivo;
+
+private:
+    const uint8_t *_entrada;
+    size_t _tamanhoEntrada;
+    size_t _lidos;
+};
+
+#ifndef DEVICE_I2C_ASYNCH
+#define DEVICE_I2C_ASYNCH       0
+#endif
+
+#define I2C_EVENT_ERROR                 (1 << 1)
+#define I2C_EVENT_ERROR_NO_SLAVE        (1 << 2)
+#define I2C_EVENT_TRANSFER_COMPLETE     (1 << 3)
+#define I2C_EVENT_TRANSFER_EARLY_NACK   (1 << 4)
+#define I2C_EVENT_ALL                   (I2C_EVENT_ERROR | I2C_EVENT_TRANSFER_COMPLETE | I2C_EVENT_ERROR_NO_SLAVE | \
+                                         I2C_EVENT_TRANSFER_EARLY_NACK)
+
+#define osWaitForever           0xFFFFFFFFu
+
+typedef std::function<void (int)> event_callback_t;
+
+template <typename T>
+static inline event_callback_t callback (T *objeto, void (T::*metodo) (int)) {
+    return [objeto, metodo] (int evento) { (objeto->*metodo) (evento); };
+}
+
+template <typename T>
+static inline event_callback_t callback (void (*funcao) (T *, int), T *argumento) {
+    return [funcao, argumento] (int evento) { funcao (argumento, evento); };
+}
+
+class EventFlags {
+public:
+    EventFlags () : sinais (0) {}
+    uint32_t set (uint32_t novos) {
+        std::lock_guard<std::mutex> guarda (trava);
+        sinais |= novos;
+        condicao.notify_all ();
+        return sinais;
+    }
+    uint32_t clear (uint32_t apagar = 0x7FFFFFFF) {
+        std::lock_guard<std::mutex> guarda (trava);
+        uint32_t anteriores = sinais;
+        sinais &= ~apagar;
+        return anteriores;
+    }
+    uint32_t wait_any (uint32_t esperados, uint32_t timeout = osWaitForever, bool apagar = true) {
+        std::unique_lock<std::mutex> guarda (trava);
+        uint32_t recebidos;
+
+        (void)timeout;
+        condicao.wait (guarda, [&] () { return (sinais & esperados) != 0; });
+        recebidos = sinais;
+        if (apagar) {
+            sinais &= ~esperados;
+        }
+        return recebidos;
+    }
+
+private:
+    std::mutex trava;
+    std::condition_variable condicao;
+    uint32_t sinais;
+};
+
+#define TAMANHO_REGISTROS_STUB  64
+
+class I2C {
+public:
+    I2C (PinName sda = NC, PinName scl = NC) : hz (100000), falha (false), simulaTempo (false), transacoes (0),
+                                               transferenciasNormais (0), transferenciasRecusadas (0),
+                                               transferenciasComErro (0), ponteiro (0), ocupado (false) {
+        (void)sda;
+        (void)scl;
+        memset (registros, 0, sizeof (registros));
+    }
+    void frequency (int f) { hz = f; }
+
+    // Tempo no fio: 9 bits por byte (com o endereço e o ACK), mais o início e o fim
+    uint32_t tempoNoFioUs (int bytes) const {
+        return (uint32_t)((9u * (uint32_t)bytes + 2u) * 1000000u / (uint32_t)hz);
+    }
+
+    // Retorna 0 em caso de sucesso (como no mbed OS); 'falha' simula um NAK do dispositivo
+    int write (int endereco, const char *dados, int tamanho, bool repetido = false) {
+        ocupaTempo (1 + tamanho);
+        return escreve (endereco, dados, tamanho, repetido);
+    }
+    int read (int endereco, char *dados, int tamanho, bool repetido = false) {
+        ocupaTempo (1 + tamanho);
+        return le (endereco, dados, tamanho, repetido);
+    }
+
+#if DEVICE_I2C_ASYNCH
+    // Escrita seguida de leitura (início repetido); o callback recebe o evento na Thread que simula a interrupção
+    int transfer (int endereco, const char *envio, int tamanhoEnvio, char *recepcao, int tamanhoRecepcao,
+                  const event_callback_t &chamada, int eventos = I2C_EVENT_TRANSFER_COMPLETE, bool repetido = false) {
+        uint32_t fio = tempoNoFioUs (1 + tamanhoEnvio) + (tamanhoRecepcao > 0 ? tempoNoFioUs (1 + tamanhoRecepcao) : 0);
+
+        bool comErro;
+
+        (void)repetido;
+        if (ocupado) {
+            return -1;
+        }
+        if (transferenciasNormais > 0) {
+            transferenciasNormais--;
+            comErro = false;
+        } else if (transferenciasRecusadas > 0) {
+            transferenciasRecusadas--;
+            return -1;
+        } else {
+            comErro = transferenciasComErro > 0;
+            transferenciasComErro -= comErro;
+        }
+        ocupado = true;
+        std::thread ([=] () {
+            int evento;
+
+            std::this_thread::sleep_for (std::chrono::microseconds (fio));
+            // Erro simulado: NAK no endereço, sem acesso aos registros
+            evento = (!comErro && escreve (endereco, envio, tamanhoEnvio, true) == 0 &&
+                      (tamanhoRecepcao == 0 || le (endereco, recepcao, tamanhoRecepcao, false) == 0))
+                     ? I2C_EVENT_TRANSFER_COMPLETE : I2C_EVENT_ERROR_NO_SLAVE;
+            ocupado = false;
+            if (evento & eventos) {
+                chamada (evento);
+            }
+        }).detach ();
+        return 0;
+    }
+#endif
+
+    int hz;
+    bool falha;
+    bool simulaTempo;
+    uint32_t transacoes;
+    uint8_t registros[TAMANHO_REGISTROS_STUB];
+    // Depois de 'transferenciasNormais' transfer atendidos, os próximos são recusados (I2C ainda ocupado no alvo) e
+    // os seguintes terminam com erro
+    int transferenciasNormais;
+    int transferenciasRecusadas;
+    int transferenciasComErro;
+    // Dispositivo simulado (opcional) no lugar dos registros: recebe o registro apontado e o byte escrito (escrita) ou
+    // preenche o byte lido, e retorna o próximo valor do ponteiro
+    std::function<uint8_t (uint8_t registro, uint8_t *valor, bool escrita)> dispositivo;
+
+private:
+    // Espera ativa pelo tempo do fio, como o I2C bloqueante do alvo
+    void ocupaTempo (int bytes) {
+        uint64_t fim;
+
+        if (simulaTempo) {
+            fim = relogioStubUs () + tempoNoFioUs (bytes);
+            while (relogioStubUs () < fim) {
+            }
+        }
+    }
+
+    int escreve (int endereco, const char *dados, int tamanho, bool repetido) {
+        (void)endereco;
+        (void)repetido;
+        transacoes++;
+        if (falha) {
+            return -1;
+        }
+        for (int i = 0; i < tamanho; i++) {
+            if (i == 0) {
+                ponteiro = dispositivo ? (uint8_t)dados[0] : (uint8_t)dados[0] % TAMANHO_REGISTROS_STUB;
+            } else if (dispositivo) {
+                uint8_t valor = (uint8_t)dados[i];
+                ponteiro = dispositivo (ponteiro, &valor, true);
+            } else {
+                registros[ponteiro] = (uint8_t)dados[i];
+                ponteiro = (ponteiro + 1) % TAMANHO_REGISTROS_STUB;
+            }
+        }
+        return 0;
+    }
+    int le (int endereco, char *dados, int tamanho, bool repetido) {
+        (void)endereco;
+        (void)repetido;
+        transacoes++;
+        if (falha) {
+            return -1;
+        }
+        for (int i = 0; i < tamanho; i++) {
+            if (dispositivo) {
+                uint8_t valor = 0;
+                ponteiro = dispositivo (ponteiro, &valor, false);
+                dados[i] = (char)valor;
+            } else {
+                dados[i] = (char)registros[ponteiro];
+                ponteiro = (ponteiro + 1) % TAMANHO_REGISTROS_STUB;
+            }
+        }
+        return 0;
+    }
+
+    uint8_t ponteiro;
+    volatile bool ocupado;
+};
+
+#endif /*_MBED_STUB_H_*/
@@ -0,0 +1,52 @@
+/**
+ * teste.h       v0.0        17-10-2026
+ *
+ * Orientador: Elias Teodoro da Silva Junior
+ * Autores: Felipe Moura de Castro e Joao Bruno Costa Cruz,
+ * Instituto Federal de Educação, Ciência e Tecnologia do Ceará (IFCE) - Campus Fortaleza
+ *
+ * @Opensource
+ * Este código-fonte pode ser utilizado, copiado, estudado, modificado e redistribuído sem restrições.
+ *
+ * Copyright (c) 2019, Felipe Moura de Castro e Joao Bruno Costa Cruz.
+ *
+ */
+
+#ifndef _TESTE_H_
+#define _TESTE_H_
+
+#include <stdio.h>
+#include <stdint.h>
+#include <time.h>
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * Verificações dos testes no computador
+ *
+ * CONFERE registra a falha (arquivo, linha e condição) e continua, para que uma execução mostre todas as falhas.
+ * FIM_DO_TESTE imprime o resumo e é o valor de retorno do main (0 se nenhuma verificação falhou), como o ctest espera.
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+static int verificacoesDoTeste = 0;
+static int falhasDoTeste = 0;
+
+#define CONFERE(condicao) \
+    do { \
+        verificacoesDoTeste++; \
+        if (!(condicao)) { \
+            falhasDoTeste++; \
+            printf ("FALHA %s:%d: %s\n", __FILE__, __LINE__, #condicao); \
+        } \
+    } while (0)
+
+#define FIM_DO_TESTE() \
+    (printf ("%d verificacoes, %d falhas\n", verificacoesDoTeste, falhasDoTeste), falhasDoTeste ? 1 : 0)
+
+// Tempo monotônico em nanossegundos, para os benchmarks
+static inline uint64_t agoraNs (void) {
+    struct timespec agora;
+    clock_gettime (CLOCK_MONOTONIC, &agora);
+    return (uint64_t)agora.tv_sec * 1000000000u + (uint64_t)agora.tv_nsec;
+}
+
+#endif /*_TESTE_H_*/
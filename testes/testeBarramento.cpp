@@ -0,0 +1,144 @@
+/**
+ * testeBarramento.cpp       v0.0        17-10-2026
+ *
+ * Orientador: Elias Teodoro da Silva Junior
+ * Autores: Felipe Moura de Castro e Joao Bruno Costa Cruz,
+ * Instituto Federal de Educação, Ciência e Tecnologia do Ceará (IFCE) - Campus Fortaleza
+ *
+ * @Opensource
+ * Este código-fonte pode ser utilizado, copiado, estudado, modificado e redistribuído sem restrições.
+ *
+ * Copyright (c) 2019, Felipe Moura de Castro e Joao Bruno Costa Cruz.
+ *
+ */
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * Teste do gerenciador de barramento I2C com Threads de verdade
+ *
+ * 1. Prioridade: com o barramento ocupado, um cliente de baixa prioridade e depois um de alta passam a esperar; na
+ *    liberação, o de alta deve receber o barramento primeiro, e a espera máxima do de baixa deve incluir as duas posses.
+ * 2. Exclusão: três clientes disputam o barramento sem parar; em nenhum momento duas transações se sobrepõem e o dono
+ *    é sempre o cliente que chamou obtemBarramento.
+ * 3. Relatório: relatorioBarramento zera a espera máxima; depois dele, uma transação sem disputa tem espera pequena.
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+#include "teste.h"
+#include "BarramentoCarro/barramentoCarro.h"
+#include <thread>
+#include <atomic>
+#include <chrono>
+
+#define TESTE_POSSE_MS          20
+#define TESTE_TRANSACOES        20000
+
+static I2C i2c;
+static barramentoI2C barramento;
+static clienteI2C alta, media, baixa, principal;
+
+static void esperaAte (const volatile bool *condicao) {
+    while (!*condicao) {
+        std::this_thread::sleep_for (std::chrono::microseconds (100));
+    }
+}
+
+static void testaPrioridade (void) {
+    std::atomic<int> ordem (0);
+    int ordemAlta = 0, ordemBaixa = 0;
+
+    cadastraClienteI2C (&barramento, &principal, "principal", 0);
+    obtemBarramento (&barramento, &principal);
+
+    std::thread threadBaixa ([&] () {
+        obtemBarramento (&barramento, &baixa);
+        ordemBaixa = ++ordem;
+        std::this_thread::sleep_for (std::chrono::milliseconds (TESTE_POSSE_MS));
+        liberaBarramento (&barramento, &baixa);
+    });
+    esperaAte (&baixa.esperando);
+    std::thread threadAlta ([&] () {
+        obtemBarramento (&barramento, &alta);
+        ordemAlta = ++ordem;
+        std::this_thread::sleep_for (std::chrono::milliseconds (TESTE_POSSE_MS));
+        liberaBarramento (&barramento, &alta);
+    });
+    esperaAte (&alta.esperando);
+
+    std::this_thread::sleep_for (std::chrono::milliseconds (TESTE_POSSE_MS));
+    liberaBarramento (&barramento, &principal);
+    threadAlta.join ();
+    threadBaixa.join ();
+
+    printf ("prioridade: alta foi a %d, baixa a %d; espera maxima da baixa %lu us\n", ordemAlta, ordemBaixa,
+            (unsigned long)baixa.esperaMaximaUs);
+    CONFERE (ordemAlta == 1 && ordemBaixa == 2);
+    CONFERE (barramento.dono == NULL);
+    CONFERE (baixa.esperaMaximaUs >= 2 * TESTE_POSSE_MS * 1000);
+}
+
+static void testaExclusao (void) {
+    std::atomic<int> dentro (0);
+    std::atomic<uint32_t> sobreposicoes (0), donoErrado (0);
+    clienteI2C *clientes[3] = { &alta, &media, &baixa };
+    std::thread threads[3];
+    int t;
+
+    for (t = 0; t < 3; t++) {
+        threads[t] = std::thread ([&, t] () {
+            char registro = 0, dados[7];
+            for (int k = 0; k < TESTE_TRANSACOES; k++) {
+                obtemBarramento (&barramento, clientes[t]);
+                sobreposicoes += (++dentro != 1);
+                donoErrado += (barramento.dono != clientes[t]);
+                // Duas operações seguidas na mesma transação, como a leitura da hora do DS1307
+                i2c.write (0xD0, &registro, 1, true);
+                i2c.read (0xD0, dados, sizeof (dados));
+                --dentro;
+                liberaBarramento (&barramento, clientes[t]);
+            }
+        });
+    }
+    for (t = 0; t < 3; t++) {
+        threads[t].join ();
+    }
+    printf ("exclusao: %lu transacoes de cada cliente, %lu sobreposicoes, %lu com o dono errado\n",
+            (unsigned long)TESTE_TRANSACOES, (unsigned long)sobreposicoes, (unsigned long)donoErrado);
+    CONFERE (sobreposicoes == 0);
+    CONFERE (donoErrado == 0);
+    CONFERE (barramento.dono == NULL);
+    CONFERE (alta.transacoes == TESTE_TRANSACOES + 1);
+    CONFERE (media.transacoes == TESTE_TRANSACOES);
+    CONFERE (baixa.transacoes == TESTE_TRANSACOES + 1);
+}
+
+static void testaRelatorio (void) {
+    static clienteI2C anteriores[BARRAMENTO_MAX_CLIENTES];
+    uint32_t esperaAnterior = baixa.esperaMaximaUs;
+    int i;
+
+    relatorioBarramento (&barramento, "I2C teste", anteriores, 1000000);
+    for (i = 0; i < barramento.quantidadeDeClientes; i++) {
+        CONFERE (barramento.clientes[i]->esperaMaximaUs == 0);
+    }
+
+    // Sem disputa, a espera do intervalo seguinte não carrega a do intervalo anterior
+    obtemBarramento (&barramento, &baixa);
+    liberaBarramento (&barramento, &baixa);
+    printf ("relatorio: espera maxima da baixa %lu us antes, %lu us no intervalo seguinte\n",
+            (unsigned long)esperaAnterior, (unsigned long)baixa.esperaMaximaUs);
+    CONFERE (baixa.esperaMaximaUs < esperaAnterior);
+    CONFERE (baixa.esperaMaximaUs < 1000);
+}
+
+int main (void) {
+    iniciaBarramento (&barramento, &i2c, BARRAMENTO_RAPIDO_HZ);
+    CONFERE (i2c.hz == BARRAMENTO_RAPIDO_HZ);
+    cadastraClienteI2C (&barramento, &alta, "alta", 3);
+    cadastraClienteI2C (&barramento, &media, "media", 2);
+    cadastraClienteI2C (&barramento, &baixa, "baixa", 1);
+
+    testaPrioridade ();
+    testaExclusao ();
+    testaRelatorio ();
+    return FIM_DO_TESTE ();
+}
@@ -0,0 +1,191 @@
+/**
+ * testeBufferGPS.cpp       v0.0        17-10-2026
+ *
+ * Orientador: Elias Teodoro da Silva Junior
+ * Autores: Felipe Moura de Castro e Joao Bruno Costa Cruz,
+ * Instituto Federal de Educação, Ciência e Tecnologia do Ceará (IFCE) - Campus Fortaleza
+ *
+ * @Opensource
+ * Este código-fonte pode ser utilizado, copiado, estudado, modificado e redistribuído sem restrições.
+ *
+ * Copyright (c) 2019, Felipe Moura de Castro e Joao Bruno Costa Cruz.
+ *
+ */
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * Teste do buffer circular de recepção do GPS (insereNaFila/retiraDaFila do filaCarro) com a interrupção simulada a 115200 baud
+ *
+ * 1. Tempo simulado: cada byte chega 86,8 us depois do anterior (10 bits a 115200 baud) e é inserido como na
+ *    interrupção receberByteDoGPS; a Thread do GPS é acordada no fim de cada linha ou quadro UBX, roda depois de
+ *    TESTE_LATENCIA_US e esvazia o buffer. Uma vez por segundo ela fica bloqueada por 'bloqueioMs' (Threads de maior
+ *    prioridade, cartão SD...). Os 512 bytes duram 44 ms, mas o bloqueio pode começar com uma linha inteira no buffer:
+ *    até ~36 ms nenhuma sentença pode ser perdida; acima disso os bytes perdidos devem aparecer em 'perdidos' e as
+ *    sentenças cortadas devem ser descartadas, sem fixes errados.
+ * 2. Duas Threads de verdade: a produtora insere a captura no ritmo de 115200 baud e depois o mais rápido possível
+ *    (repetindo quando o buffer está cheio); a consumidora confere que recebe exatamente a mesma sequência de bytes.
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+#include "teste.h"
+#include "receptorGPS.h"
+#include "trajetoSimulado.h"
+#include <thread>
+#include <atomic>
+
+#define TESTE_BYTE_US           (1e6 * 10.0 / 115200.0)
+#define TESTE_LATENCIA_US       1000.0
+#define TESTE_EPOCAS            120
+#define TESTE_MAIOR_LINHA       82      // a Thread só é acordada no fim da linha
+
+typedef struct {
+    uint32_t fixes;
+    uint32_t perdidos;
+    uint32_t descartadas;
+    uint32_t fixesForaDoTrajeto;
+} resultadoSimulacao;
+
+// Fix plausível: dentro de ~5 km do ponto inicial do trajeto simulado
+static bool fixPlausivel (const dataGPS *fix) {
+    return fix->valid == 'A' && llabs (fix->latitude - (long long)(TRAJETO_LATITUDE_INICIAL * 1e7)) < 500000 &&
+           llabs (fix->longitude - (long long)(TRAJETO_LONGITUDE_INICIAL * 1e7)) < 500000;
+}
+
+static void simula (const uint8_t *captura, int tamanho, double bloqueioMs, resultadoSimulacao *resultado) {
+    static bufferCircularGPS buffer;
+    delimitadorUBX delimitador;
+    receptorGPS receptor;
+    dataGPS fix;
+    double agora, execucao = -1.0, fimDoBloqueio = 0.0, proximoBloqueio = 500000.0;
+    uint8_t c;
+    int i;
+
+    iniciaFila (&buffer);
+    iniciaReceptor (&receptor);
+    memset (&delimitador, 0, sizeof (delimitador));
+    memset (resultado, 0, sizeof (resultadoSimulacao));
+
+    for (i = 0; i <= tamanho; i++) {
+        agora = i * TESTE_BYTE_US;
+
+        // Bloqueio periódico da Thread do GPS
+        if (agora >= proximoBloqueio) {
+            fimDoBloqueio = proximoBloqueio + bloqueioMs * 1000.0;
+            proximoBloqueio += 1000000.0;
+        }
+
+        // A Thread roda quando foi acordada, a latência passou e não está bloqueada
+        if (execucao >= 0.0 && agora >= execucao && agora >= fimDoBloqueio) {
+            while (retiraDaFila (&buffer, &c)) {
+                if (recebeByte (&receptor, c, &fix)) {
+                    resultado->fixes++;
+                    resultado->fixesForaDoTrajeto += !fixPlausivel (&fix);
+                }
+            }
+            execucao = -1.0;
+        }
+        if (i == tamanho) {
+            break;
+        }
+
+        // Interrupção de recepção
+        insereNaFila (&buffer, &captura[i]);
+        if ((captura[i] == '\n' || fimDeQuadroUBX (&delimitador, captura[i])) && execucao < 0.0) {
+            execucao = agora + TESTE_LATENCIA_US;
+        }
+    }
+
+    // Última passada da Thread depois do fim da captura
+    while (retiraDaFila (&buffer, &c)) {
+        if (recebeByte (&receptor, c, &fix)) {
+            resultado->fixes++;
+            resultado->fixesForaDoTrajeto += !fixPlausivel (&fix);
+        }
+    }
+    resultado->perdidos = buffer.perdidos;
+    resultado->descartadas = receptor.montador.estatisticas.rejeitadas + receptor.montador.estatisticas.truncadas +
+                             receptor.decodificador.estatisticas.rejeitadas +
+                             receptor.decodificador.estatisticas.truncadas;
+}
+
+static void testaTempoSimulado (const char *nome, int receptorSimulado) {
+    static const double bloqueios[] = { 0.0, 20.0, 30.0, 80.0 };
+    resultadoSimulacao resultado;
+    uint8_t *captura;
+    int tamanho, i;
+
+    captura = geraCaptura (receptorSimulado, TESTE_EPOCAS, 1.5, &tamanho);
+    for (i = 0; i < (int)(sizeof (bloqueios) / sizeof (bloqueios[0])); i++) {
+        simula (captura, tamanho, bloqueios[i], &resultado);
+        printf ("%-12s bloqueio de %2.0f ms/s: %3lu fixes de %d, %5lu bytes perdidos, %3lu sentencas/quadros "
+                "descartados\n", nome, bloqueios[i], (unsigned long)resultado.fixes, TESTE_EPOCAS,
+                (unsigned long)resultado.perdidos, (unsigned long)resultado.descartadas);
+
+        // Nenhum fix errado, com ou sem perda
+        CONFERE (resultado.fixesForaDoTrajeto == 0);
+        if (bloqueios[i] * 1000.0 < (TAMANHO_BUFFER_GPS - TESTE_MAIOR_LINHA) * TESTE_BYTE_US - TESTE_LATENCIA_US) {
+            CONFERE (resultado.perdidos == 0);
+            CONFERE (resultado.descartadas == 0);
+            CONFERE (resultado.fixes == TESTE_EPOCAS);
+        } else {
+            // A perda é contabilizada e as sentenças cortadas não viram fixes
+            CONFERE (resultado.perdidos > 0);
+            CONFERE (resultado.descartadas > 0);
+            CONFERE (resultado.fixes < TESTE_EPOCAS);
+        }
+    }
+    free (captura);
+}
+
+static void testaDuasThreads (bool ritmoDaSerial) {
+    static bufferCircularGPS buffer;
+    std::atomic<bool> terminou (false);
+    uint8_t *captura;
+    int tamanho, recebidos = 0, diferentes = 0;
+    uint32_t repeticoes = 0;
+    uint8_t c;
+
+    captura = geraCaptura (RECEPTOR_GPS, ritmoDaSerial ? 10 : 500, 1.5, &tamanho);
+    iniciaFila (&buffer);
+
+    std::thread produtora ([&] () {
+        uint64_t inicio = agoraNs ();
+        for (int i = 0; i < tamanho; i++) {
+            if (ritmoDaSerial) {
+                while (agoraNs () - inicio < (uint64_t)(i * TESTE_BYTE_US * 1000.0)) {
+                }
+            }
+            // A interrupção descartaria o byte; aqui a produtora repete para conferir a sequência inteira
+            while (!insereNaFila (&buffer, &captura[i])) {
+                repeticoes++;
+                std::this_thread::yield ();
+            }
+        }
+        terminou = true;
+    });
+
+    while (!terminou || buffer.inicio != buffer.fim) {
+        if (retiraDaFila (&buffer, &c)) {
+            diferentes += (recebidos >= tamanho || c != captura[recebidos]);
+            recebidos++;
+        } else {
+            std::this_thread::yield ();
+        }
+    }
+    produtora.join ();
+
+    printf ("duas Threads (%s): %d bytes recebidos de %d, %d diferentes, buffer cheio %lu vezes\n",
+            ritmoDaSerial ? "115200 baud" : "sem ritmo", recebidos, tamanho, diferentes,
+            (unsigned long)repeticoes);
+    CONFERE (recebidos == tamanho);
+    CONFERE (diferentes == 0);
+    free (captura);
+}
+
+int main (void) {
+    testaTempoSimulado ("NEO-6M NMEA", RECEPTOR_GPS);
+    testaTempoSimulado ("M8 NMEA", RECEPTOR_MULTI);
+    testaTempoSimulado ("NEO-6M UBX", -1);
+    testaDuasThreads (true);
+    testaDuasThreads (false);
+    return FIM_DO_TESTE ();
+}
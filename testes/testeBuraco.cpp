@@ -0,0 +1,197 @@
+/**
+ * testeBuraco.cpp       v0.0        17-10-2026
+ *
+ * Orientador: Elias Teodoro da Silva Junior
+ * Autores: Felipe Moura de Castro e Joao Bruno Costa Cruz,
+ * Instituto Federal de Educação, Ciência e Tecnologia do Ceará (IFCE) - Campus Fortaleza
+ *
+ * @Opensource
+ * Este código-fonte pode ser utilizado, copiado, estudado, modificado e redistribuído sem restrições.
+ *
+ * Copyright (c) 2019, Felipe Moura de Castro e Joao Bruno Costa Cruz.
+ *
+ */
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * Teste do detector de buracos e lombadas (detectaBuraco) e da janela capturada em torno do disparo
+ *
+ * Cada leitura bruta leva o seu número de sequência (amostraNumero), o que permite conferir exatamente quais amostras
+ * foram parar na janela. A aceleração vertical é zero, a não ser nos eventos. Casos:
+ * 1. buraco (-8 m/s² em uma amostra) a 54 km/h: a captura termina BURACO_POS_AMOSTRAS depois do disparo, a janela tem
+ *    as BURACO_PRE_AMOSTRAS anteriores (o disparo é a amostra BURACO_PRE_AMOSTRAS - 1) e as seguintes, em ordem, e o
+ *    resumo tem o tipo, a posição, a velocidade, o instante, o pico e o jerk do disparo;
+ * 2. lombada (+6 m/s²) em outra posição do vetor circular do histórico: a mesma janela, tipo lombada;
+ * 3. limiar que cresce com a velocidade: uma ondulação suave de 4 m/s² (jerk abaixo do limiar) dispara a 18 km/h, mas
+ *    não a 54 km/h, nem abaixo de 10 km/h, nem antes de o histórico ter BURACO_PRE_AMOSTRAS leituras;
+ * 4. fila cheia: o terceiro evento sem consumidor ainda é resumido, mas a janela é contada em perdidos.
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+#include "teste.h"
+#include "PavimentoCarro/pavimentoCarro.h"
+#include <math.h>
+#include <string.h>
+
+#define TESTE_TAXA_HZ       1000.0f
+#define TESTE_PI            3.14159265358979
+
+typedef struct {
+    detectorBuraco detector;
+    filaBuraco fila;
+    dataGPS posicao;
+    uint32_t amostras;
+    int eventos;
+    eventoBuraco ultimo;
+} estradaSimulada;
+
+// Leitura bruta de número 'numero'
+static void amostraNumero (uint32_t numero, MPU6050Motion6 *amostra) {
+    memset (amostra, 0, sizeof (MPU6050Motion6));
+    amostra->accelero[0] = (int16_t)numero;
+    amostra->accelero[1] = (int16_t)(numero >> 16);
+    amostra->gyro[0] = (int16_t)(numero * 3u);
+}
+
+static bool amostraConfere (const MPU6050Motion6 *lida, uint32_t numero) {
+    MPU6050Motion6 esperada;
+
+    amostraNumero (numero, &esperada);
+    return memcmp (lida, &esperada, sizeof (esperada)) == 0;
+}
+
+static void iniciaEstrada (estradaSimulada *estrada, int32_t velocidade) {
+    memset (estrada, 0, sizeof (estradaSimulada));
+    iniciaDetectorBuraco (&estrada->detector, TESTE_TAXA_HZ);
+    iniciaFila (&estrada->fila);
+    estrada->posicao.latitude = -37436000;
+    estrada->posicao.longitude = -385336000;
+    estrada->posicao.speed = velocidade;
+}
+
+// Uma amostra; o instante (ms) e a latitude andam com o número da amostra
+static void passa (estradaSimulada *estrada, float vertical) {
+    MPU6050Motion6 amostra;
+
+    amostraNumero (estrada->amostras, &amostra);
+    estrada->posicao.latitude++;
+    if (detectaBuraco (&estrada->detector, &estrada->fila, &amostra, vertical, &estrada->posicao,
+                       1000000 + estrada->amostras, &estrada->ultimo)) {
+        estrada->eventos++;
+    }
+    estrada->amostras++;
+}
+
+static void anda (estradaSimulada *estrada, int amostras) {
+    int i;
+
+    for (i = 0; i < amostras; i++) {
+        passa (estrada, 0.0f);
+    }
+}
+
+// Ondulação suave de 'amplitude' a 'frequencia' durante 'amostras'
+static void ondula (estradaSimulada *estrada, int amostras, float frequencia, float amplitude) {
+    int i;
+
+    for (i = 0; i < amostras; i++) {
+        passa (estrada, amplitude * (float)sin (2.0 * TESTE_PI * frequencia * i / TESTE_TAXA_HZ));
+    }
+}
+
+// Evento em 'disparo' de 'vertical' m/s²; confere o término da captura e a janela publicada na fila
+static void confereEvento (estradaSimulada *estrada, uint32_t disparo, float vertical, char tipo) {
+    const capturaBuraco *captura;
+    int32_t latitude;
+    int i, emOrdem = 0, eventos = estrada->eventos;
+
+    anda (estrada, (int)(disparo - estrada->amostras));
+    latitude = estrada->posicao.latitude + 1;
+    passa (estrada, vertical);
+    anda (estrada, BURACO_POS_AMOSTRAS - 1);
+    CONFERE (estrada->eventos == eventos);
+    passa (estrada, 0.0f);
+    CONFERE (estrada->eventos == eventos + 1);
+
+    CONFERE (estrada->ultimo.tipo == tipo && estrada->ultimo.numero == estrada->detector.eventos);
+    CONFERE (estrada->ultimo.latitude == latitude && estrada->ultimo.longitude == estrada->posicao.longitude);
+    CONFERE (estrada->ultimo.velocidade == (uint32_t)estrada->posicao.speed);
+    CONFERE (estrada->ultimo.instante == 1000000 + disparo);
+    CONFERE (estrada->ultimo.pico == (uint16_t)(fabsf (vertical) * 1000.0f));
+    CONFERE (estrada->ultimo.jerk == (uint16_t)(fabsf (vertical) * TESTE_TAXA_HZ));
+
+    captura = consultaFila (&estrada->fila);
+    CONFERE (captura != NULL);
+    if (captura == NULL) {
+        return;
+    }
+    CONFERE (memcmp (&captura->evento, &estrada->ultimo, sizeof (eventoBuraco)) == 0);
+    for (i = 0; i < BURACO_JANELA; i++) {
+        emOrdem += amostraConfere (&captura->amostras[i], disparo - (BURACO_PRE_AMOSTRAS - 1) + i);
+    }
+    printf ("%s na amostra %lu: janela de %lu a %lu, %d de %d amostras corretas, pico %u mm/s2, jerk %u m/s3\n",
+            tipo == BURACO_BURACO ? "buraco" : "lombada", (unsigned long)disparo,
+            (unsigned long)(disparo - (BURACO_PRE_AMOSTRAS - 1)), (unsigned long)(disparo + BURACO_POS_AMOSTRAS),
+            emOrdem, BURACO_JANELA, estrada->ultimo.pico, estrada->ultimo.jerk);
+    CONFERE (emOrdem == BURACO_JANELA);
+    liberaDaFila (&estrada->fila);
+    CONFERE (consultaFila (&estrada->fila) == NULL);
+}
+
+static void testaJanelas (estradaSimulada *estrada) {
+    iniciaEstrada (estrada, 15000);
+    confereEvento (estrada, 1000, -8.0f, BURACO_BURACO);
+    // Disparo na posição 100 do histórico (1636 % 256): a parte anterior da janela dá a volta no vetor circular
+    confereEvento (estrada, 1636, 6.0f, BURACO_LOMBADA);
+    CONFERE (estrada->fila.perdidos == 0);
+}
+
+static void testaLimiares (estradaSimulada *estrada) {
+    // Histórico ainda sem BURACO_PRE_AMOSTRAS leituras: não há janela completa para capturar
+    iniciaEstrada (estrada, 15000);
+    anda (estrada, BURACO_PRE_AMOSTRAS / 2);
+    passa (estrada, -8.0f);
+    anda (estrada, BURACO_JANELA);
+    CONFERE (estrada->detector.eventos == 0);
+
+    // 4 m/s² a 5 Hz: jerk de no máximo ~126 m/s³, só o limiar do pico pode disparar (3 m/s² + 0,1 por m/s)
+    estrada->posicao.speed = 15000;
+    ondula (estrada, 1000, 5.0f, 4.0f);
+    CONFERE (estrada->detector.eventos == 0);
+    estrada->posicao.speed = 2500;
+    ondula (estrada, 1000, 5.0f, 4.0f);
+    CONFERE (estrada->detector.eventos == 0);
+    estrada->posicao.speed = 5000;
+    ondula (estrada, 1000, 5.0f, 4.0f);
+    anda (estrada, BURACO_POS_AMOSTRAS);
+    printf ("ondulacao de 4 m/s2: 0 eventos a 54 km/h e a 9 km/h, %lu a 18 km/h\n",
+            (unsigned long)estrada->detector.eventos);
+    CONFERE (estrada->detector.eventos > 0 && estrada->eventos == (int)estrada->detector.eventos);
+    CONFERE (estrada->ultimo.velocidade == 5000);
+}
+
+static void testaFilaCheia (estradaSimulada *estrada) {
+    iniciaEstrada (estrada, 15000);
+    anda (estrada, 1000);
+    passa (estrada, -8.0f);
+    anda (estrada, 1000);
+    passa (estrada, 6.0f);
+    anda (estrada, 1000);
+    passa (estrada, -7.0f);
+    anda (estrada, 1000);
+    CONFERE (estrada->eventos == 3 && estrada->ultimo.numero == 3 && estrada->ultimo.tipo == BURACO_BURACO);
+    CONFERE (estrada->fila.perdidos == 1);
+    CONFERE (consultaFila (&estrada->fila)->evento.numero == 1);
+    liberaDaFila (&estrada->fila);
+    CONFERE (consultaFila (&estrada->fila)->evento.numero == 2);
+    liberaDaFila (&estrada->fila);
+    CONFERE (consultaFila (&estrada->fila) == NULL);
+}
+
+int main (void) {
+    static estradaSimulada estrada;
+
+    testaJanelas (&estrada);
+    testaLimiares (&estrada);
+    testaFilaCheia (&estrada);
+    return FIM_DO_TESTE ();
+}
@@ -0,0 +1,198 @@
+/**
+ * testeCalibracao.cpp       v0.0        17-10-2026
+ *
+ * Orientador: Elias Teodoro da Silva Junior
+ * Autores: Felipe Moura de Castro e Joao Bruno Costa Cruz,
+ * Instituto Federal de Educação, Ciência e Tecnologia do Ceará (IFCE) - Campus Fortaleza
+ *
+ * @Opensource
+ * Este código-fonte pode ser utilizado, copiado, estudado, modificado e redistribuído sem restrições.
+ *
+ * Copyright (c) 2019, Felipe Moura de Castro e Joao Bruno Costa Cruz.
+ *
+ */
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * Teste do registro de calibração na memória do DS1307 (salvaCalibracao / carregaCalibracao)
+ *
+ * A memória do DS1307 são os registros 8 a 63 do I2C do stub. O registro de calibração ocupa os bytes
+ * CALIBRACAO_ENDERECO (18) a 41: marca, versão, os 20 bytes do registroCalibracao e o CRC-16, logo depois do registro
+ * da partida rápida (bytes 0 a 17). Casos:
+ * 1. salvaCalibracao depois de salvaPartida: os bytes 0 a 17 e 42 a 55 não mudam, e um novo RtcDs1307 no mesmo I2C (a
+ *    próxima partida) lê o mesmo registro e a mesma partida; o CRC gravado é o CRC-16/CCITT (0x1021, início 0xFFFF,
+ *    big endian), calculado à parte;
+ * 2. qualquer um dos 192 bits trocado isoladamente, ou outra versão com o CRC refeito, faz carregaCalibracao recusar o
+ *    registro; memória vazia também é recusada;
+ * 3. salvaPartida depois de salvaCalibracao não estraga o registro de calibração, e com o barramento em falha
+ *    salvaCalibracao retorna 0 sem mudar a memória.
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+#include "teste.h"
+#include "CalibracaoCarro/calibracaoCarro.h"
+#include "TempoCarro/tempoCarro.h"
+#include <string.h>
+
+#define TESTE_REGISTRO_RAM          8       // primeiro registro da memória do DS1307
+#define TESTE_TAMANHO_RAM           56
+#define TESTE_TAMANHO_PARTIDA       18
+#define TESTE_TAMANHO_CALIBRACAO    (2 + (int)sizeof (registroCalibracao) + 2)
+
+// CRC-16/CCITT (CCITT-FALSE), bit a bit
+static uint16_t crcReferencia (const uint8_t *dados, int n) {
+    uint16_t crc = 0xFFFF;
+    int i, b;
+
+    for (i = 0; i < n; i++) {
+        for (b = 7; b >= 0; b--) {
+            crc = ((crc >> 15) ^ ((dados[i] >> b) & 1)) ? (uint16_t)((crc << 1) ^ 0x1021) : (uint16_t)(crc << 1);
+        }
+    }
+    return crc;
+}
+
+static uint8_t *memoria (I2C *i2c, int endereco) {
+    return &i2c->registros[TESTE_REGISTRO_RAM + endereco];
+}
+
+static void preencheFix (dataGPS *fix) {
+    memset (fix, 0, sizeof (dataGPS));
+    fix->latitude = -37436000;
+    fix->longitude = -385336000;
+    fix->altitude = 21300;
+    fix->valid = 'A';
+    memcpy (fix->date, "171026", 6);
+    fix->time = 123456;
+}
+
+// Registro com valores de sinal e bytes variados
+static void preencheRegistro (registroCalibracao *registro) {
+    registro->acce[0] = 123;
+    registro->acce[1] = -456;
+    registro->acce[2] = -9810;
+    registro->gyro[0] = -37;
+    registro->gyro[1] = 255;
+    registro->gyro[2] = -32768;
+    registro->rolagem = 175;
+    registro->arfagem = -349;
+    registro->guinada = 31415;
+    registro->validos = CALIBRACAO_BIAS | CALIBRACAO_NIVEL | CALIBRACAO_GUINADA;
+}
+
+// Nova partida: o RtcDs1307 lê a memória do DS1307 na construção
+static int carregaNaPartida (I2C *i2c, registroCalibracao *registro) {
+    RtcDs1307 rtc (*i2c);
+    return carregaCalibracao (&rtc, registro);
+}
+
+static int partidaNaPartida (I2C *i2c, partidaGPS *partida) {
+    RtcDs1307 rtc (*i2c);
+    return carregaPartida (&rtc, partida);
+}
+
+static void testaGravacao (I2C *i2c) {
+    uint8_t partida[TESTE_TAMANHO_PARTIDA], resto[TESTE_TAMANHO_RAM - CALIBRACAO_ENDERECO - TESTE_TAMANHO_CALIBRACAO];
+    const uint8_t *gravado;
+    registroCalibracao registro, lido;
+    partidaGPS ultimoFix;
+    dataGPS fix;
+    unsigned int i;
+
+    CONFERE (CALIBRACAO_ENDERECO == TESTE_TAMANHO_PARTIDA && TESTE_TAMANHO_CALIBRACAO == 24);
+    CONFERE (crcReferencia ((const uint8_t *)"123456789", 9) == 0x29B1);
+
+    // Bytes depois do registro com um padrão que não deve mudar
+    for (i = 0; i < sizeof (resto); i++) {
+        memoria (i2c, CALIBRACAO_ENDERECO + TESTE_TAMANHO_CALIBRACAO)[i] = (uint8_t)(0xA0 + i);
+    }
+    memcpy (resto, memoria (i2c, CALIBRACAO_ENDERECO + TESTE_TAMANHO_CALIBRACAO), sizeof (resto));
+    CONFERE (carregaNaPartida (i2c, &lido) == 0);
+
+    RtcDs1307 rtc (*i2c);
+    preencheFix (&fix);
+    CONFERE (salvaPartida (&rtc, &fix) == 1);
+    memcpy (partida, memoria (i2c, 0), sizeof (partida));
+
+    preencheRegistro (&registro);
+    CONFERE (salvaCalibracao (&rtc, &registro) == 1);
+    CONFERE (memcmp (partida, memoria (i2c, 0), sizeof (partida)) == 0);
+    CONFERE (memcmp (resto, memoria (i2c, CALIBRACAO_ENDERECO + TESTE_TAMANHO_CALIBRACAO), sizeof (resto)) == 0);
+
+    // Formato: marca, versão, registro e CRC-16 big endian dos 22 bytes anteriores
+    gravado = memoria (i2c, CALIBRACAO_ENDERECO);
+    CONFERE (gravado[0] == CALIBRACAO_MARCA && gravado[1] == CALIBRACAO_VERSAO);
+    CONFERE (memcmp (&gravado[2], &registro, sizeof (registro)) == 0);
+    CONFERE (crcReferencia (gravado, TESTE_TAMANHO_CALIBRACAO - 2) ==
+             ((gravado[TESTE_TAMANHO_CALIBRACAO - 2] << 8) | gravado[TESTE_TAMANHO_CALIBRACAO - 1]));
+
+    // Próxima partida: os dois registros voltam
+    memset (&lido, 0, sizeof (lido));
+    CONFERE (carregaNaPartida (i2c, &lido) == 1);
+    CONFERE (memcmp (&lido, &registro, sizeof (registro)) == 0);
+    CONFERE (partidaNaPartida (i2c, &ultimoFix) == 1);
+    CONFERE (ultimoFix.latitude == fix.latitude && ultimoFix.longitude == fix.longitude);
+    printf ("calibracao nos bytes %d a %d, CRC 0x%02X%02X; partida (0 a %d) e bytes %d a %d intactos\n",
+            CALIBRACAO_ENDERECO, CALIBRACAO_ENDERECO + TESTE_TAMANHO_CALIBRACAO - 1,
+            gravado[TESTE_TAMANHO_CALIBRACAO - 2], gravado[TESTE_TAMANHO_CALIBRACAO - 1], TESTE_TAMANHO_PARTIDA - 1,
+            CALIBRACAO_ENDERECO + TESTE_TAMANHO_CALIBRACAO, TESTE_TAMANHO_RAM - 1);
+}
+
+static void testaCorrompido (I2C *i2c) {
+    uint8_t *gravado = memoria (i2c, CALIBRACAO_ENDERECO);
+    uint8_t copia[TESTE_TAMANHO_CALIBRACAO];
+    registroCalibracao lido;
+    uint16_t crc;
+    int i, aceitos = 0;
+
+    memcpy (copia, gravado, sizeof (copia));
+    for (i = 0; i < TESTE_TAMANHO_CALIBRACAO * 8; i++) {
+        gravado[i / 8] ^= (uint8_t)(1 << (i % 8));
+        aceitos += carregaNaPartida (i2c, &lido);
+        gravado[i / 8] ^= (uint8_t)(1 << (i % 8));
+    }
+    printf ("registro com um bit trocado: %d de %d aceitos\n", aceitos, TESTE_TAMANHO_CALIBRACAO * 8);
+    CONFERE (aceitos == 0);
+
+    // Outra versão do formato, com o CRC correto: recusada
+    gravado[1] = CALIBRACAO_VERSAO + 1;
+    crc = crcReferencia (gravado, TESTE_TAMANHO_CALIBRACAO - 2);
+    gravado[TESTE_TAMANHO_CALIBRACAO - 2] = (uint8_t)(crc >> 8);
+    gravado[TESTE_TAMANHO_CALIBRACAO - 1] = (uint8_t)crc;
+    CONFERE (carregaNaPartida (i2c, &lido) == 0);
+
+    memcpy (gravado, copia, sizeof (copia));
+    CONFERE (carregaNaPartida (i2c, &lido) == 1);
+}
+
+static void testaOrdem (I2C *i2c) {
+    uint8_t copia[TESTE_TAMANHO_RAM];
+    registroCalibracao registro, lido;
+    partidaGPS ultimoFix;
+    dataGPS fix;
+
+    // A partida regravada (outro fix) leva junto a calibração da cópia do RtcDs1307
+    RtcDs1307 rtc (*i2c);
+    preencheFix (&fix);
+    fix.latitude += 1000;
+    CONFERE (salvaPartida (&rtc, &fix) == 1);
+    preencheRegistro (&registro);
+    CONFERE (carregaNaPartida (i2c, &lido) == 1 && memcmp (&lido, &registro, sizeof (registro)) == 0);
+    CONFERE (partidaNaPartida (i2c, &ultimoFix) == 1 && ultimoFix.latitude == fix.latitude);
+
+    // Barramento em falha: retorna 0 e a memória do DS1307 não muda
+    memcpy (copia, memoria (i2c, 0), sizeof (copia));
+    registro.guinada = -1;
+    i2c->falha = true;
+    CONFERE (salvaCalibracao (&rtc, &registro) == 0);
+    i2c->falha = false;
+    CONFERE (memcmp (copia, memoria (i2c, 0), sizeof (copia)) == 0);
+}
+
+int main (void) {
+    static I2C i2c;
+
+    testaGravacao (&i2c);
+    testaCorrompido (&i2c);
+    testaOrdem (&i2c);
+    return FIM_DO_TESTE ();
+}
@@ -0,0 +1,322 @@
+/**
+ * testeCercas.cpp       v0.0        17-10-2026
+ *
+ * Orientador: Elias Teodoro da Silva Junior
+ * Autores: Felipe Moura de Castro e Joao Bruno Costa Cruz,
+ * Instituto Federal de Educação, Ciência e Tecnologia do Ceará (IFCE) - Campus Fortaleza
+ *
+ * @Opensource
+ * Este código-fonte pode ser utilizado, copiado, estudado, modificado e redistribuído sem restrições.
+ *
+ * Copyright (c) 2019, Felipe Moura de Castro e Joao Bruno Costa Cruz.
+ *
+ */
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * Teste das cercas virtuais (CercaCarro)
+ *
+ * 1. Grade contra força bruta: conjuntos aleatórios de cercas (retângulos, polígonos convexos, estrelas côncavas,
+ *    cercas que cobrem várias células e cercas menores que uma célula) são montados em grades de vários tamanhos, e
+ *    localizaNasCercas é comparada, ponto a ponto, com o teste par-ímpar sobre todas as arestas. Os pontos são
+ *    aleatórios, vizinhos dos vértices e sobre as bordas das células; pontos exatamente sobre uma aresta (onde dentro
+ *    e fora são igualmente corretos) não são comparados.
+ * 2. A grade gerada em CercaCarro/gradeDasCercas.cpp é igual à montada agora com os mesmos vértices.
+ * 3. verificaCercas só gera eventos em transições confirmadas por CERCA_CONFIRMACOES fixes, ignora o carro andando
+ *    sobre a borda e adia o evento quando não há espaço no vetor de eventos.
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+#include "teste.h"
+#include <stdlib.h>
+#include "CercaCarro/cercaCarro.h"
+#include "CercaCarro/gradeDasCercas.h"
+
+#define TESTE_CONJUNTOS         40
+#define TESTE_PONTOS            4000
+#define TESTE_MAX_VERTICES      2048
+#define TESTE_GRADE_MAXIMA      (64 * 64)
+
+static verticeCerca vertices[TESTE_MAX_VERTICES];
+static poligonoCerca poligonos[CERCA_MAX_POLIGONOS];
+static uint16_t inicioDaCelula[TESTE_GRADE_MAXIMA + 1];
+static registroCerca registros[CERCA_MAX_INDICE + 1];
+static uint16_t arestas[CERCA_MAX_INDICE];
+static uint32_t semente = 2463534242u;
+
+static uint32_t aleatorio (void) {
+    semente ^= semente << 13;
+    semente ^= semente >> 17;
+    semente ^= semente << 5;
+    return semente;
+}
+
+// Inteiro em [minimo, maximo]
+static int32_t entre (int32_t minimo, int32_t maximo) {
+    return minimo + (int32_t)(aleatorio () % (uint32_t)(maximo - minimo + 1));
+}
+
+static void preparaMontagem (montagemCerca *montagem) {
+    memset (montagem, 0, sizeof (montagemCerca));
+    montagem->inicioDaCelula = inicioDaCelula;
+    montagem->registros = registros;
+    montagem->arestas = arestas;
+    montagem->maximoDeRegistros = CERCA_MAX_INDICE;
+    montagem->maximoDeArestas = CERCA_MAX_INDICE;
+}
+
+// Acrescenta uma cerca com centro (latitude, longitude) e raio aproximado (graus * 10^7)
+static int acrescentaCerca (int quantidade, int *usados, int32_t latitude, int32_t longitude, int32_t raio) {
+    int forma = (int)(aleatorio () % 3), n, k;
+    double angulo, r;
+
+    poligonos[quantidade].nome = "teste";
+    poligonos[quantidade].tipo = CERCA_RESTRITA;
+    poligonos[quantidade].primeiroVertice = (uint16_t)*usados;
+    if (forma == 0) {
+        // Retângulo: arestas horizontais e verticais, vértices com coordenadas repetidas
+        int32_t altura = entre (raio / 4, raio), largura = entre (raio / 4, raio);
+        verticeCerca retangulo[4] = { { latitude + altura, longitude - largura }, { latitude + altura, longitude + largura },
+                                      { latitude - altura, longitude + largura }, { latitude - altura, longitude - largura } };
+        memcpy (&vertices[*usados], retangulo, sizeof (retangulo));
+        n = 4;
+    } else {
+        // Convexo (forma 1) ou estrela côncava (forma 2), com 3 a 12 vértices
+        n = (forma == 1) ? entre (3, 8) : 2 * entre (3, 6);
+        for (k = 0; k < n; k++) {
+            angulo = 2.0 * 3.14159265358979 * (k + 0.3 * (aleatorio () % 1000) / 1000.0) / n;
+            r = (forma == 2 && (k & 1)) ? raio * 0.35 : raio * (0.7 + 0.3 * (aleatorio () % 1000) / 1000.0);
+            vertices[*usados + k].latitude = latitude + (int32_t)(r * cos (angulo));
+            vertices[*usados + k].longitude = longitude + (int32_t)(r * sin (angulo));
+        }
+    }
+    poligonos[quantidade].quantidadeDeVertices = (uint16_t)n;
+    *usados += n;
+    return quantidade + 1;
+}
+
+// Sinal de (b - a) x (c - a)
+static int64_t orientacaoBruta (const verticeCerca *a, const verticeCerca *b, int64_t x, int64_t y) {
+    return ((int64_t)b->longitude - a->longitude) * (y - a->latitude) - ((int64_t)b->latitude - a->latitude) * (x - a->longitude);
+}
+
+// Teste par-ímpar com todas as arestas; retorna -1 se o ponto está sobre uma aresta
+static int dentroPorForcaBruta (const poligonoCerca *poligono, int32_t latitude, int32_t longitude) {
+    const verticeCerca *a, *b;
+    int dentro = 0, i, j;
+    int64_t o;
+
+    for (i = 0; i < poligono->quantidadeDeVertices; i++) {
+        j = (i + 1) % poligono->quantidadeDeVertices;
+        a = &vertices[poligono->primeiroVertice + i];
+        b = &vertices[poligono->primeiroVertice + j];
+        o = orientacaoBruta (a, b, longitude, latitude);
+        if (o == 0 && longitude >= (a->longitude < b->longitude ? a->longitude : b->longitude) &&
+            longitude <= (a->longitude > b->longitude ? a->longitude : b->longitude) &&
+            latitude >= (a->latitude < b->latitude ? a->latitude : b->latitude) &&
+            latitude <= (a->latitude > b->latitude ? a->latitude : b->latitude)) {
+            return -1;
+        }
+        // A aresta cruza a horizontal do ponto (meio-aberta em cima) à direita dele
+        if ((a->latitude > latitude) != (b->latitude > latitude)) {
+            if ((b->latitude > a->latitude) ? (o > 0) : (o < 0)) {
+                dentro ^= 1;
+            }
+        }
+    }
+    return dentro;
+}
+
+typedef struct {
+    long comparados;
+    long sobreAresta;
+    long diferentes;
+} comparacao;
+
+static void comparaPonto (const cercasCarro *cercas, int quantidade, int32_t latitude, int32_t longitude,
+                          comparacao *resultado) {
+    uint32_t dentro[CERCA_PALAVRAS];
+    int p, esperado;
+
+    localizaNasCercas (cercas, latitude, longitude, dentro);
+    for (p = 0; p < quantidade; p++) {
+        esperado = dentroPorForcaBruta (&poligonos[p], latitude, longitude);
+        if (esperado < 0) {
+            resultado->sobreAresta++;
+            continue;
+        }
+        resultado->comparados++;
+        if (esperado != (int)((dentro[p >> 5] >> (p & 31)) & 1)) {
+            if (resultado->diferentes++ < 5) {
+                printf ("  diferenca: cerca %d, ponto (%ld, %ld), forca bruta %d\n", p, (long)latitude,
+                        (long)longitude, esperado);
+            }
+        }
+    }
+}
+
+static void testaForcaBruta (void) {
+    static const uint16_t tamanhos[][2] = { { 1, 1 }, { 4, 7 }, { 16, 16 }, { 64, 64 } };
+    montagemCerca montagem;
+    cercasCarro cercas;
+    comparacao resultado;
+    int32_t minimoLat, maximoLat, minimoLon, maximoLon, latitude, longitude;
+    int conjunto, t, i, k, quantidade, usados, montadas = 0, recusadas = 0;
+
+    memset (&resultado, 0, sizeof (resultado));
+    for (conjunto = 0; conjunto < TESTE_CONJUNTOS; conjunto++) {
+        // Cercas ao redor de Fortaleza, de 30 m a 3 km, muitas se sobrepondo
+        quantidade = entre (1, CERCA_MAX_POLIGONOS);
+        usados = 0;
+        for (i = 0; i < quantidade; ) {
+            i = acrescentaCerca (i, &usados, entre (-37600000, -37300000), entre (-385500000, -385200000),
+                                 entre (3000, 300000));
+        }
+        minimoLat = maximoLat = vertices[0].latitude;
+        minimoLon = maximoLon = vertices[0].longitude;
+        for (i = 0; i < usados; i++) {
+            minimoLat = (vertices[i].latitude < minimoLat) ? vertices[i].latitude : minimoLat;
+            maximoLat = (vertices[i].latitude > maximoLat) ? vertices[i].latitude : maximoLat;
+            minimoLon = (vertices[i].longitude < minimoLon) ? vertices[i].longitude : minimoLon;
+            maximoLon = (vertices[i].longitude > maximoLon) ? vertices[i].longitude : maximoLon;
+        }
+
+        for (t = 0; t < (int)(sizeof (tamanhos) / sizeof (tamanhos[0])); t++) {
+            preparaMontagem (&montagem);
+            if (!montaGradeCerca (&montagem, tamanhos[t][0], tamanhos[t][1], vertices, poligonos, (uint16_t)quantidade)) {
+                recusadas++;        // centro de célula sobre uma aresta
+                continue;
+            }
+            montadas++;
+            CONFERE (iniciaCercas (&cercas, vertices, poligonos, (uint16_t)quantidade, &montagem.grade));
+
+            // Pontos aleatórios, inclusive fora do retângulo das cercas
+            for (k = 0; k < TESTE_PONTOS; k++) {
+                latitude = entre (minimoLat - 1000, maximoLat + 1000);
+                longitude = entre (minimoLon - 1000, maximoLon + 1000);
+                comparaPonto (&cercas, quantidade, latitude, longitude, &resultado);
+            }
+            // Vizinhança dos vértices
+            for (i = 0; i < usados; i++) {
+                for (k = 0; k < 9; k++) {
+                    comparaPonto (&cercas, quantidade, vertices[i].latitude + (k / 3 - 1),
+                                  vertices[i].longitude + (k % 3 - 1), &resultado);
+                }
+            }
+            // Bordas das células
+            for (i = 0; i <= tamanhos[t][0]; i++) {
+                for (k = 0; k < 50; k++) {
+                    comparaPonto (&cercas, quantidade, montagem.grade.latitudeMinima + i * montagem.grade.alturaDaCelula,
+                                  entre (minimoLon, maximoLon), &resultado);
+                }
+            }
+            for (i = 0; i <= tamanhos[t][1]; i++) {
+                for (k = 0; k < 50; k++) {
+                    comparaPonto (&cercas, quantidade, entre (minimoLat, maximoLat),
+                                  montagem.grade.longitudeMinima + i * montagem.grade.larguraDaCelula, &resultado);
+                }
+            }
+        }
+    }
+    printf ("forca bruta: %d grades montadas (%d recusadas), %ld comparacoes, %ld pontos sobre arestas, %ld diferencas\n",
+            montadas, recusadas, resultado.comparados, resultado.sobreAresta, resultado.diferentes);
+    CONFERE (montadas >= TESTE_CONJUNTOS * 3);
+    CONFERE (resultado.comparados > 1000000);
+    CONFERE (resultado.diferentes == 0);
+
+    // Cerca inválida e grade que não cabe na montagem
+    poligonos[0].quantidadeDeVertices = 2;
+    preparaMontagem (&montagem);
+    CONFERE (!montaGradeCerca (&montagem, 16, 16, vertices, poligonos, 1));
+    acrescentaCerca (0, &usados, -37450000, -385350000, 100000);
+    preparaMontagem (&montagem);
+    montagem.maximoDeArestas = 3;
+    CONFERE (!montaGradeCerca (&montagem, 16, 16, vertices, poligonos, 1));
+}
+
+static void testaGradeGerada (void) {
+    montagemCerca montagem;
+    cercasCarro cercas;
+    uint32_t dentro[CERCA_PALAVRAS], celulas;
+    int iguais;
+
+    preparaMontagem (&montagem);
+    CONFERE (montaGradeCerca (&montagem, gradeDasCercas.linhas, gradeDasCercas.colunas, verticesDasCercas,
+                              poligonosDasCercas, quantidadeDeCercas));
+    celulas = (uint32_t)gradeDasCercas.linhas * gradeDasCercas.colunas;
+    iguais = montagem.grade.latitudeMinima == gradeDasCercas.latitudeMinima &&
+             montagem.grade.longitudeMinima == gradeDasCercas.longitudeMinima &&
+             montagem.grade.alturaDaCelula == gradeDasCercas.alturaDaCelula &&
+             montagem.grade.larguraDaCelula == gradeDasCercas.larguraDaCelula &&
+             memcmp (montagem.inicioDaCelula, gradeDasCercas.inicioDaCelula, (celulas + 1) * sizeof (uint16_t)) == 0 &&
+             memcmp (montagem.arestas, gradeDasCercas.arestas, montagem.quantidadeDeArestas * sizeof (uint16_t)) == 0;
+    for (uint32_t r = 0; r <= montagem.quantidadeDeRegistros; r++) {
+        iguais = iguais && montagem.registros[r].poligono == gradeDasCercas.registros[r].poligono &&
+                 montagem.registros[r].centroDentro == gradeDasCercas.registros[r].centroDentro &&
+                 montagem.registros[r].primeiraAresta == gradeDasCercas.registros[r].primeiraAresta;
+    }
+    printf ("gradeDasCercas.cpp: %u cercas, grade de %u x %u, %s montada agora\n", quantidadeDeCercas,
+            gradeDasCercas.linhas, gradeDasCercas.colunas, iguais ? "igual a" : "diferente da");
+    CONFERE (iguais);
+
+    // O IFCE: centro dentro da garagem, 200 m ao norte fora
+    CONFERE (iniciaCercas (&cercas, verticesDasCercas, poligonosDasCercas, quantidadeDeCercas, &gradeDasCercas));
+    localizaNasCercas (&cercas, -37443000, -385361000, dentro);
+    CONFERE (dentro[0] == 1);
+    localizaNasCercas (&cercas, -37425000, -385361000, dentro);
+    CONFERE (dentro[0] == 0);
+}
+
+static void testaTransicoes (void) {
+    cercasCarro cercas;
+    eventoCerca eventos[4];
+    dataGPS fix;
+    int i, n, total = 0;
+
+    CONFERE (iniciaCercas (&cercas, verticesDasCercas, poligonosDasCercas, quantidadeDeCercas, &gradeDasCercas));
+    memset (&fix, 0, sizeof (fix));
+    fix.valid = 'A';
+
+    // Liga fora da garagem: o primeiro fix só define o estado
+    fix.latitude = -37425000;
+    fix.longitude = -385361000;
+    CONFERE (verificaCercas (&cercas, &fix, eventos, 4) == 0);
+
+    // Andando sobre a borda norte (dentro e fora alternados): nenhum evento
+    for (i = 0; i < 20; i++) {
+        fix.latitude = (i & 1) ? -37434990 : -37435010;
+        total += verificaCercas (&cercas, &fix, eventos, 4);
+    }
+    CONFERE (total == 0);
+
+    // Entra: o evento sai no CERCA_CONFIRMACOES-ésimo fix dentro
+    fix.latitude = -37443000;
+    for (i = 1; i <= CERCA_CONFIRMACOES; i++) {
+        n = verificaCercas (&cercas, &fix, eventos, 4);
+        CONFERE (n == (i == CERCA_CONFIRMACOES ? 1 : 0));
+    }
+    CONFERE (eventos[0].poligono == 0 && eventos[0].transicao == CERCA_ENTRADA && eventos[0].latitude == fix.latitude);
+    CONFERE (verificaCercas (&cercas, &fix, eventos, 4) == 0);
+
+    // Fix inválido fora da cerca é ignorado
+    fix.valid = 'V';
+    fix.latitude = -37425000;
+    for (i = 0; i < CERCA_CONFIRMACOES; i++) {
+        CONFERE (verificaCercas (&cercas, &fix, eventos, 4) == 0);
+    }
+
+    // Sai sem espaço para o evento: a saída fica para o primeiro fix com espaço
+    fix.valid = 'A';
+    for (i = 0; i < CERCA_CONFIRMACOES + 2; i++) {
+        CONFERE (verificaCercas (&cercas, &fix, eventos, 0) == 0);
+    }
+    CONFERE (verificaCercas (&cercas, &fix, eventos, 4) == 1);
+    CONFERE (eventos[0].transicao == CERCA_SAIDA);
+    CONFERE (verificaCercas (&cercas, &fix, eventos, 4) == 0);
+}
+
+int main (void) {
+    testaForcaBruta ();
+    testaGradeGerada ();
+    testaTransicoes ();
+    return FIM_DO_TESTE ();
+}
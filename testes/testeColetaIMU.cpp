@@ -0,0 +1,211 @@
+/**
+ * testeColetaIMU.cpp       v0.0        17-10-2026
+ *
+ * Orientador: Elias Teodoro da Silva Junior
+ * Autores: Felipe Moura de Castro e Joao Bruno Costa Cruz,
+ * Instituto Federal de Educação, Ciência e Tecnologia do Ceará (IFCE) - Campus Fortaleza
+ *
+ * @Opensource
+ * Este código-fonte pode ser utilizado, copiado, estudado, modificado e redistribuído sem restrições.
+ *
+ * Copyright (c) 2019, Felipe Moura de Castro e Joao Bruno Costa Cruz.
+ *
+ */
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * Teste da coleta da FIFO da MPU6050 com o I2C assíncrono (DEVICE_I2C_ASYNCH = 1): esvaziaFifoIMU e startFifoRead
+ *
+ * A MPU6050 simulada (mpuSimulada.h) atende o I2C do stub; cada amostra leva o seu número de sequência em todos os
+ * campos, e o transfer termina em outra Thread do stub, depois do tempo no fio a 400 kHz. Casos:
+ * 1. FIFOs de 1 a 73 amostras (até 5 rajadas nas duas áreas alternadas) chegam inteiras e em ordem à fila;
+ * 2. transfer recusado (I2C ocupado) ou com erro na primeira ou na terceira rajada: o restante é lido com as leituras
+ *    bloqueantes, sem perder nem repetir amostras;
+ * 3. uma Thread produz amostras a 1 kHz enquanto a coleta roda a cada TESTE_AMOSTRAS_POR_LEITURA amostras;
+ * 4. latência: tempo de cada coleta de 10 amostras (da chamada ao retorno) e CPU da Thread de coleta, assíncrona x
+ *    bloqueante (todo transfer recusado), com o tempo no fio simulado também nas leituras bloqueantes.
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+#include "teste.h"
+#include "ImuCarro/imuCarro.h"
+#include "mpuSimulada.h"
+#include <thread>
+#include <chrono>
+
+#define TESTE_HZ                        400000
+#define TESTE_AMOSTRAS_POR_LEITURA      10
+#define TESTE_AMOSTRAS_EM_TEMPO_REAL    1000
+#define TESTE_COLETAS                   200
+
+static mpuSimulada modelo;
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * Coleta
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+static I2C i2c;
+static MPU6050 mpu (i2c);
+static barramentoI2C barramento;
+static clienteI2C cliente;
+static filaIMU fila;
+static desempenhoIMU desempenho;
+static coletorIMU coletor;
+static uint32_t esperada;
+
+// Retira a fila e confere que cada amostra é a seguinte da sequência; retorna as amostras fora da sequência
+static int confereFila (int *retiradas) {
+    MPU6050Motion6 amostra;
+    int foraDeOrdem = 0;
+
+    *retiradas = 0;
+    while (retiraDaFila (&fila, &amostra)) {
+        if (!amostraConfere (&amostra, esperada)) {
+            foraDeOrdem++;
+        }
+        esperada++;
+        (*retiradas)++;
+    }
+    return foraDeOrdem;
+}
+
+// Coloca 'amostras' na FIFO, esvazia e confere; retorna 1 se todas chegaram em ordem
+static int coletaConfere (int amostras) {
+    int entregues, retiradas, foraDeOrdem;
+
+    produzAmostras (&modelo, amostras);
+    entregues = esvaziaFifoIMU (&coletor);
+    foraDeOrdem = confereFila (&retiradas);
+    return entregues == amostras && retiradas == amostras && foraDeOrdem == 0 && bytesNaFifo (&modelo) == 0;
+}
+
+static void testaRajadas (void) {
+    int amostras, corretas = 0, leituras;
+
+    for (amostras = 1; amostras <= MPU6050_FIFO_SIZE / MPU6050_MOTION6_LENGTH; amostras++) {
+        leituras = desempenho.leituras;
+        corretas += coletaConfere (amostras);
+        CONFERE ((int)desempenho.leituras - leituras == (amostras + MPU6050_FIFO_BURST - 1) / MPU6050_FIFO_BURST);
+    }
+    printf ("FIFO de 1 a 73 amostras: %d coletas completas e em ordem\n", corretas);
+    CONFERE (corretas == MPU6050_FIFO_SIZE / MPU6050_MOTION6_LENGTH);
+    CONFERE (desempenho.errosI2C == 0 && desempenho.estourosFIFO == 0);
+}
+
+static void testaRecurso (void) {
+    uint32_t erros = desempenho.errosI2C;
+
+    // Recusado logo na primeira rajada: tudo bloqueante
+    i2c.transferenciasRecusadas = 1;
+    CONFERE (coletaConfere (40));
+    CONFERE (i2c.transferenciasRecusadas == 0);
+
+    // Recusado na terceira: as duas primeiras rajadas chegam pelo transfer, o resto pela leitura bloqueante
+    i2c.transferenciasNormais = 2;
+    i2c.transferenciasRecusadas = 1;
+    CONFERE (coletaConfere (60));
+
+    // Erro no transfer (NAK no endereço): a FIFO não foi lida e o restante é lido de forma bloqueante
+    i2c.transferenciasComErro = 1;
+    CONFERE (coletaConfere (50));
+    i2c.transferenciasNormais = 2;
+    i2c.transferenciasComErro = 1;
+    CONFERE (coletaConfere (73));
+    CONFERE (desempenho.errosI2C - erros == 2);
+    CONFERE (i2c.transferenciasNormais == 0 && i2c.transferenciasRecusadas == 0 && i2c.transferenciasComErro == 0);
+}
+
+static void testaTempoReal (void) {
+    std::thread sensor ([] () {
+        std::chrono::steady_clock::time_point proxima = std::chrono::steady_clock::now ();
+        int i;
+
+        for (i = 0; i < TESTE_AMOSTRAS_EM_TEMPO_REAL; i++) {
+            proxima += std::chrono::microseconds (1000);
+            std::this_thread::sleep_until (proxima);
+            produzAmostras (&modelo, 1);
+        }
+    });
+    uint32_t inicio = esperada;
+    int retiradas, foraDeOrdem = 0, coletas = 0;
+
+    while (esperada - inicio < TESTE_AMOSTRAS_EM_TEMPO_REAL && coletas < 10 * TESTE_AMOSTRAS_EM_TEMPO_REAL) {
+        std::this_thread::sleep_for (std::chrono::microseconds (1000 * TESTE_AMOSTRAS_POR_LEITURA));
+        CONFERE (esvaziaFifoIMU (&coletor) >= 0);
+        foraDeOrdem += confereFila (&retiradas);
+        coletas++;
+    }
+    sensor.join ();
+    esvaziaFifoIMU (&coletor);
+    foraDeOrdem += confereFila (&retiradas);
+    printf ("1 kHz em tempo real: %lu amostras em %d coletas, %d fora da sequencia\n",
+            (unsigned long)(esperada - inicio), coletas, foraDeOrdem);
+    CONFERE (esperada - inicio == TESTE_AMOSTRAS_EM_TEMPO_REAL);
+    CONFERE (foraDeOrdem == 0 && fila.perdidos == 0);
+}
+
+static uint64_t cpuDaThreadNs (void) {
+    struct timespec agora;
+    clock_gettime (CLOCK_THREAD_CPUTIME_ID, &agora);
+    return (uint64_t)agora.tv_sec * 1000000000u + (uint64_t)agora.tv_nsec;
+}
+
+// Latência e CPU médias por coleta de TESTE_AMOSTRAS_POR_LEITURA amostras (us)
+static void mede (const char *nome, bool bloqueante, double *latencia, double *cpu) {
+    uint64_t inicio, cpuInicial, somaLatencia = 0, somaCpu = 0, maior = 0, tempo;
+    int i, retiradas, foraDeOrdem = 0;
+
+    for (i = 0; i < TESTE_COLETAS; i++) {
+        produzAmostras (&modelo, TESTE_AMOSTRAS_POR_LEITURA);
+        i2c.transferenciasRecusadas = bloqueante ? 1000 : 0;
+        inicio = agoraNs ();
+        cpuInicial = cpuDaThreadNs ();
+        esvaziaFifoIMU (&coletor);
+        somaCpu += cpuDaThreadNs () - cpuInicial;
+        tempo = agoraNs () - inicio;
+        somaLatencia += tempo;
+        maior = tempo > maior ? tempo : maior;
+        foraDeOrdem += confereFila (&retiradas);
+    }
+    i2c.transferenciasRecusadas = 0;
+    *latencia = somaLatencia / 1000.0 / TESTE_COLETAS;
+    *cpu = somaCpu / 1000.0 / TESTE_COLETAS;
+    printf ("%-12s latencia media %7.1f us (maior %7.1f us), CPU da Thread %7.1f us por coleta\n", nome, *latencia,
+            maior / 1000.0, *cpu);
+    CONFERE (foraDeOrdem == 0);
+}
+
+static void testaLatencia (void) {
+    double fio, latenciaAssincrona, cpuAssincrona, latenciaBloqueante, cpuBloqueante;
+
+    i2c.simulaTempo = true;
+    // Contagem (registro + 2 bytes) e a rajada (registro + 10 amostras)
+    fio = i2c.tempoNoFioUs (2) + i2c.tempoNoFioUs (3) + i2c.tempoNoFioUs (2) +
+          i2c.tempoNoFioUs (1 + TESTE_AMOSTRAS_POR_LEITURA * MPU6050_MOTION6_LENGTH);
+    printf ("MPU6050 a %d Hz: %.0f us no fio por coleta de %d amostras\n", i2c.hz, fio, TESTE_AMOSTRAS_POR_LEITURA);
+    mede ("assincrona", false, &latenciaAssincrona, &cpuAssincrona);
+    mede ("bloqueante", true, &latenciaBloqueante, &cpuBloqueante);
+    printf ("liberados %.1f us de CPU por coleta (%.0f%% do tempo no fio)\n", cpuBloqueante - cpuAssincrona,
+            100.0 * (cpuBloqueante - cpuAssincrona) / fio);
+    i2c.simulaTempo = false;
+
+    CONFERE (latenciaAssincrona >= fio && latenciaBloqueante >= fio);
+    CONFERE (cpuBloqueante >= 0.9 * fio);
+    CONFERE (cpuBloqueante - cpuAssincrona > 0.5 * fio);
+}
+
+int main (void) {
+    ligaMpuSimulada (&modelo, &i2c);
+    iniciaBarramento (&barramento, &i2c, TESTE_HZ);
+    cadastraClienteI2C (&barramento, &cliente, "Coleta IMU", 3);
+    mpu.setMotion6Fifo (true);
+    iniciaFila (&fila);
+    iniciaColetor (&coletor, &mpu, &barramento, &cliente, &fila, &desempenho);
+
+    testaRajadas ();
+    testaRecurso ();
+    testaTempoReal ();
+    testaLatencia ();
+    i2c.dispositivo = nullptr;
+    return FIM_DO_TESTE ();
+}
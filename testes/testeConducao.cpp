@@ -0,0 +1,74 @@
+/**
+ * testeConducao.cpp       v0.0        17-10-2026
+ *
+ * Orientador: Elias Teodoro da Silva Junior
+ * Autores: Felipe Moura de Castro e Joao Bruno Costa Cruz,
+ * Instituto Federal de Educação, Ciência e Tecnologia do Ceará (IFCE) - Campus Fortaleza
+ *
+ * @Opensource
+ * Este código-fonte pode ser utilizado, copiado, estudado, modificado e redistribuído sem restrições.
+ *
+ * Copyright (c) 2019, Felipe Moura de Castro e Joao Bruno Costa Cruz.
+ *
+ */
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * Teste do classificador de condução com e sem a guinada da montagem
+ *
+ * Uma frenagem de 0,5 g por 1 s a 54 km/h, amostrada a 1 kHz, deve gerar um único evento de frenagem quando o eixo X é
+ * a frente do carro, nenhum evento antes da calibração da guinada e nenhum quando o alinhamento se perde no meio dela.
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+#include "teste.h"
+#include "ConducaoCarro/conducaoCarro.h"
+
+#define TESTE_TAXA_HZ           1000
+
+// Repouso, frenagem de 1 s e repouso; alinhamento perdido a partir da amostra perdeEm (-1 para nunca)
+static int frenagem (conducaoCarro *conducao, bool alinhado, int perdeEm, eventoConducao *ultimo) {
+    float linear[3] = { 0.0f, 0.0f, 0.0f };
+    dataGPS posicao;
+    eventoConducao evento;
+    int n, eventos = 0;
+
+    memset (&posicao, 0, sizeof (posicao));
+    posicao.valid = 'A';
+    posicao.speed = 15000;
+    for (n = 0; n < 3 * TESTE_TAXA_HZ; n++) {
+        linear[0] = (n >= TESTE_TAXA_HZ && n < 2 * TESTE_TAXA_HZ) ? -4.9f : 0.0f;
+        if (classificaConducao (conducao, linear, &posicao, 1000 + n, alinhado && (perdeEm < 0 || n < perdeEm),
+                                &evento)) {
+            memcpy (ultimo, &evento, sizeof (evento));
+            eventos++;
+        }
+    }
+    return eventos;
+}
+
+int main (void) {
+    conducaoCarro conducao;
+    eventoConducao evento;
+
+    iniciaConducao (&conducao, TESTE_TAXA_HZ);
+    CONFERE (frenagem (&conducao, true, -1, &evento) == 1);
+    CONFERE (evento.tipo == CONDUCAO_FRENAGEM);
+    CONFERE (!evento.severo);
+    CONFERE (evento.duracaoMs > 900 && evento.duracaoMs < 1200);
+    CONFERE (conducao.contagens[CONDUCAO_FRENAGEM][0] == 1);
+    CONFERE (conducao.amostrasSemGuinada == 0);
+
+    iniciaConducao (&conducao, TESTE_TAXA_HZ);
+    CONFERE (frenagem (&conducao, false, -1, &evento) == 0);
+    CONFERE (conducao.eventos == 0);
+    CONFERE (conducao.amostrasSemGuinada == 3 * TESTE_TAXA_HZ);
+
+    // Alinhamento perdido no meio da frenagem: o evento em andamento é descartado
+    iniciaConducao (&conducao, TESTE_TAXA_HZ);
+    CONFERE (frenagem (&conducao, true, 1500, &evento) == 0);
+    CONFERE (conducao.eventos == 0);
+    CONFERE (conducao.amostrasSemGuinada == 1500);
+
+    printf ("conducao com e sem a guinada da montagem conferida\n");
+    return FIM_DO_TESTE ();
+}
@@ -0,0 +1,186 @@
+/**
+ * testeCoordenadas.cpp       v0.0        17-10-2026
+ *
+ * Orientador: Elias Teodoro da Silva Junior
+ * Autores: Felipe Moura de Castro e Joao Bruno Costa Cruz,
+ * Instituto Federal de Educação, Ciência e Tecnologia do Ceará (IFCE) - Campus Fortaleza
+ *
+ * @Opensource
+ * Este código-fonte pode ser utilizado, copiado, estudado, modificado e redistribuído sem restrições.
+ *
+ * Copyright (c) 2019, Felipe Moura de Castro e Joao Bruno Costa Cruz.
+ *
+ */
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * Teste do ponto fixo do dataGPS (graus * 10^7 e mm/s) contra a representação em double da primeira versão
+ *
+ * 1. Coordenadas: para todos os minutos mm.mmmmm (0 a 59.99999) dos graus testados, nos dois hemisférios:
+ *    - transformaCoordenada dá o valor exato arredondado em 10^-7 graus, e a volta para minutos * 10^5 é exata;
+ *    - em 3 graus S e 38 graus W (Fortaleza), o texto com 7 casas do formataDecimal volta ao mesmo inteiro e
+ *      o texto com 6 casas é idêntico ao "%.6lf" da versão original (transformaCoordenada em double), exceto nos
+ *      empates exatos em 10^-6 (minutos * 10^5 múltiplo de 6 mais 3), onde o arredondamento do double é arbitrário e o
+ *      formataDecimal arredonda para longe do zero; esses empates são contados.
+ * 2. Velocidade: para 0 a 1000 nós (knots * 10^3), transformaSpeed erra no máximo 0,5 mm/s, a volta para knots * 10^3
+ *    erra no máximo 1 e o texto em km/h (MM_S_PARA_KMH_E4) erra no máximo 0,0018 km/h. A versão original usava
+ *    1 knot = 1,853 km/h e não é comparada.
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+#include "teste.h"
+#include "GPS_Carro/GPS_Carro.h"
+#include "gpsOriginal.h"
+
+#define TESTE_MINUTOS           6000000     // mm.mmmmm * 10^5
+
+typedef struct {
+    long valores;
+    long errosExatos;
+    long errosDeVolta;
+    long errosDeTexto;
+    long diferencasForaDeEmpate;
+    long empates;
+    long empatesDiferentes;
+} resultadoCoordenadas;
+
+// Lê o texto decimal de volta como inteiro, sem ponto flutuante ("-3.7436000" -> -37436000)
+static long long leDecimal (const char *texto) {
+    long long valor = 0;
+    const char *p;
+
+    for (p = texto; *p; p++) {
+        if (*p >= '0' && *p <= '9') {
+            valor = valor * 10 + (*p - '0');
+        }
+    }
+    return (texto[0] == '-') ? -valor : valor;
+}
+
+static void testaGraus (int graus, char direcao, bool comparaOriginal, resultadoCoordenadas *resultado) {
+    char atual[24], antigo[24];
+    original::dataGPS data;
+    int32_t valor, sinal = (direcao == 'S' || direcao == 'W') ? -1 : 1;
+    long long exato;
+    int32_t minutos;
+
+    for (minutos = 0; minutos < TESTE_MINUTOS; minutos++) {
+        valor = transformaCoordenada (graus * 10000000 + minutos, direcao);
+        resultado->valores++;
+
+        // Exato: minutos * 10^5 / 60 * 10^2 = minutos * 5 / 3, sem empates em 10^-7 (frações 0, 1/3 e 2/3)
+        exato = sinal * (graus * 10000000LL + (minutos * 5LL + 1) / 3);
+        resultado->errosExatos += (valor != exato);
+
+        // Volta para minutos * 10^5: o erro de 1/3 em 10^-7 graus vira 0,2 em 10^-5 minutos
+        resultado->errosDeVolta += ((llabs (valor) - graus * 10000000LL) * 3 + 2) / 5 != minutos;
+
+        if (comparaOriginal) {
+            // Texto com todas as casas volta ao mesmo inteiro
+            formataDecimal (atual, sizeof (atual), valor, 7, 7);
+            resultado->errosDeTexto += leDecimal (atual) != valor;
+
+            // Como a versão original: ddmm.mmmmm em double, convertido e impresso com "%.6lf"
+            memset (&data, 0, sizeof (data));
+            data.latitude = graus * 100.0 + minutos / 100000.0;
+            data.longitude = data.latitude;
+            data.direction1 = direcao;
+            data.direction2 = direcao;
+            original::transformaCoordenada (&data);
+            snprintf (antigo, sizeof (antigo), "%.6lf", (direcao == 'S') ? data.latitude : data.longitude);
+            formataDecimal (atual, sizeof (atual), valor, 7, 6);
+            if (minutos % 6 == 3) {
+                resultado->empates++;
+                resultado->empatesDiferentes += strcmp (atual, antigo) != 0;
+            } else if (strcmp (atual, antigo) != 0) {
+                if (resultado->diferencasForaDeEmpate++ < 5) {
+                    printf ("%d graus %07ld %c: atual %s, original %s\n", graus, (long)minutos, direcao, atual,
+                            antigo);
+                }
+            }
+        }
+    }
+}
+
+static void testaCoordenadas (void) {
+    static const struct {
+        int graus;
+        char comparaOriginal;
+    } casos[] = {
+        { 0, 0 }, { 3, 'S' }, { 38, 'W' }, { 89, 0 }, { 179, 0 },
+    };
+    static const char direcoes[] = { 'N', 'S', 'E', 'W' };
+    resultadoCoordenadas resultado;
+    int i, j;
+
+    memset (&resultado, 0, sizeof (resultado));
+    for (i = 0; i < (int)(sizeof (casos) / sizeof (casos[0])); i++) {
+        for (j = 0; j < (int)sizeof (direcoes); j++) {
+            // Os textos são conferidos só na região do carro, que é a parte mais lenta
+            testaGraus (casos[i].graus, direcoes[j], casos[i].comparaOriginal == direcoes[j], &resultado);
+        }
+    }
+
+    printf ("coordenadas: %ld valores, %ld fora do exato, %ld voltas erradas, %ld textos que nao voltam\n",
+            resultado.valores, resultado.errosExatos, resultado.errosDeVolta, resultado.errosDeTexto);
+    printf ("\"%%.6lf\" original: %ld diferencas fora de empate, %ld de %ld empates em 10^-6 arredondados diferente\n",
+            resultado.diferencasForaDeEmpate, resultado.empatesDiferentes, resultado.empates);
+    CONFERE (resultado.errosExatos == 0);
+    CONFERE (resultado.errosDeVolta == 0);
+    CONFERE (resultado.errosDeTexto == 0);
+    CONFERE (resultado.diferencasForaDeEmpate == 0);
+    CONFERE (resultado.empates > 0);
+
+    // Campo corrompido fora de -180..180 graus
+    CONFERE (transformaCoordenada (181 * 10000000 + 1, 'N') == 0);
+    CONFERE (transformaCoordenada (180 * 10000000, 'W') == -1800000000);
+}
+
+static void testaVelocidade (void) {
+    long errosDeArredondamento = 0, errosDeVolta = 0, errosDeTexto = 0;
+    char texto[24];
+    int32_t nos, velocidade;
+    long double erro, maiorErroKmh = 0.0L;
+
+    for (nos = 0; nos <= 1000000; nos++) {
+        velocidade = transformaSpeed (nos);
+
+        // |velocidade - nos * 1852 / 3600| <= 0,5 mm/s
+        errosDeArredondamento += llabs (velocidade * 3600LL - nos * 1852LL) > 1800;
+        // Volta para knots * 10^3 (1 mm/s equivale a 1,94 knots * 10^-3)
+        errosDeVolta += llabs ((velocidade * 3600LL * 2 + 1852) / (1852 * 2) - nos) > 1;
+
+        formataDecimal (texto, sizeof (texto), MM_S_PARA_KMH_E4 (velocidade), 4, 4);
+        erro = fabsl (strtold (texto, NULL) - nos * 1.852L / 1000.0L);
+        if (erro > maiorErroKmh) {
+            maiorErroKmh = erro;
+        }
+        errosDeTexto += erro > 0.0018L + 1e-9L;
+    }
+
+    printf ("velocidade: %ld fora de 0,5 mm/s, %ld voltas com erro maior que 1, maior erro em km/h %.5Lf\n",
+            errosDeArredondamento, errosDeVolta, maiorErroKmh);
+    CONFERE (errosDeArredondamento == 0);
+    CONFERE (errosDeVolta == 0);
+    CONFERE (errosDeTexto == 0);
+
+    // Limite de 1000 nós para campos corrompidos, sem estourar o int32
+    CONFERE (transformaSpeed (2000000) == transformaSpeed (1000000));
+    CONFERE (transformaSpeed (INT32_MAX) == transformaSpeed (1000000));
+}
+
+// O exemplo da documentação do formataDecimal: 9 caracteres e o terminador; com menos espaço o texto é truncado
+static void testaExemplo (void) {
+    char texto[16];
+
+    formataDecimal (texto, 10, -37345678, 7, 6);
+    CONFERE (strcmp (texto, "-3.734568") == 0);
+    formataDecimal (texto, 8, -37345678, 7, 6);
+    CONFERE (strcmp (texto, "-3.7345") == 0);
+}
+
+int main (void) {
+    testaExemplo ();
+    testaCoordenadas ();
+    testaVelocidade ();
+    return FIM_DO_TESTE ();
+}
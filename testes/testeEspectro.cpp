@@ -0,0 +1,233 @@
+/**
+ * testeEspectro.cpp       v0.0        17-10-2026
+ *
+ * Orientador: Elias Teodoro da Silva Junior
+ * Autores: Felipe Moura de Castro e Joao Bruno Costa Cruz,
+ * Instituto Federal de Educação, Ciência e Tecnologia do Ceará (IFCE) - Campus Fortaleza
+ *
+ * @Opensource
+ * Este código-fonte pode ser utilizado, copiado, estudado, modificado e redistribuído sem restrições.
+ *
+ * Copyright (c) 2019, Felipe Moura de Castro e Joao Bruno Costa Cruz.
+ *
+ */
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * Teste e benchmark da FFT portátil do espectroCarro (ESPECTRO_CMSIS_DSP = 0)
+ *
+ * A referência é uma DFT direta em long double, com senos e cossenos calculados por cosl/sinl a cada termo: não usa
+ * as tabelas do analisador, de forma que um erro nelas também aparece. Para cada sinal (impulsos, DC, Nyquist, tons
+ * sobre um índice e entre dois, ruído, aceleração com a gravidade) a saída de fftReal é comparada à referência em todos
+ * os índices de 0 a N/2: o erro é dado em relação à norma do espectro, que não depende de onde está a energia.
+ *
+ * Em seguida, um tom de amplitude conhecida confere as bandas de acrescentaEspectro (Parseval com a janela), e o
+ * benchmark mede fftReal e, para comparação, a DFT direta em float com as tabelas do módulo.
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+#include "teste.h"
+#include "EspectroCarro/espectroCarro.h"
+#include <math.h>
+#include <string.h>
+
+#define TESTE_TAXA_HZ           1000.0f
+#define TESTE_ERRO_RMS          1e-7        // erro RMS por índice relativo à norma do espectro (medido: ~2 * 10^-8)
+#define TESTE_ERRO_MAXIMO       1e-6        // maior erro de um índice relativo à norma do espectro (medido: ~10^-7)
+#define TESTE_TRANSFORMADAS     20000
+#define TESTE_DFTS              200
+
+static espectroCarro espectro;
+
+// DFT direta em long double dos índices 0 a N/2
+static void dftReferencia (const float *x, long double *re, long double *im) {
+    const long double pi = 3.141592653589793238462643383279502884L;
+    int k, n;
+
+    for (k = 0; k <= ESPECTRO_N / 2; k++) {
+        re[k] = im[k] = 0.0L;
+        for (n = 0; n < ESPECTRO_N; n++) {
+            long double angulo = 2.0L * pi * (long double)((k * n) % ESPECTRO_N) / ESPECTRO_N;
+            re[k] += x[n] * cosl (angulo);
+            im[k] -= x[n] * sinl (angulo);
+        }
+    }
+}
+
+// DFT direta em float com as tabelas do módulo (o custo que a FFT evita)
+static void dftTabelas (const float *x, float *saida) {
+    float re, im, c, s;
+    int k, n, indice;
+
+    for (k = 0; k <= ESPECTRO_N / 2; k++) {
+        re = im = 0.0f;
+        for (n = 0; n < ESPECTRO_N; n++) {
+            indice = (k * n) % ESPECTRO_N;
+            c = indice < ESPECTRO_N / 2 ? espectro.cosseno[indice] : -espectro.cosseno[indice - ESPECTRO_N / 2];
+            s = indice < ESPECTRO_N / 2 ? espectro.seno[indice] : -espectro.seno[indice - ESPECTRO_N / 2];
+            re += x[n] * c;
+            im -= x[n] * s;
+        }
+        saida[k < ESPECTRO_N / 2 ? 2 * k : 1] = re;
+        if (k > 0 && k < ESPECTRO_N / 2) {
+            saida[2 * k + 1] = im;
+        }
+    }
+}
+
+static uint32_t semente = 12345;
+
+static float aleatorio (void) {
+    semente = semente * 1103515245u + 12345u;
+    return ((semente >> 8) & 0xFFFF) / 32768.0f - 1.0f;
+}
+
+static void comparaComReferencia (const char *nome, const float *x) {
+    static long double re[ESPECTRO_N / 2 + 1], im[ESPECTRO_N / 2 + 1];
+    float entrada[ESPECTRO_N], saida[ESPECTRO_N];
+    long double norma = 0.0L, somaDosErros = 0.0L, maiorErro = 0.0L, erro, dr, di;
+    int k;
+
+    dftReferencia (x, re, im);
+    memcpy (entrada, x, sizeof (entrada));
+    fftReal (&espectro, entrada, saida);
+
+    for (k = 0; k <= ESPECTRO_N / 2; k++) {
+        if (k == 0) {
+            dr = saida[0] - re[0];
+            di = im[0];
+        } else if (k == ESPECTRO_N / 2) {
+            dr = saida[1] - re[k];
+            di = im[k];
+        } else {
+            dr = saida[2 * k] - re[k];
+            di = saida[2 * k + 1] - im[k];
+        }
+        erro = dr * dr + di * di;
+        somaDosErros += erro;
+        if (erro > maiorErro) {
+            maiorErro = erro;
+        }
+        norma += re[k] * re[k] + im[k] * im[k];
+    }
+    norma = sqrtl (norma);
+    printf ("%-34s erro RMS relativo %.2e, maior erro relativo %.2e\n", nome,
+            (double)(sqrtl (somaDosErros / (ESPECTRO_N / 2 + 1)) / norma), (double)(sqrtl (maiorErro) / norma));
+    CONFERE (sqrtl (somaDosErros / (ESPECTRO_N / 2 + 1)) / norma < TESTE_ERRO_RMS);
+    CONFERE (sqrtl (maiorErro) / norma < TESTE_ERRO_MAXIMO);
+}
+
+static void testaFFT (void) {
+    float x[ESPECTRO_N];
+    int n;
+
+    memset (x, 0, sizeof (x));
+    x[0] = 1.0f;
+    comparaComReferencia ("impulso em 0", x);
+
+    memset (x, 0, sizeof (x));
+    x[37] = 1.0f;
+    comparaComReferencia ("impulso em 37", x);
+
+    for (n = 0; n < ESPECTRO_N; n++) {
+        x[n] = 9.81f;
+    }
+    comparaComReferencia ("DC", x);
+
+    for (n = 0; n < ESPECTRO_N; n++) {
+        x[n] = (n & 1) ? -1.0f : 1.0f;
+    }
+    comparaComReferencia ("Nyquist", x);
+
+    for (n = 0; n < ESPECTRO_N; n++) {
+        x[n] = sinf (2.0f * 3.14159265f * 10.0f * n / ESPECTRO_N);
+    }
+    comparaComReferencia ("tom no indice 10", x);
+
+    for (n = 0; n < ESPECTRO_N; n++) {
+        x[n] = 0.3f * cosf (2.0f * 3.14159265f * 37.5f * n / ESPECTRO_N);
+    }
+    comparaComReferencia ("tom entre os indices 37 e 38", x);
+
+    for (n = 0; n < ESPECTRO_N; n++) {
+        x[n] = aleatorio ();
+    }
+    comparaComReferencia ("ruido", x);
+
+    for (n = 0; n < ESPECTRO_N; n++) {
+        x[n] = (9.81f + 0.5f * aleatorio () + 2.0f * sinf (2.0f * 3.14159265f * 45.0f * n / TESTE_TAXA_HZ)) *
+               espectro.hann[n];
+    }
+    comparaComReferencia ("gravidade, tom e ruido com Hann", x);
+
+    for (n = 0; n < ESPECTRO_N; n++) {
+        x[n] = 150.0f * aleatorio ();
+    }
+    comparaComReferencia ("ruido de 150 m/s2", x);
+}
+
+// Um tom de 2 m/s² (RMS 1414 mm/s²) a 45 Hz deve aparecer inteiro na banda de 32 a 64 Hz. Como a janela não tem um
+// número inteiro de ciclos, a média removida não é exatamente 9,81 e o resto, com a Hann, vaza ~2% para a banda de 1 Hz.
+static void testaBandas (void) {
+    static const float limites[ESPECTRO_BANDAS + 1] = ESPECTRO_LIMITES_HZ;
+    float x[ESPECTRO_N];
+    dataGPS posicao;
+    janelaEspectro janela;
+    int n, b, completas = 0;
+
+    memset (&posicao, 0, sizeof (posicao));
+    for (n = 0; n < ESPECTRO_N; n++) {
+        x[n] = 9.81f + 2.0f * sinf (2.0f * 3.14159265f * 45.0f * n / TESTE_TAXA_HZ);
+    }
+    // Em blocos de 10 amostras, como a Thread da navegação entrega
+    for (n = 0; n < ESPECTRO_N; n += 10) {
+        completas += acrescentaEspectro (&espectro, &x[n], n + 10 <= ESPECTRO_N ? 10 : ESPECTRO_N - n, &posicao, 0,
+                                         &janela);
+    }
+    CONFERE (completas == 1);
+    for (b = 0; b < ESPECTRO_BANDAS; b++) {
+        printf ("banda %5.0f-%3.0f Hz: %5u mm/s2\n", limites[b], limites[b + 1], janela.bandas[b]);
+        if (limites[b] <= 45.0f && limites[b + 1] > 45.0f) {
+            CONFERE (fabsf (janela.bandas[b] - 1414.2f) < 0.02f * 1414.2f);
+        } else {
+            CONFERE (janela.bandas[b] < 0.03f * 1414.2f);
+        }
+    }
+    CONFERE (espectro.transformadas == 1);
+}
+
+static void mede (void) {
+    static float x[ESPECTRO_N], entrada[ESPECTRO_N], saida[ESPECTRO_N];
+    uint64_t inicio, nsFFT, nsDFT;
+    float soma = 0.0f;
+    int i;
+
+    for (i = 0; i < ESPECTRO_N; i++) {
+        x[i] = aleatorio ();
+    }
+    inicio = agoraNs ();
+    for (i = 0; i < TESTE_TRANSFORMADAS; i++) {
+        memcpy (entrada, x, sizeof (entrada));
+        fftReal (&espectro, entrada, saida);
+        soma += saida[i & (ESPECTRO_N - 1)];
+    }
+    nsFFT = (agoraNs () - inicio) / TESTE_TRANSFORMADAS;
+
+    inicio = agoraNs ();
+    for (i = 0; i < TESTE_DFTS; i++) {
+        dftTabelas (x, saida);
+        soma += saida[i & (ESPECTRO_N - 1)];
+    }
+    nsDFT = (agoraNs () - inicio) / TESTE_DFTS;
+
+    printf ("fftReal de %d pontos: %llu ns; DFT direta em float: %llu ns (%.0f vezes) [%g]\n", ESPECTRO_N,
+            (unsigned long long)nsFFT, (unsigned long long)nsDFT, (double)nsDFT / (nsFFT ? nsFFT : 1), (double)soma);
+    CONFERE (nsFFT * 10 < nsDFT);
+}
+
+int main (void) {
+    iniciaEspectro (&espectro, TESTE_TAXA_HZ);
+    testaFFT ();
+    testaBandas ();
+    mede ();
+    return FIM_DO_TESTE ();
+}
@@ -0,0 +1,198 @@
+/**
+ * testeFifoIMU.cpp       v0.0        17-10-2026
+ *
+ * Orientador: Elias Teodoro da Silva Junior
+ * Autores: Felipe Moura de Castro e Joao Bruno Costa Cruz,
+ * Instituto Federal de Educação, Ciência e Tecnologia do Ceará (IFCE) - Campus Fortaleza
+ *
+ * @Opensource
+ * Este código-fonte pode ser utilizado, copiado, estudado, modificado e redistribuído sem restrições.
+ *
+ * Copyright (c) 2019, Felipe Moura de Castro e Joao Bruno Costa Cruz.
+ *
+ */
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * Teste da FIFO da MPU6050 com as leituras bloqueantes: marca de coleta (contaAmostraPronta) e estouro (estourosFIFO)
+ *
+ * A MPU6050 simulada (mpuSimulada.h) atende o I2C do stub; cada amostra leva o seu número de sequência. Casos:
+ * 1. setMotion6Fifo e setInterrupts gravam FIFO_EN, USER_CTRL e INT_ENABLE; readFifoMotion6 respeita o tamanho pedido;
+ * 2. 73 amostras (1022 bytes) ainda não são estouro; 74 ou 80 amostras deixam a contagem em 1024: a coleta retorna -1,
+ *    conta o estouro e zera a FIFO, e as amostras seguintes chegam em ordem;
+ * 3. pulsos de dado pronto a 1 kHz durante 1 s, com a coleta acordada a cada TESTE_MARCA pulsos: 100 coletas, a FIFO
+ *    nunca passa da marca e todas as amostras chegam em ordem;
+ * 4. a Thread de coleta atrasa 80 ms: um estouro contado, e a coleta volta ao normal na marca seguinte.
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+#include "teste.h"
+#include "ImuCarro/imuCarro.h"
+#include "mpuSimulada.h"
+
+#define TESTE_MARCA                 10      // amostras por coleta (IMU_AMOSTRAS_POR_LEITURA no main.cpp)
+#define TESTE_PULSOS                1000    // 1 s a 1 kHz
+#define TESTE_ATRASO                80      // amostras produzidas sem coleta (ms a 1 kHz)
+
+static I2C i2c;
+static MPU6050 mpu (i2c);
+static mpuSimulada modelo;
+static barramentoI2C barramento;
+static clienteI2C cliente;
+static filaIMU fila;
+static desempenhoIMU desempenho;
+static coletorIMU coletor;
+static uint32_t esperada;
+
+// Retira a fila e confere a sequência; retorna as amostras retiradas, ou -1 se alguma estiver fora da sequência
+static int confereFila (void) {
+    MPU6050Motion6 amostra;
+    int retiradas = 0;
+    bool emOrdem = true;
+
+    while (retiraDaFila (&fila, &amostra)) {
+        emOrdem = emOrdem && amostraConfere (&amostra, esperada);
+        esperada++;
+        retiradas++;
+    }
+    return emOrdem ? retiradas : -1;
+}
+
+static void testaConfiguracao (void) {
+    MPU6050Motion6 lidas[40];
+    int i, emOrdem = 0;
+
+    mpu.setMotion6Fifo (true);
+    mpu.setInterrupts (MPU6050_INT_DATA_RDY | MPU6050_INT_FIFO_OFLOW);
+    CONFERE (modelo.registros[MPU6050_FIFO_EN_REG] == MPU6050_FIFO_MOTION6);
+    CONFERE (modelo.registros[MPU6050_USER_CTRL_REG] & (1 << MPU6050_FIFO_EN_BIT));
+    CONFERE (modelo.registros[MPU6050_INT_ENABLE_REG] == (MPU6050_INT_DATA_RDY | MPU6050_INT_FIFO_OFLOW));
+
+    // Pede menos que o que há na FIFO (em mais de uma rajada): o resto fica para a leitura seguinte
+    esperada = modelo.produzidas;
+    produzAmostras (&modelo, 30);
+    CONFERE (mpu.getFifoCount () == 30 * MPU6050_MOTION6_LENGTH);
+    CONFERE (mpu.readFifoMotion6 (lidas, 25) == 25);
+    CONFERE (bytesNaFifo (&modelo) == 5 * MPU6050_MOTION6_LENGTH);
+    CONFERE (mpu.readFifoMotion6 (&lidas[25], 15) == 5);
+    for (i = 0; i < 30; i++) {
+        emOrdem += amostraConfere (&lidas[i], esperada + i);
+    }
+    CONFERE (emOrdem == 30);
+    CONFERE (mpu.readFifoMotion6 (lidas, 15) == 0);
+
+    // Desligada: FIFO_EN zerado nos dois registros
+    mpu.setMotion6Fifo (false);
+    CONFERE (modelo.registros[MPU6050_FIFO_EN_REG] == 0);
+    CONFERE (!(modelo.registros[MPU6050_USER_CTRL_REG] & (1 << MPU6050_FIFO_EN_BIT)));
+    mpu.setMotion6Fifo (true);
+}
+
+static void testaEstouro (void) {
+    MPU6050Motion6 lidas[MPU6050_FIFO_BURST];
+    uint32_t estouros = desempenho.estourosFIFO;
+
+    // Cheia, mas alinhada: 73 amostras, 1022 bytes
+    esperada = modelo.produzidas;
+    produzAmostras (&modelo, MPU6050_FIFO_SIZE / MPU6050_MOTION6_LENGTH);
+    CONFERE (bytesNaFifo (&modelo) == 1022);
+    CONFERE (esvaziaFifoIMU (&coletor) == 73);
+    CONFERE (confereFila () == 73);
+    CONFERE (desempenho.estourosFIFO == estouros);
+
+    // Uma amostra a mais: a contagem para em 1024 e as amostras não estão mais alinhadas
+    produzAmostras (&modelo, 74);
+    CONFERE (bytesNaFifo (&modelo) == MPU6050_FIFO_SIZE);
+    CONFERE (esvaziaFifoIMU (&coletor) == -1);
+    CONFERE (desempenho.estourosFIFO == estouros + 1);
+    CONFERE (bytesNaFifo (&modelo) == 0 && fila.perdidos == 0);
+    CONFERE (confereFila () == 0);
+
+    // Depois de zerada, a FIFO volta a entregar as amostras em ordem
+    esperada = modelo.produzidas;
+    produzAmostras (&modelo, 5);
+    CONFERE (esvaziaFifoIMU (&coletor) == 5);
+    CONFERE (confereFila () == 5);
+
+    // A leitura direta do driver também recusa a FIFO estourada
+    produzAmostras (&modelo, 80);
+    CONFERE (mpu.readFifoMotion6 (lidas, MPU6050_FIFO_BURST) == -1);
+    CONFERE (bytesNaFifo (&modelo) == 0);
+    printf ("estouros: 73 amostras (1022 bytes) lidas; 74 e 80 amostras (1024 bytes) recusadas e a FIFO zerada\n");
+}
+
+// Pulsos de dado pronto a 1 kHz: a cada pulso o sensor produz uma amostra; na marca, a coleta esvazia a FIFO.
+// Com 'atraso' > 0, a coleta que cair no pulso 'inicioDoAtraso' só acontece 'atraso' pulsos depois.
+static void pulsa (int pulsos, int inicioDoAtraso, int atraso, int *coletas, int *maiorFifo, int *foraDeOrdem,
+                   int *recusadas) {
+    volatile uint32_t sinalizadas = 0;
+    int pulso, n, pendente = 0;
+
+    *coletas = *maiorFifo = *foraDeOrdem = *recusadas = 0;
+    for (pulso = 0; pulso < pulsos; pulso++) {
+        produzAmostras (&modelo, 1);
+        if (contaAmostraPronta (&sinalizadas, TESTE_MARCA)) {
+            pendente = 1;
+        }
+        if (pendente && !(atraso > 0 && pulso >= inicioDoAtraso && pulso < inicioDoAtraso + atraso)) {
+            pendente = 0;
+            *maiorFifo = bytesNaFifo (&modelo) > *maiorFifo ? bytesNaFifo (&modelo) : *maiorFifo;
+            n = esvaziaFifoIMU (&coletor);
+            (*coletas)++;
+            if (n < 0) {
+                (*recusadas)++;
+                esperada = modelo.produzidas;
+            }
+            *foraDeOrdem += confereFila () < 0;
+        }
+    }
+}
+
+static void testaMarca (void) {
+    int coletas, maiorFifo, foraDeOrdem, recusadas;
+    uint32_t inicio, estouros = desempenho.estourosFIFO;
+
+    esperada = inicio = modelo.produzidas;
+    pulsa (TESTE_PULSOS, 0, 0, &coletas, &maiorFifo, &foraDeOrdem, &recusadas);
+    printf ("1 kHz com a marca em %d amostras: %d coletas, no maximo %d bytes na FIFO, %lu amostras\n", TESTE_MARCA,
+            coletas, maiorFifo, (unsigned long)(esperada - inicio));
+    CONFERE (coletas == TESTE_PULSOS / TESTE_MARCA);
+    CONFERE (maiorFifo == TESTE_MARCA * MPU6050_MOTION6_LENGTH);
+    CONFERE (esperada - inicio == TESTE_PULSOS && foraDeOrdem == 0 && recusadas == 0);
+    CONFERE (desempenho.estourosFIFO == estouros && fila.perdidos == 0);
+}
+
+static void testaAtraso (void) {
+    int coletas, maiorFifo, foraDeOrdem, recusadas;
+    uint32_t estouros = desempenho.estourosFIFO;
+
+    // A coleta do pulso 309 só acontece no 389: 80 amostras na FIFO, que estoura
+    esperada = modelo.produzidas;
+    pulsa (TESTE_PULSOS, 309, TESTE_ATRASO, &coletas, &maiorFifo, &foraDeOrdem, &recusadas);
+    printf ("coleta atrasada %d ms: %d coletas, %d recusada, %lu estouro\n", TESTE_ATRASO, coletas, recusadas,
+            (unsigned long)(desempenho.estourosFIFO - estouros));
+    CONFERE (recusadas == 1 && desempenho.estourosFIFO == estouros + 1);
+    CONFERE (maiorFifo == MPU6050_FIFO_SIZE);
+    CONFERE (coletas == TESTE_PULSOS / TESTE_MARCA - TESTE_ATRASO / TESTE_MARCA);
+    CONFERE (foraDeOrdem == 0 && fila.perdidos == 0);
+
+    // Sem atraso, volta ao normal
+    esperada = modelo.produzidas;
+    pulsa (TESTE_PULSOS, 0, 0, &coletas, &maiorFifo, &foraDeOrdem, &recusadas);
+    CONFERE (recusadas == 0 && foraDeOrdem == 0 && maiorFifo == TESTE_MARCA * MPU6050_MOTION6_LENGTH);
+    CONFERE (desempenho.estourosFIFO == estouros + 1);
+}
+
+int main (void) {
+    ligaMpuSimulada (&modelo, &i2c);
+    iniciaBarramento (&barramento, &i2c, 400000);
+    cadastraClienteI2C (&barramento, &cliente, "Coleta IMU", 3);
+    iniciaFila (&fila);
+    iniciaColetor (&coletor, &mpu, &barramento, &cliente, &fila, &desempenho);
+
+    testaConfiguracao ();
+    testaEstouro ();
+    testaMarca ();
+    testaAtraso ();
+    i2c.dispositivo = nullptr;
+    return FIM_DO_TESTE ();
+}
@@ -0,0 +1,199 @@
+/**
+ * testeFusaoNMEA.cpp       v0.0        17-10-2026
+ *
+ * Orientador: Elias Teodoro da Silva Junior
+ * Autores: Felipe Moura de Castro e Joao Bruno Costa Cruz,
+ * Instituto Federal de Educação, Ciência e Tecnologia do Ceará (IFCE) - Campus Fortaleza
+ *
+ * @Opensource
+ * Este código-fonte pode ser utilizado, copiado, estudado, modificado e redistribuído sem restrições.
+ *
+ * Copyright (c) 2019, Felipe Moura de Castro e Joao Bruno Costa Cruz.
+ *
+ */
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * Teste e benchmark da fusão NMEA (fundeNMEA) sobre capturas do NEO-6M (talker GP) e de um receptor
+ * multi-constelação (solução GN, GSV de GP e GL)
+ *
+ * 1. Coerência: cada época simulada deve gerar exatamente um fix, e todos os campos do fix devem vir da mesma época
+ *    (tempo, posição, velocidade e curso iguais aos do RMC da época; GGA, GSA e GSV com os valores escritos). A partir
+ *    da segunda época, o fix deve ser entregue na última sentença usada da própria época (o último GSV; o GLL é
+ *    ignorado), sem esperar a próxima.
+ * 2. Custo: cada sentença é medida isoladamente (melhor de TESTE_RODADAS passadas, descontado o custo da medição).
+ *    São informados o tempo médio e o pior caso por tipo de sentença, e o pior caso deve ficar abaixo de
+ *    TESTE_ORCAMENTO_NS.
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+#include "teste.h"
+#include "GPS_Carro/GPS_Carro.h"
+#include "trajetoSimulado.h"
+
+#define TESTE_EPOCAS            600
+#define TESTE_RODADAS           5
+#define TESTE_MAXIMO            (TESTE_EPOCAS * 16)
+#define TESTE_ORCAMENTO_NS      2000.0      // no computador; um fix por segundo tem ~15 sentenças
+
+typedef struct {
+    char texto[TAMANHO_SENTENCA_GPS];
+    int tamanho;
+    int epoca;
+    bool ultimaDaEpoca;
+    uint64_t melhorNs;
+} sentencaCapturada;
+
+typedef struct {
+    int32_t time;
+    int32_t altitude;
+    dataGPS rmc;
+} verdadeDaEpoca;
+
+static sentencaCapturada sentencas[TESTE_MAXIMO];
+static verdadeDaEpoca verdades[TESTE_EPOCAS];
+static int quantidade;
+
+// Escreve as épocas e guarda as sentenças como entregues pelo montador, com a época de cada uma
+static void geraSentencas (int receptor) {
+    static char epoca[4096];
+    trajetoSimulado trajeto;
+    montadorNMEA montador;
+    long centesimos;
+    int e, i, n, ultima;
+
+    quantidade = 0;
+    iniciaTrajeto (&trajeto, 1.5, 12345);
+    iniciaMontador (&montador);
+    for (e = 0; e < TESTE_EPOCAS; e++) {
+        n = escreveEpocaNMEA (&trajeto, receptor, epoca, sizeof (epoca));
+        centesimos = lround (trajeto.tempo * 100.0) + 12L * 360000L;
+        verdades[e].time = (int32_t)(((centesimos / 360000L) % 24) * 10000 + ((centesimos / 6000L) % 60) * 100 +
+                                     (centesimos / 100L) % 60);
+        verdades[e].altitude = (int32_t)lround (trajeto.altitude * 10.0) * 100;
+        ultima = -1;
+        for (i = 0; i < n && quantidade < TESTE_MAXIMO; i++) {
+            if (montaSentenca (&montador, epoca[i])) {
+                memcpy (sentencas[quantidade].texto, montador.sentenca, montador.tamanho);
+                sentencas[quantidade].tamanho = montador.tamanho;
+                sentencas[quantidade].epoca = e;
+                sentencas[quantidade].ultimaDaEpoca = false;
+                sentencas[quantidade].melhorNs = UINT64_MAX;
+                if (strncmp (montador.sentenca + 2, "RMC", 3) == 0) {
+                    memset (&verdades[e].rmc, 0, sizeof (dataGPS));
+                    dataCatch (montador.sentenca, montador.tamanho, &verdades[e].rmc);
+                }
+                // O GLL não é usado pela fusão: a época termina no último GSV
+                if (strncmp (montador.sentenca + 2, "GLL", 3) != 0) {
+                    ultima = quantidade;
+                }
+                quantidade++;
+            }
+        }
+        if (ultima >= 0) {
+            sentencas[ultima].ultimaDaEpoca = true;
+        }
+        avancaTrajeto (&trajeto, 1.0);
+    }
+}
+
+static void confereFix (const dataGPS *fix, int receptor, int epoca) {
+    const dataGPS *rmc = &verdades[epoca].rmc;
+
+    CONFERE (fix->time == verdades[epoca].time);
+    CONFERE (fix->time == rmc->time && fix->millisecond == rmc->millisecond);
+    CONFERE (fix->valid == 'A');
+    CONFERE (fix->latitude == rmc->latitude && fix->longitude == rmc->longitude);
+    CONFERE (fix->speed == rmc->speed && fix->course == rmc->course);
+    CONFERE (strncmp (fix->date, "171026", 6) == 0);
+    CONFERE (fix->altitude == verdades[epoca].altitude);
+    CONFERE (fix->fixQuality == 1 && fix->satellites == 8);
+    CONFERE (fix->fixType == 3 && fix->hdop == 95 && fix->pdop == 172 && fix->vdop == 143);
+    CONFERE (fix->satellitesInView == ((receptor == RECEPTOR_MULTI) ? 11 + 7 : 11));
+}
+
+// Uma passada pela captura; a primeira confere os fixes
+static void passada (int receptor, bool confere, uint64_t custoDaMedicao) {
+    fusaoNMEA fusao;
+    dataGPS fix;
+    char copia[TAMANHO_SENTENCA_GPS];
+    int i, fixes = 0, atrasados = 0, epocaEsperada = 0;
+    uint64_t inicio, ns;
+    int concluida;
+
+    iniciaFusaoNMEA (&fusao);
+    for (i = 0; i < quantidade; i++) {
+        memcpy (copia, sentencas[i].texto, sentencas[i].tamanho);
+        inicio = agoraNs ();
+        concluida = fundeNMEA (&fusao, copia, sentencas[i].tamanho, &fix);
+        ns = agoraNs () - inicio;
+        ns = (ns > custoDaMedicao) ? ns - custoDaMedicao : 0;
+        if (ns < sentencas[i].melhorNs) {
+            sentencas[i].melhorNs = ns;
+        }
+
+        if (confere && concluida) {
+            // A primeira época só termina no RMC seguinte; as demais, na própria última sentença
+            atrasados += !sentencas[i].ultimaDaEpoca;
+            CONFERE (epocaEsperada < TESTE_EPOCAS);
+            if (epocaEsperada < TESTE_EPOCAS) {
+                confereFix (&fix, receptor, epocaEsperada);
+            }
+            epocaEsperada++;
+            fixes++;
+        }
+    }
+    if (confere) {
+        CONFERE (fixes == TESTE_EPOCAS);
+        CONFERE (atrasados == 1);
+    }
+}
+
+static void testaReceptor (const char *nome, int receptor) {
+    static const char *tipos[] = { "RMC", "VTG", "GGA", "GSA", "GSV", "GLL" };
+    uint64_t custoDaMedicao = UINT64_MAX, inicio, soma, pior, total = 0, piorDeTodos = 0;
+    int rodada, i, t, n;
+
+    geraSentencas (receptor);
+
+    // Custo de duas leituras seguidas do relógio
+    for (i = 0; i < 1000; i++) {
+        inicio = agoraNs ();
+        soma = agoraNs () - inicio;
+        if (soma < custoDaMedicao) {
+            custoDaMedicao = soma;
+        }
+    }
+
+    for (rodada = 0; rodada < TESTE_RODADAS; rodada++) {
+        passada (receptor, rodada == 0, custoDaMedicao);
+    }
+
+    printf ("%s: %d sentencas em %d epocas\n", nome, quantidade, TESTE_EPOCAS);
+    for (t = 0; t < (int)(sizeof (tipos) / sizeof (tipos[0])); t++) {
+        soma = 0;
+        pior = 0;
+        n = 0;
+        for (i = 0; i < quantidade; i++) {
+            if (strncmp (sentencas[i].texto + 2, tipos[t], 3) == 0) {
+                soma += sentencas[i].melhorNs;
+                pior = (sentencas[i].melhorNs > pior) ? sentencas[i].melhorNs : pior;
+                n++;
+            }
+        }
+        if (n > 0) {
+            printf ("  %s: %5d sentencas, %6.1f ns em media, pior caso %5lu ns\n", tipos[t], n, (double)soma / n,
+                    (unsigned long)pior);
+        }
+        total += soma;
+        piorDeTodos = (pior > piorDeTodos) ? pior : piorDeTodos;
+    }
+    printf ("  todas: %6.1f ns/sentenca em media, pior caso %lu ns (orcamento %.0f ns)\n",
+            (double)total / quantidade, (unsigned long)piorDeTodos, TESTE_ORCAMENTO_NS);
+    CONFERE (piorDeTodos < TESTE_ORCAMENTO_NS);
+}
+
+int main (void) {
+    testaReceptor ("NEO-6M (GP)", RECEPTOR_GPS);
+    testaReceptor ("multi-constelacao (GN/GP/GL)", RECEPTOR_MULTI);
+    return FIM_DO_TESTE ();
+}
@@ -0,0 +1,146 @@
+/**
+ * testeMontador.cpp       v0.0        17-10-2026
+ *
+ * Orientador: Elias Teodoro da Silva Junior
+ * Autores: Felipe Moura de Castro e Joao Bruno Costa Cruz,
+ * Instituto Federal de Educação, Ciência e Tecnologia do Ceará (IFCE) - Campus Fortaleza
+ *
+ * @Opensource
+ * Este código-fonte pode ser utilizado, copiado, estudado, modificado e redistribuído sem restrições.
+ *
+ * Copyright (c) 2019, Felipe Moura de Castro e Joao Bruno Costa Cruz.
+ *
+ */
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * Teste do montador de sentenças NMEA (montaSentenca) e dos seus contadores
+ *
+ * As sentenças de referência são os exemplos clássicos de RMC e GGA, com a soma de verificação publicada. Casos:
+ * 1. sentença correta (com os dígitos da soma em maiúsculas ou minúsculas): aceita no último dígito, sem o '$';
+ * 2. cada byte do corpo trocado, soma errada ou dígito que não é hexadecimal: rejeitada;
+ * 3. novo '$' no meio, fim de linha sem '*' ou sentença maior que o buffer: truncada, e a sentença seguinte é aceita;
+ * 4. bytes fora de uma sentença (ruído entre as linhas) não mudam nenhum contador.
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+#include "teste.h"
+#include "GPS_Carro/GPS_Carro.h"
+#include <string.h>
+
+static const char rmc[] = "$GPRMC,123519,A,4807.038,N,01131.000,E,022.4,084.4,230394,003.1,W*6A\r\n";
+static const char gga[] = "$GPGGA,123519,4807.038,N,01131.000,E,1,08,0.9,545.4,M,46.9,M,,*47\r\n";
+
+// Entrega 'texto' byte a byte; retorna quantas sentenças foram aceitas e guarda o índice do byte da última
+static int entrega (montadorNMEA *montador, const char *texto, int tamanho, int *ultimoByte) {
+    int i, aceitas = 0;
+
+    for (i = 0; i < tamanho; i++) {
+        if (montaSentenca (montador, texto[i])) {
+            aceitas++;
+            if (ultimoByte != NULL) {
+                *ultimoByte = i;
+            }
+        }
+    }
+    return aceitas;
+}
+
+static int entregaTexto (montadorNMEA *montador, const char *texto) {
+    return entrega (montador, texto, (int)strlen (texto), NULL);
+}
+
+static bool contadores (const montadorNMEA *montador, uint32_t aceitas, uint32_t rejeitadas, uint32_t truncadas) {
+    return montador->estatisticas.aceitas == aceitas && montador->estatisticas.rejeitadas == rejeitadas &&
+           montador->estatisticas.truncadas == truncadas;
+}
+
+static void testaAceitas (montadorNMEA *montador) {
+    char copia[sizeof (rmc)];
+    int ultimo = -1;
+
+    iniciaMontador (montador);
+    CONFERE (entrega (montador, rmc, (int)strlen (rmc), &ultimo) == 1);
+    CONFERE (ultimo == (int)strlen (rmc) - 3);
+    CONFERE (strcmp (montador->sentenca, "GPRMC,123519,A,4807.038,N,01131.000,E,022.4,084.4,230394,003.1,W*6A") == 0);
+    CONFERE (montador->tamanho == (int)strlen (rmc) - 3);
+    CONFERE (entregaTexto (montador, gga) == 1);
+    CONFERE (strncmp (montador->sentenca, "GPGGA,", 6) == 0);
+
+    // Dígitos da soma em minúsculas
+    strcpy (copia, rmc);
+    copia[strlen (copia) - 3] = 'a';
+    CONFERE (entregaTexto (montador, copia) == 1);
+    CONFERE (contadores (montador, 3, 0, 0));
+}
+
+static void testaRejeitadas (montadorNMEA *montador) {
+    char copia[sizeof (rmc)];
+    int i, corpo = (int)(strchr (rmc, '*') - rmc) - 1, aceitas = 0;
+
+    iniciaMontador (montador);
+    // Qualquer byte do corpo trocado muda o XOR
+    for (i = 1; i <= corpo; i++) {
+        strcpy (copia, rmc);
+        copia[i] = (copia[i] == '0') ? '1' : '0';
+        aceitas += entregaTexto (montador, copia);
+    }
+    printf ("RMC com um byte do corpo trocado: %d de %d aceitas\n", aceitas, corpo);
+    CONFERE (aceitas == 0);
+    CONFERE (contadores (montador, 0, (uint32_t)corpo, 0));
+
+    // Soma errada, dígito que não é hexadecimal no primeiro ou no segundo lugar
+    CONFERE (entregaTexto (montador, "$GPGGA,123519,4807.038,N,01131.000,E,1,08,0.9,545.4,M,46.9,M,,*48\r\n") == 0);
+    CONFERE (entregaTexto (montador, "$GPGGA,123519,4807.038,N,01131.000,E,1,08,0.9,545.4,M,46.9,M,,*G7\r\n") == 0);
+    CONFERE (entregaTexto (montador, "$GPGGA,123519,4807.038,N,01131.000,E,1,08,0.9,545.4,M,46.9,M,,*4\r\n") == 0);
+    CONFERE (contadores (montador, 0, (uint32_t)corpo + 3, 0));
+
+    // O montador continua funcionando
+    CONFERE (entregaTexto (montador, gga) == 1);
+    CONFERE (contadores (montador, 1, (uint32_t)corpo + 3, 0));
+}
+
+static void testaTruncadas (montadorNMEA *montador) {
+    char longa[3 * TAMANHO_SENTENCA_GPS];
+
+    iniciaMontador (montador);
+    // Bytes perdidos: a sentença é interrompida por um novo '$' no corpo e depois no meio da soma
+    CONFERE (entregaTexto (montador, "$GPRMC,123519,A,4807.0") == 0);
+    CONFERE (entregaTexto (montador, "$GPGGA,123519,4807.038,N,01131.000,E,1,08,0.9,545.4,M,46.9,M,,*4") == 0);
+    CONFERE (entregaTexto (montador, rmc) == 1);
+    CONFERE (contadores (montador, 1, 0, 2));
+
+    // Fim de linha sem soma de verificação
+    CONFERE (entregaTexto (montador, "$GPGSA,A,3,04,05,,09,12,,,24,,,,,2.5,1.3,2.1\r\n") == 0);
+    CONFERE (contadores (montador, 1, 0, 3));
+
+    // Maior que o buffer (bytes de outra sentença emendados sem '$')
+    memset (longa, 'A', sizeof (longa));
+    longa[0] = '$';
+    longa[sizeof (longa) - 1] = '\0';
+    CONFERE (entregaTexto (montador, longa) == 0);
+    CONFERE (contadores (montador, 1, 0, 4));
+    CONFERE (entregaTexto (montador, gga) == 1);
+    CONFERE (contadores (montador, 2, 0, 4));
+}
+
+static void testaRuido (montadorNMEA *montador) {
+    static const char ruido[] = "\r\n\xff\x00garbage*12\r\n,,,";
+
+    iniciaMontador (montador);
+    CONFERE (entrega (montador, ruido, sizeof (ruido) - 1, NULL) == 0);
+    CONFERE (contadores (montador, 0, 0, 0));
+    CONFERE (entregaTexto (montador, rmc) == 1);
+    CONFERE (entrega (montador, ruido, sizeof (ruido) - 1, NULL) == 0);
+    CONFERE (entregaTexto (montador, gga) == 1);
+    CONFERE (contadores (montador, 2, 0, 0));
+}
+
+int main (void) {
+    montadorNMEA montador;
+
+    testaAceitas (&montador);
+    testaRejeitadas (&montador);
+    testaTruncadas (&montador);
+    testaRuido (&montador);
+    return FIM_DO_TESTE ();
+}
@@ -0,0 +1,167 @@
+/**
+ * testeMotion6.cpp       v0.0        17-10-2026
+ *
+ * Orientador: Elias Teodoro da Silva Junior
+ * Autores: Felipe Moura de Castro e Joao Bruno Costa Cruz,
+ * Instituto Federal de Educação, Ciência e Tecnologia do Ceará (IFCE) - Campus Fortaleza
+ *
+ * @Opensource
+ * Este código-fonte pode ser utilizado, copiado, estudado, modificado e redistribuído sem restrições.
+ *
+ * Copyright (c) 2019, Felipe Moura de Castro e Joao Bruno Costa Cruz.
+ *
+ */
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * Teste da leitura em uma transação da MPU6050 (getMotion6Raw) e da conversão (convertMotion6)
+ *
+ * Uma MPU6050 simulada (128 registros) atende o I2C do stub. Os registros de ACCEL_XOUT_H a GYRO_ZOUT_L recebem valores
+ * big endian escolhidos para pegar erros de ordem e de sinal: byte baixo com o bit 7 ligado, -1, -32768 e 32767.
+ * 1. getMotion6Raw devolve os sete valores com uma escrita e uma leitura no I2C, iguais aos de decodeMotion6 e aos das
+ *    leituras separadas (getAcceleroRaw, getGyroRaw, getTempRaw);
+ * 2. em cada uma das quatro escalas do acelerômetro e do giroscópio, convertMotion6 dá o mesmo que getAccelero e
+ *    getGyro, e o fundo de escala nominal (2 g = 16384 LSB, 250 °/s = 131 LSB por °/s); setAcceleroRange e setGyroRange
+ *    só mudam os bits 4:3 do registro de configuração;
+ * 3. temperatura: -521 LSB são 35 °C (datasheet), e os ponteiros NULL são aceitos.
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+#include "teste.h"
+#include "MPU6050.h"
+#include <math.h>
+
+#define TESTE_GRAUS_POR_RADIANO     57.29578f
+
+static uint8_t registros[128];
+
+static uint8_t atende (uint8_t registro, uint8_t *valor, bool escrita) {
+    registro &= 0x7F;
+    if (escrita) {
+        registros[registro] = *valor;
+    } else {
+        *valor = registros[registro];
+    }
+    return (registro + 1) & 0x7F;
+}
+
+// Grava os valores big endian a partir de ACCEL_XOUT_H, na ordem dos registros
+static void gravaMotion6 (const MPU6050Motion6 *amostra, char *bytes) {
+    int16_t campos[7];
+    int i;
+
+    memcpy (campos, amostra->accelero, sizeof (amostra->accelero));
+    campos[3] = amostra->temp;
+    memcpy (&campos[4], amostra->gyro, sizeof (amostra->gyro));
+    for (i = 0; i < 7; i++) {
+        bytes[2 * i] = (char)((uint16_t)campos[i] >> 8);
+        bytes[2 * i + 1] = (char)campos[i];
+        registros[MPU6050_ACCEL_XOUT_H_REG + 2 * i] = (uint8_t)bytes[2 * i];
+        registros[MPU6050_ACCEL_XOUT_H_REG + 2 * i + 1] = (uint8_t)bytes[2 * i + 1];
+    }
+}
+
+static bool igual (float a, float b) {
+    return fabsf (a - b) <= 1e-5f * fmaxf (1.0f, fabsf (b));
+}
+
+static void testaLeitura (I2C *i2c, MPU6050 *mpu, const MPU6050Motion6 *referencia) {
+    MPU6050Motion6 lida, decodificada;
+    char bytes[MPU6050_MOTION6_LENGTH];
+    int separados[3], i;
+    uint32_t transacoes;
+
+    gravaMotion6 (referencia, bytes);
+    transacoes = i2c->transacoes;
+    mpu->getMotion6Raw (&lida);
+    CONFERE (i2c->transacoes - transacoes == 2);
+    CONFERE (memcmp (&lida, referencia, sizeof (lida)) == 0);
+    MPU6050::decodeMotion6 (bytes, &decodificada);
+    CONFERE (memcmp (&decodificada, referencia, sizeof (decodificada)) == 0);
+
+    mpu->getAcceleroRaw (separados);
+    for (i = 0; i < 3; i++) {
+        CONFERE (separados[i] == lida.accelero[i]);
+    }
+    mpu->getGyroRaw (separados);
+    for (i = 0; i < 3; i++) {
+        CONFERE (separados[i] == lida.gyro[i]);
+    }
+    CONFERE (mpu->getTempRaw () == lida.temp);
+    CONFERE (mpu->getAcceleroRawX () == lida.accelero[0] && mpu->getGyroRawY () == lida.gyro[1]);
+}
+
+static void testaEscalas (MPU6050 *mpu, const MPU6050Motion6 *referencia) {
+    static const float acceleroLSB[4] = { 16384.0f, 8192.0f, 4096.0f, 2048.0f };
+    static const float gyroLSB[4] = { 131.0f, 65.5f, 32.8f, 16.4f };    // LSB por °/s (datasheet)
+    MPU6050Motion6 fundo;
+    char bytes[MPU6050_MOTION6_LENGTH];
+    float acce[3], gyro[3], separados[3], temp;
+    int escala, i;
+
+    for (escala = 0; escala < 4; escala++) {
+        // Bits de autoteste (7:5) e os de baixo devem ser preservados
+        registros[MPU6050_ACCELERO_CONFIG_REG] = 0xE7;
+        registros[MPU6050_GYRO_CONFIG_REG] = 0xE7;
+        mpu->setAcceleroRange ((char)escala);
+        mpu->setGyroRange ((char)escala);
+        CONFERE (registros[MPU6050_ACCELERO_CONFIG_REG] == (0xE7 | (escala << 3)));
+        CONFERE (registros[MPU6050_GYRO_CONFIG_REG] == (0xE7 | (escala << 3)));
+
+        gravaMotion6 (referencia, bytes);
+        mpu->convertMotion6 (referencia, acce, gyro, &temp);
+        mpu->getAccelero (separados);
+        for (i = 0; i < 3; i++) {
+            CONFERE (igual (acce[i], separados[i]));
+            CONFERE (igual (acce[i], referencia->accelero[i] * 9.81f / acceleroLSB[escala]));
+        }
+        mpu->getGyro (separados);
+        for (i = 0; i < 3; i++) {
+            CONFERE (igual (gyro[i], separados[i]));
+        }
+
+        // Fundo de escala: 1 g em cada eixo do acelerômetro e 1 °/s em cada eixo do giroscópio
+        for (i = 0; i < 3; i++) {
+            fundo.accelero[i] = (int16_t)acceleroLSB[escala];
+            fundo.gyro[i] = (int16_t)(gyroLSB[escala] * 10.0f);
+        }
+        fundo.temp = 0;
+        mpu->convertMotion6 (&fundo, acce, gyro, NULL);
+        for (i = 0; i < 3; i++) {
+            CONFERE (igual (acce[i], 9.81f));
+            CONFERE (fabsf (gyro[i] * TESTE_GRAUS_POR_RADIANO - 10.0f) < 0.01f);
+        }
+        printf ("escala %d: %5.0f LSB/g, %4.1f LSB por grau/s -> %.4f m/s2, %.4f grau/s\n", escala,
+                acceleroLSB[escala], gyroLSB[escala], acce[0], gyro[0] * TESTE_GRAUS_POR_RADIANO / 10.0f);
+    }
+}
+
+static void testaTemperatura (MPU6050 *mpu) {
+    MPU6050Motion6 amostra;
+    float acce[3] = { 1.0f, 2.0f, 3.0f }, temp = 0.0f;
+
+    memset (&amostra, 0, sizeof (amostra));
+    amostra.temp = -521;
+    mpu->convertMotion6 (&amostra, NULL, NULL, &temp);
+    CONFERE (igual (temp, 35.0f));
+    amostra.temp = 3400 - 521;
+    mpu->convertMotion6 (&amostra, NULL, NULL, &temp);
+    CONFERE (igual (temp, 45.0f));
+
+    // Só o que foi pedido é escrito
+    mpu->convertMotion6 (&amostra, NULL, NULL, NULL);
+    CONFERE (acce[0] == 1.0f && acce[1] == 2.0f && acce[2] == 3.0f);
+}
+
+int main (void) {
+    static I2C i2c;
+    MPU6050Motion6 referencia = { { 0x1234, -2, -32768 }, -1000, { 0x00FF, -129, 32767 } };
+
+    i2c.dispositivo = atende;
+    MPU6050 mpu (i2c);
+
+    testaLeitura (&i2c, &mpu, &referencia);
+    testaEscalas (&mpu, &referencia);
+    testaTemperatura (&mpu);
+    i2c.dispositivo = nullptr;
+    return FIM_DO_TESTE ();
+}
@@ -0,0 +1,155 @@
+/**
+ * testeOdometro.cpp       v0.0        17-10-2026
+ *
+ * Orientador: Elias Teodoro da Silva Junior
+ * Autores: Felipe Moura de Castro e Joao Bruno Costa Cruz,
+ * Instituto Federal de Educação, Ciência e Tecnologia do Ceará (IFCE) - Campus Fortaleza
+ *
+ * @Opensource
+ * Este código-fonte pode ser utilizado, copiado, estudado, modificado e redistribuído sem restrições.
+ *
+ * Copyright (c) 2019, Felipe Moura de Castro e Joao Bruno Costa Cruz.
+ *
+ */
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * Teste do odômetro e da divisão em viagens (atualizaOdometro)
+ *
+ * Um carro simulado anda para o Norte com um fix por segundo; a distância verdadeira de cada trecho é conhecida. O dia:
+ * 1. estacionado com o GPS oscilando: nada é somado e nenhuma viagem começa;
+ * 2. uma manobra de 3 s: a distância entra no total, mas não há viagem;
+ * 3. viagem 1: 2 min a 54 km/h, 30 s no semáforo com o motor ligado, 1 min a 36 km/h e o motor desligado por 1 min;
+ * 4. viagem 2: 1 min a 54 km/h e a garagem coberta (sem fix) com o motor desligado;
+ * 5. viagem 3: 1 min a 54 km/h e 15 min parado com o motor ligado.
+ * Confere o total (e a leitura por leDistanciaOdometro), o número, a duração, a distância, a marcha lenta, a velocidade
+ * máxima e os pontos de cada resumo.
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+#include "teste.h"
+#include "OdometroCarro/odometroCarro.h"
+#include <string.h>
+
+#define TESTE_METROS_POR_UNIDADE    0.011119508     // metros por 10^-7 graus de latitude
+#define TESTE_TOLERANCIA            0.002           // erro relativo aceito na distância
+#define TESTE_MAXIMO_VIAGENS        4
+
+typedef struct {
+    odometroCarro odometro;
+    dataGPS fix;
+    uint64_t contadorMs;
+    double verdadeiraM;
+    resumoViagem resumos[TESTE_MAXIMO_VIAGENS];
+    int viagens;
+} diaSimulado;
+
+static void iniciaDia (diaSimulado *dia) {
+    memset (dia, 0, sizeof (diaSimulado));
+    iniciaOdometro (&dia->odometro);
+    dia->fix.latitude = -37436000;
+    dia->fix.longitude = -385336000;
+    memcpy (dia->fix.date, "171026", 6);
+    dia->fix.time = 80000;
+    dia->contadorMs = 1000;
+}
+
+// Avanço de um fix para o Norte (10^-7 graus) a 'velocidade' mm/s
+static int32_t passoDe (int32_t velocidade) {
+    return (int32_t)(velocidade / 1000.0 / TESTE_METROS_POR_UNIDADE + 0.5);
+}
+
+// Avança 'segundos' fixes a 'velocidade' mm/s para o Norte; oscilacao > 0 faz a posição parada oscilar (10^-7 graus)
+static void percorre (diaSimulado *dia, int segundos, int32_t velocidade, bool motor, bool valido, int oscilacao) {
+    int32_t passo = passoDe (velocidade);
+    int i;
+
+    for (i = 0; i < segundos; i++) {
+        dia->fix.latitude += passo + (i % 2 ? oscilacao : -oscilacao);
+        dia->fix.speed = velocidade;
+        dia->fix.valid = valido ? 'A' : 'V';
+        dia->fix.time += (dia->fix.time % 100 == 59) ? (dia->fix.time % 10000 == 5959 ? 4041 : 41) : 1;
+        dia->contadorMs += 1000;
+        if (velocidade >= ODOMETRO_VELOCIDADE_PARADO) {
+            dia->verdadeiraM += passo * TESTE_METROS_POR_UNIDADE;
+        }
+        if (atualizaOdometro (&dia->odometro, &dia->fix, motor, dia->contadorMs,
+                              &dia->resumos[dia->viagens % TESTE_MAXIMO_VIAGENS])) {
+            dia->viagens++;
+        }
+    }
+}
+
+static bool perto (double medida, double verdadeira) {
+    return medida > verdadeira * (1.0 - TESTE_TOLERANCIA) && medida < verdadeira * (1.0 + TESTE_TOLERANCIA);
+}
+
+int main (void) {
+    static diaSimulado dia;
+    resumoViagem *resumo;
+    double manobraM, viagemM;
+    int32_t latitudeDaPartida, latitudeDaParada;
+
+    iniciaDia (&dia);
+
+    // 1. Estacionado: o GPS "passeia" ~5 m, parado, com o motor desligado
+    percorre (&dia, 60, 0, false, true, 450);
+    CONFERE (leDistanciaOdometro (&dia.odometro) == 0);
+    CONFERE (!dia.odometro.emViagem && dia.viagens == 0);
+
+    // 2. Manobra de 3 s: é distância percorrida, mas não é uma viagem
+    percorre (&dia, 3, 3000, true, true, 0);
+    percorre (&dia, 120, 0, false, true, 0);
+    manobraM = dia.verdadeiraM;
+    CONFERE (perto (leDistanciaOdometro (&dia.odometro) / 1000.0, manobraM));
+    CONFERE (!dia.odometro.emViagem && dia.viagens == 0);
+
+    // 3. Viagem 1, com uma parada no semáforo que não a encerra
+    latitudeDaPartida = dia.fix.latitude;
+    percorre (&dia, 4, 15000, true, true, 0);
+    CONFERE (!dia.odometro.emViagem);
+    percorre (&dia, 116, 15000, true, true, 0);
+    CONFERE (dia.odometro.emViagem && dia.odometro.viagem.numero == 1);
+    percorre (&dia, 30, 0, true, true, 0);
+    percorre (&dia, 60, 10000, true, true, 0);
+    latitudeDaParada = dia.fix.latitude;
+    percorre (&dia, 60, 0, false, true, 0);
+    CONFERE (dia.viagens == 0);
+    percorre (&dia, 1, 0, false, true, 0);
+    CONFERE (dia.viagens == 1 && !dia.odometro.emViagem);
+
+    resumo = &dia.resumos[0];
+    viagemM = dia.verdadeiraM - manobraM;
+    printf ("viagem %lu: %lu ms, %lu mm (verdadeira %.0f mm), %lu ms em marcha lenta, maxima %lu mm/s\n",
+            (unsigned long)resumo->numero, (unsigned long)resumo->duracaoMs, (unsigned long)resumo->distanciaMm,
+            viagemM * 1000.0, (unsigned long)resumo->tempoParadoMs, (unsigned long)resumo->velocidadeMaxima);
+    CONFERE (resumo->numero == 1);
+    CONFERE (resumo->duracaoMs == (uint32_t)(120 + 30 + 60) * 1000);
+    CONFERE (perto (resumo->distanciaMm / 1000.0, viagemM));
+    CONFERE (resumo->tempoParadoMs == 29000);
+    CONFERE (resumo->velocidadeMaxima == 15000);
+    CONFERE (resumo->inicio == (uint64_t)DateTime (2026, 10, 17, 8, 3, 4).unixtime () * 1000);
+    CONFERE (resumo->latitudeInicial == latitudeDaPartida + passoDe (15000));
+    CONFERE (resumo->latitudeFinal == latitudeDaParada && resumo->longitudeFinal == dia.fix.longitude);
+
+    // 4. Viagem 2: termina na garagem coberta, sem fix, com o motor desligado
+    percorre (&dia, 60, 15000, true, true, 0);
+    CONFERE (dia.odometro.emViagem && dia.odometro.viagem.numero == 2);
+    percorre (&dia, 61, 0, false, false, 0);
+    CONFERE (dia.viagens == 2);
+    CONFERE (dia.resumos[1].numero == 2 && dia.resumos[1].duracaoMs == 60000);
+    CONFERE (perto (dia.resumos[1].distanciaMm / 1000.0, 60 * 15.0));
+
+    // 5. Viagem 3: termina depois de 15 minutos parado, mesmo com o motor ligado
+    percorre (&dia, 60, 15000, true, true, 0);
+    percorre (&dia, ODOMETRO_LIMITE_PARADO_MS / 1000, 0, true, true, 0);
+    CONFERE (dia.viagens == 2);
+    percorre (&dia, 1, 0, true, true, 0);
+    CONFERE (dia.viagens == 3 && dia.resumos[2].numero == 3);
+    CONFERE (dia.resumos[2].tempoParadoMs == 0);
+
+    printf ("total: %llu mm (verdadeira %.0f mm) em %d viagens\n",
+            (unsigned long long)leDistanciaOdometro (&dia.odometro), dia.verdadeiraM * 1000.0, dia.viagens);
+    CONFERE (leDistanciaOdometro (&dia.odometro) == dia.odometro.distanciaTotalMm);
+    CONFERE (perto (leDistanciaOdometro (&dia.odometro) / 1000.0, dia.verdadeiraM));
+    return FIM_DO_TESTE ();
+}
@@ -0,0 +1,145 @@
+/**
+ * testePartida.cpp       v0.0        17-10-2026
+ *
+ * Orientador: Elias Teodoro da Silva Junior
+ * Autores: Felipe Moura de Castro e Joao Bruno Costa Cruz,
+ * Instituto Federal de Educação, Ciência e Tecnologia do Ceará (IFCE) - Campus Fortaleza
+ *
+ * @Opensource
+ * Este código-fonte pode ser utilizado, copiado, estudado, modificado e redistribuído sem restrições.
+ *
+ * Copyright (c) 2019, Felipe Moura de Castro e Joao Bruno Costa Cruz.
+ *
+ */
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * Teste da partida rápida: registro do último fix na memória do DS1307 e quadro UBX-AID-INI
+ *
+ * 1. salvaPartida grava marca, registro e CRC-8 nos bytes 0 a 17 da memória do DS1307 (registros 8 a 25 do I2C do
+ *    stub); um novo RtcDs1307 no mesmo I2C (a próxima partida) lê o mesmo fix com carregaPartida.
+ * 2. Qualquer bit trocado (na marca, no registro ou no CRC) faz carregaPartida recusar o registro; fixes inválidos e
+ *    falhas do barramento não são gravados.
+ * 3. enviaPartidaUBX escreve byte a byte o quadro AID-INI esperado, montado à parte a partir da descrição do protocolo
+ *    u-blox (payload de 48 bytes: lat/lon em 10^-7 graus, altitude em cm, data AAMM, DDHHMMSS, flags pos|time|lla|utc).
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+#include "teste.h"
+#include "TempoCarro/tempoCarro.h"
+#include <string.h>
+
+#define TESTE_REGISTRO_RAM      8       // primeiro registro da memória do DS1307
+#define TESTE_TAMANHO_PARTIDA   18      // marca, 16 bytes do registro e soma
+
+// AID-INI de -3,7436 / -38,5336, 21,3 m, 17/10/2026 12:34:56 UTC, 1 km e 2 s de incerteza
+static const uint8_t aidIniEsperado[] = {
+    0xB5, 0x62, 0x0B, 0x01, 0x30, 0x00, 0xA0, 0xC5, 0xC4, 0xFD, 0x40, 0x3D, 0x08, 0xE9,
+    0x52, 0x08, 0x00, 0x00, 0xA0, 0x86, 0x01, 0x00, 0x00, 0x00, 0x32, 0x0A, 0x80, 0x48,
+    0x05, 0x01, 0x00, 0x00, 0x00, 0x00, 0xD0, 0x07, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x23, 0x04, 0x00, 0x00, 0x59, 0x15,
+};
+
+static void preencheFix (dataGPS *fix) {
+    memset (fix, 0, sizeof (dataGPS));
+    fix->latitude = -37436000;
+    fix->longitude = -385336000;
+    fix->altitude = 21300;
+    fix->valid = 'A';
+    memcpy (fix->date, "171026", 6);
+    fix->time = 123456;
+}
+
+// Nova partida: o RtcDs1307 lê a memória do DS1307 na construção
+static int carregaNaPartida (I2C *i2c, partidaGPS *partida) {
+    RtcDs1307 rtc (*i2c);
+    return carregaPartida (&rtc, partida);
+}
+
+static void testaRegistro (I2C *i2c, partidaGPS *partida) {
+    RtcDs1307 rtc (*i2c);
+    uint8_t copia[TESTE_TAMANHO_PARTIDA];
+    dataGPS fix;
+    int i, aceitos = 0;
+
+    // Memória vazia: sem marca
+    CONFERE (carregaNaPartida (i2c, partida) == 0);
+
+    preencheFix (&fix);
+    CONFERE (salvaPartida (&rtc, &fix) == 1);
+    CONFERE (i2c->registros[TESTE_REGISTRO_RAM] == PARTIDA_MARCA);
+    memcpy (copia, &i2c->registros[TESTE_REGISTRO_RAM], sizeof (copia));
+
+    memset (partida, 0, sizeof (partidaGPS));
+    CONFERE (carregaNaPartida (i2c, partida) == 1);
+    CONFERE (partida->latitude == fix.latitude && partida->longitude == fix.longitude);
+    CONFERE (partida->altitude == fix.altitude);
+    CONFERE (partida->tempoDoFix == DateTime (2026, 10, 17, 12, 34, 56).unixtime ());
+
+    // Cada um dos 144 bits trocado isoladamente é recusado
+    for (i = 0; i < TESTE_TAMANHO_PARTIDA * 8; i++) {
+        i2c->registros[TESTE_REGISTRO_RAM + i / 8] ^= (uint8_t)(1 << (i % 8));
+        aceitos += carregaNaPartida (i2c, partida);
+        i2c->registros[TESTE_REGISTRO_RAM + i / 8] ^= (uint8_t)(1 << (i % 8));
+    }
+    printf ("registro com um bit trocado: %d de %d aceitos\n", aceitos, TESTE_TAMANHO_PARTIDA * 8);
+    CONFERE (aceitos == 0);
+    CONFERE (carregaNaPartida (i2c, partida) == 1);
+
+    // Fix inválido, sem data ou com o barramento em falha: nada é gravado
+    fix.valid = 'V';
+    CONFERE (salvaPartida (&rtc, &fix) == 0);
+    preencheFix (&fix);
+    fix.date[0] = '\0';
+    CONFERE (salvaPartida (&rtc, &fix) == 0);
+    preencheFix (&fix);
+    fix.latitude = 0;
+    i2c->falha = true;
+    CONFERE (salvaPartida (&rtc, &fix) == 0);
+    i2c->falha = false;
+    CONFERE (memcmp (copia, &i2c->registros[TESTE_REGISTRO_RAM], sizeof (copia)) == 0);
+}
+
+static void testaAidIni (const partidaGPS *partida) {
+    RawSerial serial;
+    dataGPS referencia;
+    decodificadorUBX decodificador;
+    unsigned int i;
+    int quadros = 0;
+
+    // Referência montada como em prepararPartidaRapida: posição do registro e data/hora do tempo do fix
+    memset (&referencia, 0, sizeof (referencia));
+    referencia.latitude = partida->latitude;
+    referencia.longitude = partida->longitude;
+    referencia.altitude = partida->altitude;
+    dataHoraDoTempo ((uint64_t)partida->tempoDoFix * 1000, &referencia);
+    enviaPartidaUBX (&serial, &referencia, 100000, 2000);
+    CONFERE (serial.enviados == sizeof (aidIniEsperado));
+    CONFERE (memcmp (serial.saida, aidIniEsperado, sizeof (aidIniEsperado)) == 0);
+
+    // Só a posição: flags pos|lla e nenhum campo de tempo
+    referencia.date[0] = '\0';
+    serial.enviados = 0;
+    enviaPartidaUBX (&serial, &referencia, 100000, 2000);
+    iniciaDecodificadorUBX (&decodificador);
+    for (i = 0; i < serial.enviados; i++) {
+        quadros += decodificaUBX (&decodificador, serial.saida[i]) > 0;
+    }
+    CONFERE (quadros == 1 && decodificador.classe == UBX_CLASSE_AID && decodificador.tamanho == 48);
+    CONFERE (decodificador.payload[44] == 0x21 && decodificador.payload[45] == 0x00);
+    CONFERE (decodificador.payload[18] == 0 && decodificador.payload[20] == 0 && decodificador.payload[28] == 0);
+
+    // Sem posição nem data: nada é enviado
+    referencia.latitude = referencia.longitude = 0;
+    serial.enviados = 0;
+    enviaPartidaUBX (&serial, &referencia, 100000, 2000);
+    CONFERE (serial.enviados == 0);
+}
+
+int main (void) {
+    static I2C i2c;
+    partidaGPS partida;
+
+    testaRegistro (&i2c, &partida);
+    testaAidIni (&partida);
+    return FIM_DO_TESTE ();
+}
@@ -0,0 +1,205 @@
+/**
+ * testePavimento.cpp       v0.0        17-10-2026
+ *
+ * Orientador: Elias Teodoro da Silva Junior
+ * Autores: Felipe Moura de Castro e Joao Bruno Costa Cruz,
+ * Instituto Federal de Educação, Ciência e Tecnologia do Ceará (IFCE) - Campus Fortaleza
+ *
+ * @Opensource
+ * Este código-fonte pode ser utilizado, copiado, estudado, modificado e redistribuído sem restrições.
+ *
+ * Copyright (c) 2019, Felipe Moura de Castro e Joao Bruno Costa Cruz.
+ *
+ */
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * Teste do estimador de irregularidade: a cascata de biquads (filtraBiquad) e o RMS por trecho (processaPavimento)
+ *
+ * O filtro do estimador (passa-altas de 1 Hz e passa-baixas de 25 Hz, Butterworth de 2ª ordem, a 1 kHz) recebe
+ * senoides sintéticas. A referência é a resposta do Butterworth pela transformação bilinear, calculada em double à
+ * parte: |H| = 1 / sqrt (1 + (t / tc)^4) no passa-baixas e (t / tc)^2 / sqrt (1 + (t / tc)^4) no passa-altas, com
+ * t = tan (pi f / fs) e tc = tan (pi fc / fs). Casos:
+ * 1. o ganho de 0,2 a 200 Hz (medido pelo RMS em períodos inteiros, depois do transiente) confere com a referência
+ *    a 1%, e é 0,707 (-3 dB) nos dois cortes;
+ * 2. a saída não depende do tamanho do bloco (1, 7 ou 32 amostras, ou no mesmo vetor) e, com preparaBiquad, a
+ *    gravidade constante não produz transiente;
+ * 3. 9,81 m/s² + 1 m/s² a 10 Hz a 54 km/h: um trecho a cada 10 m, com o RMS e o pico de 1 m/s² filtrado, a velocidade
+ *    e a posição do fim do trecho; a 100 Hz (vibração do motor) o RMS cai ao ganho do passa-baixas; abaixo de
+ *    10 km/h as amostras não entram no RMS e os trechos sem amostras não são entregues.
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+#include "teste.h"
+#include "PavimentoCarro/pavimentoCarro.h"
+#include <math.h>
+#include <string.h>
+
+#define TESTE_TAXA_HZ       1000.0f
+#define TESTE_GRAVIDADE     9.81f
+#define TESTE_PI            3.14159265358979
+
+// Resposta do passa-altas de 1 Hz seguido do passa-baixas de 25 Hz (Butterworth de 2ª ordem, bilinear)
+static double ganhoReferencia (double f) {
+    double t = tan (TESTE_PI * f / TESTE_TAXA_HZ);
+    double alta = pow (t / tan (TESTE_PI * PAVIMENTO_PASSA_ALTA_HZ / TESTE_TAXA_HZ), 2.0);
+    double baixa = pow (t / tan (TESTE_PI * PAVIMENTO_PASSA_BAIXA_HZ / TESTE_TAXA_HZ), 2.0);
+
+    return alta / sqrt (1.0 + alta * alta) / sqrt (1.0 + baixa * baixa);
+}
+
+static float senoide (int k, float frequencia, float amplitude) {
+    return amplitude * (float)sin (2.0 * TESTE_PI * frequencia * k / TESTE_TAXA_HZ);
+}
+
+// Ganho medido: filtra 'frequencia' em blocos até o transiente acabar e mede o RMS nos últimos períodos inteiros
+static double ganhoMedido (float frequencia) {
+    pavimentoCarro pavimento;
+    float bloco[PAVIMENTO_BLOCO];
+    int periodo = (int)(TESTE_TAXA_HZ / frequencia + 0.5f);
+    int medidas = periodo * (((int)TESTE_TAXA_HZ + periodo - 1) / periodo);    // ao menos 1 s
+    int total = 5 * (int)TESTE_TAXA_HZ + medidas;                               // 5 s de transiente
+    int k, i, n;
+    double soma = 0.0;
+
+    iniciaPavimento (&pavimento, TESTE_TAXA_HZ);
+    for (k = 0; k < total; k += n) {
+        n = total - k < PAVIMENTO_BLOCO ? total - k : PAVIMENTO_BLOCO;
+        for (i = 0; i < n; i++) {
+            bloco[i] = senoide (k + i, frequencia, 1.0f);
+        }
+        filtraBiquad (&pavimento.filtro, bloco, bloco, n);
+        for (i = 0; i < n; i++) {
+            if (k + i >= total - medidas) {
+                soma += (double)bloco[i] * bloco[i];
+            }
+        }
+    }
+    return sqrt (2.0 * soma / medidas);
+}
+
+static void testaResposta (void) {
+    static const float frequencias[] = { 0.2f, 0.5f, 1.0f, 2.0f, 5.0f, 10.0f, 25.0f, 50.0f, 100.0f, 200.0f };
+    double medido, referencia;
+    unsigned int i;
+
+    for (i = 0; i < sizeof (frequencias) / sizeof (frequencias[0]); i++) {
+        medido = ganhoMedido (frequencias[i]);
+        referencia = ganhoReferencia (frequencias[i]);
+        printf ("%6.1f Hz: ganho %.4f (referencia %.4f, %+6.1f dB)\n", frequencias[i], medido, referencia,
+                20.0 * log10 (medido));
+        CONFERE (fabs (medido - referencia) <= 0.01 * referencia);
+    }
+
+    // -3 dB nos dois cortes (o outro estágio quase não atenua ali)
+    CONFERE (fabs (ganhoMedido (PAVIMENTO_PASSA_ALTA_HZ) - sqrt (0.5)) < 0.01);
+    CONFERE (fabs (ganhoMedido (PAVIMENTO_PASSA_BAIXA_HZ) - sqrt (0.5)) < 0.01);
+}
+
+static void testaBlocos (void) {
+    static const int tamanhos[] = { 1, 7, PAVIMENTO_BLOCO };
+    static float entrada[2000], referencia[2000], saida[2000];
+    biquadCascata filtro;
+    pavimentoCarro pavimento;
+    unsigned int t;
+    int k, n, iguais;
+    float maior = 0.0f;
+
+    for (k = 0; k < 2000; k++) {
+        entrada[k] = TESTE_GRAVIDADE + senoide (k, 10.0f, 1.0f) + senoide (k, 180.0f, 0.5f);
+    }
+    iniciaPavimento (&pavimento, TESTE_TAXA_HZ);
+    memcpy (&filtro, &pavimento.filtro, sizeof (filtro));
+    filtraBiquad (&filtro, entrada, referencia, 2000);
+
+    for (t = 0; t < sizeof (tamanhos) / sizeof (tamanhos[0]); t++) {
+        memcpy (&filtro, &pavimento.filtro, sizeof (filtro));
+        memcpy (saida, entrada, sizeof (saida));
+        for (k = 0; k < 2000; k += n) {
+            n = 2000 - k < tamanhos[t] ? 2000 - k : tamanhos[t];
+            filtraBiquad (&filtro, &saida[k], &saida[k], n);
+        }
+        for (k = 0, iguais = 0; k < 2000; k++) {
+            iguais += saida[k] == referencia[k];
+        }
+        CONFERE (iguais == 2000);
+    }
+
+    // Gravidade constante com o filtro preparado: sem o degrau de 9,81 m/s² na saída
+    memcpy (&filtro, &pavimento.filtro, sizeof (filtro));
+    preparaBiquad (&filtro, TESTE_GRAVIDADE);
+    for (k = 0; k < 2000; k++) {
+        entrada[k] = TESTE_GRAVIDADE;
+    }
+    filtraBiquad (&filtro, entrada, saida, 2000);
+    for (k = 0; k < 2000; k++) {
+        maior = fabsf (saida[k]) > maior ? fabsf (saida[k]) : maior;
+    }
+    printf ("gravidade constante com preparaBiquad: maior saida %.2e m/s2\n", maior);
+    CONFERE (maior < 1e-3f);
+}
+
+// Percorre 'segundos' a 'velocidade' mm/s com 9,81 m/s² + 'amplitude' a 'frequencia'; retorna os trechos entregues
+static int percorre (pavimentoCarro *pavimento, dataGPS *posicao, uint32_t *distanciaMm, int segundos,
+                     int32_t velocidade, float frequencia, float amplitude, trechoPavimento *trechos, int maximo) {
+    float bloco[PAVIMENTO_BLOCO];
+    int k, i, total = segundos * (int)TESTE_TAXA_HZ, entregues = 0;
+
+    posicao->speed = velocidade;
+    for (k = 0; k < total; k += PAVIMENTO_BLOCO) {
+        for (i = 0; i < PAVIMENTO_BLOCO; i++) {
+            bloco[i] = TESTE_GRAVIDADE + senoide (k + i, frequencia, amplitude);
+        }
+        *distanciaMm += (uint32_t)velocidade * PAVIMENTO_BLOCO / (uint32_t)TESTE_TAXA_HZ;
+        posicao->latitude += 1;
+        if (processaPavimento (pavimento, bloco, PAVIMENTO_BLOCO, *distanciaMm, posicao,
+                               1000000 + k, &trechos[entregues < maximo ? entregues : maximo - 1])) {
+            entregues++;
+        }
+    }
+    return entregues;
+}
+
+static void testaTrechos (void) {
+    static trechoPavimento trechos[128];
+    pavimentoCarro pavimento;
+    dataGPS posicao;
+    uint32_t distanciaMm = 0;
+    double esperado = ganhoReferencia (10.0) * 1000.0, motor = ganhoReferencia (100.0) * 1000.0;
+    int entregues, i, conferem = 0;
+
+    memset (&posicao, 0, sizeof (posicao));
+    posicao.latitude = -37436000;
+    posicao.longitude = -385336000;
+    iniciaPavimento (&pavimento, TESTE_TAXA_HZ);
+
+    // 54 km/h por 20 s (625 blocos de 480 mm): cada trecho fecha no 21º bloco, 10080 mm, e são 29 trechos
+    entregues = percorre (&pavimento, &posicao, &distanciaMm, 20, 15000, 10.0f, 1.0f, trechos, 128);
+    printf ("10 Hz a 54 km/h: %d trechos, rms %u mm/s2 (esperado %.0f), pico %u, %lu mm/s\n", entregues, trechos[5].rms,
+            esperado / sqrt (2.0), trechos[5].pico, (unsigned long)trechos[5].velocidade);
+    CONFERE (entregues == 29);
+    for (i = 1; i < entregues; i++) {
+        conferem += fabs (trechos[i].rms - esperado / sqrt (2.0)) <= 0.02 * esperado &&
+                    fabs (trechos[i].pico - esperado) <= 0.02 * esperado &&
+                    trechos[i].velocidade == 15000;
+    }
+    CONFERE (conferem == entregues - 1);
+    CONFERE (trechos[0].latitude == -37436000 + 22 && trechos[entregues - 1].longitude == posicao.longitude);
+    CONFERE (trechos[entregues - 1].latitude > trechos[entregues - 2].latitude);
+    CONFERE (trechos[entregues - 1].instante > trechos[entregues - 2].instante);
+
+    // Vibração do motor a 100 Hz: fora da faixa da suspensão
+    entregues = percorre (&pavimento, &posicao, &distanciaMm, 4, 15000, 100.0f, 1.0f, trechos, 128);
+    printf ("100 Hz a 54 km/h: rms %u mm/s2 (esperado %.0f)\n", trechos[entregues - 1].rms, motor / sqrt (2.0));
+    CONFERE (fabs (trechos[entregues - 1].rms - motor / sqrt (2.0)) <= 0.05 * motor + 1.0);
+
+    // Devagar (9 km/h, 25 m): só fecha o trecho que começou em movimento; os seguintes não têm amostras
+    entregues = percorre (&pavimento, &posicao, &distanciaMm, 10, 2500, 10.0f, 1.0f, trechos, 128);
+    CONFERE (entregues == 1 && pavimento.amostras == 0);
+}
+
+int main (void) {
+    testaResposta ();
+    testaBlocos ();
+    testaTrechos ();
+    return FIM_DO_TESTE ();
+}
@@ -0,0 +1,170 @@
+/**
+ * testePublicacao.cpp       v0.0        17-10-2026
+ *
+ * Orientador: Elias Teodoro da Silva Junior
+ * Autores: Felipe Moura de Castro e Joao Bruno Costa Cruz,
+ * Instituto Federal de Educação, Ciência e Tecnologia do Ceará (IFCE) - Campus Fortaleza
+ *
+ * @Opensource
+ * Este código-fonte pode ser utilizado, copiado, estudado, modificado e redistribuído sem restrições.
+ *
+ * Copyright (c) 2019, Felipe Moura de Castro e Joao Bruno Costa Cruz.
+ *
+ */
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * Teste de leituras rasgadas no controle de sequência (publicaGPS/leGPS e publicaCalibracao/leCalibracao)
+ *
+ * Uma Thread publica sem parar; a publicação k tem todos os campos derivados de k (cada byte do dataGPS igual a
+ * k & 0xFF, com a latitude igual a k; cada campo do registroCalibracao igual a k). Outra Thread lê ao mesmo tempo e
+ * confere que todo valor lido vem de uma única publicação, que ele é o da publicação informada pelo retorno da leitura e
+ * que as leituras nunca voltam no tempo.
+ *
+ * Como referência, uma terceira passada copia o dataGPS sem o controle de sequência e conta as cópias rasgadas: mostra
+ * que a disputa acontece de fato (em um computador com um só núcleo ela é rara, e a contagem pode ser zero).
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+#include "teste.h"
+#include "GPS_Carro/GPS_Carro.h"
+#include "CalibracaoCarro/calibracaoCarro.h"
+#include <thread>
+#include <atomic>
+
+#define TESTE_PUBLICACOES       2000000
+
+typedef struct {
+    uint32_t leituras;
+    uint32_t rasgadas;
+    uint32_t foraDaSequencia;
+    uint32_t voltas;
+} resultadoLeitura;
+
+// Publicação k do dataGPS: todos os bytes iguais a k & 0xFF e a latitude igual a k
+static void montaFix (uint32_t k, dataGPS *data) {
+    memset (data, (int)(k & 0xFF), sizeof (dataGPS));
+    data->latitude = (int32_t)k;
+}
+
+static bool fixInteiro (const dataGPS *data) {
+    const uint8_t *p = (const uint8_t *)data;
+    uint8_t esperado = (uint8_t)((uint32_t)data->latitude & 0xFF);
+    size_t i;
+
+    for (i = 0; i < sizeof (dataGPS); i++) {
+        if ((i < offsetof (dataGPS, latitude) || i >= offsetof (dataGPS, latitude) + sizeof (int32_t)) &&
+            p[i] != esperado) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static void testaGPS (bool comSequencia) {
+    static publicadorGPS publicador;
+    std::atomic<bool> terminou (false);
+    resultadoLeitura resultado;
+    dataGPS lido;
+    uint32_t n, anterior = 0;
+
+    memset (&publicador, 0, sizeof (publicador));
+    memset (&resultado, 0, sizeof (resultado));
+
+    std::thread escritora ([&] () {
+        dataGPS data;
+        for (uint32_t k = 1; k <= TESTE_PUBLICACOES; k++) {
+            montaFix (k, &data);
+            publicaGPS (&publicador, &data);
+        }
+        terminou = true;
+    });
+
+    while (!terminou) {
+        if (comSequencia) {
+            n = leGPS (&publicador, &lido);
+            // A publicação n tem a latitude n (0 antes da primeira)
+            resultado.foraDaSequencia += ((uint32_t)lido.latitude != n);
+            resultado.voltas += (n < anterior);
+            anterior = n;
+        } else {
+            memcpy (&lido, (const void *)&publicador.dados, sizeof (dataGPS));
+        }
+        resultado.rasgadas += !fixInteiro (&lido);
+        resultado.leituras++;
+    }
+    escritora.join ();
+
+    printf ("%s: %lu leituras durante %d publicacoes, %lu rasgadas, %lu fora da sequencia, %lu voltas\n",
+            comSequencia ? "publicaGPS/leGPS" : "dataGPS sem sequencia (referencia)", (unsigned long)resultado.leituras,
+            TESTE_PUBLICACOES, (unsigned long)resultado.rasgadas, (unsigned long)resultado.foraDaSequencia,
+            (unsigned long)resultado.voltas);
+    if (comSequencia) {
+        CONFERE (resultado.leituras > 0);
+        CONFERE (resultado.rasgadas == 0);
+        CONFERE (resultado.foraDaSequencia == 0);
+        CONFERE (resultado.voltas == 0);
+        CONFERE (leGPS (&publicador, &lido) == TESTE_PUBLICACOES);
+    }
+}
+
+static bool registroInteiro (const registroCalibracao *registro, uint16_t esperado) {
+    int k;
+
+    for (k = 0; k < 3; k++) {
+        if ((uint16_t)registro->acce[k] != esperado || (uint16_t)registro->gyro[k] != esperado) {
+            return false;
+        }
+    }
+    return (uint16_t)registro->rolagem == esperado && (uint16_t)registro->arfagem == esperado &&
+           (uint16_t)registro->guinada == esperado && registro->validos == esperado;
+}
+
+static void testaCalibracao (void) {
+    static calibracaoCarro calibracao;
+    std::atomic<bool> terminou (false);
+    resultadoLeitura resultado;
+    registroCalibracao lido;
+    uint32_t n, anterior = 0;
+
+    iniciaCalibracao (&calibracao, 1000);
+    memset (&resultado, 0, sizeof (resultado));
+
+    std::thread escritora ([&] () {
+        registroCalibracao *registro = &calibracao.registro;
+        for (uint32_t k = 1; k <= TESTE_PUBLICACOES; k++) {
+            int16_t v = (int16_t)(uint16_t)k;
+            registro->acce[0] = registro->acce[1] = registro->acce[2] = v;
+            registro->gyro[0] = registro->gyro[1] = registro->gyro[2] = v;
+            registro->rolagem = registro->arfagem = registro->guinada = v;
+            registro->validos = (uint16_t)k;
+            publicaCalibracao (&calibracao);
+        }
+        terminou = true;
+    });
+
+    while (!terminou) {
+        n = leCalibracao (&calibracao, &lido);
+        resultado.rasgadas += !registroInteiro (&lido, lido.validos);
+        resultado.foraDaSequencia += (lido.validos != (uint16_t)n);
+        resultado.voltas += (n < anterior);
+        anterior = n;
+        resultado.leituras++;
+    }
+    escritora.join ();
+
+    printf ("publicaCalibracao/leCalibracao: %lu leituras durante %d publicacoes, %lu rasgadas, %lu fora da sequencia, "
+            "%lu voltas\n", (unsigned long)resultado.leituras, TESTE_PUBLICACOES, (unsigned long)resultado.rasgadas,
+            (unsigned long)resultado.foraDaSequencia, (unsigned long)resultado.voltas);
+    CONFERE (resultado.leituras > 0);
+    CONFERE (resultado.rasgadas == 0);
+    CONFERE (resultado.foraDaSequencia == 0);
+    CONFERE (resultado.voltas == 0);
+    CONFERE (leCalibracao (&calibracao, &lido) == TESTE_PUBLICACOES);
+}
+
+int main (void) {
+    testaGPS (true);
+    testaCalibracao ();
+    testaGPS (false);
+    return FIM_DO_TESTE ();
+}
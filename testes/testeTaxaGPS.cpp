@@ -0,0 +1,116 @@
+/**
+ * testeTaxaGPS.cpp       v0.0        17-10-2026
+ *
+ * Orientador: Elias Teodoro da Silva Junior
+ * Autores: Felipe Moura de Castro e Joao Bruno Costa Cruz,
+ * Instituto Federal de Educação, Ciência e Tecnologia do Ceará (IFCE) - Campus Fortaleza
+ *
+ * @Opensource
+ * Este código-fonte pode ser utilizado, copiado, estudado, modificado e redistribuído sem restrições.
+ *
+ * Copyright (c) 2019, Felipe Moura de Castro e Joao Bruno Costa Cruz.
+ *
+ */
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * Teste da negociação da taxa do GPS (configuraTaxaGPS) com um receptor simulado do outro lado da serial
+ *
+ * O receptor simulado só entende os bytes enviados na taxa em que está; bytes em outra taxa são erros de enquadramento
+ * que zeram o decodificador dele. O CFG-PRT troca a taxa do receptor e o CFG-RATE é confirmado com ACK-ACK (ou
+ * perdido, para simular a UART do receptor se recuperando). Casos:
+ * 1. receptor novo, em 9600: passa a 115200 e 5 Hz;
+ * 2. receptor já em 115200 (reset só do microcontrolador): continua em 115200 e 5 Hz;
+ * 3. receptor em 115200 que perde o primeiro CFG-RATE: a sonda em 115200 confirma, sem voltar a 9600;
+ * 4. sem receptor: a serial volta para 9600.
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+#include "teste.h"
+#include "GPS_Carro/GPS_Carro.h"
+
+#define TESTE_BAUD_INICIAL      9600
+#define TESTE_BAUD_ALTA         115200
+#define TESTE_PERIODO_MS        200
+
+typedef struct {
+    bool presente;
+    int taxa;
+    int taxasPerdidas;
+    uint16_t periodoMs;
+    decodificadorUBX decodificador;
+    uint8_t resposta[16];
+} receptorSimulado;
+
+static void recebeNoReceptor (receptorSimulado *receptor, RawSerial *serial, uint8_t c) {
+    decodificadorUBX *d = &receptor->decodificador;
+    uint8_t ack[2];
+
+    if (!receptor->presente) {
+        return;
+    }
+    if (serial->taxa != receptor->taxa) {
+        iniciaDecodificadorUBX (d);
+        return;
+    }
+    if (decodificaUBX (d, c) <= 0 || d->classe != UBX_CLASSE_CFG) {
+        return;
+    }
+    if (d->id == UBX_CFG_PRT && d->tamanho == 20) {
+        receptor->taxa = d->payload[8] | (d->payload[9] << 8) | (d->payload[10] << 16) | (d->payload[11] << 24);
+    } else if (d->id == UBX_CFG_RATE && d->tamanho == 6) {
+        if (receptor->taxasPerdidas > 0) {
+            receptor->taxasPerdidas--;
+            return;
+        }
+        receptor->periodoMs = (uint16_t)(d->payload[0] | (d->payload[1] << 8));
+        ack[0] = UBX_CLASSE_CFG;
+        ack[1] = UBX_CFG_RATE;
+        serial->recebe (receptor->resposta, montaMensagemUBX (UBX_CLASSE_ACK, UBX_ACK_ACK, ack, 2,
+                                                                receptor->resposta));
+    }
+}
+
+// Negocia com o receptor e retorna o resultado de configuraTaxaGPS
+static int negocia (receptorSimulado *receptor, RawSerial *serial, bool presente, int taxa, int taxasPerdidas) {
+    receptor->presente = presente;
+    receptor->taxa = taxa;
+    receptor->taxasPerdidas = taxasPerdidas;
+    receptor->periodoMs = 1000;
+    iniciaDecodificadorUBX (&receptor->decodificador);
+    serial->baud (TESTE_BAUD_INICIAL);
+    serial->recebe (NULL, 0);
+    serial->dispositivo = [receptor] (RawSerial *s, uint8_t c) { recebeNoReceptor (receptor, s, c); };
+    return configuraTaxaGPS (serial, TESTE_BAUD_INICIAL, TESTE_BAUD_ALTA, TESTE_PERIODO_MS);
+}
+
+int main (void) {
+    static receptorSimulado receptor;
+    RawSerial serial;
+
+    // 1. Receptor novo
+    CONFERE (negocia (&receptor, &serial, true, TESTE_BAUD_INICIAL, 0) == 1);
+    CONFERE (serial.taxa == TESTE_BAUD_ALTA && receptor.taxa == TESTE_BAUD_ALTA);
+    CONFERE (receptor.periodoMs == TESTE_PERIODO_MS);
+
+    // 2. Receptor que guardou 115200 na memória com bateria
+    CONFERE (negocia (&receptor, &serial, true, TESTE_BAUD_ALTA, 0) == 1);
+    CONFERE (serial.taxa == TESTE_BAUD_ALTA && receptor.taxa == TESTE_BAUD_ALTA);
+    CONFERE (receptor.periodoMs == TESTE_PERIODO_MS);
+
+    // 3. O primeiro CFG-RATE se perde: a sonda em 115200 confirma
+    CONFERE (negocia (&receptor, &serial, true, TESTE_BAUD_ALTA, 1) == 1);
+    CONFERE (serial.taxa == TESTE_BAUD_ALTA && receptor.taxa == TESTE_BAUD_ALTA);
+    CONFERE (receptor.periodoMs == TESTE_PERIODO_MS);
+
+    // 4. Sem receptor: volta para a taxa original
+    CONFERE (negocia (&receptor, &serial, false, TESTE_BAUD_INICIAL, 0) == 0);
+    CONFERE (serial.taxa == TESTE_BAUD_INICIAL);
+
+    // Receptor que nunca confirma o CFG-RATE (só aceita 1 Hz): volta para 9600, onde o receptor também volta
+    CONFERE (negocia (&receptor, &serial, true, TESTE_BAUD_INICIAL, 2) == 0);
+    CONFERE (serial.taxa == TESTE_BAUD_INICIAL && receptor.taxa == TESTE_BAUD_INICIAL);
+    CONFERE (receptor.periodoMs == 1000);
+
+    serial.dispositivo = nullptr;
+    return FIM_DO_TESTE ();
+}
@@ -0,0 +1,64 @@
+/**
+ * testeTempo.cpp       v0.0        17-10-2026
+ *
+ * Orientador: Elias Teodoro da Silva Junior
+ * Autores: Felipe Moura de Castro e Joao Bruno Costa Cruz,
+ * Instituto Federal de Educação, Ciência e Tecnologia do Ceará (IFCE) - Campus Fortaleza
+ *
+ * @Opensource
+ * Este código-fonte pode ser utilizado, copiado, estudado, modificado e redistribuído sem restrições.
+ *
+ * Copyright (c) 2019, Felipe Moura de Castro e Joao Bruno Costa Cruz.
+ *
+ */
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * Teste da data usada no nome dos arquivos do SD (dataDoArquivo)
+ *
+ * Com o relógio sincronizado, a data é a local (UTC-3), também perto da meia-noite UTC. Sem hora, como na partida com o
+ * GPS sem fix e o DS1307 desacertado (sincronizaRelogioRTC recusa o ano 2000 do stub), a data do arquivo anterior é
+ * mantida; sem arquivo anterior ou com o controle.txt corrompido, 000000.
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+#include "teste.h"
+#include "TempoCarro/tempoCarro.h"
+#include <string.h>
+
+int main (void) {
+    I2C i2c;
+    RtcDs1307 rtc (i2c);
+    relogioGPS relogio;
+    dataGPS fix;
+    char data[7];
+
+    // 17/10/2026 02:30 UTC é 16/10/2026 23:30 em Brasília
+    CONFERE (dataDoArquivo ((uint64_t)DateTime (2026, 10, 17, 2, 30, 0).unixtime () * 1000, "261017AB", data) == 1);
+    CONFERE (strcmp (data, "261016") == 0);
+    CONFERE (dataDoArquivo ((uint64_t)DateTime (2026, 10, 17, 15, 0, 0).unixtime () * 1000, NULL, data) == 1);
+    CONFERE (strcmp (data, "261017") == 0);
+
+    // Partida sem GPS e com o RTC desacertado: o relógio fica sem hora
+    iniciaRelogio (&relogio);
+    CONFERE (sincronizaRelogioRTC (&relogio, &rtc, 5000) == 0);
+    CONFERE (tempoEmMs (&relogio, 5000) == 0);
+
+    CONFERE (dataDoArquivo (tempoEmMs (&relogio, 5000), "261016AC", data) == 0);
+    CONFERE (strcmp (data, "261016") == 0);
+    CONFERE (dataDoArquivo (0, "", data) == 0);
+    CONFERE (strcmp (data, "000000") == 0);
+    CONFERE (dataDoArquivo (0, NULL, data) == 0);
+    CONFERE (strcmp (data, "000000") == 0);
+    CONFERE (dataDoArquivo (0, "26\r\n16", data) == 0);
+    CONFERE (strcmp (data, "000000") == 0);
+
+    // Com o primeiro fix, a data volta a ser a do relógio
+    memset (&fix, 0, sizeof (fix));
+    memcpy (fix.date, "171026", 6);
+    fix.time = 143000;
+    CONFERE (sincronizaRelogio (&relogio, &fix, 6000) == 1);
+    CONFERE (dataDoArquivo (tempoEmMs (&relogio, 6000), "261016AC", data) == 1);
+    CONFERE (strcmp (data, "261017") == 0);
+    printf ("arquivo com o relogio sincronizado: %s\n", data);
+    return FIM_DO_TESTE ();
+}
@@ -0,0 +1,199 @@
+/**
+ * testeUBX.cpp       v0.0        17-10-2026
+ *
+ * Orientador: Elias Teodoro da Silva Junior
+ * Autores: Felipe Moura de Castro e Joao Bruno Costa Cruz,
+ * Instituto Federal de Educação, Ciência e Tecnologia do Ceará (IFCE) - Campus Fortaleza
+ *
+ * @Opensource
+ * Este código-fonte pode ser utilizado, copiado, estudado, modificado e redistribuído sem restrições.
+ *
+ * Copyright (c) 2019, Felipe Moura de Castro e Joao Bruno Costa Cruz.
+ *
+ */
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * Teste do modo UBX: HDOP e satélites utilizados
+ *
+ * 1. configuraModoUBX liga NAV-DOP e NAV-SOL junto com as demais mensagens NAV (comandos lidos do RawSerial do stub).
+ * 2. Na captura UBX simulada, todo fix tem os DOPs do NAV-DOP e os satélites do NAV-SOL e é confiável.
+ * 3. Sem o NAV-DOP (ou sem o NAV-SOL) nenhum fix é entregue, e fixConfiavel descarta um fix UBX com HDOP zero (um fix
+ *    NMEA só com o RMC continua aceito).
+ * 4. O NAV-PVT só completa o fix com o NAV-DOP da mesma época.
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+#include "teste.h"
+#include "receptorGPS.h"
+#include "trajetoSimulado.h"
+
+#define TESTE_EPOCAS            600
+#define TESTE_HDOP_MAXIMO       500
+
+static void testaConfiguracao (void) {
+    RawSerial serial;
+    decodificadorUBX decodificador;
+    bool dop = false, sol = false;
+    int mensagens = 0;
+    size_t i;
+
+    configuraModoUBX (&serial);
+    iniciaDecodificadorUBX (&decodificador);
+    for (i = 0; i < serial.enviados && i < TAMANHO_SAIDA_STUB; i++) {
+        if (decodificaUBX (&decodificador, serial.saida[i]) > 0 && decodificador.classe == UBX_CLASSE_CFG &&
+            decodificador.id == UBX_CFG_MSG && decodificador.tamanho == 3) {
+            mensagens++;
+            if (decodificador.payload[0] == UBX_CLASSE_NAV && decodificador.payload[2] == 1) {
+                dop = dop || decodificador.payload[1] == UBX_NAV_DOP;
+                sol = sol || decodificador.payload[1] == UBX_NAV_SOL;
+            }
+        }
+    }
+    printf ("configuraModoUBX: %d comandos CFG-MSG, NAV-DOP %s, NAV-SOL %s\n", mensagens, dop ? "ligado" : "desligado",
+            sol ? "ligado" : "desligado");
+    CONFERE (dop && sol);
+}
+
+// Copia a captura sem os quadros NAV com o id informado
+static int removeQuadros (const uint8_t *captura, int tamanho, uint8_t id, uint8_t *saida) {
+    int i = 0, n = 0, quadro;
+
+    while (i + 8 <= tamanho) {
+        quadro = 8 + (captura[i + 4] | (captura[i + 5] << 8));
+        if (!(captura[i + 2] == UBX_CLASSE_NAV && captura[i + 3] == id)) {
+            memcpy (saida + n, captura + i, quadro);
+            n += quadro;
+        }
+        i += quadro;
+    }
+    return n;
+}
+
+static int contaFixes (const uint8_t *captura, int tamanho, int *confiaveis) {
+    receptorGPS receptor;
+    dataGPS fix;
+    int i;
+
+    *confiaveis = 0;
+    iniciaReceptor (&receptor);
+    for (i = 0; i < tamanho; i++) {
+        if (recebeByte (&receptor, captura[i], &fix)) {
+            *confiaveis += fixConfiavel (&fix, TESTE_HDOP_MAXIMO);
+        }
+    }
+    return (int)receptor.fixes;
+}
+
+static void testaCaptura (void) {
+    receptorGPS receptor;
+    dataGPS fix;
+    uint8_t *captura, *recortada;
+    int tamanho, n, i, fixes = 0, confiaveis, errados = 0;
+
+    captura = geraCaptura (-1, TESTE_EPOCAS, 1.5, &tamanho);
+    iniciaReceptor (&receptor);
+    for (i = 0; i < tamanho; i++) {
+        if (recebeByte (&receptor, captura[i], &fix)) {
+            fixes++;
+            errados += !(strcmp (fix.protocol, "UBX") == 0 && fix.hdop == 95 && fix.pdop == 172 && fix.vdop == 143 &&
+                         fix.satellites == 8 && fix.fixType == 3 && fixConfiavel (&fix, TESTE_HDOP_MAXIMO));
+        }
+    }
+    printf ("captura UBX: %d fixes de %d, %d sem HDOP 0,95 e 8 satelites\n", fixes, TESTE_EPOCAS, errados);
+    CONFERE (fixes == TESTE_EPOCAS);
+    CONFERE (errados == 0);
+
+    // Sem NAV-DOP ou sem NAV-SOL a época nunca fica completa
+    recortada = (uint8_t *)malloc (tamanho);
+    n = removeQuadros (captura, tamanho, UBX_NAV_DOP, recortada);
+    CONFERE (n < tamanho);
+    CONFERE (contaFixes (recortada, n, &confiaveis) == 0);
+    n = removeQuadros (captura, tamanho, UBX_NAV_SOL, recortada);
+    CONFERE (n < tamanho);
+    CONFERE (contaFixes (recortada, n, &confiaveis) == 0);
+    free (recortada);
+    free (captura);
+
+    // Fix UBX válido mas sem HDOP: descartado; fix NMEA só com o RMC: aceito
+    memset (&fix, 0, sizeof (fix));
+    fix.valid = 'A';
+    strcpy (fix.protocol, "UBX");
+    CONFERE (!fixConfiavel (&fix, TESTE_HDOP_MAXIMO));
+    fix.hdop = 95;
+    CONFERE (fixConfiavel (&fix, TESTE_HDOP_MAXIMO));
+    fix.hdop = TESTE_HDOP_MAXIMO + 1;
+    CONFERE (!fixConfiavel (&fix, TESTE_HDOP_MAXIMO));
+    fix.hdop = 0;
+    strcpy (fix.protocol, "GPRMC");
+    CONFERE (fixConfiavel (&fix, TESTE_HDOP_MAXIMO));
+}
+
+// Entrega um quadro NAV ao decodificador; retorna o resultado do interpretaUBX
+static int entregaQuadro (decodificadorUBX *decodificador, uint8_t id, const uint8_t *payload, uint16_t tamanho,
+                          dataGPS *fix) {
+    uint8_t quadro[TAMANHO_PAYLOAD_UBX + 8];
+    int n = montaMensagemUBX (UBX_CLASSE_NAV, id, payload, tamanho, quadro), i, completo = 0;
+
+    for (i = 0; i < n; i++) {
+        if (decodificaUBX (decodificador, quadro[i]) > 0) {
+            completo = interpretaUBX (decodificador, fix);
+        }
+    }
+    return completo;
+}
+
+static void escreveU32 (uint8_t *p, uint32_t valor) {
+    p[0] = (uint8_t)valor;
+    p[1] = (uint8_t)(valor >> 8);
+    p[2] = (uint8_t)(valor >> 16);
+    p[3] = (uint8_t)(valor >> 24);
+}
+
+static void testaPVT (void) {
+    decodificadorUBX decodificador;
+    uint8_t pvt[92], dop[18];
+    dataGPS fix;
+
+    memset (&fix, 0, sizeof (fix));
+    memset (pvt, 0, sizeof (pvt));
+    memset (dop, 0, sizeof (dop));
+    iniciaDecodificadorUBX (&decodificador);
+
+    escreveU32 (&pvt[0], 561600000);
+    pvt[4] = 0xEA;                  // 2026
+    pvt[5] = 0x07;
+    pvt[6] = 10;
+    pvt[7] = 17;
+    pvt[8] = 12;
+    pvt[20] = 3;                    // fix 3D
+    pvt[21] = 0x01;                 // gnssFixOK
+    pvt[23] = 9;
+    escreveU32 (&pvt[24], (uint32_t)-385336000);
+    escreveU32 (&pvt[28], (uint32_t)-37436000);
+    pvt[76] = 150;                  // pDOP 1,50
+
+    // NAV-PVT sozinho não tem HDOP: o fix espera o NAV-DOP
+    CONFERE (entregaQuadro (&decodificador, UBX_NAV_PVT, pvt, sizeof (pvt), &fix) == 0);
+
+    // NAV-DOP de outra época não completa o fix
+    escreveU32 (&dop[0], 561601000);
+    dop[12] = 88;
+    CONFERE (entregaQuadro (&decodificador, UBX_NAV_DOP, dop, sizeof (dop), &fix) == 0);
+
+    CONFERE (entregaQuadro (&decodificador, UBX_NAV_PVT, pvt, sizeof (pvt), &fix) == 0);
+    escreveU32 (&dop[0], 561600000);
+    dop[6] = 150;
+    dop[10] = 120;
+    dop[12] = 88;
+    CONFERE (entregaQuadro (&decodificador, UBX_NAV_DOP, dop, sizeof (dop), &fix) == 1);
+    CONFERE (fix.hdop == 88 && fix.pdop == 150 && fix.vdop == 120 && fix.satellites == 9);
+    CONFERE (fix.latitude == -37436000 && fix.longitude == -385336000 && fix.time == 120000);
+    CONFERE (fixConfiavel (&fix, TESTE_HDOP_MAXIMO));
+}
+
+int main (void) {
+    testaConfiguracao ();
+    testaCaptura ();
+    testaPVT ();
+    return FIM_DO_TESTE ();
+}
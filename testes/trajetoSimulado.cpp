@@ -0,0 +1,332 @@
+/**
+ * trajetoSimulado.cpp       v0.0        17-10-2026
+ *
+ * Orientador: Elias Teodoro da Silva Junior
+ * Autores: Felipe Moura de Castro e Joao Bruno Costa Cruz,
+ * Instituto Federal de Educação, Ciência e Tecnologia do Ceará (IFCE) - Campus Fortaleza
+ *
+ * @Opensource
+ * Este código-fonte pode ser utilizado, copiado, estudado, modificado e redistribuído sem restrições.
+ *
+ * Copyright (c) 2019, Felipe Moura de Castro e Joao Bruno Costa Cruz.
+ *
+ */
+
+#include "trajetoSimulado.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define RAIO_DA_TERRA_M         6371000.0
+#define PI_D                    3.14159265358979323846
+#define PASSO_S                 0.01
+#define NOS_POR_M_S             (3600.0 / 1852.0)
+
+// Segundos da semana GPS às 12:00:00 de sábado, 17/10/26 (época 0 do trajeto)
+#define ITOW_INICIAL_MS         561600000u
+
+/**
+ * Aceleração longitudinal (m/s²) e taxa de variação do curso (graus/s, sentido horário) em cada trecho do ciclo
+ */
+static void perfilDoTrajeto (double tempo, double *aceleracao, double *taxaDoCurso) {
+    double t = fmod (tempo, TRAJETO_CICLO_S);
+
+    *aceleracao = 0.0;
+    *taxaDoCurso = 0.0;
+    if (t < 20.0)        *aceleracao = 0.75;     // arrancada até 15 m/s
+    else if (t < 80.0)   ;                       // reta
+    else if (t < 110.0)  *taxaDoCurso = 3.0;     // curva de 90° à direita
+    else if (t < 150.0)  ;                       // reta
+    else if (t < 165.0)  *aceleracao = -1.0;     // frenagem
+    else if (t < 200.0)  ;                       // parado
+    else if (t < 215.0)  *aceleracao = 0.8;      // arrancada até 12 m/s
+    else if (t < 245.0)  *taxaDoCurso = -6.0;    // retorno de 180° à esquerda
+    else if (t < 285.0)  ;                       // reta
+    else if (t < 297.0)  *aceleracao = -1.0;     // frenagem
+}
+
+void iniciaTrajeto (trajetoSimulado *trajeto, double ruidoM, uint32_t semente) {
+    memset (trajeto, 0, sizeof (trajetoSimulado));
+    trajeto->latitude = TRAJETO_LATITUDE_INICIAL;
+    trajeto->longitude = TRAJETO_LONGITUDE_INICIAL;
+    trajeto->altitude = TRAJETO_ALTITUDE_INICIAL;
+    trajeto->ruidoM = ruidoM;
+    trajeto->semente = semente ? semente : 1;
+}
+
+void avancaTrajeto (trajetoSimulado *trajeto, double dt) {
+    double aceleracao, taxaDoCurso, h, velocidadeMedia, cursoMedio;
+
+    while (dt > 1e-9) {
+        h = (dt < PASSO_S) ? dt : PASSO_S;
+        perfilDoTrajeto (trajeto->tempo, &aceleracao, &taxaDoCurso);
+        if (trajeto->velocidade <= 0.0 && aceleracao < 0.0) {
+            aceleracao = 0.0;
+        }
+
+        // Ponto médio do passo
+        velocidadeMedia = trajeto->velocidade + 0.5 * aceleracao * h;
+        if (velocidadeMedia < 0.0) velocidadeMedia = 0.0;
+        cursoMedio = (trajeto->curso + 0.5 * taxaDoCurso * h) * PI_D / 180.0;
+        trajeto->latitude += velocidadeMedia * cos (cursoMedio) * h / RAIO_DA_TERRA_M * 180.0 / PI_D;
+        trajeto->longitude += velocidadeMedia * sin (cursoMedio) * h /
+                              (RAIO_DA_TERRA_M * cos (trajeto->latitude * PI_D / 180.0)) * 180.0 / PI_D;
+
+        trajeto->velocidade += aceleracao * h;
+        if (trajeto->velocidade < 0.0) trajeto->velocidade = 0.0;
+        trajeto->curso = fmod (trajeto->curso + taxaDoCurso * h + 360.0, 360.0);
+        trajeto->tempo += h;
+        dt -= h;
+
+        trajeto->longitudinal = aceleracao;
+        trajeto->guinada = -taxaDoCurso * PI_D / 180.0;
+        trajeto->lateral = trajeto->velocidade * trajeto->guinada;
+    }
+}
+
+double normalSimulada (trajetoSimulado *trajeto) {
+    uint32_t x;
+    double u1, u2;
+
+    // xorshift32 e Box-Muller
+    x = trajeto->semente;
+    x ^= x << 13; x ^= x >> 17; x ^= x << 5;
+    u1 = (x + 1.0) / 4294967297.0;
+    x ^= x << 13; x ^= x >> 17; x ^= x << 5;
+    u2 = (x + 1.0) / 4294967297.0;
+    trajeto->semente = x;
+    return sqrt (-2.0 * log (u1)) * cos (2.0 * PI_D * u2);
+}
+
+int escreveSentencaNMEA (char *saida, int tamanho, const char *corpo) {
+    uint8_t soma = 0;
+    const char *p;
+    int n;
+
+    for (p = corpo; *p; p++) {
+        soma ^= (uint8_t)*p;
+    }
+    n = snprintf (saida, tamanho, "$%s*%02X\r\n", corpo, soma);
+    return (n > 0 && n < tamanho) ? n : 0;
+}
+
+// hhmmss.ss a partir do tempo do trajeto
+static void escreveHora (char *saida, int tamanho, double tempo) {
+    long centesimos = lround (tempo * 100.0) + 12L * 360000L;
+
+    snprintf (saida, tamanho, "%02ld%02ld%02ld.%02ld", (centesimos / 360000L) % 24, (centesimos / 6000L) % 60,
+              (centesimos / 100L) % 60, centesimos % 100L);
+}
+
+// ddmm.mmmmm,N (ou dddmm.mmmmm,E), arredondado para 10^-5 minuto
+static void escreveCoordenada (char *saida, int tamanho, double graus, int digitosDosGraus, char positivo,
+                               char negativo) {
+    long long total = llround (fabs (graus) * 60.0 * 100000.0);
+
+    // Os graus (no máximo 180) limitados a 3 dígitos: o texto sempre cabe nos vetores de escreveEpocaNMEA
+    snprintf (saida, tamanho, "%0*lld%02lld.%05lld,%c", digitosDosGraus, (total / 6000000LL) % 1000,
+              (total / 100000LL) % 60, total % 100000LL, graus < 0 ? negativo : positivo);
+}
+
+// Acrescenta uma sentença a saida; retorna false se não coube
+static bool acrescentaSentenca (char *saida, int tamanho, int *usados, const char *corpo) {
+    int n = escreveSentencaNMEA (saida + *usados, tamanho - *usados, corpo);
+
+    *usados += n;
+    return n > 0;
+}
+
+// Grupo de GSV com os satélites visíveis de uma constelação (4 por sentença)
+static bool acrescentaGSV (char *saida, int tamanho, int *usados, const char *talker, int visiveis, int primeiro) {
+    char corpo[100];
+    int total = (visiveis + 3) / 4, numero, i, n;
+
+    for (numero = 1; numero <= total; numero++) {
+        n = snprintf (corpo, sizeof (corpo), "%sGSV,%d,%d,%02d", talker, total, numero, visiveis);
+        for (i = (numero - 1) * 4; i < visiveis && i < numero * 4; i++) {
+            n += snprintf (corpo + n, sizeof (corpo) - n, ",%02d,%02d,%03d,%02d", primeiro + i, 15 + 7 * i,
+                           (37 * i) % 360, 25 + i);
+        }
+        if (!acrescentaSentenca (saida, tamanho, usados, corpo)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+int escreveEpocaNMEA (trajetoSimulado *trajeto, int receptor, char *saida, int tamanho) {
+    const char *solucao = (receptor == RECEPTOR_MULTI) ? "GN" : "GP";
+    char hora[16], latitude[24], longitude[24], corpo[100];
+    double norte = trajeto->ruidoM * normalSimulada (trajeto);
+    double leste = trajeto->ruidoM * normalSimulada (trajeto);
+    double nos = trajeto->velocidade * NOS_POR_M_S;
+    int usados = 0;
+    bool coube;
+
+    escreveHora (hora, sizeof (hora), trajeto->tempo);
+    escreveCoordenada (latitude, sizeof (latitude), trajeto->latitude + norte / RAIO_DA_TERRA_M * 180.0 / PI_D,
+                       2, 'N', 'S');
+    escreveCoordenada (longitude, sizeof (longitude), trajeto->longitude + leste /
+                       (RAIO_DA_TERRA_M * cos (trajeto->latitude * PI_D / 180.0)) * 180.0 / PI_D, 3, 'E', 'W');
+
+    snprintf (corpo, sizeof (corpo), "%sRMC,%s,A,%s,%s,%.3f,%.2f,171026,,,A", solucao, hora, latitude, longitude,
+              nos, trajeto->curso);
+    coube = acrescentaSentenca (saida, tamanho, &usados, corpo);
+    snprintf (corpo, sizeof (corpo), "%sVTG,%.2f,T,,M,%.3f,N,%.3f,K,A", solucao, trajeto->curso, nos,
+              trajeto->velocidade * 3.6);
+    coube = coube && acrescentaSentenca (saida, tamanho, &usados, corpo);
+    snprintf (corpo, sizeof (corpo), "%sGGA,%s,%s,%s,1,08,0.95,%.1f,M,-10.2,M,,", solucao, hora, latitude,
+              longitude, trajeto->altitude);
+    coube = coube && acrescentaSentenca (saida, tamanho, &usados, corpo);
+
+    if (receptor == RECEPTOR_MULTI) {
+        // Um GSA por constelação, com os mesmos DOPs
+        coube = coube && acrescentaSentenca (saida, tamanho, &usados,
+                                             "GNGSA,A,3,02,05,09,12,15,,,,,,,,1.72,0.95,1.43,1");
+        coube = coube && acrescentaSentenca (saida, tamanho, &usados,
+                                             "GNGSA,A,3,68,69,79,,,,,,,,,,1.72,0.95,1.43,2");
+        coube = coube && acrescentaGSV (saida, tamanho, &usados, "GP", 11, 2);
+        coube = coube && acrescentaGSV (saida, tamanho, &usados, "GL", 7, 65);
+    } else {
+        coube = coube && acrescentaSentenca (saida, tamanho, &usados,
+                                             "GPGSA,A,3,02,05,09,12,15,17,19,24,,,,,1.72,0.95,1.43");
+        coube = coube && acrescentaGSV (saida, tamanho, &usados, "GP", 11, 2);
+    }
+
+    snprintf (corpo, sizeof (corpo), "%sGLL,%s,%s,%s,A,A", solucao, latitude, longitude, hora);
+    coube = coube && acrescentaSentenca (saida, tamanho, &usados, corpo);
+    return coube ? usados : 0;
+}
+
+// Escrita little-endian, como nos payloads UBX
+static void escreveU16 (uint8_t *p, uint32_t valor) {
+    p[0] = (uint8_t)valor;
+    p[1] = (uint8_t)(valor >> 8);
+}
+
+static void escreveU32 (uint8_t *p, uint32_t valor) {
+    escreveU16 (p, valor);
+    escreveU16 (p + 2, valor >> 16);
+}
+
+// Acrescenta um quadro UBX (com a soma de Fletcher própria, independente do GPS_Carro); retorna false se não coube
+static bool acrescentaQuadroUBX (uint8_t *saida, int tamanho, int *usados, uint8_t classe, uint8_t id,
+                                 const uint8_t *payload, int tamanhoDoPayload) {
+    uint8_t *q = saida + *usados, ckA = 0, ckB = 0;
+    int i;
+
+    if (*usados + tamanhoDoPayload + 8 > tamanho) {
+        return false;
+    }
+    q[0] = 0xB5;
+    q[1] = 0x62;
+    q[2] = classe;
+    q[3] = id;
+    escreveU16 (&q[4], (uint32_t)tamanhoDoPayload);
+    memcpy (&q[6], payload, tamanhoDoPayload);
+    for (i = 2; i < 6 + tamanhoDoPayload; i++) {
+        ckA += q[i];
+        ckB += ckA;
+    }
+    q[6 + tamanhoDoPayload] = ckA;
+    q[7 + tamanhoDoPayload] = ckB;
+    *usados += tamanhoDoPayload + 8;
+    return true;
+}
+
+int escreveEpocaUBX (trajetoSimulado *trajeto, uint8_t *saida, int tamanho) {
+    uint8_t p[52];
+    double norte = trajeto->ruidoM * normalSimulada (trajeto);
+    double leste = trajeto->ruidoM * normalSimulada (trajeto);
+    double curso = trajeto->curso * PI_D / 180.0;
+    long milissegundos = lround (trajeto->tempo * 1000.0);
+    uint32_t iTOW = ITOW_INICIAL_MS + (uint32_t)milissegundos;
+    long segundos = 12L * 3600L + milissegundos / 1000L;
+    int usados = 0;
+    bool coube;
+
+    // NAV-POSLLH
+    memset (p, 0, sizeof (p));
+    escreveU32 (&p[0], iTOW);
+    escreveU32 (&p[4], (uint32_t)(int32_t)llround ((trajeto->longitude + leste /
+                (RAIO_DA_TERRA_M * cos (trajeto->latitude * PI_D / 180.0)) * 180.0 / PI_D) * 1e7));
+    escreveU32 (&p[8], (uint32_t)(int32_t)llround ((trajeto->latitude + norte / RAIO_DA_TERRA_M * 180.0 / PI_D) * 1e7));
+    escreveU32 (&p[12], (uint32_t)(int32_t)lround ((trajeto->altitude - 10.2) * 1000.0));
+    escreveU32 (&p[16], (uint32_t)(int32_t)lround (trajeto->altitude * 1000.0));
+    escreveU32 (&p[20], 2500);
+    escreveU32 (&p[24], 4000);
+    coube = acrescentaQuadroUBX (saida, tamanho, &usados, 0x01, 0x02, p, 28);
+
+    // NAV-STATUS: fix 3D, gpsFixOk
+    memset (p, 0, sizeof (p));
+    escreveU32 (&p[0], iTOW);
+    p[4] = 3;
+    p[5] = 0x0D;
+    coube = coube && acrescentaQuadroUBX (saida, tamanho, &usados, 0x01, 0x03, p, 16);
+
+    // NAV-DOP: os mesmos DOPs do GSA (10^-2)
+    memset (p, 0, sizeof (p));
+    escreveU32 (&p[0], iTOW);
+    escreveU16 (&p[4], 198);
+    escreveU16 (&p[6], 172);
+    escreveU16 (&p[8], 98);
+    escreveU16 (&p[10], 143);
+    escreveU16 (&p[12], 95);
+    escreveU16 (&p[14], 71);
+    escreveU16 (&p[16], 63);
+    coube = coube && acrescentaQuadroUBX (saida, tamanho, &usados, 0x01, 0x04, p, 18);
+
+    // NAV-SOL: fix 3D com 8 satélites, como no GGA
+    memset (p, 0, sizeof (p));
+    escreveU32 (&p[0], iTOW);
+    p[10] = 3;
+    p[11] = 0x0D;
+    escreveU16 (&p[44], 172);
+    p[47] = 8;
+    coube = coube && acrescentaQuadroUBX (saida, tamanho, &usados, 0x01, 0x06, p, 52);
+
+    // NAV-VELNED: velocidades em cm/s e curso em 10^-5 graus
+    memset (p, 0, sizeof (p));
+    escreveU32 (&p[0], iTOW);
+    escreveU32 (&p[4], (uint32_t)(int32_t)lround (trajeto->velocidade * cos (curso) * 100.0));
+    escreveU32 (&p[8], (uint32_t)(int32_t)lround (trajeto->velocidade * sin (curso) * 100.0));
+    escreveU32 (&p[16], (uint32_t)lround (trajeto->velocidade * 100.0));
+    escreveU32 (&p[20], (uint32_t)lround (trajeto->velocidade * 100.0));
+    escreveU32 (&p[24], (uint32_t)(int32_t)lround (trajeto->curso * 100000.0));
+    coube = coube && acrescentaQuadroUBX (saida, tamanho, &usados, 0x01, 0x12, p, 36);
+
+    // NAV-TIMEUTC
+    memset (p, 0, sizeof (p));
+    escreveU32 (&p[0], iTOW);
+    escreveU32 (&p[8], (uint32_t)((milissegundos % 1000L) * 1000000L));
+    escreveU16 (&p[12], 2026);
+    p[14] = 10;
+    p[15] = 17;
+    p[16] = (uint8_t)((segundos / 3600L) % 24);
+    p[17] = (uint8_t)((segundos / 60L) % 60);
+    p[18] = (uint8_t)(segundos % 60L);
+    p[19] = 0x07;
+    coube = coube && acrescentaQuadroUBX (saida, tamanho, &usados, 0x01, 0x21, p, 20);
+
+    return coube ? usados : 0;
+}
+
+uint8_t *geraCaptura (int receptor, int epocas, double ruidoM, int *tamanho) {
+    trajetoSimulado trajeto;
+    int capacidade = epocas * 1200 + 1, usados = 0, n, i;
+    uint8_t *captura = (uint8_t *)malloc (capacidade);
+
+    iniciaTrajeto (&trajeto, ruidoM, 12345);
+    for (i = 0; i < epocas && captura != NULL; i++) {
+        if (receptor < 0) {
+            n = escreveEpocaUBX (&trajeto, captura + usados, capacidade - usados);
+        } else {
+            n = escreveEpocaNMEA (&trajeto, receptor, (char *)captura + usados, capacidade - usados);
+        }
+        usados += n;
+        avancaTrajeto (&trajeto, 1.0);
+    }
+    *tamanho = usados;
+    return captura;
+}
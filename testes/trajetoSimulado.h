@@ -0,0 +1,171 @@
+/**
+ * trajetoSimulado.h       v0.0        17-10-2026
+ *
+ * Orientador: Elias Teodoro da Silva Junior
+ * Autores: Felipe Moura de Castro e Joao Bruno Costa Cruz,
+ * Instituto Federal de Educação, Ciência e Tecnologia do Ceará (IFCE) - Campus Fortaleza
+ *
+ * @Opensource
+ * Este código-fonte pode ser utilizado, copiado, estudado, modificado e redistribuído sem restrições.
+ *
+ * Copyright (c) 2019, Felipe Moura de Castro e Joao Bruno Costa Cruz.
+ *
+ */
+
+#ifndef _TRAJETO_SIMULADO_H_
+#define _TRAJETO_SIMULADO_H_
+
+#include <stdint.h>
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * Trajeto simulado para os testes no computador
+ *
+ * Um percurso de TRAJETO_CICLO_S segundos que se repete: arrancada, reta, curva de 90° à direita, reta, frenagem,
+ * parada, arrancada, retorno de 180° à esquerda, reta, frenagem e parada, partindo de Fortaleza. A posição é integrada
+ * em passos de 10 ms a partir da velocidade e do curso, de forma que a verdade (posição, velocidade, curso e as
+ * acelerações longitudinal e lateral) é conhecida em qualquer instante.
+ *
+ * A partir do trajeto são escritas as épocas que um receptor enviaria: sentenças NMEA com a soma de verificação
+ * correta (GP.. de um receptor só GPS, ou a mistura GN/GP/GL de um receptor multi-constelação) ou os quadros UBX
+ * do modo binário. O ruído da posição informada é gaussiano, com semente fixa (a mesma semente gera a mesma captura).
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+#define TRAJETO_CICLO_S             300.0
+#define TRAJETO_LATITUDE_INICIAL    -3.7436
+#define TRAJETO_LONGITUDE_INICIAL   -38.5336
+#define TRAJETO_ALTITUDE_INICIAL    21.3
+
+/**
+ * Receptores simulados
+ */
+#define RECEPTOR_GPS                0       // NEO-6M: RMC, VTG, GGA, GSA, GSV e GLL com talker GP
+#define RECEPTOR_MULTI              1       // u-blox M8: GN para a solução, GP e GL para os satélites visíveis
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * @brief   Estado verdadeiro do carro simulado
+ *
+ * @var tempo                         segundos desde o início (a época 0 é 12:00:00 UTC de 17/10/26)
+ * @var latitude, longitude           posição verdadeira (graus)
+ * @var altitude                      altitude (m)
+ * @var velocidade                    velocidade (m/s)
+ * @var curso                         curso (graus a partir do Norte, sentido horário)
+ * @var longitudinal                  aceleração longitudinal (m/s², positiva para a frente)
+ * @var lateral                       aceleração lateral (m/s², positiva para a esquerda)
+ * @var guinada                       velocidade angular de guinada (rad/s, positiva para a esquerda)
+ * @var ruidoM                        desvio padrão do ruído da posição informada (m)
+ * @var semente                       estado do gerador pseudoaleatório
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+typedef struct {
+    double tempo;
+    double latitude;
+    double longitude;
+    double altitude;
+    double velocidade;
+    double curso;
+    double longitudinal;
+    double lateral;
+    double guinada;
+    double ruidoM;
+    uint32_t semente;
+} trajetoSimulado;
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * Protótipo das funções
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * @brief Inicializa o trajeto parado no ponto inicial
+ *
+ * @param trajeto       ponteiro para o trajeto
+ * @param ruidoM        desvio padrão do ruído da posição informada (m)
+ * @param semente       semente do gerador pseudoaleatório (diferente de 0)
+ *
+ * @return                      Não retorna nada.
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+void iniciaTrajeto (trajetoSimulado *trajeto, double ruidoM, uint32_t semente);
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * @brief Avança o trajeto
+ *
+ * @param trajeto       ponteiro para o trajeto
+ * @param dt            intervalo (s)
+ *
+ * @return                      Não retorna nada.
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+void avancaTrajeto (trajetoSimulado *trajeto, double dt);
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * @brief Número pseudoaleatório com distribuição normal padrão (usa e atualiza a semente do trajeto)
+ *
+ * @param trajeto       ponteiro para o trajeto
+ *
+ * @return                      amostra da normal com média 0 e desvio padrão 1.
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+double normalSimulada (trajetoSimulado *trajeto);
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * @brief Escreve uma sentença NMEA completa: '$', corpo, '*', soma de verificação e "\r\n"
+ *
+ * @param saida         vetor de saída
+ * @param tamanho       tamanho do vetor de saída
+ * @param corpo         sentença sem '$' e sem a soma (ex.: "GPRMC,...")
+ *
+ * @return                      quantidade de bytes escritos (0 se não couber).
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+int escreveSentencaNMEA (char *saida, int tamanho, const char *corpo);
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * @brief Escreve as sentenças NMEA da época atual, na ordem em que o receptor as envia
+ *
+ * @param trajeto       ponteiro para o trajeto (o ruído atualiza a semente)
+ * @param receptor      RECEPTOR_GPS ou RECEPTOR_MULTI
+ * @param saida         vetor de saída
+ * @param tamanho       tamanho do vetor de saída
+ *
+ * @return                      quantidade de bytes escritos (0 se não couber).
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+int escreveEpocaNMEA (trajetoSimulado *trajeto, int receptor, char *saida, int tamanho);
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * @brief Escreve os quadros UBX da época atual, como no modo UBX do NEO-6M
+ *
+ * @param trajeto       ponteiro para o trajeto (o ruído atualiza a semente)
+ * @param saida         vetor de saída
+ * @param tamanho       tamanho do vetor de saída
+ *
+ * @return                      quantidade de bytes escritos (0 se não couber).
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+int escreveEpocaUBX (trajetoSimulado *trajeto, uint8_t *saida, int tamanho);
+
+/**
+ *----------------------------------------------------------------------------------------------------------------------
+ * @brief Monta uma captura com várias épocas seguidas, a 1 fix por segundo
+ *
+ * @param receptor      RECEPTOR_GPS ou RECEPTOR_MULTI (NMEA), ou -1 para UBX
+ * @param epocas        quantidade de épocas
+ * @param ruidoM        desvio padrão do ruído da posição (m)
+ * @param tamanho       ponteiro que recebe a quantidade de bytes da captura
+ *
+ * @return                      captura alocada com malloc (liberada por quem chamou).
+ *----------------------------------------------------------------------------------------------------------------------
+ */
+uint8_t *geraCaptura (int receptor, int epocas, double ruidoM, int *tamanho);
+
+#endif /*_TRAJETO_SIMULADO_H_*/